@@ -0,0 +1,302 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file DeferredDestruction.hpp
+**/
+
+#ifndef UTILITIES_CONTAINERS_DEFERRED_DESTRUCTION_HPP
+#define UTILITIES_CONTAINERS_DEFERRED_DESTRUCTION_HPP
+
+#include "ReferenceCounted.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace Containers
+{
+    namespace ReferenceCounted
+    {
+        /** \brief Event handler that postpones destruction of resources
+         *
+         * When last reference is gone, resource is not destroyed inline.
+         * It is put on retire list of releasing thread instead. Retire list is
+         * moved to handler when it reaches batch size or when thread calls
+         * Flush. Moved batches are tagged with current epoch.
+         *
+         * Reclaim destroys all batches retired before current epoch. Call
+         * Advance_epoch at a point where none of threads keeps raw pointers
+         * obtained from references, e.g. at the end of frame. Reclaim can be
+         * called from any thread, e.g. from background task.
+         *
+         * Weak references to retired resource expire immediately.
+         *
+         * Handler has to outlive threads that retired resources with it.
+         **/
+        template <typename T>
+        class Deferred_destruction : public Event_handler < T >
+        {
+        public:
+            using epoch_t = Platform::uint64;
+            using size_type = Platform::uint32;
+
+            Deferred_destruction(size_type batch_size = 64);
+            virtual ~Deferred_destruction();
+
+            /* No copying */
+            Deferred_destruction(const Deferred_destruction &) = delete;
+            Deferred_destruction & operator = (const Deferred_destruction &) = delete;
+
+            virtual void On_last_reference_gone(
+                T * resource,
+                bool & should_resource_be_destoyed);
+
+            epoch_t Get_epoch() const;
+            epoch_t Advance_epoch();
+
+            void Flush();
+            size_type Reclaim();
+            size_type Reclaim_all();
+
+            size_type Get_pending_number() const;
+
+        private:
+            struct Batch
+            {
+                std::vector< T * > m_resources;
+                epoch_t m_epoch;
+            };
+
+            struct Retire_list
+            {
+                ~Retire_list();
+
+                Deferred_destruction * m_owner = nullptr;
+                std::vector< T * > m_resources;
+            };
+
+            void retire(T * resource);
+            void flush(Retire_list & list);
+            static size_type destroy(std::vector< Batch > & batches);
+
+            static thread_local Retire_list s_retire_list;
+
+            const size_type m_batch_size;
+            std::atomic< epoch_t > m_epoch;
+            std::atomic< size_type > m_pending;
+
+            mutable std::mutex m_mutex;
+            std::vector< Batch > m_batches;
+        };
+
+        template <typename T>
+        thread_local typename Deferred_destruction<T>::Retire_list Deferred_destruction<T>::s_retire_list;
+
+        template <typename T>
+        Deferred_destruction<T>::Retire_list::~Retire_list()
+        {
+            if (nullptr != m_owner)
+            {
+                m_owner->flush(*this);
+            }
+        }
+
+        template <typename T>
+        Deferred_destruction<T>::Deferred_destruction(size_type batch_size)
+            : m_batch_size(batch_size)
+            , m_epoch(0)
+            , m_pending(0)
+        {
+            /* Nothing to be done here */
+        }
+
+        template <typename T>
+        Deferred_destruction<T>::~Deferred_destruction()
+        {
+            if (this == s_retire_list.m_owner)
+            {
+                flush(s_retire_list);
+                s_retire_list.m_owner = nullptr;
+            }
+
+            Reclaim_all();
+        }
+
+        template <typename T>
+        void Deferred_destruction<T>::On_last_reference_gone(
+            T * resource,
+            bool & should_resource_be_destoyed)
+        {
+            should_resource_be_destoyed = false;
+
+            /* Resource must not be revived while waiting for destruction */
+            resource->expire_weak_references();
+
+            retire(resource);
+        }
+
+        template <typename T>
+        auto Deferred_destruction<T>::Get_epoch() const -> epoch_t
+        {
+            return m_epoch.load(std::memory_order_acquire);
+        }
+
+        template <typename T>
+        auto Deferred_destruction<T>::Advance_epoch() -> epoch_t
+        {
+            return m_epoch.fetch_add(1, std::memory_order_acq_rel) + 1;
+        }
+
+        template <typename T>
+        void Deferred_destruction<T>::Flush()
+        {
+            if (this == s_retire_list.m_owner)
+            {
+                flush(s_retire_list);
+            }
+        }
+
+        template <typename T>
+        auto Deferred_destruction<T>::Reclaim() -> size_type
+        {
+            const epoch_t epoch = Get_epoch();
+            std::vector< Batch > expired;
+
+            {
+                std::lock_guard< std::mutex > lock(m_mutex);
+
+                auto it = m_batches.begin();
+                while (m_batches.end() != it)
+                {
+                    if (epoch > it->m_epoch)
+                    {
+                        expired.push_back(std::move(*it));
+                        it = m_batches.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+            }
+
+            /* Destruction is done outside of lock */
+            const size_type count = destroy(expired);
+            m_pending.fetch_sub(count, std::memory_order_relaxed);
+
+            return count;
+        }
+
+        template <typename T>
+        auto Deferred_destruction<T>::Reclaim_all() -> size_type
+        {
+            std::vector< Batch > expired;
+
+            {
+                std::lock_guard< std::mutex > lock(m_mutex);
+
+                expired.swap(m_batches);
+            }
+
+            const size_type count = destroy(expired);
+            m_pending.fetch_sub(count, std::memory_order_relaxed);
+
+            return count;
+        }
+
+        template <typename T>
+        auto Deferred_destruction<T>::Get_pending_number() const -> size_type
+        {
+            return m_pending.load(std::memory_order_relaxed);
+        }
+
+        template <typename T>
+        void Deferred_destruction<T>::retire(T * resource)
+        {
+            Retire_list & list = s_retire_list;
+
+            /* List is shared by all handlers of T, pass retired resources to previous owner */
+            if (this != list.m_owner)
+            {
+                if (nullptr != list.m_owner)
+                {
+                    list.m_owner->flush(list);
+                }
+
+                list.m_owner = this;
+            }
+
+            list.m_resources.push_back(resource);
+            m_pending.fetch_add(1, std::memory_order_relaxed);
+
+            if (m_batch_size <= list.m_resources.size())
+            {
+                flush(list);
+            }
+        }
+
+        template <typename T>
+        void Deferred_destruction<T>::flush(Retire_list & list)
+        {
+            if (true == list.m_resources.empty())
+            {
+                return;
+            }
+
+            Batch batch;
+            batch.m_resources.swap(list.m_resources);
+            batch.m_epoch = Get_epoch();
+
+            std::lock_guard< std::mutex > lock(m_mutex);
+
+            m_batches.push_back(std::move(batch));
+        }
+
+        template <typename T>
+        auto Deferred_destruction<T>::destroy(std::vector< Batch > & batches) -> size_type
+        {
+            size_type count = 0;
+
+            for (auto & batch : batches)
+            {
+                for (auto resource : batch.m_resources)
+                {
+                    resource->destroy();
+                }
+
+                count += size_type(batch.m_resources.size());
+            }
+
+            batches.clear();
+
+            return count;
+        }
+    }
+}
+
+#endif /* UTILITIES_CONTAINERS_DEFERRED_DESTRUCTION_HPP */
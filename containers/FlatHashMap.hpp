@@ -0,0 +1,688 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file FlatHashMap.hpp
+**/
+
+#ifndef UTILITIES_CONTAINERS_FLAT_HASH_MAP_HPP
+#define UTILITIES_CONTAINERS_FLAT_HASH_MAP_HPP
+
+#include <emmintrin.h>
+
+#if (UTILITIES_COMPILER == UTILITIES_COMPIELR_MSVC)
+#include <intrin.h>
+#endif /* UTILITIES_COMPILER == UTILITIES_COMPIELR_MSVC */
+
+#include <cstring>
+#include <functional>
+#include <new>
+#include <utility>
+
+namespace Containers
+{
+    /** \brief Open addressing hash map
+     *
+     * Entries are stored in single contiguous array. Each entry has one
+     * control byte, control bytes are probed in groups of 16 with SSE2.
+     * Control byte keeps 7 bits of hash for full entry, so keys are
+     * compared only on probable match.
+     *
+     * Insertion and erasure invalidate pointers returned by Find.
+     **/
+    template <
+        typename K,
+        typename V,
+        typename H = std::hash< K >,
+        typename E = std::equal_to< K > >
+    class Flat_hash_map
+    {
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = std::pair< K, V >;
+        using size_type = size_t;
+
+        /* Ctr & dtr */
+        Flat_hash_map();
+        Flat_hash_map(size_type capacity);
+        ~Flat_hash_map();
+
+        /* Copy */
+        Flat_hash_map(const Flat_hash_map & map);
+        Flat_hash_map & operator = (const Flat_hash_map & map);
+
+        /* Move */
+        Flat_hash_map(Flat_hash_map && map);
+        Flat_hash_map & operator = (Flat_hash_map && map);
+
+        /* Access */
+        V * Find(const K & key);
+        const V * Find(const K & key) const;
+        bool Contains(const K & key) const;
+
+        V & operator [] (const K & key);
+
+        /* Returns false when key is already stored, value is not modified */
+        bool Insert(const K & key, const V & value);
+        bool Insert(K && key, V && value);
+        bool Erase(const K & key);
+
+        void Clear();
+        void Reserve(size_type count);
+
+        size_type Size() const;
+        size_type Capacity() const;
+        bool Is_empty() const;
+
+        template <typename F>
+        void For_each(const F & f);
+
+        template <typename F>
+        void For_each(const F & f) const;
+
+    private:
+        using ctrl_t = Platform::int8;
+
+        static const ctrl_t m_Empty = ctrl_t(-128);
+        static const ctrl_t m_Deleted = ctrl_t(-2);
+        static const size_type m_Group_width = 16;
+        static const size_type m_Min_capacity = 16;
+
+        /* Group of 16 control bytes */
+        class Group
+        {
+        public:
+            Group(const ctrl_t * ctrl)
+                : m_ctrl(_mm_loadu_si128((const __m128i *) ctrl))
+            {
+            }
+
+            Platform::uint32 Match(ctrl_t h2) const
+            {
+                const __m128i match = _mm_set1_epi8(h2);
+
+                return Platform::uint32(_mm_movemask_epi8(_mm_cmpeq_epi8(match, m_ctrl)));
+            }
+
+            Platform::uint32 Match_empty() const
+            {
+                return Match(m_Empty);
+            }
+
+            Platform::uint32 Match_empty_or_deleted() const
+            {
+                /* Both special values are lower than -1, full entries are not negative */
+                const __m128i full_limit = _mm_set1_epi8(-1);
+
+                return Platform::uint32(_mm_movemask_epi8(_mm_cmpgt_epi8(full_limit, m_ctrl)));
+            }
+
+        private:
+            __m128i m_ctrl;
+        };
+
+        static size_type hash(const K & key);
+        static size_type h1(size_type hash);
+        static ctrl_t h2(size_type hash);
+        static Platform::uint32 lowest_bit(Platform::uint32 mask);
+        static size_type capacity_for(size_type count);
+        static size_type max_load(size_type capacity);
+
+        size_type find_index(const K & key, size_type hash) const;
+        size_type find_free(size_type hash) const;
+        size_type prepare_insert(const K & key, bool & out_is_new);
+        void set_ctrl(size_type index, ctrl_t value);
+
+        void allocate(size_type capacity);
+        void deallocate();
+        void rehash(size_type capacity);
+        void copy(const Flat_hash_map & map);
+        void move(Flat_hash_map & map);
+
+        ctrl_t * m_ctrl;
+        value_type * m_slots;
+        size_type m_capacity;
+        size_type m_size;
+        size_type m_growth_left;
+    };
+
+    template <typename K, typename V, typename H, typename E>
+    Flat_hash_map<K, V, H, E>::Flat_hash_map()
+        : m_ctrl(nullptr)
+        , m_slots(nullptr)
+        , m_capacity(0)
+        , m_size(0)
+        , m_growth_left(0)
+    {
+        /* Nothing to be done here */
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    Flat_hash_map<K, V, H, E>::Flat_hash_map(size_type capacity)
+        : Flat_hash_map()
+    {
+        Reserve(capacity);
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    Flat_hash_map<K, V, H, E>::~Flat_hash_map()
+    {
+        deallocate();
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    Flat_hash_map<K, V, H, E>::Flat_hash_map(const Flat_hash_map & map)
+        : Flat_hash_map()
+    {
+        copy(map);
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    Flat_hash_map<K, V, H, E> & Flat_hash_map<K, V, H, E>::operator = (const Flat_hash_map & map)
+    {
+        if (this != &map)
+        {
+            deallocate();
+            copy(map);
+        }
+
+        return *this;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    Flat_hash_map<K, V, H, E>::Flat_hash_map(Flat_hash_map && map)
+        : Flat_hash_map()
+    {
+        move(map);
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    Flat_hash_map<K, V, H, E> & Flat_hash_map<K, V, H, E>::operator = (Flat_hash_map && map)
+    {
+        if (this != &map)
+        {
+            deallocate();
+            move(map);
+        }
+
+        return *this;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    V * Flat_hash_map<K, V, H, E>::Find(const K & key)
+    {
+        const size_type index = find_index(key, hash(key));
+
+        if (m_capacity == index)
+        {
+            return nullptr;
+        }
+
+        return &m_slots[index].second;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    const V * Flat_hash_map<K, V, H, E>::Find(const K & key) const
+    {
+        const size_type index = find_index(key, hash(key));
+
+        if (m_capacity == index)
+        {
+            return nullptr;
+        }
+
+        return &m_slots[index].second;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    bool Flat_hash_map<K, V, H, E>::Contains(const K & key) const
+    {
+        return (nullptr != Find(key));
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    V & Flat_hash_map<K, V, H, E>::operator [] (const K & key)
+    {
+        bool is_new = false;
+        const size_type index = prepare_insert(key, is_new);
+
+        if (true == is_new)
+        {
+            new (&m_slots[index]) value_type(key, V());
+        }
+
+        return m_slots[index].second;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    bool Flat_hash_map<K, V, H, E>::Insert(const K & key, const V & value)
+    {
+        bool is_new = false;
+        const size_type index = prepare_insert(key, is_new);
+
+        if (true == is_new)
+        {
+            new (&m_slots[index]) value_type(key, value);
+        }
+
+        return is_new;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    bool Flat_hash_map<K, V, H, E>::Insert(K && key, V && value)
+    {
+        bool is_new = false;
+        const size_type index = prepare_insert(key, is_new);
+
+        if (true == is_new)
+        {
+            new (&m_slots[index]) value_type(std::move(key), std::move(value));
+        }
+
+        return is_new;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    bool Flat_hash_map<K, V, H, E>::Erase(const K & key)
+    {
+        const size_type index = find_index(key, hash(key));
+
+        if (m_capacity == index)
+        {
+            return false;
+        }
+
+        m_slots[index].~value_type();
+        set_ctrl(index, m_Deleted);
+        m_size -= 1;
+
+        return true;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    void Flat_hash_map<K, V, H, E>::Clear()
+    {
+        for (size_type i = 0; i < m_capacity; ++i)
+        {
+            if (0 <= m_ctrl[i])
+            {
+                m_slots[i].~value_type();
+            }
+        }
+
+        if (0 != m_capacity)
+        {
+            memset(m_ctrl, m_Empty, m_capacity + m_Group_width - 1);
+        }
+
+        m_size = 0;
+        m_growth_left = max_load(m_capacity);
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    void Flat_hash_map<K, V, H, E>::Reserve(size_type count)
+    {
+        const size_type capacity = capacity_for(count);
+
+        if (capacity > m_capacity)
+        {
+            rehash(capacity);
+        }
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    auto Flat_hash_map<K, V, H, E>::Size() const -> size_type
+    {
+        return m_size;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    auto Flat_hash_map<K, V, H, E>::Capacity() const -> size_type
+    {
+        return m_capacity;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    bool Flat_hash_map<K, V, H, E>::Is_empty() const
+    {
+        return (0 == m_size);
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    template <typename F>
+    void Flat_hash_map<K, V, H, E>::For_each(const F & f)
+    {
+        for (size_type i = 0; i < m_capacity; ++i)
+        {
+            if (0 <= m_ctrl[i])
+            {
+                f(m_slots[i].first, m_slots[i].second);
+            }
+        }
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    template <typename F>
+    void Flat_hash_map<K, V, H, E>::For_each(const F & f) const
+    {
+        for (size_type i = 0; i < m_capacity; ++i)
+        {
+            if (0 <= m_ctrl[i])
+            {
+                const value_type & slot = m_slots[i];
+
+                f(slot.first, slot.second);
+            }
+        }
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    auto Flat_hash_map<K, V, H, E>::hash(const K & key) -> size_type
+    {
+        /* Standard hashes of integers are identity, mix bits before split */
+        Platform::uint64 h = Platform::uint64(H()(key));
+
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+
+        return size_type(h);
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    auto Flat_hash_map<K, V, H, E>::h1(size_type hash) -> size_type
+    {
+        return hash >> 7;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    auto Flat_hash_map<K, V, H, E>::h2(size_type hash) -> ctrl_t
+    {
+        return ctrl_t(hash & 0x7f);
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    Platform::uint32 Flat_hash_map<K, V, H, E>::lowest_bit(Platform::uint32 mask)
+    {
+#if (UTILITIES_COMPILER == UTILITIES_COMPIELR_MSVC)
+        unsigned long index = 0;
+
+        _BitScanForward(&index, mask);
+
+        return Platform::uint32(index);
+#else /* UTILITIES_COMPILER == UTILITIES_COMPIELR_MSVC */
+        return Platform::uint32(__builtin_ctz(mask));
+#endif /* UTILITIES_COMPILER == UTILITIES_COMPIELR_MSVC */
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    auto Flat_hash_map<K, V, H, E>::capacity_for(size_type count) -> size_type
+    {
+        size_type capacity = m_Min_capacity;
+
+        while (max_load(capacity) < count)
+        {
+            capacity *= 2;
+        }
+
+        return capacity;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    auto Flat_hash_map<K, V, H, E>::max_load(size_type capacity) -> size_type
+    {
+        /* 7/8 */
+        return capacity - capacity / 8;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    auto Flat_hash_map<K, V, H, E>::find_index(const K & key, size_type hash) const -> size_type
+    {
+        if (0 == m_capacity)
+        {
+            return m_capacity;
+        }
+
+        const size_type mask = m_capacity - 1;
+        const ctrl_t h2_value = h2(hash);
+        size_type position = h1(hash) & mask;
+        size_type step = 0;
+
+        while (1)
+        {
+            const Group group(m_ctrl + position);
+
+            for (Platform::uint32 match = group.Match(h2_value); 0 != match; match &= match - 1)
+            {
+                const size_type index = (position + lowest_bit(match)) & mask;
+
+                if (true == E()(m_slots[index].first, key))
+                {
+                    return index;
+                }
+            }
+
+            /* Key would have been stored in first empty entry */
+            if (0 != group.Match_empty())
+            {
+                return m_capacity;
+            }
+
+            /* Triangular probing visits each group once */
+            step += m_Group_width;
+            position = (position + step) & mask;
+        }
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    auto Flat_hash_map<K, V, H, E>::find_free(size_type hash) const -> size_type
+    {
+        const size_type mask = m_capacity - 1;
+        size_type position = h1(hash) & mask;
+        size_type step = 0;
+
+        while (1)
+        {
+            const Group group(m_ctrl + position);
+            const Platform::uint32 match = group.Match_empty_or_deleted();
+
+            if (0 != match)
+            {
+                return (position + lowest_bit(match)) & mask;
+            }
+
+            step += m_Group_width;
+            position = (position + step) & mask;
+        }
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    auto Flat_hash_map<K, V, H, E>::prepare_insert(const K & key, bool & out_is_new) -> size_type
+    {
+        const size_type key_hash = hash(key);
+
+        {
+            const size_type index = find_index(key, key_hash);
+
+            if (m_capacity != index)
+            {
+                out_is_new = false;
+                return index;
+            }
+        }
+
+        size_type index = (0 == m_capacity)
+                        ? m_capacity
+                        : find_free(key_hash);
+
+        /* Growth is reserved only for empty entries, deleted ones are reused */
+        if ((m_capacity == index) ||
+            ((0 == m_growth_left) && (m_Empty == m_ctrl[index])))
+        {
+            if (0 == m_capacity)
+            {
+                rehash(m_Min_capacity);
+            }
+            else if (m_size * 2 < max_load(m_capacity))
+            {
+                /* Mostly deleted entries, clean up in place */
+                rehash(m_capacity);
+            }
+            else
+            {
+                rehash(m_capacity * 2);
+            }
+
+            index = find_free(key_hash);
+        }
+
+        if (m_Empty == m_ctrl[index])
+        {
+            m_growth_left -= 1;
+        }
+
+        set_ctrl(index, h2(key_hash));
+        m_size += 1;
+        out_is_new = true;
+
+        return index;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    void Flat_hash_map<K, V, H, E>::set_ctrl(size_type index, ctrl_t value)
+    {
+        m_ctrl[index] = value;
+
+        /* First group is mirrored after last entry, so group loads never wrap */
+        if (m_Group_width - 1 > index)
+        {
+            m_ctrl[m_capacity + index] = value;
+        }
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    void Flat_hash_map<K, V, H, E>::allocate(size_type capacity)
+    {
+        const size_type ctrl_size = capacity + m_Group_width - 1;
+
+        m_ctrl = new ctrl_t[ctrl_size];
+        m_slots = (value_type *) ::operator new(capacity * sizeof(value_type));
+        m_capacity = capacity;
+        m_size = 0;
+        m_growth_left = max_load(capacity);
+
+        memset(m_ctrl, m_Empty, ctrl_size);
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    void Flat_hash_map<K, V, H, E>::deallocate()
+    {
+        if (0 == m_capacity)
+        {
+            return;
+        }
+
+        for (size_type i = 0; i < m_capacity; ++i)
+        {
+            if (0 <= m_ctrl[i])
+            {
+                m_slots[i].~value_type();
+            }
+        }
+
+        delete[] m_ctrl;
+        ::operator delete(m_slots);
+
+        m_ctrl = nullptr;
+        m_slots = nullptr;
+        m_capacity = 0;
+        m_size = 0;
+        m_growth_left = 0;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    void Flat_hash_map<K, V, H, E>::rehash(size_type capacity)
+    {
+        ctrl_t * old_ctrl = m_ctrl;
+        value_type * old_slots = m_slots;
+        const size_type old_capacity = m_capacity;
+        const size_type size = m_size;
+
+        allocate(capacity);
+
+        for (size_type i = 0; i < old_capacity; ++i)
+        {
+            if (0 > old_ctrl[i])
+            {
+                continue;
+            }
+
+            const size_type key_hash = hash(old_slots[i].first);
+            const size_type index = find_free(key_hash);
+
+            set_ctrl(index, h2(key_hash));
+            new (&m_slots[index]) value_type(std::move(old_slots[i]));
+            old_slots[i].~value_type();
+        }
+
+        m_size = size;
+        m_growth_left -= size;
+
+        if (0 != old_capacity)
+        {
+            delete[] old_ctrl;
+            ::operator delete(old_slots);
+        }
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    void Flat_hash_map<K, V, H, E>::copy(const Flat_hash_map & map)
+    {
+        Reserve(map.m_size);
+
+        map.For_each([this](const K & key, const V & value) { Insert(key, value); });
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    void Flat_hash_map<K, V, H, E>::move(Flat_hash_map & map)
+    {
+        m_ctrl = map.m_ctrl;
+        m_slots = map.m_slots;
+        m_capacity = map.m_capacity;
+        m_size = map.m_size;
+        m_growth_left = map.m_growth_left;
+
+        map.m_ctrl = nullptr;
+        map.m_slots = nullptr;
+        map.m_capacity = 0;
+        map.m_size = 0;
+        map.m_growth_left = 0;
+    }
+}
+
+#endif /* UTILITIES_CONTAINERS_FLAT_HASH_MAP_HPP */
@@ -38,6 +38,12 @@ namespace Containers
 	{
 		class Base_resource;
 
+        template <typename T>
+        class Deferred_destruction;
+
+        template <typename T>
+        class Weak_reference;
+
         template <typename T>
 		class Event_handler
 		{
@@ -58,15 +64,23 @@ namespace Containers
             template <typename T>
             friend class Reference;
 
+            template <typename T>
+            friend class Deferred_destruction;
+
+            template <typename T>
+            friend class Weak_reference;
+
         public:
             using Event_handler = Event_handler < T >;
             using Reference = Reference < T >;
+            using Weak_reference = Weak_reference < T >;
             using ref_count_t = Platform::uint32;
 
             Event_handler * Get_event_handler() const;
             void Set_event_handler(Event_handler * handler);
 
             ref_count_t Get_references_number() const;
+            ref_count_t Get_weak_references_number() const;
 
         protected:
             Resource();
@@ -75,9 +89,21 @@ namespace Containers
         private:
 			void increase_reference_count();
 			void decrease_reference_count();
+            void destroy();
+
+            /* Outlives resource as long as there are weak references */
+            struct Weak_counter
+            {
+                T * m_resource;
+                ref_count_t m_counter;
+            };
+
+            Weak_counter * get_weak_counter();
+            void expire_weak_references();
 
             Event_handler * m_event_handler = nullptr;
             ref_count_t m_reference_counter = ref_count_t(0);
+            Weak_counter * m_weak_counter = nullptr;
         };
 
 		template <typename T>
@@ -110,6 +136,41 @@ namespace Containers
 			T * m_resource;
 		};
 
+        /** \brief Non-owning reference
+         *
+         * Weak reference does not keep resource alive. Lock returns strong
+         * reference when resource was not destroyed, retired or released
+         * otherwise.
+         **/
+        template <typename T>
+        class Weak_reference
+        {
+        public:
+            using Reference = Reference < T >;
+
+            Weak_reference();
+            Weak_reference(T * resource);
+            Weak_reference(const Reference & reference);
+            Weak_reference(const Weak_reference & reference);
+            Weak_reference(Weak_reference && reference);
+            Weak_reference & operator = (const Weak_reference & reference);
+            Weak_reference & operator = (Weak_reference && reference);
+            ~Weak_reference();
+
+            void Reset(T * resource);
+            void Release();
+
+            Reference Lock() const;
+            bool Is_expired() const;
+
+        private:
+            using Weak_counter = typename Resource< T >::Weak_counter;
+
+            void set(Weak_counter * counter);
+
+            Weak_counter * m_counter;
+        };
+
         /* *** Even_handler *** */
         template <typename T>
         void Event_handler<T>::On_resource_destruction(T * resource)
@@ -137,6 +198,8 @@ namespace Containers
         template <typename T>
         Resource<T>::~Resource()
         {
+            expire_weak_references();
+
             if (nullptr != m_event_handler)
             {
                 m_event_handler->On_resource_destruction((T *) this);
@@ -162,6 +225,17 @@ namespace Containers
             return m_reference_counter;
         }
 
+        template <typename T>
+        auto Resource<T>::Get_weak_references_number() const -> ref_count_t
+        {
+            if (nullptr == m_weak_counter)
+            {
+                return ref_count_t(0);
+            }
+
+            return m_weak_counter->m_counter;
+        }
+
         template <typename T>
         void Resource<T>::increase_reference_count()
         {
@@ -177,7 +251,7 @@ namespace Containers
 
                 if (nullptr == m_event_handler)
                 {
-                    delete this;
+                    destroy();
                 }
                 else
                 {
@@ -189,7 +263,7 @@ namespace Containers
 
                     if (true == should_resource_be_destroyed)
                     {
-                        delete this;
+                        destroy();
                     }
                 }
             }
@@ -204,6 +278,44 @@ namespace Containers
             }
         }
 
+        template <typename T>
+        void Resource<T>::destroy()
+        {
+            delete this;
+        }
+
+        template <typename T>
+        auto Resource<T>::get_weak_counter() -> Weak_counter *
+        {
+            if (nullptr == m_weak_counter)
+            {
+                m_weak_counter = new Weak_counter{ (T *) this, ref_count_t(0) };
+            }
+
+            return m_weak_counter;
+        }
+
+        template <typename T>
+        void Resource<T>::expire_weak_references()
+        {
+            if (nullptr == m_weak_counter)
+            {
+                return;
+            }
+
+            if (0 == m_weak_counter->m_counter)
+            {
+                delete m_weak_counter;
+            }
+            else
+            {
+                /* Last weak reference will release counter */
+                m_weak_counter->m_resource = nullptr;
+            }
+
+            m_weak_counter = nullptr;
+        }
+
         /* *** Reference *** */
 		template <typename T>
 		Reference<T>::Reference()
@@ -329,6 +441,135 @@ namespace Containers
 		{
 			return m_resource;
 		}
+
+        /* *** Weak_reference *** */
+        template <typename T>
+        Weak_reference<T>::Weak_reference()
+            : m_counter(nullptr)
+        {
+            /* Nothing to be done here */
+        }
+
+        template <typename T>
+        Weak_reference<T>::Weak_reference(T * resource)
+            : m_counter(nullptr)
+        {
+            Reset(resource);
+        }
+
+        template <typename T>
+        Weak_reference<T>::Weak_reference(const Reference & reference)
+            : Weak_reference((T *) reference.Get())
+        {
+            /* Nothing to be done here */
+        }
+
+        template <typename T>
+        Weak_reference<T>::Weak_reference(const Weak_reference & reference)
+            : m_counter(nullptr)
+        {
+            set(reference.m_counter);
+        }
+
+        template <typename T>
+        Weak_reference<T>::Weak_reference(Weak_reference && reference)
+            : m_counter(reference.m_counter)
+        {
+            reference.m_counter = nullptr;
+        }
+
+        template <typename T>
+        Weak_reference<T> & Weak_reference<T>::operator = (const Weak_reference & reference)
+        {
+            if (m_counter != reference.m_counter)
+            {
+                Release();
+                set(reference.m_counter);
+            }
+
+            return *this;
+        }
+
+        template <typename T>
+        Weak_reference<T> & Weak_reference<T>::operator = (Weak_reference && reference)
+        {
+            if (this != &reference)
+            {
+                Release();
+
+                m_counter = reference.m_counter;
+                reference.m_counter = nullptr;
+            }
+
+            return *this;
+        }
+
+        template <typename T>
+        Weak_reference<T>::~Weak_reference()
+        {
+            Release();
+        }
+
+        template <typename T>
+        void Weak_reference<T>::Reset(T * resource)
+        {
+            Release();
+
+            if (nullptr == resource)
+            {
+                return;
+            }
+
+            set(resource->get_weak_counter());
+        }
+
+        template <typename T>
+        void Weak_reference<T>::Release()
+        {
+            if (nullptr == m_counter)
+            {
+                return;
+            }
+
+            m_counter->m_counter -= 1;
+
+            if ((0 == m_counter->m_counter) &&
+                (nullptr == m_counter->m_resource))
+            {
+                delete m_counter;
+            }
+
+            m_counter = nullptr;
+        }
+
+        template <typename T>
+        auto Weak_reference<T>::Lock() const -> Reference
+        {
+            if (true == Is_expired())
+            {
+                return Reference();
+            }
+
+            return Reference(m_counter->m_resource);
+        }
+
+        template <typename T>
+        bool Weak_reference<T>::Is_expired() const
+        {
+            return (nullptr == m_counter) || (nullptr == m_counter->m_resource);
+        }
+
+        template <typename T>
+        void Weak_reference<T>::set(Weak_counter * counter)
+        {
+            if (nullptr == counter)
+            {
+                return;
+            }
+
+            m_counter = counter;
+            m_counter->m_counter += 1;
+        }
 	}
 }
 
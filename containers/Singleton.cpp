@@ -0,0 +1,90 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file Singleton.cpp
+**/
+
+#include "PCH.hpp"
+
+#include "Singleton.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace Containers
+{
+    struct Singleton_shutdown_entry
+    {
+        Singleton_shutdown::order_t m_order;
+        Singleton_shutdown::release_t m_release;
+    };
+
+    static std::mutex s_shutdown_mutex;
+    static std::vector< Singleton_shutdown_entry > s_shutdown_entries;
+
+    void Singleton_shutdown::Register(order_t order, release_t release)
+    {
+        std::lock_guard< std::mutex > lock(s_shutdown_mutex);
+
+        for (auto & entry : s_shutdown_entries)
+        {
+            if (release == entry.m_release)
+            {
+                entry.m_order = order;
+                return;
+            }
+        }
+
+        s_shutdown_entries.push_back(Singleton_shutdown_entry{ order, release });
+    }
+
+    void Singleton_shutdown::Release_all()
+    {
+        std::vector< Singleton_shutdown_entry > entries;
+
+        {
+            std::lock_guard< std::mutex > lock(s_shutdown_mutex);
+
+            entries.swap(s_shutdown_entries);
+        }
+
+        std::stable_sort(
+            entries.begin(),
+            entries.end(),
+            [](const Singleton_shutdown_entry & l, const Singleton_shutdown_entry & r) -> bool
+            {
+                return l.m_order < r.m_order;
+            });
+
+        /* Release is done without lock, destructors may use other singletons */
+        for (auto & entry : entries)
+        {
+            entry.m_release();
+        }
+    }
+}
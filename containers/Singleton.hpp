@@ -32,8 +32,17 @@
 #ifndef UTILITIES_CONTAINERS_SINGLETON_HPP
 #define UTILITIES_CONTAINERS_SINGLETON_HPP
 
+#include <atomic>
+#include <mutex>
+
 namespace Containers
 {
+    /** \brief Process wide singleton
+     *
+     * Get_singleton is thread safe. Once instance exists it costs single
+     * acquire load. Instance constructed directly with new is published
+     * by constructor, such construction is not synchronised.
+     **/
     template <class T>
     class Singleton
     {
@@ -43,51 +52,204 @@ namespace Containers
 
         virtual ~Singleton();
 
-        static typename pointer Get_singleton();
+        static pointer Get_singleton();
         static void Release();
 
     protected:
         Singleton();
 
     private:
-        static typename pointer s_singleton;
+        static pointer create();
+
+        static std::atomic< pointer > s_singleton;
+        static std::mutex s_mutex;
+        static thread_local bool s_is_being_created;
     };
 
+    /** \brief Singleton with instance per thread
+     *
+     * Instance is released when thread exits.
+     **/
+    template <class T>
+    class Thread_singleton
+    {
+    public:
+        typedef T value_type;
+        typedef T * pointer;
+
+        virtual ~Thread_singleton();
+
+        static pointer Get_singleton();
+        static void Release();
+
+    protected:
+        Thread_singleton();
+
+    private:
+        struct Holder
+        {
+            ~Holder();
+
+            pointer m_singleton = nullptr;
+        };
+
+        static thread_local Holder s_holder;
+    };
+
+    /** \brief Releases registered singletons in defined order
+     *
+     * Singletons are released in ascending order. Singleton with lower
+     * order can use singletons with higher order in its destructor.
+     **/
+    class Singleton_shutdown
+    {
+    public:
+        using order_t = Platform::int32;
+        using release_t = void (*)();
+
+        static void Register(order_t order, release_t release);
+        static void Release_all();
+    };
+
+    /** \brief Singleton released by Singleton_shutdown::Release_all
+     **/
+    template <class T, Platform::int32 order>
+    class Ordered_singleton : public Singleton < T >
+    {
+    protected:
+        Ordered_singleton();
+        virtual ~Ordered_singleton() = default;
+    };
+
+    /* *** Singleton *** */
     template <class T>
     Singleton<T>::Singleton()
     {
-        s_singleton = (pointer) this;
+        /* Instance created by Get_singleton is published when fully constructed */
+        if (false == s_is_being_created)
+        {
+            s_singleton.store((pointer) this, std::memory_order_release);
+        }
     }
 
     template <class T>
     Singleton<T>::~Singleton()
     {
-        s_singleton = nullptr;
+        pointer expected = (pointer) this;
+
+        s_singleton.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
     }
 
     template <class T>
     typename Singleton<T>::pointer Singleton<T>::Get_singleton()
     {
-        if (nullptr == s_singleton)
+        pointer singleton = s_singleton.load(std::memory_order_acquire);
+
+        if (nullptr == singleton)
         {
-            new T;
+            singleton = create();
         }
 
-        return s_singleton;
+        return singleton;
     }
 
     template <typename T>
     void Singleton<T>::Release()
     {
-        if (nullptr != s_singleton)
+        std::lock_guard< std::mutex > lock(s_mutex);
+
+        pointer singleton = s_singleton.load(std::memory_order_acquire);
+
+        if (nullptr != singleton)
+        {
+            delete singleton;
+        }
+    }
+
+    template <class T>
+    typename Singleton<T>::pointer Singleton<T>::create()
+    {
+        std::lock_guard< std::mutex > lock(s_mutex);
+
+        pointer singleton = s_singleton.load(std::memory_order_relaxed);
+
+        if (nullptr == singleton)
+        {
+            s_is_being_created = true;
+            singleton = new T;
+            s_is_being_created = false;
+
+            s_singleton.store(singleton, std::memory_order_release);
+        }
+
+        return singleton;
+    }
+
+    template <class T>
+    std::atomic< typename Singleton<T>::pointer > Singleton<T>::s_singleton(nullptr);
+
+    template <class T>
+    std::mutex Singleton<T>::s_mutex;
+
+    template <class T>
+    thread_local bool Singleton<T>::s_is_being_created = false;
+
+    /* *** Thread_singleton *** */
+    template <class T>
+    Thread_singleton<T>::Thread_singleton()
+    {
+        s_holder.m_singleton = (pointer) this;
+    }
+
+    template <class T>
+    Thread_singleton<T>::~Thread_singleton()
+    {
+        if ((pointer) this == s_holder.m_singleton)
         {
-            auto singleton = s_singleton;
+            s_holder.m_singleton = nullptr;
+        }
+    }
+
+    template <class T>
+    typename Thread_singleton<T>::pointer Thread_singleton<T>::Get_singleton()
+    {
+        if (nullptr == s_holder.m_singleton)
+        {
+            new T;
+        }
+
+        return s_holder.m_singleton;
+    }
+
+    template <class T>
+    void Thread_singleton<T>::Release()
+    {
+        if (nullptr != s_holder.m_singleton)
+        {
+            auto singleton = s_holder.m_singleton;
             delete singleton;
         }
     }
 
     template <class T>
-    typename Singleton<T>::pointer Singleton<T>::s_singleton = nullptr;
+    Thread_singleton<T>::Holder::~Holder()
+    {
+        if (nullptr != m_singleton)
+        {
+            auto singleton = m_singleton;
+            delete singleton;
+        }
+    }
+
+    template <class T>
+    thread_local typename Thread_singleton<T>::Holder Thread_singleton<T>::s_holder;
+
+    /* *** Ordered_singleton *** */
+    template <class T, Platform::int32 order>
+    Ordered_singleton<T, order>::Ordered_singleton()
+    {
+        Singleton_shutdown::Register(order, &Singleton<T>::Release);
+    }
 }
 
 #endif /* UTILITIES_CONTAINERS_SINGLETON_HPP */
@@ -0,0 +1,408 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file SlotMap.hpp
+**/
+
+#ifndef UTILITIES_CONTAINERS_SLOT_MAP_HPP
+#define UTILITIES_CONTAINERS_SLOT_MAP_HPP
+
+#include <utility>
+#include <vector>
+
+namespace Containers
+{
+    /** \brief Densely stored objects addressed by stable handles
+     *
+     * Objects are kept in contiguous array without gaps, iteration is
+     * linear scan. Handle is 32 bits of slot index and 32 bits of slot
+     * generation. Generation of slot is advanced on every erase, so handle
+     * of erased object does not match object inserted later in the same
+     * slot until generation wraps around, after 2^32 - 1 reuses of slot.
+     * Null handle is 0.
+     *
+     * Erase moves last object into erased place, so order of objects is
+     * not preserved and pointers returned by Get are invalidated by
+     * Insert and Erase.
+     **/
+    template <typename T>
+    class Slot_map
+    {
+    public:
+        using value_type = T;
+        using handle_t = Platform::uint64;
+        using size_type = Platform::uint32;
+
+        static constexpr handle_t m_Null_handle = handle_t(0);
+
+        /* Ctr & dtr */
+        Slot_map();
+        ~Slot_map() = default;
+
+        /* Copy */
+        Slot_map(const Slot_map & map) = default;
+        Slot_map & operator = (const Slot_map & map) = default;
+
+        /* Move */
+        Slot_map(Slot_map && map);
+        Slot_map & operator = (Slot_map && map);
+
+        /* Modification */
+        handle_t Insert(const T & value);
+        handle_t Insert(T && value);
+        bool Erase(handle_t handle);
+        void Clear();
+        void Reserve(size_type count);
+
+        /* Access */
+        T * Get(handle_t handle);
+        const T * Get(handle_t handle) const;
+        bool Contains(handle_t handle) const;
+
+        /* Dense access, index is in range [0, Size) */
+        T * Data();
+        const T * Data() const;
+        handle_t Get_handle(size_type index) const;
+
+        size_type Size() const;
+        bool Is_empty() const;
+
+        template <typename F>
+        void For_each(const F & f);
+
+        template <typename F>
+        void For_each(const F & f) const;
+
+    private:
+        struct Slot
+        {
+            /* Index of object when slot is used, next free slot otherwise */
+            size_type m_index;
+            size_type m_generation;
+        };
+
+        static constexpr size_type m_End_of_free_list = size_type(~0u);
+
+        static handle_t make_handle(size_type slot, size_type generation);
+        static size_type get_slot(handle_t handle);
+        static size_type get_generation(handle_t handle);
+
+        size_type acquire_slot();
+        const Slot * find_slot(handle_t handle) const;
+
+        std::vector< T > m_values;
+        std::vector< size_type > m_value_slots;
+        std::vector< Slot > m_slots;
+        size_type m_free_list;
+    };
+
+    /* Definitions of constants, required when odr-used before C++17 */
+    template <typename T>
+    constexpr typename Slot_map<T>::handle_t Slot_map<T>::m_Null_handle;
+
+    template <typename T>
+    constexpr typename Slot_map<T>::size_type Slot_map<T>::m_End_of_free_list;
+
+    template <typename T>
+    Slot_map<T>::Slot_map()
+        : m_free_list(m_End_of_free_list)
+    {
+        /* Nothing to be done here */
+    }
+
+    template <typename T>
+    Slot_map<T>::Slot_map(Slot_map && map)
+        : m_values(std::move(map.m_values))
+        , m_value_slots(std::move(map.m_value_slots))
+        , m_slots(std::move(map.m_slots))
+        , m_free_list(map.m_free_list)
+    {
+        map.Clear();
+        map.m_slots.clear();
+        map.m_free_list = m_End_of_free_list;
+    }
+
+    template <typename T>
+    Slot_map<T> & Slot_map<T>::operator = (Slot_map && map)
+    {
+        if (this != &map)
+        {
+            m_values = std::move(map.m_values);
+            m_value_slots = std::move(map.m_value_slots);
+            m_slots = std::move(map.m_slots);
+            m_free_list = map.m_free_list;
+
+            map.Clear();
+            map.m_slots.clear();
+            map.m_free_list = m_End_of_free_list;
+        }
+
+        return *this;
+    }
+
+    template <typename T>
+    auto Slot_map<T>::Insert(const T & value) -> handle_t
+    {
+        const size_type slot = acquire_slot();
+
+        m_slots[slot].m_index = size_type(m_values.size());
+        m_values.push_back(value);
+        m_value_slots.push_back(slot);
+
+        return make_handle(slot, m_slots[slot].m_generation);
+    }
+
+    template <typename T>
+    auto Slot_map<T>::Insert(T && value) -> handle_t
+    {
+        const size_type slot = acquire_slot();
+
+        m_slots[slot].m_index = size_type(m_values.size());
+        m_values.push_back(std::move(value));
+        m_value_slots.push_back(slot);
+
+        return make_handle(slot, m_slots[slot].m_generation);
+    }
+
+    template <typename T>
+    bool Slot_map<T>::Erase(handle_t handle)
+    {
+        if (nullptr == find_slot(handle))
+        {
+            return false;
+        }
+
+        const size_type slot = get_slot(handle);
+        const size_type index = m_slots[slot].m_index;
+        const size_type last = size_type(m_values.size() - 1);
+
+        /* Keep objects dense, move last one into the gap */
+        if (last != index)
+        {
+            m_values[index] = std::move(m_values[last]);
+            m_value_slots[index] = m_value_slots[last];
+            m_slots[m_value_slots[index]].m_index = index;
+        }
+
+        m_values.pop_back();
+        m_value_slots.pop_back();
+
+        /* Invalidate handles and return slot to free list */
+        m_slots[slot].m_generation += 1;
+        if (0 == m_slots[slot].m_generation)
+        {
+            m_slots[slot].m_generation = 1;
+        }
+
+        m_slots[slot].m_index = m_free_list;
+        m_free_list = slot;
+
+        return true;
+    }
+
+    template <typename T>
+    void Slot_map<T>::Clear()
+    {
+        for (auto slot : m_value_slots)
+        {
+            m_slots[slot].m_generation += 1;
+            if (0 == m_slots[slot].m_generation)
+            {
+                m_slots[slot].m_generation = 1;
+            }
+
+            m_slots[slot].m_index = m_free_list;
+            m_free_list = slot;
+        }
+
+        m_values.clear();
+        m_value_slots.clear();
+    }
+
+    template <typename T>
+    void Slot_map<T>::Reserve(size_type count)
+    {
+        m_values.reserve(count);
+        m_value_slots.reserve(count);
+        m_slots.reserve(count);
+    }
+
+    template <typename T>
+    T * Slot_map<T>::Get(handle_t handle)
+    {
+        const Slot * slot = find_slot(handle);
+
+        if (nullptr == slot)
+        {
+            return nullptr;
+        }
+
+        return &m_values[slot->m_index];
+    }
+
+    template <typename T>
+    const T * Slot_map<T>::Get(handle_t handle) const
+    {
+        const Slot * slot = find_slot(handle);
+
+        if (nullptr == slot)
+        {
+            return nullptr;
+        }
+
+        return &m_values[slot->m_index];
+    }
+
+    template <typename T>
+    bool Slot_map<T>::Contains(handle_t handle) const
+    {
+        return (nullptr != find_slot(handle));
+    }
+
+    template <typename T>
+    T * Slot_map<T>::Data()
+    {
+        return m_values.data();
+    }
+
+    template <typename T>
+    const T * Slot_map<T>::Data() const
+    {
+        return m_values.data();
+    }
+
+    template <typename T>
+    auto Slot_map<T>::Get_handle(size_type index) const -> handle_t
+    {
+        if (m_values.size() <= index)
+        {
+            return m_Null_handle;
+        }
+
+        const size_type slot = m_value_slots[index];
+
+        return make_handle(slot, m_slots[slot].m_generation);
+    }
+
+    template <typename T>
+    auto Slot_map<T>::Size() const -> size_type
+    {
+        return size_type(m_values.size());
+    }
+
+    template <typename T>
+    bool Slot_map<T>::Is_empty() const
+    {
+        return m_values.empty();
+    }
+
+    template <typename T>
+    template <typename F>
+    void Slot_map<T>::For_each(const F & f)
+    {
+        for (auto & value : m_values)
+        {
+            f(value);
+        }
+    }
+
+    template <typename T>
+    template <typename F>
+    void Slot_map<T>::For_each(const F & f) const
+    {
+        for (const auto & value : m_values)
+        {
+            f(value);
+        }
+    }
+
+    template <typename T>
+    auto Slot_map<T>::make_handle(size_type slot, size_type generation) -> handle_t
+    {
+        return (handle_t(generation) << 32) | handle_t(slot);
+    }
+
+    template <typename T>
+    auto Slot_map<T>::get_slot(handle_t handle) -> size_type
+    {
+        return size_type(handle & 0xffffffffu);
+    }
+
+    template <typename T>
+    auto Slot_map<T>::get_generation(handle_t handle) -> size_type
+    {
+        return size_type(handle >> 32);
+    }
+
+    template <typename T>
+    auto Slot_map<T>::acquire_slot() -> size_type
+    {
+        if (m_End_of_free_list != m_free_list)
+        {
+            const size_type slot = m_free_list;
+
+            m_free_list = m_slots[slot].m_index;
+
+            return slot;
+        }
+
+        /* Generation starts at 1, so valid handle is never null */
+        m_slots.push_back(Slot{ 0, 1 });
+
+        return size_type(m_slots.size() - 1);
+    }
+
+    template <typename T>
+    auto Slot_map<T>::find_slot(handle_t handle) const -> const Slot *
+    {
+        const size_type slot = get_slot(handle);
+
+        if (m_slots.size() <= slot)
+        {
+            return nullptr;
+        }
+
+        const Slot & result = m_slots[slot];
+
+        if (get_generation(handle) != result.m_generation)
+        {
+            return nullptr;
+        }
+
+        /* Free slot keeps generation of next use */
+        if ((m_values.size() <= result.m_index) ||
+            (slot != m_value_slots[result.m_index]))
+        {
+            return nullptr;
+        }
+
+        return &result;
+    }
+}
+
+#endif /* UTILITIES_CONTAINERS_SLOT_MAP_HPP */
@@ -0,0 +1,153 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file benchmark.cpp
+**/
+
+#include "PCH.hpp"
+
+#include "FlatHashMap.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+/** \brief Compares Flat_hash_map against std::map and std::unordered_map
+ *
+ * For each size keys are inserted and then looked up in random order.
+ * Results are reported as nanoseconds per operation.
+ **/
+
+using bench_key_t = Platform::uint32;
+using bench_value_t = Platform::uint32;
+using clock_type = std::chrono::steady_clock;
+
+static double elapsed_ns(clock_type::time_point begin, size_t count)
+{
+    const auto duration = std::chrono::duration_cast< std::chrono::nanoseconds >(clock_type::now() - begin);
+
+    return double(duration.count()) / double(count);
+}
+
+template <typename M>
+static void insert(M & map, const std::vector< bench_key_t > & keys)
+{
+    for (auto key : keys)
+    {
+        map[key] = key;
+    }
+}
+
+template <typename M>
+static bench_value_t find(const M & map, const std::vector< bench_key_t > & keys)
+{
+    bench_value_t sum = 0;
+
+    for (auto key : keys)
+    {
+        auto it = map.find(key);
+
+        sum += it->second;
+    }
+
+    return sum;
+}
+
+static bench_value_t find(
+    const Containers::Flat_hash_map< bench_key_t, bench_value_t > & map,
+    const std::vector< bench_key_t > & keys)
+{
+    bench_value_t sum = 0;
+
+    for (auto key : keys)
+    {
+        sum += *map.Find(key);
+    }
+
+    return sum;
+}
+
+template <typename M>
+static void measure(
+    const char * name,
+    const std::vector< bench_key_t > & keys,
+    const std::vector< bench_key_t > & lookups)
+{
+    M map;
+
+    auto begin = clock_type::now();
+    insert(map, keys);
+    const double insert_ns = elapsed_ns(begin, keys.size());
+
+    begin = clock_type::now();
+    const bench_value_t sum = find(map, lookups);
+    const double find_ns = elapsed_ns(begin, lookups.size());
+
+    printf("%-22s %10zu %12.2f %12.2f %12u\n",
+        name,
+        keys.size(),
+        insert_ns,
+        find_ns,
+        sum);
+}
+
+int main(int argc, char ** argv)
+{
+    static const size_t sizes[] = { 1000, 10000, 100000, 1000000, 10000000 };
+    static const size_t n_lookups = 1000000;
+
+    std::mt19937 generator(1234);
+
+    printf("%-22s %10s %12s %12s %12s\n", "container", "entries", "insert ns", "find ns", "checksum");
+
+    for (auto size : sizes)
+    {
+        std::vector< bench_key_t > keys(size);
+        std::vector< bench_key_t > lookups(n_lookups);
+
+        for (auto & key : keys)
+        {
+            key = bench_key_t(generator());
+        }
+
+        std::uniform_int_distribution< size_t > distribution(0, size - 1);
+        for (auto & lookup : lookups)
+        {
+            lookup = keys[distribution(generator)];
+        }
+
+        measure< std::map< bench_key_t, bench_value_t > >("std::map", keys, lookups);
+        measure< std::unordered_map< bench_key_t, bench_value_t > >("std::unordered_map", keys, lookups);
+        measure< Containers::Flat_hash_map< bench_key_t, bench_value_t > >("Flat_hash_map", keys, lookups);
+    }
+
+    return 0;
+}
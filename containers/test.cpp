@@ -33,11 +33,17 @@
 
 #include <Unit_Tests\UnitTests.hpp>
 
+#include "DeferredDestruction.hpp"
+#include "FlatHashMap.hpp"
 #include "IntrusiveList.hpp"
 #include "ReferenceCounted.hpp"
 #include "Singleton.hpp"
+#include "SlotMap.hpp"
 
 #include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
 
 /* *** Intrusive_list *** */
 
@@ -445,6 +451,359 @@ UNIT_TEST(Reference_counted_reference)
     return Passed;
 }
 
+UNIT_TEST(Reference_counted_weak_reference)
+{
+    auto res = new Ref_counted_res;
+    if (nullptr == res)
+    {
+        return NotAvailable;
+    }
+    Ref_counted_event_handler handler;
+    res->Set_event_handler(&handler);
+    handler.m_should_resource_be_destroyed = false;
+
+    Ref_counted_res::Reference ref(res);
+    Ref_counted_res::Weak_reference weak(ref);
+
+    TEST_ASSERT(Ref_counted_res::ref_count_t(1), res->Get_references_number());
+    TEST_ASSERT(Ref_counted_res::ref_count_t(1), res->Get_weak_references_number());
+    TEST_ASSERT(false, weak.Is_expired());
+
+    /* Copy & move */
+    {
+        Ref_counted_res::Weak_reference weak_b(weak);
+        Ref_counted_res::Weak_reference weak_c(std::move(weak_b));
+        TEST_ASSERT(Ref_counted_res::ref_count_t(2), res->Get_weak_references_number());
+        TEST_ASSERT(true, weak_b.Is_expired());
+
+        weak_b = weak_c;
+        TEST_ASSERT(Ref_counted_res::ref_count_t(3), res->Get_weak_references_number());
+    }
+
+    TEST_ASSERT(Ref_counted_res::ref_count_t(1), res->Get_weak_references_number());
+
+    /* Lock */
+    {
+        auto locked = weak.Lock();
+        TEST_ASSERT(locked.Get(), res);
+        TEST_ASSERT(Ref_counted_res::ref_count_t(2), res->Get_references_number());
+    }
+
+    /* Resource kept by event handler can be revived */
+    ref.Release();
+    TEST_ASSERT(true, handler.m_was_called_on_last_reference_gone);
+    TEST_ASSERT(false, weak.Is_expired());
+
+    ref = weak.Lock();
+    TEST_ASSERT(ref.Get(), res);
+
+    /* Destruction expires weak references */
+    handler.m_should_resource_be_destroyed = true;
+    ref.Release();
+
+    TEST_ASSERT(true, handler.m_was_called_on_resource_destruction);
+    TEST_ASSERT(true, weak.Is_expired());
+    TEST_ASSERT(weak.Lock().Get(), (Ref_counted_res *) 0);
+
+    weak.Release();
+
+    return Passed;
+}
+
+
+/* *** Deferred_destruction *** */
+
+class Deferred_res : public Containers::ReferenceCounted::Resource< Deferred_res >
+{
+public:
+    Deferred_res() = default;
+    virtual ~Deferred_res() = default;
+};
+
+class Deferred_res_handler : public Containers::ReferenceCounted::Deferred_destruction< Deferred_res >
+{
+public:
+    Deferred_res_handler()
+        : Deferred_destruction(2)
+    {
+    }
+
+    virtual void On_resource_destruction(Deferred_res * res)
+    {
+        m_destroyed += 1;
+    }
+
+    Platform::uint32 m_destroyed = 0;
+};
+
+UNIT_TEST(Deferred_destruction_epochs)
+{
+    Deferred_res_handler handler;
+
+    auto res_a = new Deferred_res;
+    auto res_b = new Deferred_res;
+    auto res_c = new Deferred_res;
+    if ((nullptr == res_a) || (nullptr == res_b) || (nullptr == res_c))
+    {
+        return NotAvailable;
+    }
+    res_a->Set_event_handler(&handler);
+    res_b->Set_event_handler(&handler);
+    res_c->Set_event_handler(&handler);
+
+    {
+        Deferred_res::Reference ref_a(res_a);
+        Deferred_res::Reference ref_b(res_b);
+        Deferred_res::Reference ref_c(res_c);
+    }
+
+    /* Nothing is destroyed inline */
+    TEST_ASSERT(Platform::uint32(0), handler.m_destroyed);
+    TEST_ASSERT(Platform::uint32(3), handler.Get_pending_number());
+
+    /* First batch was flushed in current epoch */
+    TEST_ASSERT(Platform::uint32(0), handler.Reclaim());
+
+    handler.Advance_epoch();
+    TEST_ASSERT(Platform::uint32(2), handler.Reclaim());
+    TEST_ASSERT(Platform::uint32(2), handler.m_destroyed);
+    TEST_ASSERT(Platform::uint32(1), handler.Get_pending_number());
+
+    /* Last resource waits on retire list of this thread */
+    handler.Advance_epoch();
+    TEST_ASSERT(Platform::uint32(0), handler.Reclaim());
+
+    handler.Flush();
+    TEST_ASSERT(Platform::uint32(0), handler.Reclaim());
+
+    handler.Advance_epoch();
+    TEST_ASSERT(Platform::uint32(1), handler.Reclaim());
+    TEST_ASSERT(Platform::uint32(3), handler.m_destroyed);
+    TEST_ASSERT(Platform::uint32(0), handler.Get_pending_number());
+
+    return Passed;
+}
+
+UNIT_TEST(Deferred_destruction_weak_reference)
+{
+    Deferred_res_handler handler;
+
+    auto res = new Deferred_res;
+    if (nullptr == res)
+    {
+        return NotAvailable;
+    }
+    res->Set_event_handler(&handler);
+
+    Deferred_res::Weak_reference weak(res);
+    {
+        Deferred_res::Reference ref(res);
+        TEST_ASSERT(false, weak.Is_expired());
+    }
+
+    /* Retired resource cannot be locked */
+    TEST_ASSERT(Platform::uint32(0), handler.m_destroyed);
+    TEST_ASSERT(true, weak.Is_expired());
+    TEST_ASSERT(weak.Lock().Get(), (Deferred_res *) 0);
+
+    handler.Flush();
+    handler.Advance_epoch();
+    TEST_ASSERT(Platform::uint32(1), handler.Reclaim());
+
+    return Passed;
+}
+
+
+/* *** Flat_hash_map *** */
+
+UNIT_TEST(Flat_hash_map_initial_state)
+{
+    Containers::Flat_hash_map< Platform::uint32, Platform::uint32 > map;
+
+    TEST_ASSERT(true, map.Is_empty());
+    TEST_ASSERT(size_t(0), map.Size());
+    TEST_ASSERT((Platform::uint32 *) 0, map.Find(0));
+    TEST_ASSERT(false, map.Erase(0));
+
+    return Passed;
+}
+
+UNIT_TEST(Flat_hash_map_insert_find_erase)
+{
+    static const Platform::uint32 n_entries = 10000;
+    Containers::Flat_hash_map< Platform::uint32, Platform::uint32 > map;
+
+    for (Platform::uint32 i = 0; i < n_entries; ++i)
+    {
+        TEST_ASSERT(true, map.Insert(i * 128, i));
+    }
+
+    TEST_ASSERT(false, map.Insert(0, 1));
+    TEST_ASSERT(size_t(n_entries), map.Size());
+
+    for (Platform::uint32 i = 0; i < n_entries; ++i)
+    {
+        auto value = map.Find(i * 128);
+
+        TEST_ASSERT_NOT_EQUAL((Platform::uint32 *) 0, value);
+        TEST_ASSERT(i, *value);
+    }
+    TEST_ASSERT((Platform::uint32 *) 0, map.Find(1));
+
+    /* Erase odd entries */
+    for (Platform::uint32 i = 1; i < n_entries; i += 2)
+    {
+        TEST_ASSERT(true, map.Erase(i * 128));
+    }
+
+    TEST_ASSERT(size_t(n_entries / 2), map.Size());
+
+    for (Platform::uint32 i = 0; i < n_entries; ++i)
+    {
+        TEST_ASSERT((0 == i % 2), map.Contains(i * 128));
+    }
+
+    /* Deleted entries are reused */
+    const auto capacity = map.Capacity();
+    for (Platform::uint32 i = 1; i < n_entries; i += 2)
+    {
+        map[i * 128] = i;
+    }
+
+    TEST_ASSERT(capacity, map.Capacity());
+    TEST_ASSERT(size_t(n_entries), map.Size());
+
+    Platform::uint64 sum = 0;
+    map.For_each([&sum](const Platform::uint32 & key, Platform::uint32 & value) { sum += value; });
+    TEST_ASSERT(Platform::uint64(n_entries) * (n_entries - 1) / 2, sum);
+
+    map.Clear();
+    TEST_ASSERT(true, map.Is_empty());
+    TEST_ASSERT((Platform::uint32 *) 0, map.Find(0));
+
+    return Passed;
+}
+
+UNIT_TEST(Flat_hash_map_copy_move)
+{
+    Containers::Flat_hash_map< std::string, Platform::uint32 > map;
+
+    map["one"] = 1;
+    map["two"] = 2;
+
+    {
+        auto map_b(map);
+        TEST_ASSERT(size_t(2), map_b.Size());
+        TEST_ASSERT(Platform::uint32(2), *map_b.Find("two"));
+
+        auto map_c(std::move(map_b));
+        TEST_ASSERT(true, map_b.Is_empty());
+        TEST_ASSERT(Platform::uint32(1), *map_c.Find("one"));
+
+        map_b = map_c;
+        map_c.Clear();
+        TEST_ASSERT(Platform::uint32(1), *map_b.Find("one"));
+        TEST_ASSERT((Platform::uint32 *) 0, map_c.Find("one"));
+    }
+
+    TEST_ASSERT(Platform::uint32(1), *map.Find("one"));
+    TEST_ASSERT(true, map.Erase("one"));
+    TEST_ASSERT(false, map.Contains("one"));
+
+    return Passed;
+}
+
+
+/* *** Slot_map *** */
+UNIT_TEST(Slot_map_insert_get_erase)
+{
+    typedef Containers::Slot_map < Platform::uint32 > map_t;
+
+    map_t map;
+
+    TEST_ASSERT(true, map.Is_empty());
+    TEST_ASSERT((Platform::uint32 *) 0, map.Get(map_t::m_Null_handle));
+
+    auto first = map.Insert(1);
+    auto second = map.Insert(2);
+    auto third = map.Insert(3);
+
+    TEST_ASSERT_NOT_EQUAL(map_t::m_Null_handle, first);
+    TEST_ASSERT(Platform::uint32(3), map.Size());
+    TEST_ASSERT(Platform::uint32(2), *map.Get(second));
+
+    /* Last object is moved into the gap, handles stay valid */
+    TEST_ASSERT(true, map.Erase(first));
+    TEST_ASSERT(false, map.Erase(first));
+    TEST_ASSERT(false, map.Contains(first));
+    TEST_ASSERT(Platform::uint32(2), map.Size());
+    TEST_ASSERT(Platform::uint32(2), *map.Get(second));
+    TEST_ASSERT(Platform::uint32(3), *map.Get(third));
+    TEST_ASSERT(third, map.Get_handle(0));
+
+    /* Slot is reused with new generation */
+    auto fourth = map.Insert(4);
+
+    TEST_ASSERT_NOT_EQUAL(first, fourth);
+    TEST_ASSERT((Platform::uint32 *) 0, map.Get(first));
+    TEST_ASSERT(Platform::uint32(4), *map.Get(fourth));
+
+    Platform::uint32 sum = 0;
+    map.For_each([&sum](Platform::uint32 value) { sum += value; });
+    TEST_ASSERT(Platform::uint32(9), sum);
+
+    map.Clear();
+
+    TEST_ASSERT(true, map.Is_empty());
+    TEST_ASSERT(false, map.Contains(second));
+    TEST_ASSERT(false, map.Contains(fourth));
+
+    return Passed;
+}
+
+UNIT_TEST(Slot_map_dense_storage)
+{
+    static const Platform::uint32 n_objects = 1000;
+
+    typedef Containers::Slot_map < Platform::uint32 > map_t;
+
+    map_t map;
+    std::vector< map_t::handle_t > handles;
+
+    for (Platform::uint32 i = 0; i < n_objects; ++i)
+    {
+        handles.push_back(map.Insert(i));
+    }
+
+    for (Platform::uint32 i = 0; i < n_objects; i += 2)
+    {
+        TEST_ASSERT(true, map.Erase(handles[i]));
+    }
+
+    TEST_ASSERT(n_objects / 2, map.Size());
+
+    /* Every dense object maps back to the handle that reaches it */
+    const Platform::uint32 * data = map.Data();
+    for (Platform::uint32 i = 0; i < map.Size(); ++i)
+    {
+        TEST_ASSERT(Platform::uint32(1), data[i] % 2);
+        TEST_ASSERT(&data[i], (const Platform::uint32 *) map.Get(map.Get_handle(i)));
+    }
+
+    for (Platform::uint32 i = 1; i < n_objects; i += 2)
+    {
+        TEST_ASSERT(i, *map.Get(handles[i]));
+    }
+
+    map_t moved(std::move(map));
+
+    TEST_ASSERT(true, map.Is_empty());
+    TEST_ASSERT(n_objects / 2, moved.Size());
+    TEST_ASSERT(Platform::uint32(1), *moved.Get(handles[1]));
+
+    return Passed;
+}
+
 
 /* *** Singleton *** */
 class Single_res : public Containers::Singleton < Single_res >
@@ -475,3 +834,93 @@ UNIT_TEST(Singleton)
     return Passed;
 }
 
+UNIT_TEST(Singleton_concurrent_creation)
+{
+    static const size_t n_threads = 8;
+    Single_res::pointer results[n_threads] = { nullptr };
+    std::thread threads[n_threads];
+
+    for (size_t i = 0; i < n_threads; ++i)
+    {
+        threads[i] = std::thread([&results, i]() { results[i] = Single_res::Get_singleton(); });
+    }
+
+    for (size_t i = 0; i < n_threads; ++i)
+    {
+        threads[i].join();
+    }
+
+    for (size_t i = 0; i < n_threads; ++i)
+    {
+        TEST_ASSERT(results[0], results[i]);
+    }
+
+    Single_res::Release();
+
+    return Passed;
+}
+
+class Thread_single_res : public Containers::Thread_singleton < Thread_single_res >
+{
+public:
+    Thread_single_res() = default;
+    virtual ~Thread_single_res() = default;
+};
+
+UNIT_TEST(Thread_singleton)
+{
+    auto singleton = Thread_single_res::Get_singleton();
+    Thread_single_res::pointer other = nullptr;
+
+    std::thread thread([&other]() { other = Thread_single_res::Get_singleton(); });
+    thread.join();
+
+    TEST_ASSERT(singleton, Thread_single_res::Get_singleton());
+    TEST_ASSERT_NOT_EQUAL(singleton, other);
+
+    Thread_single_res::Release();
+
+    return Passed;
+}
+
+static Platform::uint32 s_release_sequence = 0;
+
+class Ordered_res_first : public Containers::Ordered_singleton < Ordered_res_first, 1 >
+{
+public:
+    virtual ~Ordered_res_first()
+    {
+        m_released_as = ++s_release_sequence;
+    }
+
+    static Platform::uint32 m_released_as;
+};
+
+class Ordered_res_second : public Containers::Ordered_singleton < Ordered_res_second, 2 >
+{
+public:
+    virtual ~Ordered_res_second()
+    {
+        m_released_as = ++s_release_sequence;
+    }
+
+    static Platform::uint32 m_released_as;
+};
+
+Platform::uint32 Ordered_res_first::m_released_as = 0;
+Platform::uint32 Ordered_res_second::m_released_as = 0;
+
+UNIT_TEST(Singleton_ordered_shutdown)
+{
+    /* Creation order is opposite to release order */
+    Ordered_res_second::Get_singleton();
+    Ordered_res_first::Get_singleton();
+
+    Containers::Singleton_shutdown::Release_all();
+
+    TEST_ASSERT(Platform::uint32(1), Ordered_res_first::m_released_as);
+    TEST_ASSERT(Platform::uint32(2), Ordered_res_second::m_released_as);
+
+    return Passed;
+}
+
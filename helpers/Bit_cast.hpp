@@ -0,0 +1,62 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file Bit_cast.hpp
+**/
+
+#ifndef UTILITIES_HELPERS_BIT_CAST_HPP
+#define UTILITIES_HELPERS_BIT_CAST_HPP
+
+#if defined(__has_include)
+#if __has_include(<bit>)
+#include <bit>
+#endif
+#endif
+
+namespace Helpers
+{
+    /** \brief Reinterprets bits of value as other type of the same size
+     *
+     * Can be used in constant expressions. std::bit_cast is used when
+     * available, otherwise compiler builtin which is provided by MSVC, GCC
+     * and Clang also in older language modes.
+     **/
+    template <typename To, typename From>
+    constexpr To Bit_cast(const From & from)
+    {
+        static_assert(sizeof(To) == sizeof(From), "Types have different sizes");
+
+#if defined(__cpp_lib_bit_cast)
+        return std::bit_cast< To >(from);
+#else
+        return __builtin_bit_cast(To, from);
+#endif
+    }
+}
+
+#endif /* UTILITIES_HELPERS_BIT_CAST_HPP */
@@ -36,21 +36,21 @@ namespace Helpers
     {
         typedef T Base_type;
 
-        static Base_type And(
+        static constexpr Base_type And(
             const Base_type & l,
             const Base_type & r)
         {
             return (l & r);
         }
 
-        static Base_type Or(
+        static constexpr Base_type Or(
             const Base_type & l,
             const Base_type & r)
         {
             return (l | r);
         }
 
-        static Base_type Xor(
+        static constexpr Base_type Xor(
             const Base_type & l,
             const Base_type & r)
         {
@@ -63,9 +63,9 @@ namespace Helpers
     {
         typedef T Base_type;
 
-        static const Base_type m_None = Base_type(0);
-        static const Base_type m_One  = Base_type(1);
-        static const Base_type m_All  = ~(m_None);
+        static constexpr Base_type m_None = Base_type(0);
+        static constexpr Base_type m_One  = Base_type(1);
+        static constexpr Base_type m_All  = ~(m_None);
     };
 
     template <
@@ -74,14 +74,14 @@ namespace Helpers
     struct Bit
     {
         typedef T Base_type;
-        typedef Masks< Base_type > Masks;
+        typedef Helpers::Masks< Base_type > Masks;
 
-        static Base_type Get(const Base_type & raw)
+        static constexpr Base_type Get(const Base_type & raw)
         {
             return (raw & m_Bit) >> m_Offset;
         }
 
-        static Base_type Set(
+        static constexpr Base_type Set(
             const Base_type & value,
             const Base_type & raw)
         {
@@ -92,13 +92,13 @@ namespace Helpers
             return result;
         }
 
-        static const unsigned int m_Offset    = bit;
-        static const Base_type m_Bit          = Base_type(Masks::m_One << bit);
-        static const Base_type m_Bit_inv      = Base_type(~m_Bit);
-        static const Base_type m_MSE_bits     = Base_type(Masks::m_All << bit);
-        static const Base_type m_MSE_inv_bits = Base_type(~m_MSE_bits);
-        static const Base_type m_LSE_bits     = Base_type(m_MSE_inv_bits | m_Bit);
-        static const Base_type m_LSE_inv_bits = Base_type(~m_LSE_bits);
+        static constexpr unsigned int m_Offset    = bit;
+        static constexpr Base_type m_Bit          = Base_type(Masks::m_One << bit);
+        static constexpr Base_type m_Bit_inv      = Base_type(~m_Bit);
+        static constexpr Base_type m_MSE_bits     = Base_type(Masks::m_All << bit);
+        static constexpr Base_type m_MSE_inv_bits = Base_type(~m_MSE_bits);
+        static constexpr Base_type m_LSE_bits     = Base_type(m_MSE_inv_bits | m_Bit);
+        static constexpr Base_type m_LSE_inv_bits = Base_type(~m_LSE_bits);
     };
 
     template <
@@ -108,17 +108,17 @@ namespace Helpers
     struct Mask
     {
         typedef T Base_type;
-        typedef Binary_operations< Base_type > Binary_operations;
-        typedef Masks< Base_type > Masks;
+        typedef Helpers::Binary_operations< Base_type > Binary_operations;
+        typedef Helpers::Masks< Base_type > Masks;
         typedef Bit< T, ms > MS_bit;
         typedef Bit< T, ls > LS_bit;
 
-        static const Base_type    m_Mask        = MS_bit::m_LSE_bits & LS_bit::m_MSE_bits;
-        static const Base_type    m_Mask_inv    = ~m_Mask;
-        static const unsigned int m_Mask_length = ms - ls;
-        static const Base_type    m_Mask_value  = m_Mask >> LS_bit::m_Offset;
+        static constexpr Base_type    m_Mask        = MS_bit::m_LSE_bits & LS_bit::m_MSE_bits;
+        static constexpr Base_type    m_Mask_inv    = ~m_Mask;
+        static constexpr unsigned int m_Mask_length = ms - ls;
+        static constexpr Base_type    m_Mask_value  = m_Mask >> LS_bit::m_Offset;
 
-        static Base_type Get(const Base_type & raw)
+        static constexpr Base_type Get(const Base_type & raw)
         {
             const Base_type masked_raw = Binary_operations::And(raw, m_Mask);
             const Base_type result = (masked_raw >> LS_bit::m_Offset);
@@ -126,7 +126,7 @@ namespace Helpers
             return result;
         }
 
-        static Base_type Set(
+        static constexpr Base_type Set(
             const Base_type & value,
             const Base_type & raw)
         {
@@ -0,0 +1,294 @@
+/** License
+ * 
+ * Copyright (c) 2015 Adam migielski
+ * 
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a 
+ *      copy of this software and associated documentation files (the 
+ *      "Software"), to deal in the Software without restriction, including 
+ *      without limitation the rights to use, copy, modify, merge, publish, 
+ *      distribute, sublicense, and/or sell copies of the Software, and to 
+ *      permit persons to whom the Software is furnished to do so, subject to 
+ *      the following conditions: The above copyright notice and this permission 
+ *      notice shall be included in all copies or substantial portions of the 
+ *      Software. 
+ *
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ *      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ *      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ *      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ *      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ *      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ *      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+ *
+ **/
+ 
+/**
+ * @author Adam migielski
+ * @file Bounds.hpp
+ **/
+
+#ifndef UTILITIES_MATH_BOUNDS_HPP
+#define UTILITIES_MATH_BOUNDS_HPP
+
+#include "Float4.hpp"
+#include "Vector.hpp"
+
+#include <cmath>
+
+/*
+ * Bounding volumes and frustum culling. Box is tested against plane with
+ * its corner that is farthest along plane normal, so box that intersects
+ * every plane but is outside of frustum near its edges is reported as
+ * visible. Planes used with spheres have to be normalised.
+ */
+namespace Math
+{
+	namespace Bounds
+	{
+		static const Platform::uint32 max_planes = 8;
+
+		inline aabb Make_aabb(const float4 & min, const float4 & max)
+		{
+			aabb res;
+
+			res.min = min;
+			res.max = max;
+
+			return res;
+		}
+
+		inline aabb Make_aabb(const sphere & a)
+		{
+			float4 center, radius;
+			aabb res;
+
+			center.m128 = a.m128;
+			radius = Float4::Set(a.radius);
+
+			res.min = center - radius;
+			res.max = center + radius;
+
+			return res;
+		}
+
+		inline sphere Make_sphere(const float4 & center, float radius)
+		{
+			sphere res;
+
+			res.m128 = center.m128;
+			res.radius = radius;
+
+			return res;
+		}
+
+		/* Sphere around box, it is not the smallest sphere containing box */
+		inline sphere Make_sphere(const aabb & a)
+		{
+			float4 center, diagonal;
+
+			center = (a.min + a.max) * 0.5f;
+			diagonal = a.max - a.min;
+			diagonal.w = 0.0f;
+
+			return Make_sphere(center, sqrtf(Vector::Dot(diagonal, diagonal)) * 0.5f);
+		}
+
+		/* Planes are copied as they are, count is clamped to max_planes */
+		inline frustum Make_frustum(const float4 * planes, Platform::uint32 count)
+		{
+			frustum res;
+
+			res.count = (max_planes < count) ? max_planes : count;
+
+			for (Platform::uint32 i = 0; i < max_planes; ++i)
+			{
+				const float4 plane = (i < res.count) ? planes[i] : Float4::Set(0.0f, 0.0f, 0.0f, 1.0f);
+
+				res.x[i] = plane.x;
+				res.y[i] = plane.y;
+				res.z[i] = plane.z;
+				res.w[i] = plane.w;
+			}
+
+			return res;
+		}
+
+		/*
+		 * Six normalised planes of view_projection matrix: left, right, bottom,
+		 * top, near and far. Clip space depth is in range [0, w].
+		 */
+		inline frustum Make_frustum(const float16 & view_projection)
+		{
+			float4 planes[6];
+
+			planes[0] = view_projection.w + view_projection.x;
+			planes[1] = view_projection.w - view_projection.x;
+			planes[2] = view_projection.w + view_projection.y;
+			planes[3] = view_projection.w - view_projection.y;
+			planes[4] = view_projection.z;
+			planes[5] = view_projection.w - view_projection.z;
+
+			for (auto & plane : planes)
+			{
+				const float4 normal = Float4::Set(plane.x, plane.y, plane.z, 0.0f);
+
+				/* Exact division, operator / uses approximate reciprocal */
+				plane = plane * (1.0f / sqrtf(Vector::Dot(normal, normal)));
+			}
+
+			return Make_frustum(planes, 6);
+		}
+
+		inline aabb Merge(const aabb & a, const aabb & b)
+		{
+			aabb res;
+
+			res.min.m128 = _mm_min_ps(a.min.m128, b.min.m128);
+			res.max.m128 = _mm_max_ps(a.max.m128, b.max.m128);
+
+			return res;
+		}
+
+		inline aabb Merge(const aabb & a, const float4 & point)
+		{
+			aabb res;
+
+			res.min.m128 = _mm_min_ps(a.min.m128, point.m128);
+			res.max.m128 = _mm_max_ps(a.max.m128, point.m128);
+
+			return res;
+		}
+
+		/* Smallest sphere containing both spheres */
+		inline sphere Merge(const sphere & a, const sphere & b)
+		{
+			float4 a_center, delta;
+
+			a_center.m128 = a.m128;
+			delta.m128 = _mm_sub_ps(b.m128, a.m128);
+			delta.w = 0.0f;
+
+			const float distance = sqrtf(Vector::Dot(delta, delta));
+
+			if (distance + b.radius <= a.radius)
+			{
+				return a;
+			}
+
+			if (distance + a.radius <= b.radius)
+			{
+				return b;
+			}
+
+			const float radius = (distance + a.radius + b.radius) * 0.5f;
+
+			return Make_sphere(a_center + delta * ((radius - a.radius) / distance), radius);
+		}
+
+		/*
+		 * Box containing transformed box. Center is transformed and extents
+		 * are projected on absolute values of matrix columns. Up to rounding
+		 * result is the same as bounds of eight transformed corners.
+		 */
+		inline aabb Transform(const float12 & matrix, const aabb & box)
+		{
+			const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+			__m128 c0, c1, c2, c3, center, extent, temp;
+			aabb res;
+
+			c0 = matrix.x.m128;
+			c1 = matrix.y.m128;
+			c2 = matrix.z.m128;
+			c3 = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+			_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+			center = _mm_mul_ps(_mm_add_ps(box.min.m128, box.max.m128), _mm_set1_ps(0.5f));
+			extent = _mm_mul_ps(_mm_sub_ps(box.max.m128, box.min.m128), _mm_set1_ps(0.5f));
+
+			temp = _mm_add_ps(
+				_mm_mul_ps(c0, _mm_shuffle_ps(center, center, _MM_SHUFFLE(0, 0, 0, 0))),
+				_mm_mul_ps(c1, _mm_shuffle_ps(center, center, _MM_SHUFFLE(1, 1, 1, 1))));
+			temp = _mm_add_ps(temp, _mm_mul_ps(c2, _mm_shuffle_ps(center, center, _MM_SHUFFLE(2, 2, 2, 2))));
+			center = _mm_add_ps(temp, c3);
+
+			temp = _mm_add_ps(
+				_mm_mul_ps(_mm_and_ps(c0, abs_mask), _mm_shuffle_ps(extent, extent, _MM_SHUFFLE(0, 0, 0, 0))),
+				_mm_mul_ps(_mm_and_ps(c1, abs_mask), _mm_shuffle_ps(extent, extent, _MM_SHUFFLE(1, 1, 1, 1))));
+			extent = _mm_add_ps(temp, _mm_mul_ps(_mm_and_ps(c2, abs_mask), _mm_shuffle_ps(extent, extent, _MM_SHUFFLE(2, 2, 2, 2))));
+
+			res.min.m128 = _mm_sub_ps(center, extent);
+			res.max.m128 = _mm_add_ps(center, extent);
+
+			return res;
+		}
+
+		/*
+		 * Four planes are tested at once. Distances are computed in the same
+		 * order as in batch kernels, so results are the same. Box has to be
+		 * finite, padding planes reject boxes with infinite corners.
+		 */
+		inline bool Is_visible(const frustum & planes, const aabb & box)
+		{
+			const __m128 min_x = _mm_set1_ps(box.min.x);
+			const __m128 min_y = _mm_set1_ps(box.min.y);
+			const __m128 min_z = _mm_set1_ps(box.min.z);
+			const __m128 max_x = _mm_set1_ps(box.max.x);
+			const __m128 max_y = _mm_set1_ps(box.max.y);
+			const __m128 max_z = _mm_set1_ps(box.max.z);
+			__m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+			for (Platform::uint32 i = 0; i < planes.count; i += 4)
+			{
+				const __m128 p_x = _mm_load_ps(planes.x + i);
+				const __m128 p_y = _mm_load_ps(planes.y + i);
+				const __m128 p_z = _mm_load_ps(planes.z + i);
+				__m128 distance;
+
+				distance = _mm_add_ps(
+					_mm_max_ps(_mm_mul_ps(p_x, min_x), _mm_mul_ps(p_x, max_x)),
+					_mm_max_ps(_mm_mul_ps(p_y, min_y), _mm_mul_ps(p_y, max_y)));
+				distance = _mm_add_ps(distance, _mm_max_ps(_mm_mul_ps(p_z, min_z), _mm_mul_ps(p_z, max_z)));
+				distance = _mm_add_ps(distance, _mm_load_ps(planes.w + i));
+
+				visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+			}
+
+			return (0xf == _mm_movemask_ps(visible));
+		}
+
+		inline bool Is_visible(const frustum & planes, const sphere & a)
+		{
+			const __m128 c_x = _mm_set1_ps(a.x);
+			const __m128 c_y = _mm_set1_ps(a.y);
+			const __m128 c_z = _mm_set1_ps(a.z);
+			const __m128 radius = _mm_sub_ps(_mm_setzero_ps(), _mm_set1_ps(a.radius));
+			__m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+			for (Platform::uint32 i = 0; i < planes.count; i += 4)
+			{
+				__m128 distance;
+
+				distance = _mm_add_ps(_mm_mul_ps(_mm_load_ps(planes.x + i), c_x), _mm_mul_ps(_mm_load_ps(planes.y + i), c_y));
+				distance = _mm_add_ps(distance, _mm_mul_ps(_mm_load_ps(planes.z + i), c_z));
+				distance = _mm_add_ps(distance, _mm_load_ps(planes.w + i));
+
+				visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, radius));
+			}
+
+			return (0xf == _mm_movemask_ps(visible));
+		}
+
+		/*
+		 * Batch versions, indices of visible boxes or spheres are written to
+		 * visible in increasing order and their number is returned. Visible
+		 * has to have room for count entries. Spheres are x, y, z and w
+		 * streams, w is radius. Results are the same, see Kernels.hpp
+		 */
+		Platform::uint32 Cull_batch(const frustum & planes, const aabb_soa & boxes, Platform::uint32 * visible, Platform::uint32 count);
+		Platform::uint32 Cull_batch(const frustum & planes, const float4_soa & spheres, Platform::uint32 * visible, Platform::uint32 count);
+	}
+}
+
+#endif /* UTILITIES_MATH_BOUNDS_HPP */
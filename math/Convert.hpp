@@ -0,0 +1,235 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file Convert.hpp
+**/
+
+#ifndef MATH_CONVERT_HPP
+#define MATH_CONVERT_HPP
+
+#include <Utilities\helpers\Bit_cast.hpp>
+
+#include "Float.hpp"
+#include "HalfKernels.hpp"
+
+#include <type_traits>
+
+/*
+ * Bulk conversion between float or double and narrow Float types. Rounding
+ * is to nearest even, values out of range become infinity, subnormals are
+ * preserved and NaNs become quiet keeping upper bits of payload. Widening
+ * is exact.
+ *
+ * float <-> half uses selected kernel, see HalfKernels.hpp, other pairs are
+ * converted one by one with integer operations. Narrow and Widen can be
+ * used in constant expressions.
+ */
+namespace Math
+{
+    /* Float type matching layout of built in type */
+    template <typename T>
+    struct Ieee_type;
+
+    template <>
+    struct Ieee_type < float >
+    {
+        typedef float32 type;
+    };
+
+    template <>
+    struct Ieee_type < double >
+    {
+        typedef float64 type;
+    };
+
+    template <typename N, typename W>
+    constexpr N Narrow(const W & value)
+    {
+        typedef typename Ieee_type<W>::type Wide;
+        typedef typename Wide::Base_type U;
+        typedef typename N::Base_type Base_type;
+
+        static_assert(sizeof(Wide) == sizeof(W), "Layout of Ieee_type does not match");
+        static_assert(N::m_Significand_bits < Wide::m_Significand_bits, "Narrow type is not narrower");
+        static_assert(N::m_Exponent_bits <= Wide::m_Exponent_bits, "Narrow type has wider exponent");
+        static_assert(N::m_Has_sign, "Unsigned types are not supported");
+
+        const unsigned int shift = Wide::m_Significand_bits - N::m_Significand_bits;
+        const U one = 1;
+        const U wide_infinity = Wide::Exponent_mask::m_Mask_value << Wide::m_Significand_bits;
+        const U wide_significand = Wide::Significand_mask::m_Mask_value;
+        const U narrow_infinity = U(N::Exponent_mask::m_Mask_value) << N::m_Significand_bits;
+        const int wide_sign_shift = Wide::m_Exponent_bits + Wide::m_Significand_bits;
+
+        const U bits = Helpers::Bit_cast< U >(value);
+
+        const U sign = (bits >> wide_sign_shift) << (N::m_Exponent_bits + N::m_Significand_bits);
+        const U abs = bits & ~(one << wide_sign_shift);
+        U result = 0;
+
+        if (wide_infinity < abs)
+        {
+            /* Quiet NaN, upper bits of payload */
+            result = narrow_infinity | (one << (N::m_Significand_bits - 1)) | ((abs & wide_significand) >> shift);
+        }
+        else
+        {
+            const int exponent = (0 == (abs >> Wide::m_Significand_bits))
+                               ? 1
+                               : int(abs >> Wide::m_Significand_bits);
+            const int narrow_exponent = exponent - int(Wide::m_Exponent_bias) + int(N::m_Exponent_bias);
+
+            if (1 <= narrow_exponent)
+            {
+                /* Rebias, carry of rounding goes to exponent */
+                const U rebiased = abs - (U(Wide::m_Exponent_bias - N::m_Exponent_bias) << Wide::m_Significand_bits);
+
+                result = (rebiased + (one << (shift - 1)) - 1 + ((rebiased >> shift) & 1)) >> shift;
+            }
+            else
+            {
+                /* Subnormal, significand with implicit bit */
+                const U significand = (abs & wide_significand) | ((exponent == int(abs >> Wide::m_Significand_bits)) ? (one << Wide::m_Significand_bits) : 0);
+                unsigned int subnormal_shift = shift + unsigned(1 - narrow_exponent);
+
+                if (Wide::m_Significand_bits + 2 < subnormal_shift)
+                {
+                    subnormal_shift = Wide::m_Significand_bits + 2;
+                }
+
+                result = (significand + (one << (subnormal_shift - 1)) - 1 + ((significand >> subnormal_shift) & 1)) >> subnormal_shift;
+            }
+
+            if (narrow_infinity < result)
+            {
+                result = narrow_infinity;
+            }
+        }
+
+        return N(Base_type(sign | result));
+    }
+
+    template <typename W, typename N>
+    constexpr W Widen(const N & value)
+    {
+        typedef typename Ieee_type<W>::type Wide;
+        typedef typename Wide::Base_type U;
+
+        static_assert(sizeof(Wide) == sizeof(W), "Layout of Ieee_type does not match");
+        static_assert(N::m_Significand_bits < Wide::m_Significand_bits, "Narrow type is not narrower");
+        static_assert(N::m_Exponent_bits <= Wide::m_Exponent_bits, "Narrow type has wider exponent");
+        static_assert(N::m_Has_sign, "Unsigned types are not supported");
+
+        const unsigned int shift = Wide::m_Significand_bits - N::m_Significand_bits;
+        const U one = 1;
+        const U narrow_significand = N::Significand_mask::m_Mask_value;
+        const U narrow_exponent_max = N::Exponent_mask::m_Mask_value;
+        const int narrow_sign_shift = N::m_Exponent_bits + N::m_Significand_bits;
+
+        const U bits = U(value.m_Raw);
+        const U sign = (bits >> narrow_sign_shift) << (Wide::m_Exponent_bits + Wide::m_Significand_bits);
+        U significand = bits & narrow_significand;
+        int exponent = int((bits >> N::m_Significand_bits) & narrow_exponent_max);
+        U result = 0;
+
+        if (U(exponent) == narrow_exponent_max)
+        {
+            /* Infinity or NaN, NaN becomes quiet */
+            result = (U(Wide::Exponent_mask::m_Mask_value) << Wide::m_Significand_bits) | (significand << shift);
+
+            if (0 != significand)
+            {
+                result |= one << (Wide::m_Significand_bits - 1);
+            }
+        }
+        else if ((0 != exponent) || (0 != significand))
+        {
+            if (0 == exponent)
+            {
+                /* Subnormal, normalise */
+                exponent = 1;
+
+                while (0 == (significand & (one << N::m_Significand_bits)))
+                {
+                    significand <<= 1;
+                    exponent -= 1;
+                }
+
+                significand &= narrow_significand;
+            }
+
+            const U wide_exponent = U(exponent - int(N::m_Exponent_bias) + int(Wide::m_Exponent_bias));
+
+            result = (wide_exponent << Wide::m_Significand_bits) | (significand << shift);
+        }
+
+        result |= sign;
+
+        return Helpers::Bit_cast< W >(result);
+    }
+
+    /* Built in to narrow type */
+    template <typename N, typename W>
+    typename std::enable_if< std::is_floating_point<W>::value >::type Convert(
+        const W * source,
+        N * destination,
+        Platform::uint32 count)
+    {
+        for (Platform::uint32 i = 0; i < count; ++i)
+        {
+            destination[i] = Narrow<N>(source[i]);
+        }
+    }
+
+    /* Narrow to built in type */
+    template <typename N, typename W>
+    typename std::enable_if< std::is_floating_point<W>::value >::type Convert(
+        const N * source,
+        W * destination,
+        Platform::uint32 count)
+    {
+        for (Platform::uint32 i = 0; i < count; ++i)
+        {
+            destination[i] = Widen<W>(source[i]);
+        }
+    }
+
+    static_assert(sizeof(half) == sizeof(Platform::uint16), "Half is passed to kernels as raw bits");
+
+    inline void Convert(const float * source, half * destination, Platform::uint32 count)
+    {
+        Kernels::Float_to_half(source, reinterpret_cast<Platform::uint16 *>(destination), count);
+    }
+
+    inline void Convert(const half * source, float * destination, Platform::uint32 count)
+    {
+        Kernels::Half_to_float(reinterpret_cast<const Platform::uint16 *>(source), destination, count);
+    }
+}
+
+#endif /* MATH_CONVERT_HPP */
@@ -0,0 +1,185 @@
+/** License
+ * 
+ * Copyright (c) 2015 Adam migielski
+ * 
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a 
+ *      copy of this software and associated documentation files (the 
+ *      "Software"), to deal in the Software without restriction, including 
+ *      without limitation the rights to use, copy, modify, merge, publish, 
+ *      distribute, sublicense, and/or sell copies of the Software, and to 
+ *      permit persons to whom the Software is furnished to do so, subject to 
+ *      the following conditions: The above copyright notice and this permission 
+ *      notice shall be included in all copies or substantial portions of the 
+ *      Software. 
+ *
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ *      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ *      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ *      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ *      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ *      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ *      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+ *
+ **/
+ 
+/**
+ * @author Adam migielski
+ * @file Cpu.cpp
+ **/
+
+#include "PCH.hpp"
+
+#include "Cpu.hpp"
+
+#if (UTILITIES_COMPILER == UTILITIES_COMPIELR_MSVC)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+namespace Math
+{
+	namespace Cpu
+	{
+		/* Bits of cpuid registers */
+		static const Platform::uint32 cpuid_1_edx_sse2    = 1u << 26;
+		static const Platform::uint32 cpuid_1_ecx_sse41   = 1u << 19;
+		static const Platform::uint32 cpuid_1_ecx_fma     = 1u << 12;
+		static const Platform::uint32 cpuid_1_ecx_osxsave = 1u << 27;
+		static const Platform::uint32 cpuid_1_ecx_avx     = 1u << 28;
+		static const Platform::uint32 cpuid_1_ecx_f16c    = 1u << 29;
+		static const Platform::uint32 cpuid_7_ebx_avx2    = 1u << 5;
+		static const Platform::uint32 cpuid_7_ebx_avx512f = 1u << 16;
+
+		/* State saved by operating system, XCR0 */
+		static const Platform::uint64 xcr0_ymm = 0x06;
+		static const Platform::uint64 xcr0_zmm = 0xe6;
+
+		enum Registers
+		{
+			Eax = 0,
+			Ebx,
+			Ecx,
+			Edx,
+		};
+
+		static void cpuid(Platform::uint32 leaf, Platform::uint32 subleaf, Platform::uint32 (& regs)[4])
+		{
+#if (UTILITIES_COMPILER == UTILITIES_COMPIELR_MSVC)
+			int info[4];
+
+			__cpuidex(info, int(leaf), int(subleaf));
+
+			for (Platform::uint32 i = 0; i < 4; ++i)
+			{
+				regs[i] = Platform::uint32(info[i]);
+			}
+#else
+			__cpuid_count(leaf, subleaf, regs[Eax], regs[Ebx], regs[Ecx], regs[Edx]);
+#endif
+		}
+
+		static Platform::uint64 xgetbv()
+		{
+#if (UTILITIES_COMPILER == UTILITIES_COMPIELR_MSVC)
+			return _xgetbv(0);
+#else
+			Platform::uint32 eax;
+			Platform::uint32 edx;
+
+			__asm__ volatile ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+
+			return (Platform::uint64(edx) << 32) | eax;
+#endif
+		}
+
+		static Platform::uint32 detect()
+		{
+			Platform::uint32 regs[4];
+			Platform::uint32 features = 0;
+
+			cpuid(0, 0, regs);
+			const Platform::uint32 max_leaf = regs[Eax];
+
+			if (1 > max_leaf)
+			{
+				return features;
+			}
+
+			cpuid(1, 0, regs);
+			const Platform::uint32 ecx_1 = regs[Ecx];
+			const Platform::uint32 edx_1 = regs[Edx];
+
+			if (0 != (edx_1 & cpuid_1_edx_sse2))
+			{
+				features |= Sse2;
+			}
+
+			if (0 != (ecx_1 & cpuid_1_ecx_sse41))
+			{
+				features |= Sse41;
+			}
+
+			/* Wide registers are usable only when operating system saves them */
+			Platform::uint64 xcr0 = 0;
+			if (0 != (ecx_1 & cpuid_1_ecx_osxsave))
+			{
+				xcr0 = xgetbv();
+			}
+
+			if (xcr0_ymm != (xcr0 & xcr0_ymm))
+			{
+				return features;
+			}
+
+			if (0 != (ecx_1 & cpuid_1_ecx_avx))
+			{
+				features |= Avx;
+			}
+			else
+			{
+				return features;
+			}
+
+			if (0 != (ecx_1 & cpuid_1_ecx_fma))
+			{
+				features |= Fma;
+			}
+
+			if (0 != (ecx_1 & cpuid_1_ecx_f16c))
+			{
+				features |= F16c;
+			}
+
+			if (7 > max_leaf)
+			{
+				return features;
+			}
+
+			cpuid(7, 0, regs);
+			const Platform::uint32 ebx_7 = regs[Ebx];
+
+			if (0 != (ebx_7 & cpuid_7_ebx_avx2))
+			{
+				features |= Avx2;
+			}
+
+			if ((0 != (ebx_7 & cpuid_7_ebx_avx512f)) &&
+				(xcr0_zmm == (xcr0 & xcr0_zmm)))
+			{
+				features |= Avx512f;
+			}
+
+			return features;
+		}
+
+		Platform::uint32 Get_features()
+		{
+			static const Platform::uint32 features = detect();
+
+			return features;
+		}
+	}
+}
@@ -0,0 +1,64 @@
+/** License
+ * 
+ * Copyright (c) 2015 Adam migielski
+ * 
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a 
+ *      copy of this software and associated documentation files (the 
+ *      "Software"), to deal in the Software without restriction, including 
+ *      without limitation the rights to use, copy, modify, merge, publish, 
+ *      distribute, sublicense, and/or sell copies of the Software, and to 
+ *      permit persons to whom the Software is furnished to do so, subject to 
+ *      the following conditions: The above copyright notice and this permission 
+ *      notice shall be included in all copies or substantial portions of the 
+ *      Software. 
+ *
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ *      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ *      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ *      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ *      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ *      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ *      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+ *
+ **/
+ 
+/**
+ * @author Adam migielski
+ * @file Cpu.hpp
+ **/
+
+#ifndef UTILITIES_MATH_CPU_HPP
+#define UTILITIES_MATH_CPU_HPP
+
+namespace Math
+{
+	namespace Cpu
+	{
+		/*
+		 * Instruction set extensions. Extension is reported only when it is
+		 * supported by both processor and operating system.
+		 */
+		enum Features
+		{
+			Sse2    = 0x0001,
+			Sse41   = 0x0002,
+			Avx     = 0x0004,
+			Avx2    = 0x0008,
+			Fma     = 0x0010,
+			F16c    = 0x0020,
+			Avx512f = 0x0040,
+		};
+
+		/* Detection is done once, result is cached */
+		Platform::uint32 Get_features();
+
+		inline bool Has_features(Platform::uint32 features)
+		{
+			return (features == (Get_features() & features));
+		}
+	}
+}
+
+#endif /* UTILITIES_MATH_CPU_HPP */
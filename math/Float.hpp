@@ -33,11 +33,44 @@
 #define MATH_FLOAT_HPP
 
 #include <Utilities\basic\ErrorCodes.hpp>
+#include <Utilities\helpers\Bit_cast.hpp>
 #include <Utilities\helpers\Bits.hpp>
 #include <Utilities\helpers\Type.hpp>
 
 namespace Math
 {
+    template <
+        typename T,
+        unsigned int sign_bits,
+        unsigned int exponent_bits,
+        unsigned int exponent_bias,
+        unsigned int significand_bits >
+    class Float;
+
+    /* Declared before Float, it is used by Value */
+    typedef Float <
+        Platform::uint16 /* base */,
+        1                /* sign */,
+        5                /* exponent bits */,
+        15               /* exponent bias */,
+        10               /* significand bits */
+    > float16;
+    typedef float16 half;
+    typedef Float <
+        Platform::uint32 /* base */,
+        1                /* sign */,
+        8                /* exponent bits */,
+        127              /* exponent bias */,
+        23               /* significand bits */
+    > float32;
+    typedef Float <
+        Platform::uint64 /* base */,
+        1                /* sign */,
+        11               /* exponent bits */,
+        1023            /* exponent bias */,
+        52               /* significand bits */
+    > float64;
+
     template <
         typename T,
         unsigned int sign_bits,
@@ -66,24 +99,25 @@ namespace Math
             Significand_mask;
 
 
-        Float()
+        constexpr Float()
             : m_Raw(0)
         {
         }
-        Float(const Float & _float)
+        constexpr Float(const Float & _float)
             : m_Raw(_float.m_Raw)
         {
         }
-        Float(const Base_type & raw)
+        constexpr Float(const Base_type & raw)
             : m_Raw(raw)
         {
         }
-        Float(const double & value)
+        constexpr Float(const double & value)
+            : m_Raw(0)
         {
             Value(value);
         }
 
-        static typename Type::difference_type Get_exponent(const Base_type & raw)
+        static constexpr typename Type::difference_type Get_exponent(const Base_type & raw)
         {
             const typename Type::difference_type raw_exponent( Exponent_mask::Get(raw));
             const typename Type::difference_type biased_exponent(raw_exponent - m_Exponent_bias);
@@ -91,7 +125,7 @@ namespace Math
             return biased_exponent;
         }
 
-        static Base_type Set_exponent(
+        static constexpr Base_type Set_exponent(
             const typename Type::difference_type & exponent,
             const Base_type & raw)
         {
@@ -100,19 +134,19 @@ namespace Math
             return Exponent_mask::Set(biased_exponent, raw);
         }
 
-        static Base_type Get_significand(const Base_type & raw)
+        static constexpr Base_type Get_significand(const Base_type & raw)
         {
             return Significand_mask::Get(raw);
         }
 
-        static Base_type Set_significand(
+        static constexpr Base_type Set_significand(
             const Base_type & significand,
             const Base_type & raw)
         {
             return Significand_mask::Set(significand, raw);
         }
 
-        static Base_type Get_sign(const Base_type & raw)
+        static constexpr Base_type Get_sign(const Base_type & raw)
         {
             Base_type sign = 0;
 
@@ -124,7 +158,7 @@ namespace Math
             return sign;
         }
 
-        static Base_type Set_sign(
+        static constexpr Base_type Set_sign(
             const Base_type & sign,
             const Base_type & raw)
         {
@@ -138,27 +172,27 @@ namespace Math
             return result;
         }
 
-        Platform::int32 Value(const double & value)
+        constexpr Platform::int32 Value(const double & value)
         {
-            auto base_64     = (typename float64::Base_type *) &value;
-            auto exponent_64 = float64::Get_exponent(*base_64);
+            const auto base_64     = Helpers::Bit_cast< typename float64::Base_type >(value);
+            const auto exponent_64 = float64::Get_exponent(base_64);
 
             if (m_Exponent_max < exponent_64)
             {
                 return Utilities::Invalid_parameter;
             }
 
-            auto sign_64        = float64::Get_sign       (*base_64);
-            auto significand_64 = float64::Get_significand(*base_64);
+            auto sign_64        = float64::Get_sign       (base_64);
+            auto significand_64 = float64::Get_significand(base_64);
 
             auto exponent    = exponent_64;
             auto sign        = Float::Base_type(sign_64);
             auto significand = Float::Base_type(significand_64 >> m_Significand_shift);
             auto point       = significand_64 & ((float64::Masks::m_One << m_Significand_shift) >> 1);
 
-            if (-Type::difference_type(m_Exponent_bias) > exponent_64)
+            if (-typename Type::difference_type(m_Exponent_bias) > exponent_64)
             {
-                exponent = -Type::difference_type(m_Exponent_bias);
+                exponent = -typename Type::difference_type(m_Exponent_bias);
             }
 
             if (0 != point)
@@ -187,7 +221,7 @@ namespace Math
             return Utilities::Success;
         }
 
-        double Value() const
+        constexpr double Value() const
         {
             auto exponent    = Float::Get_exponent(m_Raw);
             auto sign        = Float::Get_sign(m_Raw);
@@ -198,9 +232,9 @@ namespace Math
             float64::Base_type             significand_64 =
                 float64::Base_type(significand) << m_Significand_shift;
 
-            if (exponent == -Float::Type::difference_type(m_Exponent_bias))
+            if (exponent == -typename Float::Type::difference_type(m_Exponent_bias))
             {
-                exponent_64 = -Float::Type::difference_type(float64::m_Exponent_bias);
+                exponent_64 = -typename Float::Type::difference_type(float64::m_Exponent_bias);
             }
 
             float64::Base_type base_64 =
@@ -215,7 +249,7 @@ namespace Math
                     )
                 );
 
-            double result = *(double *) &base_64;
+            double result = Helpers::Bit_cast< double >(base_64);
 
             return result;
         }
@@ -223,39 +257,16 @@ namespace Math
         Base_type m_Raw;
 
         /* Constants */
-        static const bool m_Has_sign = (0 == sign_bits)
-                                     ? false
-                                     : true;;
-        static const Base_type          m_Exponent_bias           = Base_type(exponent_bias);
-        static const Base_type          m_Exponent_max            = Exponent_mask::m_Mask_value - m_Exponent_bias - 1;
-        static const Base_type          m_Significand_max         = Significand_mask::m_Mask_value;
-        static const Base_type          m_Significand_shift       = float64::Significand_mask::m_Mask_length - Significand_mask::m_Mask_length;
+        static constexpr bool m_Has_sign = (0 == sign_bits)
+                                         ? false
+                                         : true;;
+        static constexpr Base_type          m_Exponent_bias           = Base_type(exponent_bias);
+        static constexpr Base_type          m_Exponent_max            = Exponent_mask::m_Mask_value - m_Exponent_bias - 1;
+        static constexpr Base_type          m_Significand_max         = Significand_mask::m_Mask_value;
+        static constexpr Base_type          m_Significand_shift       = Base_type(52 - significand_bits); /* float64 is incomplete here */
+        static constexpr unsigned int       m_Exponent_bits           = exponent_bits;
+        static constexpr unsigned int       m_Significand_bits        = significand_bits;
     };
-
-
-
-    typedef Float <
-        Platform::uint16 /* base */,
-        1                /* sign */,
-        5                /* exponent bits */,
-        15               /* exponent bias */,
-        10               /* significand bits */
-    > float16;
-    typedef float16 half;
-    typedef Float <
-        Platform::uint32 /* base */,
-        1                /* sign */,
-        8                /* exponent bits */,
-        127              /* exponent bias */,
-        23               /* significand bits */
-    > float32;
-    typedef Float <
-        Platform::uint64 /* base */,
-        1                /* sign */,
-        11               /* exponent bits */,
-        1023            /* exponent bias */,
-        52               /* significand bits */
-    > float64;
 }
 
 #endif /* MATH_FLOAT_HPP */
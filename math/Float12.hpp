@@ -119,10 +119,21 @@ namespace Math
 	inline float12 operator + (const float12 & a, const float12 & b)
 	{
 		float12 res;
-			
+
+#if (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX512)
+		const __mmask16 mask = UTILITIES_MATH_SIMD_FLOAT12_MASK;
+
+		_mm512_mask_storeu_ps(res.f, mask, _mm512_maskz_add_ps(mask,
+			_mm512_maskz_loadu_ps(mask, a.f),
+			_mm512_maskz_loadu_ps(mask, b.f)));
+#elif (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX)
+		_mm256_storeu_ps(&res.f[0], _mm256_add_ps(_mm256_loadu_ps(&a.f[0]), _mm256_loadu_ps(&b.f[0])));
+		res.z.m128 = _mm_add_ps(a.z.m128, b.z.m128);
+#else
 		res.x.m128 = _mm_add_ps(a.x.m128, b.x.m128);
 		res.y.m128 = _mm_add_ps(a.y.m128, b.y.m128);
 		res.z.m128 = _mm_add_ps(a.z.m128, b.z.m128);
+#endif
 
 		return res;
 	}
@@ -130,10 +141,21 @@ namespace Math
 	inline float12 operator - (const float12 & a, const float12 & b)
 	{
 		float12 res;
-			
+
+#if (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX512)
+		const __mmask16 mask = UTILITIES_MATH_SIMD_FLOAT12_MASK;
+
+		_mm512_mask_storeu_ps(res.f, mask, _mm512_maskz_sub_ps(mask,
+			_mm512_maskz_loadu_ps(mask, a.f),
+			_mm512_maskz_loadu_ps(mask, b.f)));
+#elif (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX)
+		_mm256_storeu_ps(&res.f[0], _mm256_sub_ps(_mm256_loadu_ps(&a.f[0]), _mm256_loadu_ps(&b.f[0])));
+		res.z.m128 = _mm_sub_ps(a.z.m128, b.z.m128);
+#else
 		res.x.m128 = _mm_sub_ps(a.x.m128, b.x.m128);
 		res.y.m128 = _mm_sub_ps(a.y.m128, b.y.m128);
 		res.z.m128 = _mm_sub_ps(a.z.m128, b.z.m128);
+#endif
 
 		return res;
 	}
@@ -141,10 +163,21 @@ namespace Math
 	inline float12 operator * (const float12 & a, const float12 & b)
 	{
 		float12 res;
-			
+
+#if (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX512)
+		const __mmask16 mask = UTILITIES_MATH_SIMD_FLOAT12_MASK;
+
+		_mm512_mask_storeu_ps(res.f, mask, _mm512_maskz_mul_ps(mask,
+			_mm512_maskz_loadu_ps(mask, a.f),
+			_mm512_maskz_loadu_ps(mask, b.f)));
+#elif (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX)
+		_mm256_storeu_ps(&res.f[0], _mm256_mul_ps(_mm256_loadu_ps(&a.f[0]), _mm256_loadu_ps(&b.f[0])));
+		res.z.m128 = _mm_mul_ps(a.z.m128, b.z.m128);
+#else
 		res.x.m128 = _mm_mul_ps(a.x.m128, b.x.m128);
 		res.y.m128 = _mm_mul_ps(a.y.m128, b.y.m128);
 		res.z.m128 = _mm_mul_ps(a.z.m128, b.z.m128);
+#endif
 
 		return res;
 	}
@@ -155,11 +188,21 @@ namespace Math
 		float4 scale;
 
 		scale.m128 = _mm_set1_ps(b);
-			
-			
+
+#if (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX512)
+		const __mmask16 mask = UTILITIES_MATH_SIMD_FLOAT12_MASK;
+
+		_mm512_mask_storeu_ps(res.f, mask, _mm512_maskz_mul_ps(mask,
+			_mm512_maskz_loadu_ps(mask, a.f),
+			_mm512_broadcast_f32x4(scale.m128)));
+#elif (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX)
+		_mm256_storeu_ps(&res.f[0], _mm256_mul_ps(_mm256_loadu_ps(&a.f[0]), _mm256_broadcast_ps(&scale.m128)));
+		res.z.m128 = _mm_mul_ps(a.z.m128, scale.m128);
+#else
 		res.x.m128 = _mm_mul_ps(a.x.m128, scale.m128);
 		res.y.m128 = _mm_mul_ps(a.y.m128, scale.m128);
 		res.z.m128 = _mm_mul_ps(a.z.m128, scale.m128);
+#endif
 
 		return res;
 	}
@@ -167,11 +210,22 @@ namespace Math
 	inline float12 operator / (const float12 & a, const float12 & b)
 	{
 		float12 res;
-			
+
+#if (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX512)
+		const __mmask16 mask = UTILITIES_MATH_SIMD_FLOAT12_MASK;
+
+		_mm512_mask_storeu_ps(res.f, mask, _mm512_maskz_div_ps(mask,
+			_mm512_maskz_loadu_ps(mask, a.f),
+			_mm512_maskz_loadu_ps(mask, b.f)));
+#elif (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX)
+		_mm256_storeu_ps(&res.f[0], _mm256_div_ps(_mm256_loadu_ps(&a.f[0]), _mm256_loadu_ps(&b.f[0])));
+		res.z.m128 = _mm_div_ps(a.z.m128, b.z.m128);
+#else
 		res.x.m128 = _mm_div_ps(a.x.m128, b.x.m128);
 		res.y.m128 = _mm_div_ps(a.y.m128, b.y.m128);
 		res.z.m128 = _mm_div_ps(a.z.m128, b.z.m128);
-			
+#endif
+
 		return res;
 	}
 }
@@ -138,11 +138,18 @@ namespace Math
 	inline float16 operator + (const float16 & a, const float16 & b)
 	{
 		float16 res;
-			
+
+#if (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX512)
+		_mm512_storeu_ps(res.f, _mm512_add_ps(_mm512_loadu_ps(a.f), _mm512_loadu_ps(b.f)));
+#elif (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX)
+		_mm256_storeu_ps(&res.f[0], _mm256_add_ps(_mm256_loadu_ps(&a.f[0]), _mm256_loadu_ps(&b.f[0])));
+		_mm256_storeu_ps(&res.f[8], _mm256_add_ps(_mm256_loadu_ps(&a.f[8]), _mm256_loadu_ps(&b.f[8])));
+#else
 		res.x.m128 = _mm_add_ps(a.x.m128, b.x.m128);
 		res.y.m128 = _mm_add_ps(a.y.m128, b.y.m128);
 		res.z.m128 = _mm_add_ps(a.z.m128, b.z.m128);
 		res.w.m128 = _mm_add_ps(a.w.m128, b.w.m128);
+#endif
 
 		return res;
 	}
@@ -150,11 +157,18 @@ namespace Math
 	inline float16 operator - (const float16 & a, const float16 & b)
 	{
 		float16 res;
-			
+
+#if (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX512)
+		_mm512_storeu_ps(res.f, _mm512_sub_ps(_mm512_loadu_ps(a.f), _mm512_loadu_ps(b.f)));
+#elif (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX)
+		_mm256_storeu_ps(&res.f[0], _mm256_sub_ps(_mm256_loadu_ps(&a.f[0]), _mm256_loadu_ps(&b.f[0])));
+		_mm256_storeu_ps(&res.f[8], _mm256_sub_ps(_mm256_loadu_ps(&a.f[8]), _mm256_loadu_ps(&b.f[8])));
+#else
 		res.x.m128 = _mm_sub_ps(a.x.m128, b.x.m128);
 		res.y.m128 = _mm_sub_ps(a.y.m128, b.y.m128);
 		res.z.m128 = _mm_sub_ps(a.z.m128, b.z.m128);
 		res.w.m128 = _mm_sub_ps(a.w.m128, b.w.m128);
+#endif
 
 		return res;
 	}
@@ -162,11 +176,18 @@ namespace Math
 	inline float16 operator * (const float16 & a, const float16 & b)
 	{
 		float16 res;
-			
+
+#if (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX512)
+		_mm512_storeu_ps(res.f, _mm512_mul_ps(_mm512_loadu_ps(a.f), _mm512_loadu_ps(b.f)));
+#elif (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX)
+		_mm256_storeu_ps(&res.f[0], _mm256_mul_ps(_mm256_loadu_ps(&a.f[0]), _mm256_loadu_ps(&b.f[0])));
+		_mm256_storeu_ps(&res.f[8], _mm256_mul_ps(_mm256_loadu_ps(&a.f[8]), _mm256_loadu_ps(&b.f[8])));
+#else
 		res.x.m128 = _mm_mul_ps(a.x.m128, b.x.m128);
 		res.y.m128 = _mm_mul_ps(a.y.m128, b.y.m128);
 		res.z.m128 = _mm_mul_ps(a.z.m128, b.z.m128);
 		res.w.m128 = _mm_mul_ps(a.w.m128, b.w.m128);
+#endif
 
 		return res;
 	}
@@ -177,12 +198,18 @@ namespace Math
 		float4 scale;
 
 		scale.m128 = _mm_set1_ps(b);
-			
-			
+
+#if (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX512)
+		_mm512_storeu_ps(res.f, _mm512_mul_ps(_mm512_loadu_ps(a.f), _mm512_broadcast_f32x4(scale.m128)));
+#elif (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX)
+		_mm256_storeu_ps(&res.f[0], _mm256_mul_ps(_mm256_loadu_ps(&a.f[0]), _mm256_broadcast_ps(&scale.m128)));
+		_mm256_storeu_ps(&res.f[8], _mm256_mul_ps(_mm256_loadu_ps(&a.f[8]), _mm256_broadcast_ps(&scale.m128)));
+#else
 		res.x.m128 = _mm_mul_ps(a.x.m128, scale.m128);
 		res.y.m128 = _mm_mul_ps(a.y.m128, scale.m128);
 		res.z.m128 = _mm_mul_ps(a.z.m128, scale.m128);
 		res.w.m128 = _mm_mul_ps(a.w.m128, scale.m128);
+#endif
 
 		return res;
 	}
@@ -190,12 +217,19 @@ namespace Math
 	inline float16 operator / (const float16 & a, const float16 & b)
 	{
 		float16 res;
-			
+
+#if (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX512)
+		_mm512_storeu_ps(res.f, _mm512_div_ps(_mm512_loadu_ps(a.f), _mm512_loadu_ps(b.f)));
+#elif (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX)
+		_mm256_storeu_ps(&res.f[0], _mm256_div_ps(_mm256_loadu_ps(&a.f[0]), _mm256_loadu_ps(&b.f[0])));
+		_mm256_storeu_ps(&res.f[8], _mm256_div_ps(_mm256_loadu_ps(&a.f[8]), _mm256_loadu_ps(&b.f[8])));
+#else
 		res.x.m128 = _mm_div_ps(a.x.m128, b.x.m128);
 		res.y.m128 = _mm_div_ps(a.y.m128, b.y.m128);
 		res.z.m128 = _mm_div_ps(a.z.m128, b.z.m128);
 		res.w.m128 = _mm_div_ps(a.w.m128, b.w.m128);
-			
+#endif
+
 		return res;
 	}
 }
@@ -178,6 +178,10 @@ namespace Math
 
 		return res;
 	}
+
+	/* Batch versions, see Kernels.hpp */
+	void Normalise_batch(const float4 * a, float4 * res, Platform::uint32 count);
+	void Lerp_batch(const float4 * a, const float4 * b, const float4 * percent, float4 * res, Platform::uint32 count);
 }
 
 #endif /* UTILITIES_MATH_FLOAT4_HPP */
@@ -33,7 +33,7 @@
 #define UTILITIES_MATH_FLOATTYPES_HPP
 
 #include <Utilities\basic\Align.hpp>
-#include <xmmintrin.h>
+#include "Simd.hpp"
 
 namespace Math
 {
@@ -173,6 +173,71 @@ namespace Math
 			float4 _4;
 		};
 	};
+
+
+	/*
+	 * Structure of arrays, n-th element is made of n-th entries of streams.
+	 * Streams not used by operation can be null.
+	 */
+	struct float4_soa
+	{
+		float * x;
+		float * y;
+		float * z;
+		float * w;
+	};
+
+
+	/* Axis aligned bounding box, w of corners is not used */
+	struct aabb
+	{
+		float4 min;
+		float4 max;
+	};
+
+
+	/* Bounding sphere, center in x, y and z */
+	union ALIGN16 sphere
+	{
+		float f[4];
+
+		struct
+		{
+			float x;
+			float y;
+			float z;
+			float radius;
+		};
+
+		__m128 m128;
+	};
+
+
+	/* Structure of arrays of boxes, see float4_soa. Spheres are stored in float4_soa, radius in w */
+	struct aabb_soa
+	{
+		float * min_x;
+		float * min_y;
+		float * min_z;
+		float * max_x;
+		float * max_y;
+		float * max_z;
+	};
+
+
+	/*
+	 * Up to eight planes in structure of arrays form, point p is inside of
+	 * plane when x * p.x + y * p.y + z * p.z + w >= 0. Entries past count are
+	 * filled with plane that accepts every finite point: 0, 0, 0, 1.
+	 */
+	struct ALIGN16 frustum
+	{
+		float x[8];
+		float y[8];
+		float z[8];
+		float w[8];
+		Platform::uint32 count;
+	};
 }
 
 #endif /* UTILITIES_MATH_FLOATTYPES_HPP */
@@ -0,0 +1,71 @@
+/** License
+ * 
+ * Copyright (c) 2015 Adam migielski
+ * 
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a 
+ *      copy of this software and associated documentation files (the 
+ *      "Software"), to deal in the Software without restriction, including 
+ *      without limitation the rights to use, copy, modify, merge, publish, 
+ *      distribute, sublicense, and/or sell copies of the Software, and to 
+ *      permit persons to whom the Software is furnished to do so, subject to 
+ *      the following conditions: The above copyright notice and this permission 
+ *      notice shall be included in all copies or substantial portions of the 
+ *      Software. 
+ *
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ *      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ *      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ *      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ *      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ *      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ *      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+ *
+ **/
+ 
+/**
+ * @author Adam migielski
+ * @file HalfKernels.hpp
+ **/
+
+#ifndef UTILITIES_MATH_HALF_KERNELS_HPP
+#define UTILITIES_MATH_HALF_KERNELS_HPP
+
+/*
+ * Conversion between float and IEEE half precision, halves are passed as
+ * raw bits. Header does not depend on FloatTypes.hpp nor Float.hpp, both
+ * define Math::float16 and can not be included together.
+ *
+ * Rounding is to nearest even, values out of range become infinity, NaNs
+ * are quiet and keep upper bits of payload. Results of all kernels are
+ * the same.
+ */
+namespace Math
+{
+	namespace Kernels
+	{
+		typedef void (* float_to_half_t)(const float * source, Platform::uint16 * destination, Platform::uint32 count);
+		typedef void (* half_to_float_t)(const Platform::uint16 * source, float * destination, Platform::uint32 count);
+
+		/* Selected kernels, see Kernels.cpp */
+		void Float_to_half(const float * source, Platform::uint16 * destination, Platform::uint32 count);
+		void Half_to_float(const Platform::uint16 * source, float * destination, Platform::uint32 count);
+
+		/* Bit manipulation with SSE2 */
+		namespace Sse
+		{
+			void Float_to_half(const float * source, Platform::uint16 * destination, Platform::uint32 count);
+			void Half_to_float(const Platform::uint16 * source, float * destination, Platform::uint32 count);
+		}
+
+		/* Conversion instructions, see Kernels_f16c.cpp */
+		namespace F16c
+		{
+			void Float_to_half(const float * source, Platform::uint16 * destination, Platform::uint32 count);
+			void Half_to_float(const Platform::uint16 * source, float * destination, Platform::uint32 count);
+		}
+	}
+}
+
+#endif /* UTILITIES_MATH_HALF_KERNELS_HPP */
@@ -0,0 +1,269 @@
+/** License
+ * 
+ * Copyright (c) 2015 Adam migielski
+ * 
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a 
+ *      copy of this software and associated documentation files (the 
+ *      "Software"), to deal in the Software without restriction, including 
+ *      without limitation the rights to use, copy, modify, merge, publish, 
+ *      distribute, sublicense, and/or sell copies of the Software, and to 
+ *      permit persons to whom the Software is furnished to do so, subject to 
+ *      the following conditions: The above copyright notice and this permission 
+ *      notice shall be included in all copies or substantial portions of the 
+ *      Software. 
+ *
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ *      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ *      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ *      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ *      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ *      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ *      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+ *
+ **/
+ 
+/**
+ * @author Adam migielski
+ * @file Kernels.cpp
+ **/
+
+#include "PCH.hpp"
+
+#include "Kernels.hpp"
+
+#include "Bounds.hpp"
+#include "Cpu.hpp"
+#include "Float4.hpp"
+#include "Matrix.hpp"
+#include "Quaternion.hpp"
+#include "Skinning.hpp"
+#include "Vector.hpp"
+
+namespace Math
+{
+	namespace Kernels
+	{
+		/* SSE is available on every x86-64 processor, it is used until selection is done */
+		static Table s_table =
+		{
+			"SSE",
+			&Sse::Multiply,
+			&Sse::Multiply,
+			&Sse::Rotate,
+			&Sse::Normalise,
+			&Sse::Lerp,
+			&Sse::Inverse,
+			&Sse::Inverse,
+			&Sse::Inverse_rigid,
+			&Sse::Determinant,
+			&Sse::Determinant,
+			&Sse::Slerp,
+			&Sse::Rotation_from_quaternion,
+			&Sse::Dot,
+			&Sse::Cross,
+			&Sse::Rotate,
+			&Sse::Transform_points,
+			&Sse::Skin_points,
+			&Sse::Skin_vectors,
+			&Sse::Cull_boxes,
+			&Sse::Cull_spheres,
+			&Sse::Float_to_half,
+			&Sse::Half_to_float,
+		};
+
+		static bool select()
+		{
+			if (true == Cpu::Has_features(Cpu::Avx512f))
+			{
+				s_table.m_name = "AVX512";
+				s_table.m_multiply_float16 = &Avx512::Multiply;
+				s_table.m_multiply_float12 = &Avx512::Multiply;
+				s_table.m_rotate = &Avx512::Rotate;
+				s_table.m_normalise = &Avx512::Normalise;
+				s_table.m_lerp = &Avx512::Lerp;
+				s_table.m_inverse_float16 = &Avx512::Inverse;
+				s_table.m_inverse_float12 = &Avx512::Inverse;
+				s_table.m_inverse_rigid = &Avx512::Inverse_rigid;
+				s_table.m_determinant_float16 = &Avx512::Determinant;
+				s_table.m_determinant_float12 = &Avx512::Determinant;
+				s_table.m_slerp = &Avx512::Slerp;
+				s_table.m_rotation_from_quaternion = &Avx512::Rotation_from_quaternion;
+				s_table.m_dot_soa = &Avx512::Dot;
+				s_table.m_cross_soa = &Avx512::Cross;
+				s_table.m_rotate_soa = &Avx512::Rotate;
+				s_table.m_transform_points_soa = &Avx512::Transform_points;
+				s_table.m_skin_points_soa = &Avx512::Skin_points;
+				s_table.m_skin_vectors_soa = &Avx512::Skin_vectors;
+				s_table.m_cull_boxes_soa = &Avx512::Cull_boxes;
+				s_table.m_cull_spheres_soa = &Avx512::Cull_spheres;
+			}
+			else if (true == Cpu::Has_features(Cpu::Avx2))
+			{
+				s_table.m_name = "AVX2";
+				s_table.m_multiply_float16 = &Avx2::Multiply;
+				s_table.m_multiply_float12 = &Avx2::Multiply;
+				s_table.m_rotate = &Avx2::Rotate;
+				s_table.m_normalise = &Avx2::Normalise;
+				s_table.m_lerp = &Avx2::Lerp;
+				s_table.m_inverse_float16 = &Avx2::Inverse;
+				s_table.m_inverse_float12 = &Avx2::Inverse;
+				s_table.m_inverse_rigid = &Avx2::Inverse_rigid;
+				s_table.m_determinant_float16 = &Avx2::Determinant;
+				s_table.m_determinant_float12 = &Avx2::Determinant;
+				s_table.m_slerp = &Avx2::Slerp;
+				s_table.m_rotation_from_quaternion = &Avx2::Rotation_from_quaternion;
+				s_table.m_dot_soa = &Avx2::Dot;
+				s_table.m_cross_soa = &Avx2::Cross;
+				s_table.m_rotate_soa = &Avx2::Rotate;
+				s_table.m_transform_points_soa = &Avx2::Transform_points;
+				s_table.m_skin_points_soa = &Avx2::Skin_points;
+				s_table.m_skin_vectors_soa = &Avx2::Skin_vectors;
+				s_table.m_cull_boxes_soa = &Avx2::Cull_boxes;
+				s_table.m_cull_spheres_soa = &Avx2::Cull_spheres;
+			}
+
+			/* F16C comes with AVX, but it is separate feature */
+			if (true == Cpu::Has_features(Cpu::F16c))
+			{
+				s_table.m_float_to_half = &F16c::Float_to_half;
+				s_table.m_half_to_float = &F16c::Half_to_float;
+			}
+
+			return true;
+		}
+
+		static const bool s_is_selected = select();
+
+		const char * Get_name()
+		{
+			return s_table.m_name;
+		}
+
+		void Float_to_half(const float * source, Platform::uint16 * destination, Platform::uint32 count)
+		{
+			s_table.m_float_to_half(source, destination, count);
+		}
+
+		void Half_to_float(const Platform::uint16 * source, float * destination, Platform::uint32 count)
+		{
+			s_table.m_half_to_float(source, destination, count);
+		}
+	}
+
+	namespace Bounds
+	{
+		Platform::uint32 Cull_batch(const frustum & planes, const aabb_soa & boxes, Platform::uint32 * visible, Platform::uint32 count)
+		{
+			return Kernels::s_table.m_cull_boxes_soa(planes, boxes, visible, count);
+		}
+
+		Platform::uint32 Cull_batch(const frustum & planes, const float4_soa & spheres, Platform::uint32 * visible, Platform::uint32 count)
+		{
+			return Kernels::s_table.m_cull_spheres_soa(planes, spheres, visible, count);
+		}
+	}
+
+	namespace Matrix
+	{
+		void Multiply_batch(const float16 * a, const float16 * b, float16 * res, Platform::uint32 count)
+		{
+			Kernels::s_table.m_multiply_float16(a, b, res, count);
+		}
+
+		void Multiply_batch(const float12 * a, const float12 * b, float12 * res, Platform::uint32 count)
+		{
+			Kernels::s_table.m_multiply_float12(a, b, res, count);
+		}
+
+		void Inverse_batch(const float16 * a, float16 * res, Platform::uint32 count)
+		{
+			Kernels::s_table.m_inverse_float16(a, res, count);
+		}
+
+		void Inverse_batch(const float12 * a, float12 * res, Platform::uint32 count)
+		{
+			Kernels::s_table.m_inverse_float12(a, res, count);
+		}
+
+		void Inverse_rigid_batch(const float12 * a, float12 * res, Platform::uint32 count)
+		{
+			Kernels::s_table.m_inverse_rigid(a, res, count);
+		}
+
+		void Determinant_batch(const float16 * a, float * res, Platform::uint32 count)
+		{
+			Kernels::s_table.m_determinant_float16(a, res, count);
+		}
+
+		void Determinant_batch(const float12 * a, float * res, Platform::uint32 count)
+		{
+			Kernels::s_table.m_determinant_float12(a, res, count);
+		}
+
+		void Transform_points_batch(const float12 & matrix, const float4_soa & points, const float4_soa & res, Platform::uint32 count)
+		{
+			Kernels::s_table.m_transform_points_soa(matrix, points, res, count);
+		}
+
+		void RotationFromQuaternion_batch(const float4 * quaternions, float12 * res, Platform::uint32 count)
+		{
+			Kernels::s_table.m_rotation_from_quaternion(quaternions, res, count);
+		}
+	}
+
+	namespace Quaternion
+	{
+		void Rotate_batch(const float4 * points, const float4 * quaternions, float4 * res, Platform::uint32 count)
+		{
+			Kernels::s_table.m_rotate(points, quaternions, res, count);
+		}
+
+		void Rotate_batch(const float4_soa & points, const float4_soa & quaternions, const float4_soa & res, Platform::uint32 count)
+		{
+			Kernels::s_table.m_rotate_soa(points, quaternions, res, count);
+		}
+
+		void Slerp_batch(const float4 * a, const float4 * b, const float * percent, float4 * res, Platform::uint32 count)
+		{
+			Kernels::s_table.m_slerp(a, b, percent, res, count);
+		}
+	}
+
+	namespace Skinning
+	{
+		void Skin_points_batch(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4_soa & points, const float4_soa & res, Platform::uint32 count)
+		{
+			Kernels::s_table.m_skin_points_soa(bones, indices, weights, points, res, count);
+		}
+
+		void Skin_vectors_batch(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4_soa & vectors, const float4_soa & res, Platform::uint32 count)
+		{
+			Kernels::s_table.m_skin_vectors_soa(bones, indices, weights, vectors, res, count);
+		}
+	}
+
+	namespace Vector
+	{
+		void Dot_batch(const float4_soa & a, const float4_soa & b, float * res, Platform::uint32 count)
+		{
+			Kernels::s_table.m_dot_soa(a, b, res, count);
+		}
+
+		void Cross_batch(const float4_soa & a, const float4_soa & b, const float4_soa & res, Platform::uint32 count)
+		{
+			Kernels::s_table.m_cross_soa(a, b, res, count);
+		}
+	}
+
+	void Normalise_batch(const float4 * a, float4 * res, Platform::uint32 count)
+	{
+		Kernels::s_table.m_normalise(a, res, count);
+	}
+
+	void Lerp_batch(const float4 * a, const float4 * b, const float4 * percent, float4 * res, Platform::uint32 count)
+	{
+		Kernels::s_table.m_lerp(a, b, percent, res, count);
+	}
+}
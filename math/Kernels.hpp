@@ -0,0 +1,194 @@
+/** License
+ * 
+ * Copyright (c) 2015 Adam migielski
+ * 
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a 
+ *      copy of this software and associated documentation files (the 
+ *      "Software"), to deal in the Software without restriction, including 
+ *      without limitation the rights to use, copy, modify, merge, publish, 
+ *      distribute, sublicense, and/or sell copies of the Software, and to 
+ *      permit persons to whom the Software is furnished to do so, subject to 
+ *      the following conditions: The above copyright notice and this permission 
+ *      notice shall be included in all copies or substantial portions of the 
+ *      Software. 
+ *
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ *      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ *      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ *      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ *      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ *      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ *      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+ *
+ **/
+ 
+/**
+ * @author Adam migielski
+ * @file Kernels.hpp
+ **/
+
+#ifndef UTILITIES_MATH_KERNELS_HPP
+#define UTILITIES_MATH_KERNELS_HPP
+
+#include "FloatTypes.hpp"
+#include "HalfKernels.hpp"
+
+/*
+ * Batch kernels compiled for several instruction sets. Each set lives in
+ * its own source file compiled with matching flags. Such file can include
+ * only FloatTypes.hpp, inline functions from other headers would be
+ * compiled with wider instructions and linker may pick them for code that
+ * runs on older processors.
+ *
+ * Best set is selected once, during static initialisation, see Kernels.cpp.
+ * Output array may be the same as any of input arrays.
+ */
+namespace Math
+{
+	namespace Kernels
+	{
+		typedef void (* multiply_float16_t)(const float16 * a, const float16 * b, float16 * res, Platform::uint32 count);
+		typedef void (* multiply_float12_t)(const float12 * a, const float12 * b, float12 * res, Platform::uint32 count);
+		typedef void (* rotate_t)(const float4 * points, const float4 * quaternions, float4 * res, Platform::uint32 count);
+		typedef void (* normalise_t)(const float4 * a, float4 * res, Platform::uint32 count);
+		typedef void (* lerp_t)(const float4 * a, const float4 * b, const float4 * percent, float4 * res, Platform::uint32 count);
+		typedef void (* inverse_float16_t)(const float16 * a, float16 * res, Platform::uint32 count);
+		typedef void (* inverse_float12_t)(const float12 * a, float12 * res, Platform::uint32 count);
+		typedef void (* determinant_float16_t)(const float16 * a, float * res, Platform::uint32 count);
+		typedef void (* determinant_float12_t)(const float12 * a, float * res, Platform::uint32 count);
+		typedef void (* slerp_t)(const float4 * a, const float4 * b, const float * percent, float4 * res, Platform::uint32 count);
+		typedef void (* rotation_from_quaternion_t)(const float4 * quaternions, float12 * res, Platform::uint32 count);
+
+		/* Structure of arrays, only x, y and z streams of points and vectors are used */
+		typedef void (* dot_soa_t)(const float4_soa & a, const float4_soa & b, float * res, Platform::uint32 count);
+		typedef void (* cross_soa_t)(const float4_soa & a, const float4_soa & b, const float4_soa & res, Platform::uint32 count);
+		typedef void (* rotate_soa_t)(const float4_soa & points, const float4_soa & quaternions, const float4_soa & res, Platform::uint32 count);
+		typedef void (* transform_points_soa_t)(const float12 & matrix, const float4_soa & points, const float4_soa & res, Platform::uint32 count);
+
+		/* Four bone indices and four weights per vertex, see Skinning.hpp */
+		typedef void (* skin_soa_t)(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4_soa & source, const float4_soa & res, Platform::uint32 count);
+
+		/* Frustum culling, indices of visible elements are written and their number is returned, see Bounds.hpp */
+		typedef Platform::uint32 (* cull_boxes_soa_t)(const frustum & planes, const aabb_soa & boxes, Platform::uint32 * visible, Platform::uint32 count);
+		typedef Platform::uint32 (* cull_spheres_soa_t)(const frustum & planes, const float4_soa & spheres, Platform::uint32 * visible, Platform::uint32 count);
+
+		struct Table
+		{
+			const char * m_name;
+			multiply_float16_t m_multiply_float16;
+			multiply_float12_t m_multiply_float12;
+			rotate_t m_rotate;
+			normalise_t m_normalise;
+			lerp_t m_lerp;
+			inverse_float16_t m_inverse_float16;
+			inverse_float12_t m_inverse_float12;
+			inverse_float12_t m_inverse_rigid;
+			determinant_float16_t m_determinant_float16;
+			determinant_float12_t m_determinant_float12;
+			slerp_t m_slerp;
+			rotation_from_quaternion_t m_rotation_from_quaternion;
+			dot_soa_t m_dot_soa;
+			cross_soa_t m_cross_soa;
+			rotate_soa_t m_rotate_soa;
+			transform_points_soa_t m_transform_points_soa;
+			skin_soa_t m_skin_points_soa;
+			skin_soa_t m_skin_vectors_soa;
+			cull_boxes_soa_t m_cull_boxes_soa;
+			cull_spheres_soa_t m_cull_spheres_soa;
+			float_to_half_t m_float_to_half;
+			half_to_float_t m_half_to_float;
+		};
+
+		/* Name of selected set: "SSE", "AVX2" or "AVX512", half conversion is selected separately */
+		const char * Get_name();
+
+		namespace Sse
+		{
+			void Multiply(const float16 * a, const float16 * b, float16 * res, Platform::uint32 count);
+			void Multiply(const float12 * a, const float12 * b, float12 * res, Platform::uint32 count);
+			void Rotate(const float4 * points, const float4 * quaternions, float4 * res, Platform::uint32 count);
+			void Normalise(const float4 * a, float4 * res, Platform::uint32 count);
+			void Lerp(const float4 * a, const float4 * b, const float4 * percent, float4 * res, Platform::uint32 count);
+
+			void Inverse(const float16 * a, float16 * res, Platform::uint32 count);
+			void Inverse(const float12 * a, float12 * res, Platform::uint32 count);
+			void Inverse_rigid(const float12 * a, float12 * res, Platform::uint32 count);
+			void Determinant(const float16 * a, float * res, Platform::uint32 count);
+			void Determinant(const float12 * a, float * res, Platform::uint32 count);
+
+			void Slerp(const float4 * a, const float4 * b, const float * percent, float4 * res, Platform::uint32 count);
+			void Rotation_from_quaternion(const float4 * quaternions, float12 * res, Platform::uint32 count);
+
+			void Dot(const float4_soa & a, const float4_soa & b, float * res, Platform::uint32 count);
+			void Cross(const float4_soa & a, const float4_soa & b, const float4_soa & res, Platform::uint32 count);
+			void Rotate(const float4_soa & points, const float4_soa & quaternions, const float4_soa & res, Platform::uint32 count);
+			void Transform_points(const float12 & matrix, const float4_soa & points, const float4_soa & res, Platform::uint32 count);
+			void Skin_points(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4_soa & points, const float4_soa & res, Platform::uint32 count);
+			void Skin_vectors(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4_soa & vectors, const float4_soa & res, Platform::uint32 count);
+
+			Platform::uint32 Cull_boxes(const frustum & planes, const aabb_soa & boxes, Platform::uint32 * visible, Platform::uint32 count);
+			Platform::uint32 Cull_spheres(const frustum & planes, const float4_soa & spheres, Platform::uint32 * visible, Platform::uint32 count);
+		}
+
+		namespace Avx2
+		{
+			void Multiply(const float16 * a, const float16 * b, float16 * res, Platform::uint32 count);
+			void Multiply(const float12 * a, const float12 * b, float12 * res, Platform::uint32 count);
+			void Rotate(const float4 * points, const float4 * quaternions, float4 * res, Platform::uint32 count);
+			void Normalise(const float4 * a, float4 * res, Platform::uint32 count);
+			void Lerp(const float4 * a, const float4 * b, const float4 * percent, float4 * res, Platform::uint32 count);
+
+			void Inverse(const float16 * a, float16 * res, Platform::uint32 count);
+			void Inverse(const float12 * a, float12 * res, Platform::uint32 count);
+			void Inverse_rigid(const float12 * a, float12 * res, Platform::uint32 count);
+			void Determinant(const float16 * a, float * res, Platform::uint32 count);
+			void Determinant(const float12 * a, float * res, Platform::uint32 count);
+
+			void Slerp(const float4 * a, const float4 * b, const float * percent, float4 * res, Platform::uint32 count);
+			void Rotation_from_quaternion(const float4 * quaternions, float12 * res, Platform::uint32 count);
+
+			void Dot(const float4_soa & a, const float4_soa & b, float * res, Platform::uint32 count);
+			void Cross(const float4_soa & a, const float4_soa & b, const float4_soa & res, Platform::uint32 count);
+			void Rotate(const float4_soa & points, const float4_soa & quaternions, const float4_soa & res, Platform::uint32 count);
+			void Transform_points(const float12 & matrix, const float4_soa & points, const float4_soa & res, Platform::uint32 count);
+			void Skin_points(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4_soa & points, const float4_soa & res, Platform::uint32 count);
+			void Skin_vectors(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4_soa & vectors, const float4_soa & res, Platform::uint32 count);
+
+			Platform::uint32 Cull_boxes(const frustum & planes, const aabb_soa & boxes, Platform::uint32 * visible, Platform::uint32 count);
+			Platform::uint32 Cull_spheres(const frustum & planes, const float4_soa & spheres, Platform::uint32 * visible, Platform::uint32 count);
+		}
+
+		/* Normalise uses more precise rsqrt14, results differ from other sets */
+		namespace Avx512
+		{
+			void Multiply(const float16 * a, const float16 * b, float16 * res, Platform::uint32 count);
+			void Multiply(const float12 * a, const float12 * b, float12 * res, Platform::uint32 count);
+			void Rotate(const float4 * points, const float4 * quaternions, float4 * res, Platform::uint32 count);
+			void Normalise(const float4 * a, float4 * res, Platform::uint32 count);
+			void Lerp(const float4 * a, const float4 * b, const float4 * percent, float4 * res, Platform::uint32 count);
+
+			void Inverse(const float16 * a, float16 * res, Platform::uint32 count);
+			void Inverse(const float12 * a, float12 * res, Platform::uint32 count);
+			void Inverse_rigid(const float12 * a, float12 * res, Platform::uint32 count);
+			void Determinant(const float16 * a, float * res, Platform::uint32 count);
+			void Determinant(const float12 * a, float * res, Platform::uint32 count);
+
+			void Slerp(const float4 * a, const float4 * b, const float * percent, float4 * res, Platform::uint32 count);
+			void Rotation_from_quaternion(const float4 * quaternions, float12 * res, Platform::uint32 count);
+
+			void Dot(const float4_soa & a, const float4_soa & b, float * res, Platform::uint32 count);
+			void Cross(const float4_soa & a, const float4_soa & b, const float4_soa & res, Platform::uint32 count);
+			void Rotate(const float4_soa & points, const float4_soa & quaternions, const float4_soa & res, Platform::uint32 count);
+			void Transform_points(const float12 & matrix, const float4_soa & points, const float4_soa & res, Platform::uint32 count);
+			void Skin_points(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4_soa & points, const float4_soa & res, Platform::uint32 count);
+			void Skin_vectors(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4_soa & vectors, const float4_soa & res, Platform::uint32 count);
+
+			Platform::uint32 Cull_boxes(const frustum & planes, const aabb_soa & boxes, Platform::uint32 * visible, Platform::uint32 count);
+			Platform::uint32 Cull_spheres(const frustum & planes, const float4_soa & spheres, Platform::uint32 * visible, Platform::uint32 count);
+		}
+	}
+}
+
+#endif /* UTILITIES_MATH_KERNELS_HPP */
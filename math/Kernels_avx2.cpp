@@ -0,0 +1,990 @@
+/** License
+ * 
+ * Copyright (c) 2015 Adam migielski
+ * 
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a 
+ *      copy of this software and associated documentation files (the 
+ *      "Software"), to deal in the Software without restriction, including 
+ *      without limitation the rights to use, copy, modify, merge, publish, 
+ *      distribute, sublicense, and/or sell copies of the Software, and to 
+ *      permit persons to whom the Software is furnished to do so, subject to 
+ *      the following conditions: The above copyright notice and this permission 
+ *      notice shall be included in all copies or substantial portions of the 
+ *      Software. 
+ *
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ *      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ *      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ *      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ *      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ *      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ *      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+ *
+ **/
+ 
+/**
+ * @author Adam migielski
+ * @file Kernels_avx2.cpp
+ **/
+
+#include "PCH.hpp"
+
+#include "Kernels.hpp"
+
+#include <immintrin.h>
+
+/*
+ * Two rows, two vectors or eight stream elements per instruction. Operations
+ * are done in the same order as in Kernels_sse.cpp, results are the same.
+ */
+
+namespace Math
+{
+	namespace Kernels
+	{
+		namespace Avx2
+		{
+			static inline __m256 multiply_rows(
+				__m256 rows,
+				__m256 b_x,
+				__m256 b_y,
+				__m256 b_z,
+				__m256 b_w)
+			{
+				__m256 x, y, z, w;
+
+				x = _mm256_permute_ps(rows, _MM_SHUFFLE(0,0,0,0));
+				y = _mm256_permute_ps(rows, _MM_SHUFFLE(1,1,1,1));
+				z = _mm256_permute_ps(rows, _MM_SHUFFLE(2,2,2,2));
+				w = _mm256_permute_ps(rows, _MM_SHUFFLE(3,3,3,3));
+
+				x = _mm256_mul_ps(x, b_x);
+				y = _mm256_mul_ps(y, b_y);
+				z = _mm256_mul_ps(z, b_z);
+				w = _mm256_mul_ps(w, b_w);
+
+				x = _mm256_add_ps(x, y);
+				z = _mm256_add_ps(z, w);
+
+				return _mm256_add_ps(x, z);
+			}
+
+			static inline __m256 multiply_quaternions(__m256 a, __m256 b)
+			{
+				const __m256 helper_x = _mm256_setr_ps(-1.0f, -1.0f, 1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f);
+				const __m256 helper_y = _mm256_setr_ps(1.0f, -1.0f, -1.0f, 1.0f, 1.0f, -1.0f, -1.0f, 1.0f);
+				const __m256 helper_z = _mm256_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f);
+				__m256 res, temp;
+
+				temp = _mm256_permute_ps(b, _MM_SHUFFLE(0, 0, 0, 0));
+				temp = _mm256_mul_ps(a, temp);
+				temp = _mm256_mul_ps(helper_x, temp);
+				res  = _mm256_permute_ps(temp, _MM_SHUFFLE(0, 1, 2, 3));
+
+				temp = _mm256_permute_ps(b, _MM_SHUFFLE(1, 1, 1, 1));
+				temp = _mm256_mul_ps(a, temp);
+				temp = _mm256_mul_ps(helper_y, temp);
+				temp = _mm256_permute_ps(temp, _MM_SHUFFLE(1, 0, 3, 2));
+				res  = _mm256_add_ps(res, temp);
+
+				temp = _mm256_permute_ps(b, _MM_SHUFFLE(2, 2, 2, 2));
+				temp = _mm256_mul_ps(a, temp);
+				temp = _mm256_mul_ps(helper_z, temp);
+				temp = _mm256_permute_ps(temp, _MM_SHUFFLE(2, 3, 0, 1));
+				res  = _mm256_add_ps(res, temp);
+
+				temp = _mm256_permute_ps(b, _MM_SHUFFLE(3, 3, 3, 3));
+				temp = _mm256_mul_ps(a, temp);
+				res  = _mm256_add_ps(res, temp);
+
+				return res;
+			}
+
+			static inline __m256 rotate(__m256 points, __m256 quaternions)
+			{
+				const __m256 inverse_helper = _mm256_setr_ps(-1.0f, -1.0f, -1.0f, 1.0f, -1.0f, -1.0f, -1.0f, 1.0f);
+				const __m256 point_mask = _mm256_castsi256_ps(_mm256_setr_epi32(-1, -1, -1, 0, -1, -1, -1, 0));
+
+				const __m256 point = _mm256_and_ps(points, point_mask);
+				const __m256 inverse = _mm256_mul_ps(quaternions, inverse_helper);
+
+				return multiply_quaternions(multiply_quaternions(quaternions, point), inverse);
+			}
+
+			static inline __m256 normalise(__m256 value)
+			{
+				__m256 sum, temp;
+
+				sum  = _mm256_mul_ps(value, value);
+
+				temp = _mm256_permute_ps(sum, _MM_SHUFFLE(3, 3, 1, 1));
+				sum  = _mm256_add_ps(sum, temp);
+
+				temp = _mm256_permute_ps(sum, _MM_SHUFFLE(3, 3, 3, 2));
+				sum  = _mm256_add_ps(sum, temp);
+
+				temp = _mm256_permute_ps(sum, _MM_SHUFFLE(0, 0, 0, 0));
+				temp = _mm256_rsqrt_ps(temp);
+
+				return _mm256_mul_ps(value, temp);
+			}
+
+			static inline __m256 lerp(__m256 a, __m256 b, __m256 percent)
+			{
+				const __m256 delta = _mm256_sub_ps(b, a);
+
+				return _mm256_add_ps(a, _mm256_mul_ps(delta, percent));
+			}
+
+			static inline __m256 load(const float4 * data)
+			{
+				return _mm256_loadu_ps((const float *) data);
+			}
+
+			static inline void store(float4 * data, __m256 value)
+			{
+				_mm256_storeu_ps((float *) data, value);
+			}
+
+			/* Single vector is duplicated in both halves, only lower half is stored */
+			static inline __m256 load_last(const float4 * data)
+			{
+				return _mm256_broadcast_ps(&data->m128);
+			}
+
+			static inline void store_last(float4 * data, __m256 value)
+			{
+				data->m128 = _mm256_castps256_ps128(value);
+			}
+
+			void Multiply(const float16 * a, const float16 * b, float16 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					const __m256 b_x = _mm256_broadcast_ps(&b[i].x.m128);
+					const __m256 b_y = _mm256_broadcast_ps(&b[i].y.m128);
+					const __m256 b_z = _mm256_broadcast_ps(&b[i].z.m128);
+					const __m256 b_w = _mm256_broadcast_ps(&b[i].w.m128);
+					const __m256 a_xy = _mm256_loadu_ps(&a[i].f[0]);
+					const __m256 a_zw = _mm256_loadu_ps(&a[i].f[8]);
+
+					const __m256 res_xy = multiply_rows(a_xy, b_x, b_y, b_z, b_w);
+					const __m256 res_zw = multiply_rows(a_zw, b_x, b_y, b_z, b_w);
+
+					_mm256_storeu_ps(&res[i].f[0], res_xy);
+					_mm256_storeu_ps(&res[i].f[8], res_zw);
+				}
+			}
+
+			void Multiply(const float12 * a, const float12 * b, float12 * res, Platform::uint32 count)
+			{
+				const __m256 last = _mm256_setr_ps(0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					const __m256 b_x = _mm256_broadcast_ps(&b[i].x.m128);
+					const __m256 b_y = _mm256_broadcast_ps(&b[i].y.m128);
+					const __m256 b_z = _mm256_broadcast_ps(&b[i].z.m128);
+					const __m256 a_xy = _mm256_loadu_ps(&a[i].f[0]);
+					const __m256 a_z = _mm256_broadcast_ps(&a[i].z.m128);
+
+					const __m256 res_xy = multiply_rows(a_xy, b_x, b_y, b_z, last);
+					const __m256 res_z = multiply_rows(a_z, b_x, b_y, b_z, last);
+
+					_mm256_storeu_ps(&res[i].f[0], res_xy);
+					res[i].z.m128 = _mm256_castps256_ps128(res_z);
+				}
+			}
+
+			void Rotate(const float4 * points, const float4 * quaternions, float4 * res, Platform::uint32 count)
+			{
+				Platform::uint32 i = 0;
+
+				for (; i + 2 <= count; i += 2)
+				{
+					store(&res[i], rotate(load(&points[i]), load(&quaternions[i])));
+				}
+
+				if (i < count)
+				{
+					store_last(&res[i], rotate(load_last(&points[i]), load_last(&quaternions[i])));
+				}
+			}
+
+			void Normalise(const float4 * a, float4 * res, Platform::uint32 count)
+			{
+				Platform::uint32 i = 0;
+
+				for (; i + 2 <= count; i += 2)
+				{
+					store(&res[i], normalise(load(&a[i])));
+				}
+
+				if (i < count)
+				{
+					store_last(&res[i], normalise(load_last(&a[i])));
+				}
+			}
+
+			void Lerp(const float4 * a, const float4 * b, const float4 * percent, float4 * res, Platform::uint32 count)
+			{
+				Platform::uint32 i = 0;
+
+				for (; i + 2 <= count; i += 2)
+				{
+					store(&res[i], lerp(load(&a[i]), load(&b[i]), load(&percent[i])));
+				}
+
+				if (i < count)
+				{
+					store_last(&res[i], lerp(load_last(&a[i]), load_last(&b[i]), load_last(&percent[i])));
+				}
+			}
+
+			/* Streams are processed 8 elements at once, last elements are loaded with mask */
+			static inline __m256i lanes_mask(Platform::uint32 count)
+			{
+				const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+				return _mm256_cmpgt_epi32(_mm256_set1_epi32(Platform::int32(count)), lanes);
+			}
+
+			static inline __m256 load_stream(const float * data, Platform::uint32 count)
+			{
+				if (8 <= count)
+				{
+					return _mm256_loadu_ps(data);
+				}
+
+				return _mm256_maskload_ps(data, lanes_mask(count));
+			}
+
+			static inline void store_stream(float * data, __m256 value, Platform::uint32 count)
+			{
+				if (8 <= count)
+				{
+					_mm256_storeu_ps(data, value);
+					return;
+				}
+
+				_mm256_maskstore_ps(data, lanes_mask(count), value);
+			}
+
+			void Dot(const float4_soa & a, const float4_soa & b, float * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 8)
+				{
+					const Platform::uint32 left = count - i;
+					__m256 x, y, z;
+
+					x = _mm256_mul_ps(load_stream(a.x + i, left), load_stream(b.x + i, left));
+					y = _mm256_mul_ps(load_stream(a.y + i, left), load_stream(b.y + i, left));
+					z = _mm256_mul_ps(load_stream(a.z + i, left), load_stream(b.z + i, left));
+
+					store_stream(res + i, _mm256_add_ps(_mm256_add_ps(x, y), z), left);
+				}
+			}
+
+			void Cross(const float4_soa & a, const float4_soa & b, const float4_soa & res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 8)
+				{
+					const Platform::uint32 left = count - i;
+					const __m256 a_x = load_stream(a.x + i, left);
+					const __m256 a_y = load_stream(a.y + i, left);
+					const __m256 a_z = load_stream(a.z + i, left);
+					const __m256 b_x = load_stream(b.x + i, left);
+					const __m256 b_y = load_stream(b.y + i, left);
+					const __m256 b_z = load_stream(b.z + i, left);
+
+					store_stream(res.x + i, _mm256_sub_ps(_mm256_mul_ps(a_y, b_z), _mm256_mul_ps(a_z, b_y)), left);
+					store_stream(res.y + i, _mm256_sub_ps(_mm256_mul_ps(a_z, b_x), _mm256_mul_ps(a_x, b_z)), left);
+					store_stream(res.z + i, _mm256_sub_ps(_mm256_mul_ps(a_x, b_y), _mm256_mul_ps(a_y, b_x)), left);
+				}
+			}
+
+			void Rotate(const float4_soa & points, const float4_soa & quaternions, const float4_soa & res, Platform::uint32 count)
+			{
+				const __m256 two = _mm256_set1_ps(2.0f);
+
+				for (Platform::uint32 i = 0; i < count; i += 8)
+				{
+					const Platform::uint32 left = count - i;
+					const __m256 p_x = load_stream(points.x + i, left);
+					const __m256 p_y = load_stream(points.y + i, left);
+					const __m256 p_z = load_stream(points.z + i, left);
+					const __m256 q_x = load_stream(quaternions.x + i, left);
+					const __m256 q_y = load_stream(quaternions.y + i, left);
+					const __m256 q_z = load_stream(quaternions.z + i, left);
+					const __m256 q_w = load_stream(quaternions.w + i, left);
+
+					/* t = 2 * cross(q, p) */
+					const __m256 t_x = _mm256_mul_ps(two, _mm256_sub_ps(_mm256_mul_ps(q_y, p_z), _mm256_mul_ps(q_z, p_y)));
+					const __m256 t_y = _mm256_mul_ps(two, _mm256_sub_ps(_mm256_mul_ps(q_z, p_x), _mm256_mul_ps(q_x, p_z)));
+					const __m256 t_z = _mm256_mul_ps(two, _mm256_sub_ps(_mm256_mul_ps(q_x, p_y), _mm256_mul_ps(q_y, p_x)));
+
+					/* p + w * t + cross(q, t) */
+					store_stream(res.x + i, _mm256_add_ps(_mm256_add_ps(p_x, _mm256_mul_ps(q_w, t_x)), _mm256_sub_ps(_mm256_mul_ps(q_y, t_z), _mm256_mul_ps(q_z, t_y))), left);
+					store_stream(res.y + i, _mm256_add_ps(_mm256_add_ps(p_y, _mm256_mul_ps(q_w, t_y)), _mm256_sub_ps(_mm256_mul_ps(q_z, t_x), _mm256_mul_ps(q_x, t_z))), left);
+					store_stream(res.z + i, _mm256_add_ps(_mm256_add_ps(p_z, _mm256_mul_ps(q_w, t_z)), _mm256_sub_ps(_mm256_mul_ps(q_x, t_y), _mm256_mul_ps(q_y, t_x))), left);
+				}
+			}
+
+			void Transform_points(const float12 & matrix, const float4_soa & points, const float4_soa & res, Platform::uint32 count)
+			{
+				const __m256 m_xx = _mm256_set1_ps(matrix.xx);
+				const __m256 m_xy = _mm256_set1_ps(matrix.xy);
+				const __m256 m_xz = _mm256_set1_ps(matrix.xz);
+				const __m256 m_xw = _mm256_set1_ps(matrix.xw);
+				const __m256 m_yx = _mm256_set1_ps(matrix.yx);
+				const __m256 m_yy = _mm256_set1_ps(matrix.yy);
+				const __m256 m_yz = _mm256_set1_ps(matrix.yz);
+				const __m256 m_yw = _mm256_set1_ps(matrix.yw);
+				const __m256 m_zx = _mm256_set1_ps(matrix.zx);
+				const __m256 m_zy = _mm256_set1_ps(matrix.zy);
+				const __m256 m_zz = _mm256_set1_ps(matrix.zz);
+				const __m256 m_zw = _mm256_set1_ps(matrix.zw);
+
+				for (Platform::uint32 i = 0; i < count; i += 8)
+				{
+					const Platform::uint32 left = count - i;
+					const __m256 p_x = load_stream(points.x + i, left);
+					const __m256 p_y = load_stream(points.y + i, left);
+					const __m256 p_z = load_stream(points.z + i, left);
+					__m256 x, y, z;
+
+					x = _mm256_add_ps(_mm256_mul_ps(m_xx, p_x), _mm256_mul_ps(m_xy, p_y));
+					y = _mm256_add_ps(_mm256_mul_ps(m_yx, p_x), _mm256_mul_ps(m_yy, p_y));
+					z = _mm256_add_ps(_mm256_mul_ps(m_zx, p_x), _mm256_mul_ps(m_zy, p_y));
+
+					x = _mm256_add_ps(_mm256_add_ps(x, _mm256_mul_ps(m_xz, p_z)), m_xw);
+					y = _mm256_add_ps(_mm256_add_ps(y, _mm256_mul_ps(m_yz, p_z)), m_yw);
+					z = _mm256_add_ps(_mm256_add_ps(z, _mm256_mul_ps(m_zz, p_z)), m_zw);
+
+					store_stream(res.x + i, x, left);
+					store_stream(res.y + i, y, left);
+					store_stream(res.z + i, z, left);
+				}
+			}
+
+			/* Transposition of 4x4 block, done in every 128 bit lane */
+			static inline void transpose_rows(__m256 & r0, __m256 & r1, __m256 & r2, __m256 & r3)
+			{
+				const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+				const __m256 t1 = _mm256_unpacklo_ps(r2, r3);
+				const __m256 t2 = _mm256_unpackhi_ps(r0, r1);
+				const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+
+				r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1,0,1,0));
+				r1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3,2,3,2));
+				r2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1,0,1,0));
+				r3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3,2,3,2));
+			}
+
+			/* Sum is stored in every element */
+			static inline __m256 sum_elements(__m256 value)
+			{
+				value = _mm256_add_ps(_mm256_permute_ps(value, _MM_SHUFFLE(1,0,3,2)), value);
+
+				return _mm256_add_ps(_mm256_permute_ps(value, _MM_SHUFFLE(2,3,0,1)), value);
+			}
+
+			static inline __m256 cross_rows(__m256 a, __m256 b)
+			{
+				const __m256 a_yzx = _mm256_permute_ps(a, _MM_SHUFFLE(3,0,2,1));
+				const __m256 a_zxy = _mm256_permute_ps(a, _MM_SHUFFLE(3,1,0,2));
+				const __m256 b_yzx = _mm256_permute_ps(b, _MM_SHUFFLE(3,0,2,1));
+				const __m256 b_zxy = _mm256_permute_ps(b, _MM_SHUFFLE(3,1,0,2));
+
+				return _mm256_sub_ps(_mm256_mul_ps(a_yzx, b_zxy), _mm256_mul_ps(a_zxy, b_yzx));
+			}
+
+			/* Cramer's rule, rows are replaced with rows of inverse, determinant is returned in every element */
+			static inline __m256 inverse_rows(__m256 & r0, __m256 & r1, __m256 & r2, __m256 & r3)
+			{
+				__m256 row0, row1, row2, row3;
+				__m256 minor0, minor1, minor2, minor3;
+				__m256 det, temp;
+
+				/* Columns, second and fourth are rotated by two elements */
+				temp = _mm256_shuffle_ps(r0, r1, _MM_SHUFFLE(1,0,1,0));
+				row1 = _mm256_shuffle_ps(r2, r3, _MM_SHUFFLE(1,0,1,0));
+				row0 = _mm256_shuffle_ps(temp, row1, _MM_SHUFFLE(2,0,2,0));
+				row1 = _mm256_shuffle_ps(row1, temp, _MM_SHUFFLE(3,1,3,1));
+				temp = _mm256_shuffle_ps(r0, r1, _MM_SHUFFLE(3,2,3,2));
+				row3 = _mm256_shuffle_ps(r2, r3, _MM_SHUFFLE(3,2,3,2));
+				row2 = _mm256_shuffle_ps(temp, row3, _MM_SHUFFLE(2,0,2,0));
+				row3 = _mm256_shuffle_ps(row3, temp, _MM_SHUFFLE(3,1,3,1));
+
+				temp = _mm256_mul_ps(row2, row3);
+				temp = _mm256_permute_ps(temp, _MM_SHUFFLE(2,3,0,1));
+				minor0 = _mm256_mul_ps(row1, temp);
+				minor1 = _mm256_mul_ps(row0, temp);
+				temp = _mm256_permute_ps(temp, _MM_SHUFFLE(1,0,3,2));
+				minor0 = _mm256_sub_ps(_mm256_mul_ps(row1, temp), minor0);
+				minor1 = _mm256_sub_ps(_mm256_mul_ps(row0, temp), minor1);
+				minor1 = _mm256_permute_ps(minor1, _MM_SHUFFLE(1,0,3,2));
+
+				temp = _mm256_mul_ps(row1, row2);
+				temp = _mm256_permute_ps(temp, _MM_SHUFFLE(2,3,0,1));
+				minor0 = _mm256_add_ps(_mm256_mul_ps(row3, temp), minor0);
+				minor3 = _mm256_mul_ps(row0, temp);
+				temp = _mm256_permute_ps(temp, _MM_SHUFFLE(1,0,3,2));
+				minor0 = _mm256_sub_ps(minor0, _mm256_mul_ps(row3, temp));
+				minor3 = _mm256_sub_ps(_mm256_mul_ps(row0, temp), minor3);
+				minor3 = _mm256_permute_ps(minor3, _MM_SHUFFLE(1,0,3,2));
+
+				temp = _mm256_mul_ps(_mm256_permute_ps(row1, _MM_SHUFFLE(1,0,3,2)), row3);
+				temp = _mm256_permute_ps(temp, _MM_SHUFFLE(2,3,0,1));
+				row2 = _mm256_permute_ps(row2, _MM_SHUFFLE(1,0,3,2));
+				minor0 = _mm256_add_ps(_mm256_mul_ps(row2, temp), minor0);
+				minor2 = _mm256_mul_ps(row0, temp);
+				temp = _mm256_permute_ps(temp, _MM_SHUFFLE(1,0,3,2));
+				minor0 = _mm256_sub_ps(minor0, _mm256_mul_ps(row2, temp));
+				minor2 = _mm256_sub_ps(_mm256_mul_ps(row0, temp), minor2);
+				minor2 = _mm256_permute_ps(minor2, _MM_SHUFFLE(1,0,3,2));
+
+				temp = _mm256_mul_ps(row0, row1);
+				temp = _mm256_permute_ps(temp, _MM_SHUFFLE(2,3,0,1));
+				minor2 = _mm256_add_ps(_mm256_mul_ps(row3, temp), minor2);
+				minor3 = _mm256_sub_ps(_mm256_mul_ps(row2, temp), minor3);
+				temp = _mm256_permute_ps(temp, _MM_SHUFFLE(1,0,3,2));
+				minor2 = _mm256_sub_ps(_mm256_mul_ps(row3, temp), minor2);
+				minor3 = _mm256_sub_ps(minor3, _mm256_mul_ps(row2, temp));
+
+				temp = _mm256_mul_ps(row0, row3);
+				temp = _mm256_permute_ps(temp, _MM_SHUFFLE(2,3,0,1));
+				minor1 = _mm256_sub_ps(minor1, _mm256_mul_ps(row2, temp));
+				minor2 = _mm256_add_ps(_mm256_mul_ps(row1, temp), minor2);
+				temp = _mm256_permute_ps(temp, _MM_SHUFFLE(1,0,3,2));
+				minor1 = _mm256_add_ps(_mm256_mul_ps(row2, temp), minor1);
+				minor2 = _mm256_sub_ps(minor2, _mm256_mul_ps(row1, temp));
+
+				temp = _mm256_mul_ps(row0, row2);
+				temp = _mm256_permute_ps(temp, _MM_SHUFFLE(2,3,0,1));
+				minor1 = _mm256_add_ps(_mm256_mul_ps(row3, temp), minor1);
+				minor3 = _mm256_sub_ps(minor3, _mm256_mul_ps(row1, temp));
+				temp = _mm256_permute_ps(temp, _MM_SHUFFLE(1,0,3,2));
+				minor1 = _mm256_sub_ps(minor1, _mm256_mul_ps(row3, temp));
+				minor3 = _mm256_add_ps(_mm256_mul_ps(row1, temp), minor3);
+
+				/* Exact division, results do not depend on instruction set */
+				det = sum_elements(_mm256_mul_ps(row0, minor0));
+				temp = _mm256_div_ps(_mm256_set1_ps(1.0f), det);
+
+				r0 = _mm256_mul_ps(minor0, temp);
+				r1 = _mm256_mul_ps(minor1, temp);
+				r2 = _mm256_mul_ps(minor2, temp);
+				r3 = _mm256_mul_ps(minor3, temp);
+
+				return det;
+			}
+
+			/* Columns of inverse of rotation part are cross products of rows divided by determinant */
+			static inline __m256 affine_inverse_rows(__m256 & r0, __m256 & r1, __m256 & r2)
+			{
+				__m256 c0 = cross_rows(r1, r2);
+				__m256 c1 = cross_rows(r2, r0);
+				__m256 c2 = cross_rows(r0, r1);
+				__m256 translation;
+
+				const __m256 det = sum_elements(_mm256_mul_ps(r0, c0));
+				const __m256 inverse = _mm256_div_ps(_mm256_set1_ps(1.0f), det);
+
+				c0 = _mm256_mul_ps(c0, inverse);
+				c1 = _mm256_mul_ps(c1, inverse);
+				c2 = _mm256_mul_ps(c2, inverse);
+
+				/* -inverse * translation */
+				translation = _mm256_add_ps(_mm256_mul_ps(c0, _mm256_permute_ps(r0, _MM_SHUFFLE(3,3,3,3))), _mm256_mul_ps(c1, _mm256_permute_ps(r1, _MM_SHUFFLE(3,3,3,3))));
+				translation = _mm256_add_ps(translation, _mm256_mul_ps(c2, _mm256_permute_ps(r2, _MM_SHUFFLE(3,3,3,3))));
+				translation = _mm256_sub_ps(_mm256_setzero_ps(), translation);
+
+				transpose_rows(c0, c1, c2, translation);
+
+				r0 = c0;
+				r1 = c1;
+				r2 = c2;
+
+				return det;
+			}
+
+			/* Rotation part is transposed */
+			static inline void rigid_inverse_rows(__m256 & r0, __m256 & r1, __m256 & r2)
+			{
+				__m256 translation;
+
+				/* -transposed * translation */
+				translation = _mm256_add_ps(_mm256_mul_ps(r0, _mm256_permute_ps(r0, _MM_SHUFFLE(3,3,3,3))), _mm256_mul_ps(r1, _mm256_permute_ps(r1, _MM_SHUFFLE(3,3,3,3))));
+				translation = _mm256_add_ps(translation, _mm256_mul_ps(r2, _mm256_permute_ps(r2, _MM_SHUFFLE(3,3,3,3))));
+				translation = _mm256_sub_ps(_mm256_setzero_ps(), translation);
+
+				transpose_rows(r0, r1, r2, translation);
+			}
+
+			static inline __m256 determinant_rows(__m256 r0, __m256 r1, __m256 r2)
+			{
+				return sum_elements(_mm256_mul_ps(r0, cross_rows(r1, r2)));
+			}
+
+			/* Rows of two matrices, second one may be the same as first one */
+			static inline void load_matrices(const float16 * a, const float16 * b, __m256 & r0, __m256 & r1, __m256 & r2, __m256 & r3)
+			{
+				const __m256 a_xy = _mm256_loadu_ps(&a->f[0]);
+				const __m256 a_zw = _mm256_loadu_ps(&a->f[8]);
+				const __m256 b_xy = _mm256_loadu_ps(&b->f[0]);
+				const __m256 b_zw = _mm256_loadu_ps(&b->f[8]);
+
+				r0 = _mm256_permute2f128_ps(a_xy, b_xy, 0x20);
+				r1 = _mm256_permute2f128_ps(a_xy, b_xy, 0x31);
+				r2 = _mm256_permute2f128_ps(a_zw, b_zw, 0x20);
+				r3 = _mm256_permute2f128_ps(a_zw, b_zw, 0x31);
+			}
+
+			static inline void load_matrices(const float12 * a, const float12 * b, __m256 & r0, __m256 & r1, __m256 & r2)
+			{
+				const __m256 a_xy = _mm256_loadu_ps(&a->f[0]);
+				const __m256 b_xy = _mm256_loadu_ps(&b->f[0]);
+
+				r0 = _mm256_permute2f128_ps(a_xy, b_xy, 0x20);
+				r1 = _mm256_permute2f128_ps(a_xy, b_xy, 0x31);
+				r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(a->z.m128), b->z.m128, 1);
+			}
+
+			/* Second matrix is not stored when b is null */
+			static inline void store_matrices(float16 * a, float16 * b, __m256 r0, __m256 r1, __m256 r2, __m256 r3)
+			{
+				_mm256_storeu_ps(&a->f[0], _mm256_permute2f128_ps(r0, r1, 0x20));
+				_mm256_storeu_ps(&a->f[8], _mm256_permute2f128_ps(r2, r3, 0x20));
+
+				if (nullptr != b)
+				{
+					_mm256_storeu_ps(&b->f[0], _mm256_permute2f128_ps(r0, r1, 0x31));
+					_mm256_storeu_ps(&b->f[8], _mm256_permute2f128_ps(r2, r3, 0x31));
+				}
+			}
+
+			static inline void store_matrices(float12 * a, float12 * b, __m256 r0, __m256 r1, __m256 r2)
+			{
+				_mm256_storeu_ps(&a->f[0], _mm256_permute2f128_ps(r0, r1, 0x20));
+				a->z.m128 = _mm256_castps256_ps128(r2);
+
+				if (nullptr != b)
+				{
+					_mm256_storeu_ps(&b->f[0], _mm256_permute2f128_ps(r0, r1, 0x31));
+					b->z.m128 = _mm256_extractf128_ps(r2, 1);
+				}
+			}
+
+			static inline void store_determinants(float * res, __m256 det, bool is_pair)
+			{
+				res[0] = _mm256_cvtss_f32(det);
+
+				if (true == is_pair)
+				{
+					res[1] = _mm_cvtss_f32(_mm256_extractf128_ps(det, 1));
+				}
+			}
+
+			void Inverse(const float16 * a, float16 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 2)
+				{
+					const bool is_pair = (i + 1 < count);
+					__m256 r0, r1, r2, r3;
+
+					load_matrices(&a[i], &a[is_pair ? (i + 1) : i], r0, r1, r2, r3);
+					inverse_rows(r0, r1, r2, r3);
+					store_matrices(&res[i], is_pair ? &res[i + 1] : nullptr, r0, r1, r2, r3);
+				}
+			}
+
+			void Inverse(const float12 * a, float12 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 2)
+				{
+					const bool is_pair = (i + 1 < count);
+					__m256 r0, r1, r2;
+
+					load_matrices(&a[i], &a[is_pair ? (i + 1) : i], r0, r1, r2);
+					affine_inverse_rows(r0, r1, r2);
+					store_matrices(&res[i], is_pair ? &res[i + 1] : nullptr, r0, r1, r2);
+				}
+			}
+
+			void Inverse_rigid(const float12 * a, float12 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 2)
+				{
+					const bool is_pair = (i + 1 < count);
+					__m256 r0, r1, r2;
+
+					load_matrices(&a[i], &a[is_pair ? (i + 1) : i], r0, r1, r2);
+					rigid_inverse_rows(r0, r1, r2);
+					store_matrices(&res[i], is_pair ? &res[i + 1] : nullptr, r0, r1, r2);
+				}
+			}
+
+			void Determinant(const float16 * a, float * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 2)
+				{
+					const bool is_pair = (i + 1 < count);
+					__m256 r0, r1, r2, r3;
+
+					load_matrices(&a[i], &a[is_pair ? (i + 1) : i], r0, r1, r2, r3);
+					store_determinants(&res[i], inverse_rows(r0, r1, r2, r3), is_pair);
+				}
+			}
+
+			void Determinant(const float12 * a, float * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 2)
+				{
+					const bool is_pair = (i + 1 < count);
+					__m256 r0, r1, r2;
+
+					load_matrices(&a[i], &a[is_pair ? (i + 1) : i], r0, r1, r2);
+					store_determinants(&res[i], determinant_rows(r0, r1, r2), is_pair);
+				}
+			}
+
+			/* Polynomials of Quaternion::FastAcos and Quaternion::FastSin */
+			static inline __m256 fast_acos(__m256 x)
+			{
+				__m256 res = _mm256_set1_ps(-0.0012624911f);
+
+				res = _mm256_add_ps(_mm256_mul_ps(res, x), _mm256_set1_ps(0.0066700901f));
+				res = _mm256_add_ps(_mm256_mul_ps(res, x), _mm256_set1_ps(-0.0170881256f));
+				res = _mm256_add_ps(_mm256_mul_ps(res, x), _mm256_set1_ps(0.0308918810f));
+				res = _mm256_add_ps(_mm256_mul_ps(res, x), _mm256_set1_ps(-0.0501743046f));
+				res = _mm256_add_ps(_mm256_mul_ps(res, x), _mm256_set1_ps(0.0889789874f));
+				res = _mm256_add_ps(_mm256_mul_ps(res, x), _mm256_set1_ps(-0.2145988016f));
+				res = _mm256_add_ps(_mm256_mul_ps(res, x), _mm256_set1_ps(1.5707963050f));
+
+				return _mm256_mul_ps(_mm256_sqrt_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), x)), res);
+			}
+
+			static inline __m256 fast_sin(__m256 x)
+			{
+				const __m256 x2 = _mm256_mul_ps(x, x);
+				__m256 res = _mm256_set1_ps(-2.5052108e-8f);
+
+				res = _mm256_add_ps(_mm256_mul_ps(res, x2), _mm256_set1_ps(2.7557319e-6f));
+				res = _mm256_add_ps(_mm256_mul_ps(res, x2), _mm256_set1_ps(-1.9841270e-4f));
+				res = _mm256_add_ps(_mm256_mul_ps(res, x2), _mm256_set1_ps(8.3333333e-3f));
+				res = _mm256_add_ps(_mm256_mul_ps(res, x2), _mm256_set1_ps(-1.6666667e-1f));
+				res = _mm256_add_ps(_mm256_mul_ps(res, x2), _mm256_set1_ps(1.0f));
+
+				return _mm256_mul_ps(res, x);
+			}
+
+			/* Quaternion::Slerp on streams, first quaternion is replaced with result */
+			static inline void slerp_lanes(__m256 & x, __m256 & y, __m256 & z, __m256 & w, __m256 b_x, __m256 b_y, __m256 b_z, __m256 b_w, __m256 percent)
+			{
+				const __m256 one = _mm256_set1_ps(1.0f);
+				const __m256 rest = _mm256_sub_ps(one, percent);
+				__m256 cosine, sign, angle, sine, weight_a, weight_b, length;
+
+				cosine = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, b_x), _mm256_mul_ps(y, b_y)), _mm256_mul_ps(z, b_z)), _mm256_mul_ps(w, b_w));
+
+				/* Shortest path */
+				sign = _mm256_blendv_ps(one, _mm256_set1_ps(-1.0f), _mm256_cmp_ps(cosine, _mm256_setzero_ps(), _CMP_LT_OQ));
+				b_x = _mm256_mul_ps(b_x, sign);
+				b_y = _mm256_mul_ps(b_y, sign);
+				b_z = _mm256_mul_ps(b_z, sign);
+				b_w = _mm256_mul_ps(b_w, sign);
+				cosine = _mm256_mul_ps(cosine, sign);
+
+				angle = fast_acos(cosine);
+				sine = _mm256_sqrt_ps(_mm256_sub_ps(one, _mm256_mul_ps(cosine, cosine)));
+				weight_a = _mm256_div_ps(fast_sin(_mm256_mul_ps(rest, angle)), sine);
+				weight_b = _mm256_div_ps(fast_sin(_mm256_mul_ps(percent, angle)), sine);
+
+				/* Linear interpolation when quaternions are almost the same */
+				const __m256 is_near = _mm256_cmp_ps(_mm256_set1_ps(0.9995f), cosine, _CMP_LT_OQ);
+				weight_a = _mm256_blendv_ps(weight_a, rest, is_near);
+				weight_b = _mm256_blendv_ps(weight_b, percent, is_near);
+
+				x = _mm256_add_ps(_mm256_mul_ps(x, weight_a), _mm256_mul_ps(b_x, weight_b));
+				y = _mm256_add_ps(_mm256_mul_ps(y, weight_a), _mm256_mul_ps(b_y, weight_b));
+				z = _mm256_add_ps(_mm256_mul_ps(z, weight_a), _mm256_mul_ps(b_z, weight_b));
+				w = _mm256_add_ps(_mm256_mul_ps(w, weight_a), _mm256_mul_ps(b_w, weight_b));
+
+				length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z)), _mm256_mul_ps(w, w)));
+				x = _mm256_div_ps(x, length);
+				y = _mm256_div_ps(y, length);
+				z = _mm256_div_ps(z, length);
+				w = _mm256_div_ps(w, length);
+			}
+
+			/* Matrix::RotationFromQuaternion on streams, rows are transposed back, in every 128 bit lane n-th register holds rows of n-th quaternion */
+			static inline void rotation_rows(__m256 x, __m256 y, __m256 z, __m256 w, __m256 * r_x, __m256 * r_y, __m256 * r_z)
+			{
+				const __m256 two = _mm256_set1_ps(2.0f);
+				const __m256 ww = _mm256_mul_ps(w, w);
+				const __m256 xx = _mm256_mul_ps(x, x);
+				const __m256 yy = _mm256_mul_ps(y, y);
+				const __m256 zz = _mm256_mul_ps(z, z);
+
+				const __m256 xy2 = _mm256_mul_ps(_mm256_mul_ps(x, y), two);
+				const __m256 xz2 = _mm256_mul_ps(_mm256_mul_ps(x, z), two);
+				const __m256 xw2 = _mm256_mul_ps(_mm256_mul_ps(x, w), two);
+				const __m256 yz2 = _mm256_mul_ps(_mm256_mul_ps(y, z), two);
+				const __m256 yw2 = _mm256_mul_ps(_mm256_mul_ps(y, w), two);
+				const __m256 zw2 = _mm256_mul_ps(_mm256_mul_ps(z, w), two);
+
+				r_x[0] = _mm256_sub_ps(_mm256_sub_ps(_mm256_add_ps(ww, xx), yy), zz);
+				r_x[1] = _mm256_add_ps(xy2, zw2);
+				r_x[2] = _mm256_sub_ps(xz2, yw2);
+				r_x[3] = _mm256_setzero_ps();
+
+				r_y[0] = _mm256_sub_ps(xy2, zw2);
+				r_y[1] = _mm256_sub_ps(_mm256_add_ps(_mm256_sub_ps(ww, xx), yy), zz);
+				r_y[2] = _mm256_add_ps(yz2, xw2);
+				r_y[3] = _mm256_setzero_ps();
+
+				r_z[0] = _mm256_add_ps(xz2, yw2);
+				r_z[1] = _mm256_sub_ps(yz2, xw2);
+				r_z[2] = _mm256_add_ps(_mm256_sub_ps(_mm256_sub_ps(ww, xx), yy), zz);
+				r_z[3] = _mm256_setzero_ps();
+
+				transpose_rows(r_x[0], r_x[1], r_x[2], r_x[3]);
+				transpose_rows(r_y[0], r_y[1], r_y[2], r_y[3]);
+				transpose_rows(r_z[0], r_z[1], r_z[2], r_z[3]);
+			}
+
+			/* Up to eight quaternions, n-th register holds n-th and (n + 4)-th one, missing ones are identity */
+			static inline void load_quaternions(const float4 * data, Platform::uint32 count, __m256 & x, __m256 & y, __m256 & z, __m256 & w)
+			{
+				const __m128 identity = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+				__m256 rows[4];
+
+				for (Platform::uint32 n = 0; n < 4; ++n)
+				{
+					const __m128 low = (n < count) ? data[n].m128 : identity;
+					const __m128 high = (n + 4 < count) ? data[n + 4].m128 : identity;
+
+					rows[n] = _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+				}
+
+				transpose_rows(rows[0], rows[1], rows[2], rows[3]);
+
+				x = rows[0];
+				y = rows[1];
+				z = rows[2];
+				w = rows[3];
+			}
+
+			static inline void store_quaternions(float4 * data, Platform::uint32 count, __m256 x, __m256 y, __m256 z, __m256 w)
+			{
+				__m256 rows[4] = { x, y, z, w };
+
+				transpose_rows(rows[0], rows[1], rows[2], rows[3]);
+
+				for (Platform::uint32 n = 0; n < 4; ++n)
+				{
+					if (n < count)
+					{
+						data[n].m128 = _mm256_castps256_ps128(rows[n]);
+					}
+
+					if (n + 4 < count)
+					{
+						data[n + 4].m128 = _mm256_extractf128_ps(rows[n], 1);
+					}
+				}
+			}
+
+			static inline Platform::uint32 left_quaternions(Platform::uint32 i, Platform::uint32 count)
+			{
+				return (i + 8 <= count) ? 8 : (count - i);
+			}
+
+			void Slerp(const float4 * a, const float4 * b, const float * percent, float4 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 8)
+				{
+					const Platform::uint32 left = left_quaternions(i, count);
+					__m256 x, y, z, w;
+					__m256 b_x, b_y, b_z, b_w;
+
+					load_quaternions(&a[i], left, x, y, z, w);
+					load_quaternions(&b[i], left, b_x, b_y, b_z, b_w);
+					slerp_lanes(x, y, z, w, b_x, b_y, b_z, b_w, load_stream(percent + i, left));
+					store_quaternions(&res[i], left, x, y, z, w);
+				}
+			}
+
+			void Rotation_from_quaternion(const float4 * quaternions, float12 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 8)
+				{
+					const Platform::uint32 left = left_quaternions(i, count);
+					__m256 x, y, z, w;
+					__m256 r_x[4], r_y[4], r_z[4];
+
+					load_quaternions(&quaternions[i], left, x, y, z, w);
+					rotation_rows(x, y, z, w, r_x, r_y, r_z);
+
+					for (Platform::uint32 n = 0; n < 4; ++n)
+					{
+						if (n < left)
+						{
+							res[i + n].x.m128 = _mm256_castps256_ps128(r_x[n]);
+							res[i + n].y.m128 = _mm256_castps256_ps128(r_y[n]);
+							res[i + n].z.m128 = _mm256_castps256_ps128(r_z[n]);
+						}
+
+						if (n + 4 < left)
+						{
+							res[i + n + 4].x.m128 = _mm256_extractf128_ps(r_x[n], 1);
+							res[i + n + 4].y.m128 = _mm256_extractf128_ps(r_y[n], 1);
+							res[i + n + 4].z.m128 = _mm256_extractf128_ps(r_z[n], 1);
+						}
+					}
+				}
+			}
+
+			/*
+			 * Linear blend skinning, one vertex at once. First and second rows
+			 * share register, third row is duplicated in both halves. W is 1 for
+			 * points and 0 for vectors.
+			 */
+			static inline void skin(
+				const float12 * bones,
+				const Platform::uint16 * indices,
+				const float * weights,
+				const float4_soa & source,
+				const float4_soa & res,
+				Platform::uint32 count,
+				float w)
+			{
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					const Platform::uint16 * index = indices + 4 * i;
+					const float * weight = weights + 4 * i;
+					const __m128 vertex = _mm_setr_ps(source.x[i], source.y[i], source.z[i], w);
+					const __m256 point = _mm256_insertf128_ps(_mm256_castps128_ps256(vertex), vertex, 1);
+					__m256 scale, r_xy, r_zz;
+
+					scale = _mm256_set1_ps(weight[0]);
+					r_xy = _mm256_mul_ps(_mm256_loadu_ps(bones[index[0]].f), scale);
+					r_zz = _mm256_mul_ps(_mm256_broadcast_ps(&bones[index[0]].z.m128), scale);
+
+					for (Platform::uint32 n = 1; n < 4; ++n)
+					{
+						const float12 & bone = bones[index[n]];
+
+						scale = _mm256_set1_ps(weight[n]);
+						r_xy = _mm256_add_ps(r_xy, _mm256_mul_ps(_mm256_loadu_ps(bone.f), scale));
+						r_zz = _mm256_add_ps(r_zz, _mm256_mul_ps(_mm256_broadcast_ps(&bone.z.m128), scale));
+					}
+
+					r_xy = sum_elements(_mm256_mul_ps(r_xy, point));
+					r_zz = sum_elements(_mm256_mul_ps(r_zz, point));
+
+					res.x[i] = _mm256_cvtss_f32(r_xy);
+					res.y[i] = _mm_cvtss_f32(_mm256_extractf128_ps(r_xy, 1));
+					res.z[i] = _mm256_cvtss_f32(r_zz);
+				}
+			}
+
+			void Skin_points(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4_soa & points, const float4_soa & res, Platform::uint32 count)
+			{
+				skin(bones, indices, weights, points, res, count, 1.0f);
+			}
+
+			void Skin_vectors(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4_soa & vectors, const float4_soa & res, Platform::uint32 count)
+			{
+				skin(bones, indices, weights, vectors, res, count, 0.0f);
+			}
+
+			/* Indices of lanes set in mask are appended to visible, entry past the last one may be overwritten */
+			static inline Platform::uint32 append_visible(Platform::uint32 * visible, Platform::uint32 n_visible, Platform::uint32 i, Platform::uint32 mask, Platform::uint32 lanes)
+			{
+				for (Platform::uint32 lane = 0; lane < lanes; ++lane)
+				{
+					visible[n_visible] = i + lane;
+					n_visible += (mask >> lane) & 1u;
+				}
+
+				return n_visible;
+			}
+
+			static inline Platform::uint32 valid_lanes(Platform::uint32 count)
+			{
+				return (8 <= count) ? 0xffu : ((1u << count) - 1u);
+			}
+
+			Platform::uint32 Cull_boxes(const frustum & planes, const aabb_soa & boxes, Platform::uint32 * visible, Platform::uint32 count)
+			{
+				Platform::uint32 n_visible = 0;
+
+				for (Platform::uint32 i = 0; i < count; i += 8)
+				{
+					const Platform::uint32 left = count - i;
+					const __m256 min_x = load_stream(boxes.min_x + i, left);
+					const __m256 min_y = load_stream(boxes.min_y + i, left);
+					const __m256 min_z = load_stream(boxes.min_z + i, left);
+					const __m256 max_x = load_stream(boxes.max_x + i, left);
+					const __m256 max_y = load_stream(boxes.max_y + i, left);
+					const __m256 max_z = load_stream(boxes.max_z + i, left);
+					Platform::uint32 mask = valid_lanes(left);
+
+					for (Platform::uint32 p = 0; (p < planes.count) && (0 != mask); ++p)
+					{
+						const __m256 p_x = _mm256_set1_ps(planes.x[p]);
+						const __m256 p_y = _mm256_set1_ps(planes.y[p]);
+						const __m256 p_z = _mm256_set1_ps(planes.z[p]);
+						__m256 distance;
+
+						distance = _mm256_add_ps(
+							_mm256_max_ps(_mm256_mul_ps(p_x, min_x), _mm256_mul_ps(p_x, max_x)),
+							_mm256_max_ps(_mm256_mul_ps(p_y, min_y), _mm256_mul_ps(p_y, max_y)));
+						distance = _mm256_add_ps(distance, _mm256_max_ps(_mm256_mul_ps(p_z, min_z), _mm256_mul_ps(p_z, max_z)));
+						distance = _mm256_add_ps(distance, _mm256_set1_ps(planes.w[p]));
+
+						mask &= Platform::uint32(_mm256_movemask_ps(_mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ)));
+					}
+
+					n_visible = append_visible(visible, n_visible, i, mask, (8 <= left) ? 8 : left);
+				}
+
+				return n_visible;
+			}
+
+			Platform::uint32 Cull_spheres(const frustum & planes, const float4_soa & spheres, Platform::uint32 * visible, Platform::uint32 count)
+			{
+				Platform::uint32 n_visible = 0;
+
+				for (Platform::uint32 i = 0; i < count; i += 8)
+				{
+					const Platform::uint32 left = count - i;
+					const __m256 c_x = load_stream(spheres.x + i, left);
+					const __m256 c_y = load_stream(spheres.y + i, left);
+					const __m256 c_z = load_stream(spheres.z + i, left);
+					const __m256 radius = _mm256_sub_ps(_mm256_setzero_ps(), load_stream(spheres.w + i, left));
+					Platform::uint32 mask = valid_lanes(left);
+
+					for (Platform::uint32 p = 0; (p < planes.count) && (0 != mask); ++p)
+					{
+						__m256 distance;
+
+						distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.x[p]), c_x), _mm256_mul_ps(_mm256_set1_ps(planes.y[p]), c_y));
+						distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes.z[p]), c_z));
+						distance = _mm256_add_ps(distance, _mm256_set1_ps(planes.w[p]));
+
+						mask &= Platform::uint32(_mm256_movemask_ps(_mm256_cmp_ps(distance, radius, _CMP_GE_OQ)));
+					}
+
+					n_visible = append_visible(visible, n_visible, i, mask, (8 <= left) ? 8 : left);
+				}
+
+				return n_visible;
+			}
+		}
+	}
+}
@@ -0,0 +1,946 @@
+/** License
+ * 
+ * Copyright (c) 2015 Adam migielski
+ * 
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a 
+ *      copy of this software and associated documentation files (the 
+ *      "Software"), to deal in the Software without restriction, including 
+ *      without limitation the rights to use, copy, modify, merge, publish, 
+ *      distribute, sublicense, and/or sell copies of the Software, and to 
+ *      permit persons to whom the Software is furnished to do so, subject to 
+ *      the following conditions: The above copyright notice and this permission 
+ *      notice shall be included in all copies or substantial portions of the 
+ *      Software. 
+ *
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ *      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ *      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ *      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ *      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ *      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ *      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+ *
+ **/
+ 
+/**
+ * @author Adam migielski
+ * @file Kernels_avx512.cpp
+ **/
+
+#include "PCH.hpp"
+
+#include "Kernels.hpp"
+
+#include <immintrin.h>
+
+/*
+ * Four rows, four vectors or sixteen stream elements per instruction,
+ * remaining elements are handled with masked loads and stores. Operations are done in the same order as in
+ * Kernels_sse.cpp. Only Normalise differs, rsqrt14 is more precise than
+ * rsqrt.
+ */
+
+namespace Math
+{
+	namespace Kernels
+	{
+		namespace Avx512
+		{
+			static const __mmask16 float12_mask = 0x0fff;
+
+			static inline __m512 multiply_rows(
+				__m512 rows,
+				__m512 b_x,
+				__m512 b_y,
+				__m512 b_z,
+				__m512 b_w)
+			{
+				__m512 x, y, z, w;
+
+				x = _mm512_permute_ps(rows, _MM_SHUFFLE(0,0,0,0));
+				y = _mm512_permute_ps(rows, _MM_SHUFFLE(1,1,1,1));
+				z = _mm512_permute_ps(rows, _MM_SHUFFLE(2,2,2,2));
+				w = _mm512_permute_ps(rows, _MM_SHUFFLE(3,3,3,3));
+
+				x = _mm512_mul_ps(x, b_x);
+				y = _mm512_mul_ps(y, b_y);
+				z = _mm512_mul_ps(z, b_z);
+				w = _mm512_mul_ps(w, b_w);
+
+				x = _mm512_add_ps(x, y);
+				z = _mm512_add_ps(z, w);
+
+				return _mm512_add_ps(x, z);
+			}
+
+			static inline __m512 multiply_quaternions(__m512 a, __m512 b)
+			{
+				const __m512 helper_x = _mm512_broadcast_f32x4(_mm_setr_ps(-1.0f, -1.0f, 1.0f, 1.0f));
+				const __m512 helper_y = _mm512_broadcast_f32x4(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f));
+				const __m512 helper_z = _mm512_broadcast_f32x4(_mm_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f));
+				__m512 res, temp;
+
+				temp = _mm512_permute_ps(b, _MM_SHUFFLE(0, 0, 0, 0));
+				temp = _mm512_mul_ps(a, temp);
+				temp = _mm512_mul_ps(helper_x, temp);
+				res  = _mm512_permute_ps(temp, _MM_SHUFFLE(0, 1, 2, 3));
+
+				temp = _mm512_permute_ps(b, _MM_SHUFFLE(1, 1, 1, 1));
+				temp = _mm512_mul_ps(a, temp);
+				temp = _mm512_mul_ps(helper_y, temp);
+				temp = _mm512_permute_ps(temp, _MM_SHUFFLE(1, 0, 3, 2));
+				res  = _mm512_add_ps(res, temp);
+
+				temp = _mm512_permute_ps(b, _MM_SHUFFLE(2, 2, 2, 2));
+				temp = _mm512_mul_ps(a, temp);
+				temp = _mm512_mul_ps(helper_z, temp);
+				temp = _mm512_permute_ps(temp, _MM_SHUFFLE(2, 3, 0, 1));
+				res  = _mm512_add_ps(res, temp);
+
+				temp = _mm512_permute_ps(b, _MM_SHUFFLE(3, 3, 3, 3));
+				temp = _mm512_mul_ps(a, temp);
+				res  = _mm512_add_ps(res, temp);
+
+				return res;
+			}
+
+			static inline __m512 rotate(__m512 points, __m512 quaternions)
+			{
+				const __m512 inverse_helper = _mm512_broadcast_f32x4(_mm_setr_ps(-1.0f, -1.0f, -1.0f, 1.0f));
+				const __mmask16 point_mask = 0x7777;
+
+				const __m512 point = _mm512_maskz_mov_ps(point_mask, points);
+				const __m512 inverse = _mm512_mul_ps(quaternions, inverse_helper);
+
+				return multiply_quaternions(multiply_quaternions(quaternions, point), inverse);
+			}
+
+			static inline __m512 normalise(__m512 value)
+			{
+				__m512 sum, temp;
+
+				sum  = _mm512_mul_ps(value, value);
+
+				temp = _mm512_permute_ps(sum, _MM_SHUFFLE(3, 3, 1, 1));
+				sum  = _mm512_add_ps(sum, temp);
+
+				temp = _mm512_permute_ps(sum, _MM_SHUFFLE(3, 3, 3, 2));
+				sum  = _mm512_add_ps(sum, temp);
+
+				temp = _mm512_permute_ps(sum, _MM_SHUFFLE(0, 0, 0, 0));
+				temp = _mm512_rsqrt14_ps(temp);
+
+				return _mm512_mul_ps(value, temp);
+			}
+
+			static inline __m512 lerp(__m512 a, __m512 b, __m512 percent)
+			{
+				const __m512 delta = _mm512_sub_ps(b, a);
+
+				return _mm512_add_ps(a, _mm512_mul_ps(delta, percent));
+			}
+
+			/* Mask of first count vectors, count is in range [0, 4] */
+			static inline __mmask16 vectors_mask(Platform::uint32 count)
+			{
+				return __mmask16((1u << (count * 4)) - 1u);
+			}
+
+			static inline __m512 load(const float4 * data, __mmask16 mask)
+			{
+				return _mm512_maskz_loadu_ps(mask, (const float *) data);
+			}
+
+			static inline void store(float4 * data, __m512 value, __mmask16 mask)
+			{
+				_mm512_mask_storeu_ps((float *) data, mask, value);
+			}
+
+			void Multiply(const float16 * a, const float16 * b, float16 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					const __m512 b_x = _mm512_broadcast_f32x4(b[i].x.m128);
+					const __m512 b_y = _mm512_broadcast_f32x4(b[i].y.m128);
+					const __m512 b_z = _mm512_broadcast_f32x4(b[i].z.m128);
+					const __m512 b_w = _mm512_broadcast_f32x4(b[i].w.m128);
+					const __m512 rows = _mm512_loadu_ps(a[i].f);
+
+					_mm512_storeu_ps(res[i].f, multiply_rows(rows, b_x, b_y, b_z, b_w));
+				}
+			}
+
+			void Multiply(const float12 * a, const float12 * b, float12 * res, Platform::uint32 count)
+			{
+				const __m512 last = _mm512_broadcast_f32x4(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					const __m512 b_x = _mm512_broadcast_f32x4(b[i].x.m128);
+					const __m512 b_y = _mm512_broadcast_f32x4(b[i].y.m128);
+					const __m512 b_z = _mm512_broadcast_f32x4(b[i].z.m128);
+					const __m512 rows = _mm512_maskz_loadu_ps(float12_mask, a[i].f);
+
+					_mm512_mask_storeu_ps(res[i].f, float12_mask, multiply_rows(rows, b_x, b_y, b_z, last));
+				}
+			}
+
+			void Rotate(const float4 * points, const float4 * quaternions, float4 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 4)
+				{
+					const Platform::uint32 left = count - i;
+					const __mmask16 mask = vectors_mask((4 < left) ? 4 : left);
+
+					store(&res[i], rotate(load(&points[i], mask), load(&quaternions[i], mask)), mask);
+				}
+			}
+
+			void Normalise(const float4 * a, float4 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 4)
+				{
+					const Platform::uint32 left = count - i;
+					const __mmask16 mask = vectors_mask((4 < left) ? 4 : left);
+
+					store(&res[i], normalise(load(&a[i], mask)), mask);
+				}
+			}
+
+			void Lerp(const float4 * a, const float4 * b, const float4 * percent, float4 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 4)
+				{
+					const Platform::uint32 left = count - i;
+					const __mmask16 mask = vectors_mask((4 < left) ? 4 : left);
+
+					store(&res[i], lerp(load(&a[i], mask), load(&b[i], mask), load(&percent[i], mask)), mask);
+				}
+			}
+
+			/* Streams are processed 16 elements at once, last elements are loaded with mask */
+			static inline __m512 load_stream(const float * data, Platform::uint32 count)
+			{
+				if (16 <= count)
+				{
+					return _mm512_loadu_ps(data);
+				}
+
+				return _mm512_maskz_loadu_ps(__mmask16((1u << count) - 1u), data);
+			}
+
+			static inline void store_stream(float * data, __m512 value, Platform::uint32 count)
+			{
+				if (16 <= count)
+				{
+					_mm512_storeu_ps(data, value);
+					return;
+				}
+
+				_mm512_mask_storeu_ps(data, __mmask16((1u << count) - 1u), value);
+			}
+
+			void Dot(const float4_soa & a, const float4_soa & b, float * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 16)
+				{
+					const Platform::uint32 left = count - i;
+					__m512 x, y, z;
+
+					x = _mm512_mul_ps(load_stream(a.x + i, left), load_stream(b.x + i, left));
+					y = _mm512_mul_ps(load_stream(a.y + i, left), load_stream(b.y + i, left));
+					z = _mm512_mul_ps(load_stream(a.z + i, left), load_stream(b.z + i, left));
+
+					store_stream(res + i, _mm512_add_ps(_mm512_add_ps(x, y), z), left);
+				}
+			}
+
+			void Cross(const float4_soa & a, const float4_soa & b, const float4_soa & res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 16)
+				{
+					const Platform::uint32 left = count - i;
+					const __m512 a_x = load_stream(a.x + i, left);
+					const __m512 a_y = load_stream(a.y + i, left);
+					const __m512 a_z = load_stream(a.z + i, left);
+					const __m512 b_x = load_stream(b.x + i, left);
+					const __m512 b_y = load_stream(b.y + i, left);
+					const __m512 b_z = load_stream(b.z + i, left);
+
+					store_stream(res.x + i, _mm512_sub_ps(_mm512_mul_ps(a_y, b_z), _mm512_mul_ps(a_z, b_y)), left);
+					store_stream(res.y + i, _mm512_sub_ps(_mm512_mul_ps(a_z, b_x), _mm512_mul_ps(a_x, b_z)), left);
+					store_stream(res.z + i, _mm512_sub_ps(_mm512_mul_ps(a_x, b_y), _mm512_mul_ps(a_y, b_x)), left);
+				}
+			}
+
+			void Rotate(const float4_soa & points, const float4_soa & quaternions, const float4_soa & res, Platform::uint32 count)
+			{
+				const __m512 two = _mm512_set1_ps(2.0f);
+
+				for (Platform::uint32 i = 0; i < count; i += 16)
+				{
+					const Platform::uint32 left = count - i;
+					const __m512 p_x = load_stream(points.x + i, left);
+					const __m512 p_y = load_stream(points.y + i, left);
+					const __m512 p_z = load_stream(points.z + i, left);
+					const __m512 q_x = load_stream(quaternions.x + i, left);
+					const __m512 q_y = load_stream(quaternions.y + i, left);
+					const __m512 q_z = load_stream(quaternions.z + i, left);
+					const __m512 q_w = load_stream(quaternions.w + i, left);
+
+					/* t = 2 * cross(q, p) */
+					const __m512 t_x = _mm512_mul_ps(two, _mm512_sub_ps(_mm512_mul_ps(q_y, p_z), _mm512_mul_ps(q_z, p_y)));
+					const __m512 t_y = _mm512_mul_ps(two, _mm512_sub_ps(_mm512_mul_ps(q_z, p_x), _mm512_mul_ps(q_x, p_z)));
+					const __m512 t_z = _mm512_mul_ps(two, _mm512_sub_ps(_mm512_mul_ps(q_x, p_y), _mm512_mul_ps(q_y, p_x)));
+
+					/* p + w * t + cross(q, t) */
+					store_stream(res.x + i, _mm512_add_ps(_mm512_add_ps(p_x, _mm512_mul_ps(q_w, t_x)), _mm512_sub_ps(_mm512_mul_ps(q_y, t_z), _mm512_mul_ps(q_z, t_y))), left);
+					store_stream(res.y + i, _mm512_add_ps(_mm512_add_ps(p_y, _mm512_mul_ps(q_w, t_y)), _mm512_sub_ps(_mm512_mul_ps(q_z, t_x), _mm512_mul_ps(q_x, t_z))), left);
+					store_stream(res.z + i, _mm512_add_ps(_mm512_add_ps(p_z, _mm512_mul_ps(q_w, t_z)), _mm512_sub_ps(_mm512_mul_ps(q_x, t_y), _mm512_mul_ps(q_y, t_x))), left);
+				}
+			}
+
+			void Transform_points(const float12 & matrix, const float4_soa & points, const float4_soa & res, Platform::uint32 count)
+			{
+				const __m512 m_xx = _mm512_set1_ps(matrix.xx);
+				const __m512 m_xy = _mm512_set1_ps(matrix.xy);
+				const __m512 m_xz = _mm512_set1_ps(matrix.xz);
+				const __m512 m_xw = _mm512_set1_ps(matrix.xw);
+				const __m512 m_yx = _mm512_set1_ps(matrix.yx);
+				const __m512 m_yy = _mm512_set1_ps(matrix.yy);
+				const __m512 m_yz = _mm512_set1_ps(matrix.yz);
+				const __m512 m_yw = _mm512_set1_ps(matrix.yw);
+				const __m512 m_zx = _mm512_set1_ps(matrix.zx);
+				const __m512 m_zy = _mm512_set1_ps(matrix.zy);
+				const __m512 m_zz = _mm512_set1_ps(matrix.zz);
+				const __m512 m_zw = _mm512_set1_ps(matrix.zw);
+
+				for (Platform::uint32 i = 0; i < count; i += 16)
+				{
+					const Platform::uint32 left = count - i;
+					const __m512 p_x = load_stream(points.x + i, left);
+					const __m512 p_y = load_stream(points.y + i, left);
+					const __m512 p_z = load_stream(points.z + i, left);
+					__m512 x, y, z;
+
+					x = _mm512_add_ps(_mm512_mul_ps(m_xx, p_x), _mm512_mul_ps(m_xy, p_y));
+					y = _mm512_add_ps(_mm512_mul_ps(m_yx, p_x), _mm512_mul_ps(m_yy, p_y));
+					z = _mm512_add_ps(_mm512_mul_ps(m_zx, p_x), _mm512_mul_ps(m_zy, p_y));
+
+					x = _mm512_add_ps(_mm512_add_ps(x, _mm512_mul_ps(m_xz, p_z)), m_xw);
+					y = _mm512_add_ps(_mm512_add_ps(y, _mm512_mul_ps(m_yz, p_z)), m_yw);
+					z = _mm512_add_ps(_mm512_add_ps(z, _mm512_mul_ps(m_zz, p_z)), m_zw);
+
+					store_stream(res.x + i, x, left);
+					store_stream(res.y + i, y, left);
+					store_stream(res.z + i, z, left);
+				}
+			}
+
+			/* Transposition of 4x4 block, done in every 128 bit lane */
+			static inline void transpose_rows(__m512 & r0, __m512 & r1, __m512 & r2, __m512 & r3)
+			{
+				const __m512 t0 = _mm512_unpacklo_ps(r0, r1);
+				const __m512 t1 = _mm512_unpacklo_ps(r2, r3);
+				const __m512 t2 = _mm512_unpackhi_ps(r0, r1);
+				const __m512 t3 = _mm512_unpackhi_ps(r2, r3);
+
+				r0 = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(1,0,1,0));
+				r1 = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(3,2,3,2));
+				r2 = _mm512_shuffle_ps(t2, t3, _MM_SHUFFLE(1,0,1,0));
+				r3 = _mm512_shuffle_ps(t2, t3, _MM_SHUFFLE(3,2,3,2));
+			}
+
+			/* Sum is stored in every element */
+			static inline __m512 sum_elements(__m512 value)
+			{
+				value = _mm512_add_ps(_mm512_permute_ps(value, _MM_SHUFFLE(1,0,3,2)), value);
+
+				return _mm512_add_ps(_mm512_permute_ps(value, _MM_SHUFFLE(2,3,0,1)), value);
+			}
+
+			static inline __m512 cross_rows(__m512 a, __m512 b)
+			{
+				const __m512 a_yzx = _mm512_permute_ps(a, _MM_SHUFFLE(3,0,2,1));
+				const __m512 a_zxy = _mm512_permute_ps(a, _MM_SHUFFLE(3,1,0,2));
+				const __m512 b_yzx = _mm512_permute_ps(b, _MM_SHUFFLE(3,0,2,1));
+				const __m512 b_zxy = _mm512_permute_ps(b, _MM_SHUFFLE(3,1,0,2));
+
+				return _mm512_sub_ps(_mm512_mul_ps(a_yzx, b_zxy), _mm512_mul_ps(a_zxy, b_yzx));
+			}
+
+			/* Cramer's rule, rows are replaced with rows of inverse, determinant is returned in every element */
+			static inline __m512 inverse_rows(__m512 & r0, __m512 & r1, __m512 & r2, __m512 & r3)
+			{
+				__m512 row0, row1, row2, row3;
+				__m512 minor0, minor1, minor2, minor3;
+				__m512 det, temp;
+
+				/* Columns, second and fourth are rotated by two elements */
+				temp = _mm512_shuffle_ps(r0, r1, _MM_SHUFFLE(1,0,1,0));
+				row1 = _mm512_shuffle_ps(r2, r3, _MM_SHUFFLE(1,0,1,0));
+				row0 = _mm512_shuffle_ps(temp, row1, _MM_SHUFFLE(2,0,2,0));
+				row1 = _mm512_shuffle_ps(row1, temp, _MM_SHUFFLE(3,1,3,1));
+				temp = _mm512_shuffle_ps(r0, r1, _MM_SHUFFLE(3,2,3,2));
+				row3 = _mm512_shuffle_ps(r2, r3, _MM_SHUFFLE(3,2,3,2));
+				row2 = _mm512_shuffle_ps(temp, row3, _MM_SHUFFLE(2,0,2,0));
+				row3 = _mm512_shuffle_ps(row3, temp, _MM_SHUFFLE(3,1,3,1));
+
+				temp = _mm512_mul_ps(row2, row3);
+				temp = _mm512_permute_ps(temp, _MM_SHUFFLE(2,3,0,1));
+				minor0 = _mm512_mul_ps(row1, temp);
+				minor1 = _mm512_mul_ps(row0, temp);
+				temp = _mm512_permute_ps(temp, _MM_SHUFFLE(1,0,3,2));
+				minor0 = _mm512_sub_ps(_mm512_mul_ps(row1, temp), minor0);
+				minor1 = _mm512_sub_ps(_mm512_mul_ps(row0, temp), minor1);
+				minor1 = _mm512_permute_ps(minor1, _MM_SHUFFLE(1,0,3,2));
+
+				temp = _mm512_mul_ps(row1, row2);
+				temp = _mm512_permute_ps(temp, _MM_SHUFFLE(2,3,0,1));
+				minor0 = _mm512_add_ps(_mm512_mul_ps(row3, temp), minor0);
+				minor3 = _mm512_mul_ps(row0, temp);
+				temp = _mm512_permute_ps(temp, _MM_SHUFFLE(1,0,3,2));
+				minor0 = _mm512_sub_ps(minor0, _mm512_mul_ps(row3, temp));
+				minor3 = _mm512_sub_ps(_mm512_mul_ps(row0, temp), minor3);
+				minor3 = _mm512_permute_ps(minor3, _MM_SHUFFLE(1,0,3,2));
+
+				temp = _mm512_mul_ps(_mm512_permute_ps(row1, _MM_SHUFFLE(1,0,3,2)), row3);
+				temp = _mm512_permute_ps(temp, _MM_SHUFFLE(2,3,0,1));
+				row2 = _mm512_permute_ps(row2, _MM_SHUFFLE(1,0,3,2));
+				minor0 = _mm512_add_ps(_mm512_mul_ps(row2, temp), minor0);
+				minor2 = _mm512_mul_ps(row0, temp);
+				temp = _mm512_permute_ps(temp, _MM_SHUFFLE(1,0,3,2));
+				minor0 = _mm512_sub_ps(minor0, _mm512_mul_ps(row2, temp));
+				minor2 = _mm512_sub_ps(_mm512_mul_ps(row0, temp), minor2);
+				minor2 = _mm512_permute_ps(minor2, _MM_SHUFFLE(1,0,3,2));
+
+				temp = _mm512_mul_ps(row0, row1);
+				temp = _mm512_permute_ps(temp, _MM_SHUFFLE(2,3,0,1));
+				minor2 = _mm512_add_ps(_mm512_mul_ps(row3, temp), minor2);
+				minor3 = _mm512_sub_ps(_mm512_mul_ps(row2, temp), minor3);
+				temp = _mm512_permute_ps(temp, _MM_SHUFFLE(1,0,3,2));
+				minor2 = _mm512_sub_ps(_mm512_mul_ps(row3, temp), minor2);
+				minor3 = _mm512_sub_ps(minor3, _mm512_mul_ps(row2, temp));
+
+				temp = _mm512_mul_ps(row0, row3);
+				temp = _mm512_permute_ps(temp, _MM_SHUFFLE(2,3,0,1));
+				minor1 = _mm512_sub_ps(minor1, _mm512_mul_ps(row2, temp));
+				minor2 = _mm512_add_ps(_mm512_mul_ps(row1, temp), minor2);
+				temp = _mm512_permute_ps(temp, _MM_SHUFFLE(1,0,3,2));
+				minor1 = _mm512_add_ps(_mm512_mul_ps(row2, temp), minor1);
+				minor2 = _mm512_sub_ps(minor2, _mm512_mul_ps(row1, temp));
+
+				temp = _mm512_mul_ps(row0, row2);
+				temp = _mm512_permute_ps(temp, _MM_SHUFFLE(2,3,0,1));
+				minor1 = _mm512_add_ps(_mm512_mul_ps(row3, temp), minor1);
+				minor3 = _mm512_sub_ps(minor3, _mm512_mul_ps(row1, temp));
+				temp = _mm512_permute_ps(temp, _MM_SHUFFLE(1,0,3,2));
+				minor1 = _mm512_sub_ps(minor1, _mm512_mul_ps(row3, temp));
+				minor3 = _mm512_add_ps(_mm512_mul_ps(row1, temp), minor3);
+
+				/* Exact division, results do not depend on instruction set */
+				det = sum_elements(_mm512_mul_ps(row0, minor0));
+				temp = _mm512_div_ps(_mm512_set1_ps(1.0f), det);
+
+				r0 = _mm512_mul_ps(minor0, temp);
+				r1 = _mm512_mul_ps(minor1, temp);
+				r2 = _mm512_mul_ps(minor2, temp);
+				r3 = _mm512_mul_ps(minor3, temp);
+
+				return det;
+			}
+
+			/* Columns of inverse of rotation part are cross products of rows divided by determinant */
+			static inline __m512 affine_inverse_rows(__m512 & r0, __m512 & r1, __m512 & r2)
+			{
+				__m512 c0 = cross_rows(r1, r2);
+				__m512 c1 = cross_rows(r2, r0);
+				__m512 c2 = cross_rows(r0, r1);
+				__m512 translation;
+
+				const __m512 det = sum_elements(_mm512_mul_ps(r0, c0));
+				const __m512 inverse = _mm512_div_ps(_mm512_set1_ps(1.0f), det);
+
+				c0 = _mm512_mul_ps(c0, inverse);
+				c1 = _mm512_mul_ps(c1, inverse);
+				c2 = _mm512_mul_ps(c2, inverse);
+
+				/* -inverse * translation */
+				translation = _mm512_add_ps(_mm512_mul_ps(c0, _mm512_permute_ps(r0, _MM_SHUFFLE(3,3,3,3))), _mm512_mul_ps(c1, _mm512_permute_ps(r1, _MM_SHUFFLE(3,3,3,3))));
+				translation = _mm512_add_ps(translation, _mm512_mul_ps(c2, _mm512_permute_ps(r2, _MM_SHUFFLE(3,3,3,3))));
+				translation = _mm512_sub_ps(_mm512_setzero_ps(), translation);
+
+				transpose_rows(c0, c1, c2, translation);
+
+				r0 = c0;
+				r1 = c1;
+				r2 = c2;
+
+				return det;
+			}
+
+			/* Rotation part is transposed */
+			static inline void rigid_inverse_rows(__m512 & r0, __m512 & r1, __m512 & r2)
+			{
+				__m512 translation;
+
+				/* -transposed * translation */
+				translation = _mm512_add_ps(_mm512_mul_ps(r0, _mm512_permute_ps(r0, _MM_SHUFFLE(3,3,3,3))), _mm512_mul_ps(r1, _mm512_permute_ps(r1, _MM_SHUFFLE(3,3,3,3))));
+				translation = _mm512_add_ps(translation, _mm512_mul_ps(r2, _mm512_permute_ps(r2, _MM_SHUFFLE(3,3,3,3))));
+				translation = _mm512_sub_ps(_mm512_setzero_ps(), translation);
+
+				transpose_rows(r0, r1, r2, translation);
+			}
+
+			static inline __m512 determinant_rows(__m512 r0, __m512 r1, __m512 r2)
+			{
+				return sum_elements(_mm512_mul_ps(r0, cross_rows(r1, r2)));
+			}
+
+			/* Swaps 128 bit blocks, n-th row of k-th matrix becomes k-th block of n-th register */
+			static inline void transpose_blocks(__m512 & m0, __m512 & m1, __m512 & m2, __m512 & m3)
+			{
+				const __m512 t0 = _mm512_shuffle_f32x4(m0, m1, _MM_SHUFFLE(1,0,1,0));
+				const __m512 t1 = _mm512_shuffle_f32x4(m2, m3, _MM_SHUFFLE(1,0,1,0));
+				const __m512 t2 = _mm512_shuffle_f32x4(m0, m1, _MM_SHUFFLE(3,2,3,2));
+				const __m512 t3 = _mm512_shuffle_f32x4(m2, m3, _MM_SHUFFLE(3,2,3,2));
+
+				m0 = _mm512_shuffle_f32x4(t0, t1, _MM_SHUFFLE(2,0,2,0));
+				m1 = _mm512_shuffle_f32x4(t0, t1, _MM_SHUFFLE(3,1,3,1));
+				m2 = _mm512_shuffle_f32x4(t2, t3, _MM_SHUFFLE(2,0,2,0));
+				m3 = _mm512_shuffle_f32x4(t2, t3, _MM_SHUFFLE(3,1,3,1));
+			}
+
+			/* Up to four matrices, missing ones are zero */
+			static inline void load_matrices(const float * data, Platform::uint32 stride, Platform::uint32 count, __m512 & r0, __m512 & r1, __m512 & r2, __m512 & r3)
+			{
+				const __mmask16 mask = (16 == stride) ? 0xffff : UTILITIES_MATH_SIMD_FLOAT12_MASK;
+
+				r0 = _mm512_maskz_loadu_ps(mask, data);
+				r1 = (1 < count) ? _mm512_maskz_loadu_ps(mask, data + stride) : _mm512_setzero_ps();
+				r2 = (2 < count) ? _mm512_maskz_loadu_ps(mask, data + 2 * stride) : _mm512_setzero_ps();
+				r3 = (3 < count) ? _mm512_maskz_loadu_ps(mask, data + 3 * stride) : _mm512_setzero_ps();
+
+				transpose_blocks(r0, r1, r2, r3);
+			}
+
+			static inline void store_matrices(float * data, Platform::uint32 stride, Platform::uint32 count, __m512 r0, __m512 r1, __m512 r2, __m512 r3)
+			{
+				const __mmask16 mask = (16 == stride) ? 0xffff : UTILITIES_MATH_SIMD_FLOAT12_MASK;
+
+				transpose_blocks(r0, r1, r2, r3);
+
+				_mm512_mask_storeu_ps(data, mask, r0);
+
+				if (1 < count)
+				{
+					_mm512_mask_storeu_ps(data + stride, mask, r1);
+				}
+
+				if (2 < count)
+				{
+					_mm512_mask_storeu_ps(data + 2 * stride, mask, r2);
+				}
+
+				if (3 < count)
+				{
+					_mm512_mask_storeu_ps(data + 3 * stride, mask, r3);
+				}
+			}
+
+			/* First element of each block */
+			static inline void store_determinants(float * res, __m512 det, Platform::uint32 count)
+			{
+				const __m512i index = _mm512_setr_epi32(0, 4, 8, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+				const __mmask16 mask = __mmask16((1u << count) - 1);
+
+				_mm512_mask_storeu_ps(res, mask, _mm512_permutexvar_ps(index, det));
+			}
+
+			static inline Platform::uint32 left_matrices(Platform::uint32 i, Platform::uint32 count)
+			{
+				return (i + 4 <= count) ? 4 : (count - i);
+			}
+
+			void Inverse(const float16 * a, float16 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 4)
+				{
+					const Platform::uint32 left = left_matrices(i, count);
+					__m512 r0, r1, r2, r3;
+
+					load_matrices(a[i].f, 16, left, r0, r1, r2, r3);
+					inverse_rows(r0, r1, r2, r3);
+					store_matrices(res[i].f, 16, left, r0, r1, r2, r3);
+				}
+			}
+
+			void Inverse(const float12 * a, float12 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 4)
+				{
+					const Platform::uint32 left = left_matrices(i, count);
+					__m512 r0, r1, r2, r3;
+
+					load_matrices(a[i].f, 12, left, r0, r1, r2, r3);
+					affine_inverse_rows(r0, r1, r2);
+					store_matrices(res[i].f, 12, left, r0, r1, r2, r3);
+				}
+			}
+
+			void Inverse_rigid(const float12 * a, float12 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 4)
+				{
+					const Platform::uint32 left = left_matrices(i, count);
+					__m512 r0, r1, r2, r3;
+
+					load_matrices(a[i].f, 12, left, r0, r1, r2, r3);
+					rigid_inverse_rows(r0, r1, r2);
+					store_matrices(res[i].f, 12, left, r0, r1, r2, r3);
+				}
+			}
+
+			void Determinant(const float16 * a, float * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 4)
+				{
+					const Platform::uint32 left = left_matrices(i, count);
+					__m512 r0, r1, r2, r3;
+
+					load_matrices(a[i].f, 16, left, r0, r1, r2, r3);
+					store_determinants(res + i, inverse_rows(r0, r1, r2, r3), left);
+				}
+			}
+
+			void Determinant(const float12 * a, float * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 4)
+				{
+					const Platform::uint32 left = left_matrices(i, count);
+					__m512 r0, r1, r2, r3;
+
+					load_matrices(a[i].f, 12, left, r0, r1, r2, r3);
+					store_determinants(res + i, determinant_rows(r0, r1, r2), left);
+				}
+			}
+
+			/* Polynomials of Quaternion::FastAcos and Quaternion::FastSin */
+			static inline __m512 fast_acos(__m512 x)
+			{
+				__m512 res = _mm512_set1_ps(-0.0012624911f);
+
+				res = _mm512_add_ps(_mm512_mul_ps(res, x), _mm512_set1_ps(0.0066700901f));
+				res = _mm512_add_ps(_mm512_mul_ps(res, x), _mm512_set1_ps(-0.0170881256f));
+				res = _mm512_add_ps(_mm512_mul_ps(res, x), _mm512_set1_ps(0.0308918810f));
+				res = _mm512_add_ps(_mm512_mul_ps(res, x), _mm512_set1_ps(-0.0501743046f));
+				res = _mm512_add_ps(_mm512_mul_ps(res, x), _mm512_set1_ps(0.0889789874f));
+				res = _mm512_add_ps(_mm512_mul_ps(res, x), _mm512_set1_ps(-0.2145988016f));
+				res = _mm512_add_ps(_mm512_mul_ps(res, x), _mm512_set1_ps(1.5707963050f));
+
+				return _mm512_mul_ps(_mm512_sqrt_ps(_mm512_sub_ps(_mm512_set1_ps(1.0f), x)), res);
+			}
+
+			static inline __m512 fast_sin(__m512 x)
+			{
+				const __m512 x2 = _mm512_mul_ps(x, x);
+				__m512 res = _mm512_set1_ps(-2.5052108e-8f);
+
+				res = _mm512_add_ps(_mm512_mul_ps(res, x2), _mm512_set1_ps(2.7557319e-6f));
+				res = _mm512_add_ps(_mm512_mul_ps(res, x2), _mm512_set1_ps(-1.9841270e-4f));
+				res = _mm512_add_ps(_mm512_mul_ps(res, x2), _mm512_set1_ps(8.3333333e-3f));
+				res = _mm512_add_ps(_mm512_mul_ps(res, x2), _mm512_set1_ps(-1.6666667e-1f));
+				res = _mm512_add_ps(_mm512_mul_ps(res, x2), _mm512_set1_ps(1.0f));
+
+				return _mm512_mul_ps(res, x);
+			}
+
+			/* Quaternion::Slerp on streams, first quaternion is replaced with result */
+			static inline void slerp_lanes(__m512 & x, __m512 & y, __m512 & z, __m512 & w, __m512 b_x, __m512 b_y, __m512 b_z, __m512 b_w, __m512 percent)
+			{
+				const __m512 one = _mm512_set1_ps(1.0f);
+				const __m512 rest = _mm512_sub_ps(one, percent);
+				__m512 cosine, sign, angle, sine, weight_a, weight_b, length;
+
+				cosine = _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(x, b_x), _mm512_mul_ps(y, b_y)), _mm512_mul_ps(z, b_z)), _mm512_mul_ps(w, b_w));
+
+				/* Shortest path */
+				sign = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(cosine, _mm512_setzero_ps(), _CMP_LT_OQ), one, _mm512_set1_ps(-1.0f));
+				b_x = _mm512_mul_ps(b_x, sign);
+				b_y = _mm512_mul_ps(b_y, sign);
+				b_z = _mm512_mul_ps(b_z, sign);
+				b_w = _mm512_mul_ps(b_w, sign);
+				cosine = _mm512_mul_ps(cosine, sign);
+
+				angle = fast_acos(cosine);
+				sine = _mm512_sqrt_ps(_mm512_sub_ps(one, _mm512_mul_ps(cosine, cosine)));
+				weight_a = _mm512_div_ps(fast_sin(_mm512_mul_ps(rest, angle)), sine);
+				weight_b = _mm512_div_ps(fast_sin(_mm512_mul_ps(percent, angle)), sine);
+
+				/* Linear interpolation when quaternions are almost the same */
+				const __mmask16 is_near = _mm512_cmp_ps_mask(_mm512_set1_ps(0.9995f), cosine, _CMP_LT_OQ);
+				weight_a = _mm512_mask_blend_ps(is_near, weight_a, rest);
+				weight_b = _mm512_mask_blend_ps(is_near, weight_b, percent);
+
+				x = _mm512_add_ps(_mm512_mul_ps(x, weight_a), _mm512_mul_ps(b_x, weight_b));
+				y = _mm512_add_ps(_mm512_mul_ps(y, weight_a), _mm512_mul_ps(b_y, weight_b));
+				z = _mm512_add_ps(_mm512_mul_ps(z, weight_a), _mm512_mul_ps(b_z, weight_b));
+				w = _mm512_add_ps(_mm512_mul_ps(w, weight_a), _mm512_mul_ps(b_w, weight_b));
+
+				length = _mm512_sqrt_ps(_mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(x, x), _mm512_mul_ps(y, y)), _mm512_mul_ps(z, z)), _mm512_mul_ps(w, w)));
+				x = _mm512_div_ps(x, length);
+				y = _mm512_div_ps(y, length);
+				z = _mm512_div_ps(z, length);
+				w = _mm512_div_ps(w, length);
+			}
+
+			/* Matrix::RotationFromQuaternion on streams, rows are transposed back, in every 128 bit lane n-th register holds rows of n-th quaternion */
+			static inline void rotation_rows(__m512 x, __m512 y, __m512 z, __m512 w, __m512 * r_x, __m512 * r_y, __m512 * r_z)
+			{
+				const __m512 two = _mm512_set1_ps(2.0f);
+				const __m512 ww = _mm512_mul_ps(w, w);
+				const __m512 xx = _mm512_mul_ps(x, x);
+				const __m512 yy = _mm512_mul_ps(y, y);
+				const __m512 zz = _mm512_mul_ps(z, z);
+
+				const __m512 xy2 = _mm512_mul_ps(_mm512_mul_ps(x, y), two);
+				const __m512 xz2 = _mm512_mul_ps(_mm512_mul_ps(x, z), two);
+				const __m512 xw2 = _mm512_mul_ps(_mm512_mul_ps(x, w), two);
+				const __m512 yz2 = _mm512_mul_ps(_mm512_mul_ps(y, z), two);
+				const __m512 yw2 = _mm512_mul_ps(_mm512_mul_ps(y, w), two);
+				const __m512 zw2 = _mm512_mul_ps(_mm512_mul_ps(z, w), two);
+
+				r_x[0] = _mm512_sub_ps(_mm512_sub_ps(_mm512_add_ps(ww, xx), yy), zz);
+				r_x[1] = _mm512_add_ps(xy2, zw2);
+				r_x[2] = _mm512_sub_ps(xz2, yw2);
+				r_x[3] = _mm512_setzero_ps();
+
+				r_y[0] = _mm512_sub_ps(xy2, zw2);
+				r_y[1] = _mm512_sub_ps(_mm512_add_ps(_mm512_sub_ps(ww, xx), yy), zz);
+				r_y[2] = _mm512_add_ps(yz2, xw2);
+				r_y[3] = _mm512_setzero_ps();
+
+				r_z[0] = _mm512_add_ps(xz2, yw2);
+				r_z[1] = _mm512_sub_ps(yz2, xw2);
+				r_z[2] = _mm512_add_ps(_mm512_sub_ps(_mm512_sub_ps(ww, xx), yy), zz);
+				r_z[3] = _mm512_setzero_ps();
+
+				transpose_rows(r_x[0], r_x[1], r_x[2], r_x[3]);
+				transpose_rows(r_y[0], r_y[1], r_y[2], r_y[3]);
+				transpose_rows(r_z[0], r_z[1], r_z[2], r_z[3]);
+			}
+
+			/* Up to sixteen quaternions, missing ones are identity */
+			static inline void load_quaternions(const float4 * data, Platform::uint32 count, __m512 & x, __m512 & y, __m512 & z, __m512 & w)
+			{
+				const __m512 identity = _mm512_broadcast_f32x4(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+				__m512 rows[4];
+
+				for (Platform::uint32 n = 0; n < 4; ++n)
+				{
+					const Platform::uint32 left = (4 * n < count) ? (count - 4 * n) : 0;
+
+					rows[n] = _mm512_mask_loadu_ps(identity, vectors_mask((4 < left) ? 4 : left), &data[4 * n]);
+				}
+
+				/* n-th register holds quaternions 4 * k + n, then 4 * k + n-th elements are transposed */
+				transpose_blocks(rows[0], rows[1], rows[2], rows[3]);
+				transpose_rows(rows[0], rows[1], rows[2], rows[3]);
+
+				x = rows[0];
+				y = rows[1];
+				z = rows[2];
+				w = rows[3];
+			}
+
+			static inline void store_quaternions(float4 * data, Platform::uint32 count, __m512 x, __m512 y, __m512 z, __m512 w)
+			{
+				__m512 rows[4] = { x, y, z, w };
+
+				transpose_rows(rows[0], rows[1], rows[2], rows[3]);
+				transpose_blocks(rows[0], rows[1], rows[2], rows[3]);
+
+				for (Platform::uint32 n = 0; 4 * n < count; ++n)
+				{
+					const Platform::uint32 left = count - 4 * n;
+
+					store(&data[4 * n], rows[n], vectors_mask((4 < left) ? 4 : left));
+				}
+			}
+
+			static inline Platform::uint32 left_quaternions(Platform::uint32 i, Platform::uint32 count)
+			{
+				return (i + 16 <= count) ? 16 : (count - i);
+			}
+
+			void Slerp(const float4 * a, const float4 * b, const float * percent, float4 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 16)
+				{
+					const Platform::uint32 left = left_quaternions(i, count);
+					__m512 x, y, z, w;
+					__m512 b_x, b_y, b_z, b_w;
+
+					load_quaternions(&a[i], left, x, y, z, w);
+					load_quaternions(&b[i], left, b_x, b_y, b_z, b_w);
+					slerp_lanes(x, y, z, w, b_x, b_y, b_z, b_w, load_stream(percent + i, left));
+					store_quaternions(&res[i], left, x, y, z, w);
+				}
+			}
+
+			void Rotation_from_quaternion(const float4 * quaternions, float12 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 16)
+				{
+					const Platform::uint32 left = left_quaternions(i, count);
+					__m512 x, y, z, w;
+					__m512 r_x[4], r_y[4], r_z[4];
+
+					load_quaternions(&quaternions[i], left, x, y, z, w);
+					rotation_rows(x, y, z, w, r_x, r_y, r_z);
+
+					for (Platform::uint32 n = 0; n < 4; ++n)
+					{
+						/* k-th register holds matrix of quaternion 4 * k + n */
+						__m512 matrices[4] = { r_x[n], r_y[n], r_z[n], _mm512_setzero_ps() };
+
+						transpose_blocks(matrices[0], matrices[1], matrices[2], matrices[3]);
+
+						for (Platform::uint32 k = 0; 4 * k + n < left; ++k)
+						{
+							_mm512_mask_storeu_ps(res[i + 4 * k + n].f, float12_mask, matrices[k]);
+						}
+					}
+				}
+			}
+
+			/* Linear blend skinning, one vertex at once. W is 1 for points and 0 for vectors */
+			static inline void skin(
+				const float12 * bones,
+				const Platform::uint16 * indices,
+				const float * weights,
+				const float4_soa & source,
+				const float4_soa & res,
+				Platform::uint32 count,
+				float w)
+			{
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					const Platform::uint16 * index = indices + 4 * i;
+					const float * weight = weights + 4 * i;
+					const __m512 point = _mm512_broadcast_f32x4(_mm_setr_ps(source.x[i], source.y[i], source.z[i], w));
+					__m512 rows;
+
+					rows = _mm512_mul_ps(_mm512_maskz_loadu_ps(float12_mask, bones[index[0]].f), _mm512_set1_ps(weight[0]));
+
+					for (Platform::uint32 n = 1; n < 4; ++n)
+					{
+						rows = _mm512_add_ps(rows, _mm512_mul_ps(_mm512_maskz_loadu_ps(float12_mask, bones[index[n]].f), _mm512_set1_ps(weight[n])));
+					}
+
+					rows = sum_elements(_mm512_mul_ps(rows, point));
+
+					res.x[i] = _mm_cvtss_f32(_mm512_castps512_ps128(rows));
+					res.y[i] = _mm_cvtss_f32(_mm512_extractf32x4_ps(rows, 1));
+					res.z[i] = _mm_cvtss_f32(_mm512_extractf32x4_ps(rows, 2));
+				}
+			}
+
+			void Skin_points(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4_soa & points, const float4_soa & res, Platform::uint32 count)
+			{
+				skin(bones, indices, weights, points, res, count, 1.0f);
+			}
+
+			void Skin_vectors(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4_soa & vectors, const float4_soa & res, Platform::uint32 count)
+			{
+				skin(bones, indices, weights, vectors, res, count, 0.0f);
+			}
+
+			/* Indices of lanes set in mask are appended to visible, entry past the last one may be overwritten */
+			static inline Platform::uint32 append_visible(Platform::uint32 * visible, Platform::uint32 n_visible, Platform::uint32 i, Platform::uint32 mask, Platform::uint32 lanes)
+			{
+				for (Platform::uint32 lane = 0; lane < lanes; ++lane)
+				{
+					visible[n_visible] = i + lane;
+					n_visible += (mask >> lane) & 1u;
+				}
+
+				return n_visible;
+			}
+
+			static inline Platform::uint32 valid_lanes(Platform::uint32 count)
+			{
+				return (16 <= count) ? 0xffffu : ((1u << count) - 1u);
+			}
+
+			Platform::uint32 Cull_boxes(const frustum & planes, const aabb_soa & boxes, Platform::uint32 * visible, Platform::uint32 count)
+			{
+				Platform::uint32 n_visible = 0;
+
+				for (Platform::uint32 i = 0; i < count; i += 16)
+				{
+					const Platform::uint32 left = count - i;
+					const __m512 min_x = load_stream(boxes.min_x + i, left);
+					const __m512 min_y = load_stream(boxes.min_y + i, left);
+					const __m512 min_z = load_stream(boxes.min_z + i, left);
+					const __m512 max_x = load_stream(boxes.max_x + i, left);
+					const __m512 max_y = load_stream(boxes.max_y + i, left);
+					const __m512 max_z = load_stream(boxes.max_z + i, left);
+					Platform::uint32 mask = valid_lanes(left);
+
+					for (Platform::uint32 p = 0; (p < planes.count) && (0 != mask); ++p)
+					{
+						const __m512 p_x = _mm512_set1_ps(planes.x[p]);
+						const __m512 p_y = _mm512_set1_ps(planes.y[p]);
+						const __m512 p_z = _mm512_set1_ps(planes.z[p]);
+						__m512 distance;
+
+						distance = _mm512_add_ps(
+							_mm512_max_ps(_mm512_mul_ps(p_x, min_x), _mm512_mul_ps(p_x, max_x)),
+							_mm512_max_ps(_mm512_mul_ps(p_y, min_y), _mm512_mul_ps(p_y, max_y)));
+						distance = _mm512_add_ps(distance, _mm512_max_ps(_mm512_mul_ps(p_z, min_z), _mm512_mul_ps(p_z, max_z)));
+						distance = _mm512_add_ps(distance, _mm512_set1_ps(planes.w[p]));
+
+						mask &= Platform::uint32(_mm512_cmp_ps_mask(distance, _mm512_setzero_ps(), _CMP_GE_OQ));
+					}
+
+					n_visible = append_visible(visible, n_visible, i, mask, (16 <= left) ? 16 : left);
+				}
+
+				return n_visible;
+			}
+
+			Platform::uint32 Cull_spheres(const frustum & planes, const float4_soa & spheres, Platform::uint32 * visible, Platform::uint32 count)
+			{
+				Platform::uint32 n_visible = 0;
+
+				for (Platform::uint32 i = 0; i < count; i += 16)
+				{
+					const Platform::uint32 left = count - i;
+					const __m512 c_x = load_stream(spheres.x + i, left);
+					const __m512 c_y = load_stream(spheres.y + i, left);
+					const __m512 c_z = load_stream(spheres.z + i, left);
+					const __m512 radius = _mm512_sub_ps(_mm512_setzero_ps(), load_stream(spheres.w + i, left));
+					Platform::uint32 mask = valid_lanes(left);
+
+					for (Platform::uint32 p = 0; (p < planes.count) && (0 != mask); ++p)
+					{
+						__m512 distance;
+
+						distance = _mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(planes.x[p]), c_x), _mm512_mul_ps(_mm512_set1_ps(planes.y[p]), c_y));
+						distance = _mm512_add_ps(distance, _mm512_mul_ps(_mm512_set1_ps(planes.z[p]), c_z));
+						distance = _mm512_add_ps(distance, _mm512_set1_ps(planes.w[p]));
+
+						mask &= Platform::uint32(_mm512_cmp_ps_mask(distance, radius, _CMP_GE_OQ));
+					}
+
+					n_visible = append_visible(visible, n_visible, i, mask, (16 <= left) ? 16 : left);
+				}
+
+				return n_visible;
+			}
+		}
+	}
+}
@@ -0,0 +1,81 @@
+/** License
+ * 
+ * Copyright (c) 2015 Adam migielski
+ * 
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a 
+ *      copy of this software and associated documentation files (the 
+ *      "Software"), to deal in the Software without restriction, including 
+ *      without limitation the rights to use, copy, modify, merge, publish, 
+ *      distribute, sublicense, and/or sell copies of the Software, and to 
+ *      permit persons to whom the Software is furnished to do so, subject to 
+ *      the following conditions: The above copyright notice and this permission 
+ *      notice shall be included in all copies or substantial portions of the 
+ *      Software. 
+ *
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ *      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ *      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ *      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ *      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ *      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ *      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+ *
+ **/
+ 
+/**
+ * @author Adam migielski
+ * @file Kernels_f16c.cpp
+ **/
+
+#include "PCH.hpp"
+
+#include "HalfKernels.hpp"
+
+#include <immintrin.h>
+
+/* Eight values per instruction, last values are converted one by one */
+
+namespace Math
+{
+	namespace Kernels
+	{
+		namespace F16c
+		{
+			void Float_to_half(const float * source, Platform::uint16 * destination, Platform::uint32 count)
+			{
+				Platform::uint32 i = 0;
+
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m128i halves = _mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
+
+					_mm_storeu_si128((__m128i *) (destination + i), halves);
+				}
+
+				for (; i < count; ++i)
+				{
+					destination[i] = Platform::uint16(_cvtss_sh(source[i], _MM_FROUND_TO_NEAREST_INT));
+				}
+			}
+
+			void Half_to_float(const Platform::uint16 * source, float * destination, Platform::uint32 count)
+			{
+				Platform::uint32 i = 0;
+
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m128i halves = _mm_loadu_si128((const __m128i *) (source + i));
+
+					_mm256_storeu_ps(destination + i, _mm256_cvtph_ps(halves));
+				}
+
+				for (; i < count; ++i)
+				{
+					destination[i] = _cvtsh_ss(source[i]);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,1002 @@
+/** License
+ * 
+ * Copyright (c) 2015 Adam migielski
+ * 
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a 
+ *      copy of this software and associated documentation files (the 
+ *      "Software"), to deal in the Software without restriction, including 
+ *      without limitation the rights to use, copy, modify, merge, publish, 
+ *      distribute, sublicense, and/or sell copies of the Software, and to 
+ *      permit persons to whom the Software is furnished to do so, subject to 
+ *      the following conditions: The above copyright notice and this permission 
+ *      notice shall be included in all copies or substantial portions of the 
+ *      Software. 
+ *
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ *      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ *      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ *      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ *      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ *      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ *      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+ *
+ **/
+ 
+/**
+ * @author Adam migielski
+ * @file Kernels_sse.cpp
+ **/
+
+#include "PCH.hpp"
+
+#include "Kernels.hpp"
+
+#include <emmintrin.h>
+
+/* Operations are done in the same order as in Matrix.hpp, Quaternion.hpp and Float4.hpp */
+
+namespace Math
+{
+	namespace Kernels
+	{
+		namespace Sse
+		{
+			static inline __m128 multiply_row(
+				__m128 row,
+				__m128 b_x,
+				__m128 b_y,
+				__m128 b_z,
+				__m128 b_w)
+			{
+				__m128 x, y, z, w;
+
+				x = _mm_shuffle_ps(row, row, _MM_SHUFFLE(0,0,0,0));
+				y = _mm_shuffle_ps(row, row, _MM_SHUFFLE(1,1,1,1));
+				z = _mm_shuffle_ps(row, row, _MM_SHUFFLE(2,2,2,2));
+				w = _mm_shuffle_ps(row, row, _MM_SHUFFLE(3,3,3,3));
+
+				x = _mm_mul_ps(x, b_x);
+				y = _mm_mul_ps(y, b_y);
+				z = _mm_mul_ps(z, b_z);
+				w = _mm_mul_ps(w, b_w);
+
+				x = _mm_add_ps(x, y);
+				z = _mm_add_ps(z, w);
+
+				return _mm_add_ps(x, z);
+			}
+
+			static inline __m128 multiply_quaternion(__m128 a, __m128 b)
+			{
+				const __m128 helper_x = _mm_setr_ps(-1.0f, -1.0f, 1.0f, 1.0f);
+				const __m128 helper_y = _mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f);
+				const __m128 helper_z = _mm_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f);
+				__m128 res, temp;
+
+				temp = _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 0, 0));
+				temp = _mm_mul_ps(a, temp);
+				temp = _mm_mul_ps(helper_x, temp);
+				res  = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(0, 1, 2, 3));
+
+				temp = _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 1, 1));
+				temp = _mm_mul_ps(a, temp);
+				temp = _mm_mul_ps(helper_y, temp);
+				temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(1, 0, 3, 2));
+				res  = _mm_add_ps(res, temp);
+
+				temp = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 2, 2));
+				temp = _mm_mul_ps(a, temp);
+				temp = _mm_mul_ps(helper_z, temp);
+				temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2, 3, 0, 1));
+				res  = _mm_add_ps(res, temp);
+
+				temp = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3));
+				temp = _mm_mul_ps(a, temp);
+				res  = _mm_add_ps(res, temp);
+
+				return res;
+			}
+
+			void Multiply(const float16 * a, const float16 * b, float16 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					const __m128 b_x = b[i].x.m128;
+					const __m128 b_y = b[i].y.m128;
+					const __m128 b_z = b[i].z.m128;
+					const __m128 b_w = b[i].w.m128;
+					const __m128 a_x = a[i].x.m128;
+					const __m128 a_y = a[i].y.m128;
+					const __m128 a_z = a[i].z.m128;
+					const __m128 a_w = a[i].w.m128;
+
+					res[i].x.m128 = multiply_row(a_x, b_x, b_y, b_z, b_w);
+					res[i].y.m128 = multiply_row(a_y, b_x, b_y, b_z, b_w);
+					res[i].z.m128 = multiply_row(a_z, b_x, b_y, b_z, b_w);
+					res[i].w.m128 = multiply_row(a_w, b_x, b_y, b_z, b_w);
+				}
+			}
+
+			void Multiply(const float12 * a, const float12 * b, float12 * res, Platform::uint32 count)
+			{
+				const __m128 last = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					const __m128 b_x = b[i].x.m128;
+					const __m128 b_y = b[i].y.m128;
+					const __m128 b_z = b[i].z.m128;
+					const __m128 a_x = a[i].x.m128;
+					const __m128 a_y = a[i].y.m128;
+					const __m128 a_z = a[i].z.m128;
+
+					res[i].x.m128 = multiply_row(a_x, b_x, b_y, b_z, last);
+					res[i].y.m128 = multiply_row(a_y, b_x, b_y, b_z, last);
+					res[i].z.m128 = multiply_row(a_z, b_x, b_y, b_z, last);
+				}
+			}
+
+			void Rotate(const float4 * points, const float4 * quaternions, float4 * res, Platform::uint32 count)
+			{
+				const __m128 inverse_helper = _mm_setr_ps(-1.0f, -1.0f, -1.0f, 1.0f);
+				const __m128 point_mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					const __m128 quaternion = quaternions[i].m128;
+					const __m128 point = _mm_and_ps(points[i].m128, point_mask);
+					const __m128 inverse = _mm_mul_ps(quaternion, inverse_helper);
+
+					res[i].m128 = multiply_quaternion(multiply_quaternion(quaternion, point), inverse);
+				}
+			}
+
+			void Normalise(const float4 * a, float4 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					const __m128 value = a[i].m128;
+					__m128 sum, temp;
+
+					sum  = _mm_mul_ps(value, value);
+
+					temp = _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(3, 3, 1, 1));
+					sum  = _mm_add_ps(sum, temp);
+
+					temp = _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(3, 3, 3, 2));
+					sum  = _mm_add_ps(sum, temp);
+
+					temp = _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(0, 0, 0, 0));
+					temp = _mm_rsqrt_ps(temp);
+
+					res[i].m128 = _mm_mul_ps(value, temp);
+				}
+			}
+
+			void Lerp(const float4 * a, const float4 * b, const float4 * percent, float4 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					const __m128 delta = _mm_sub_ps(b[i].m128, a[i].m128);
+
+					res[i].m128 = _mm_add_ps(a[i].m128, _mm_mul_ps(delta, percent[i].m128));
+				}
+			}
+
+			/* Streams are processed 4 elements at once, last elements go through temporary buffer */
+			static inline __m128 load_stream(const float * data, Platform::uint32 count)
+			{
+				if (4 <= count)
+				{
+					return _mm_loadu_ps(data);
+				}
+
+				float temp[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					temp[i] = data[i];
+				}
+
+				return _mm_loadu_ps(temp);
+			}
+
+			static inline void store_stream(float * data, __m128 value, Platform::uint32 count)
+			{
+				if (4 <= count)
+				{
+					_mm_storeu_ps(data, value);
+					return;
+				}
+
+				float temp[4];
+
+				_mm_storeu_ps(temp, value);
+
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					data[i] = temp[i];
+				}
+			}
+
+			void Dot(const float4_soa & a, const float4_soa & b, float * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 4)
+				{
+					const Platform::uint32 left = count - i;
+					__m128 x, y, z;
+
+					x = _mm_mul_ps(load_stream(a.x + i, left), load_stream(b.x + i, left));
+					y = _mm_mul_ps(load_stream(a.y + i, left), load_stream(b.y + i, left));
+					z = _mm_mul_ps(load_stream(a.z + i, left), load_stream(b.z + i, left));
+
+					store_stream(res + i, _mm_add_ps(_mm_add_ps(x, y), z), left);
+				}
+			}
+
+			void Cross(const float4_soa & a, const float4_soa & b, const float4_soa & res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 4)
+				{
+					const Platform::uint32 left = count - i;
+					const __m128 a_x = load_stream(a.x + i, left);
+					const __m128 a_y = load_stream(a.y + i, left);
+					const __m128 a_z = load_stream(a.z + i, left);
+					const __m128 b_x = load_stream(b.x + i, left);
+					const __m128 b_y = load_stream(b.y + i, left);
+					const __m128 b_z = load_stream(b.z + i, left);
+
+					store_stream(res.x + i, _mm_sub_ps(_mm_mul_ps(a_y, b_z), _mm_mul_ps(a_z, b_y)), left);
+					store_stream(res.y + i, _mm_sub_ps(_mm_mul_ps(a_z, b_x), _mm_mul_ps(a_x, b_z)), left);
+					store_stream(res.z + i, _mm_sub_ps(_mm_mul_ps(a_x, b_y), _mm_mul_ps(a_y, b_x)), left);
+				}
+			}
+
+			void Rotate(const float4_soa & points, const float4_soa & quaternions, const float4_soa & res, Platform::uint32 count)
+			{
+				const __m128 two = _mm_set1_ps(2.0f);
+
+				for (Platform::uint32 i = 0; i < count; i += 4)
+				{
+					const Platform::uint32 left = count - i;
+					const __m128 p_x = load_stream(points.x + i, left);
+					const __m128 p_y = load_stream(points.y + i, left);
+					const __m128 p_z = load_stream(points.z + i, left);
+					const __m128 q_x = load_stream(quaternions.x + i, left);
+					const __m128 q_y = load_stream(quaternions.y + i, left);
+					const __m128 q_z = load_stream(quaternions.z + i, left);
+					const __m128 q_w = load_stream(quaternions.w + i, left);
+
+					/* t = 2 * cross(q, p) */
+					const __m128 t_x = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(q_y, p_z), _mm_mul_ps(q_z, p_y)));
+					const __m128 t_y = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(q_z, p_x), _mm_mul_ps(q_x, p_z)));
+					const __m128 t_z = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(q_x, p_y), _mm_mul_ps(q_y, p_x)));
+
+					/* p + w * t + cross(q, t) */
+					store_stream(res.x + i, _mm_add_ps(_mm_add_ps(p_x, _mm_mul_ps(q_w, t_x)), _mm_sub_ps(_mm_mul_ps(q_y, t_z), _mm_mul_ps(q_z, t_y))), left);
+					store_stream(res.y + i, _mm_add_ps(_mm_add_ps(p_y, _mm_mul_ps(q_w, t_y)), _mm_sub_ps(_mm_mul_ps(q_z, t_x), _mm_mul_ps(q_x, t_z))), left);
+					store_stream(res.z + i, _mm_add_ps(_mm_add_ps(p_z, _mm_mul_ps(q_w, t_z)), _mm_sub_ps(_mm_mul_ps(q_x, t_y), _mm_mul_ps(q_y, t_x))), left);
+				}
+			}
+
+			void Transform_points(const float12 & matrix, const float4_soa & points, const float4_soa & res, Platform::uint32 count)
+			{
+				const __m128 m_xx = _mm_set1_ps(matrix.xx);
+				const __m128 m_xy = _mm_set1_ps(matrix.xy);
+				const __m128 m_xz = _mm_set1_ps(matrix.xz);
+				const __m128 m_xw = _mm_set1_ps(matrix.xw);
+				const __m128 m_yx = _mm_set1_ps(matrix.yx);
+				const __m128 m_yy = _mm_set1_ps(matrix.yy);
+				const __m128 m_yz = _mm_set1_ps(matrix.yz);
+				const __m128 m_yw = _mm_set1_ps(matrix.yw);
+				const __m128 m_zx = _mm_set1_ps(matrix.zx);
+				const __m128 m_zy = _mm_set1_ps(matrix.zy);
+				const __m128 m_zz = _mm_set1_ps(matrix.zz);
+				const __m128 m_zw = _mm_set1_ps(matrix.zw);
+
+				for (Platform::uint32 i = 0; i < count; i += 4)
+				{
+					const Platform::uint32 left = count - i;
+					const __m128 p_x = load_stream(points.x + i, left);
+					const __m128 p_y = load_stream(points.y + i, left);
+					const __m128 p_z = load_stream(points.z + i, left);
+					__m128 x, y, z;
+
+					x = _mm_add_ps(_mm_mul_ps(m_xx, p_x), _mm_mul_ps(m_xy, p_y));
+					y = _mm_add_ps(_mm_mul_ps(m_yx, p_x), _mm_mul_ps(m_yy, p_y));
+					z = _mm_add_ps(_mm_mul_ps(m_zx, p_x), _mm_mul_ps(m_zy, p_y));
+
+					x = _mm_add_ps(_mm_add_ps(x, _mm_mul_ps(m_xz, p_z)), m_xw);
+					y = _mm_add_ps(_mm_add_ps(y, _mm_mul_ps(m_yz, p_z)), m_yw);
+					z = _mm_add_ps(_mm_add_ps(z, _mm_mul_ps(m_zz, p_z)), m_zw);
+
+					store_stream(res.x + i, x, left);
+					store_stream(res.y + i, y, left);
+					store_stream(res.z + i, z, left);
+				}
+			}
+
+			/* Transposition of 4x4 block, done in every 128 bit lane */
+			static inline void transpose_rows(__m128 & r0, __m128 & r1, __m128 & r2, __m128 & r3)
+			{
+				const __m128 t0 = _mm_unpacklo_ps(r0, r1);
+				const __m128 t1 = _mm_unpacklo_ps(r2, r3);
+				const __m128 t2 = _mm_unpackhi_ps(r0, r1);
+				const __m128 t3 = _mm_unpackhi_ps(r2, r3);
+
+				r0 = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(1,0,1,0));
+				r1 = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(3,2,3,2));
+				r2 = _mm_shuffle_ps(t2, t3, _MM_SHUFFLE(1,0,1,0));
+				r3 = _mm_shuffle_ps(t2, t3, _MM_SHUFFLE(3,2,3,2));
+			}
+
+			/* Sum is stored in every element */
+			static inline __m128 sum_elements(__m128 value)
+			{
+				value = _mm_add_ps(_mm_shuffle_ps(value, value, _MM_SHUFFLE(1,0,3,2)), value);
+
+				return _mm_add_ps(_mm_shuffle_ps(value, value, _MM_SHUFFLE(2,3,0,1)), value);
+			}
+
+			static inline __m128 cross_rows(__m128 a, __m128 b)
+			{
+				const __m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3,0,2,1));
+				const __m128 a_zxy = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3,1,0,2));
+				const __m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3,0,2,1));
+				const __m128 b_zxy = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3,1,0,2));
+
+				return _mm_sub_ps(_mm_mul_ps(a_yzx, b_zxy), _mm_mul_ps(a_zxy, b_yzx));
+			}
+
+			/* Cramer's rule, rows are replaced with rows of inverse, determinant is returned in every element */
+			static inline __m128 inverse_rows(__m128 & r0, __m128 & r1, __m128 & r2, __m128 & r3)
+			{
+				__m128 row0, row1, row2, row3;
+				__m128 minor0, minor1, minor2, minor3;
+				__m128 det, temp;
+
+				/* Columns, second and fourth are rotated by two elements */
+				temp = _mm_shuffle_ps(r0, r1, _MM_SHUFFLE(1,0,1,0));
+				row1 = _mm_shuffle_ps(r2, r3, _MM_SHUFFLE(1,0,1,0));
+				row0 = _mm_shuffle_ps(temp, row1, _MM_SHUFFLE(2,0,2,0));
+				row1 = _mm_shuffle_ps(row1, temp, _MM_SHUFFLE(3,1,3,1));
+				temp = _mm_shuffle_ps(r0, r1, _MM_SHUFFLE(3,2,3,2));
+				row3 = _mm_shuffle_ps(r2, r3, _MM_SHUFFLE(3,2,3,2));
+				row2 = _mm_shuffle_ps(temp, row3, _MM_SHUFFLE(2,0,2,0));
+				row3 = _mm_shuffle_ps(row3, temp, _MM_SHUFFLE(3,1,3,1));
+
+				temp = _mm_mul_ps(row2, row3);
+				temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2,3,0,1));
+				minor0 = _mm_mul_ps(row1, temp);
+				minor1 = _mm_mul_ps(row0, temp);
+				temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(1,0,3,2));
+				minor0 = _mm_sub_ps(_mm_mul_ps(row1, temp), minor0);
+				minor1 = _mm_sub_ps(_mm_mul_ps(row0, temp), minor1);
+				minor1 = _mm_shuffle_ps(minor1, minor1, _MM_SHUFFLE(1,0,3,2));
+
+				temp = _mm_mul_ps(row1, row2);
+				temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2,3,0,1));
+				minor0 = _mm_add_ps(_mm_mul_ps(row3, temp), minor0);
+				minor3 = _mm_mul_ps(row0, temp);
+				temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(1,0,3,2));
+				minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, temp));
+				minor3 = _mm_sub_ps(_mm_mul_ps(row0, temp), minor3);
+				minor3 = _mm_shuffle_ps(minor3, minor3, _MM_SHUFFLE(1,0,3,2));
+
+				temp = _mm_mul_ps(_mm_shuffle_ps(row1, row1, _MM_SHUFFLE(1,0,3,2)), row3);
+				temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2,3,0,1));
+				row2 = _mm_shuffle_ps(row2, row2, _MM_SHUFFLE(1,0,3,2));
+				minor0 = _mm_add_ps(_mm_mul_ps(row2, temp), minor0);
+				minor2 = _mm_mul_ps(row0, temp);
+				temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(1,0,3,2));
+				minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, temp));
+				minor2 = _mm_sub_ps(_mm_mul_ps(row0, temp), minor2);
+				minor2 = _mm_shuffle_ps(minor2, minor2, _MM_SHUFFLE(1,0,3,2));
+
+				temp = _mm_mul_ps(row0, row1);
+				temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2,3,0,1));
+				minor2 = _mm_add_ps(_mm_mul_ps(row3, temp), minor2);
+				minor3 = _mm_sub_ps(_mm_mul_ps(row2, temp), minor3);
+				temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(1,0,3,2));
+				minor2 = _mm_sub_ps(_mm_mul_ps(row3, temp), minor2);
+				minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, temp));
+
+				temp = _mm_mul_ps(row0, row3);
+				temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2,3,0,1));
+				minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, temp));
+				minor2 = _mm_add_ps(_mm_mul_ps(row1, temp), minor2);
+				temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(1,0,3,2));
+				minor1 = _mm_add_ps(_mm_mul_ps(row2, temp), minor1);
+				minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, temp));
+
+				temp = _mm_mul_ps(row0, row2);
+				temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2,3,0,1));
+				minor1 = _mm_add_ps(_mm_mul_ps(row3, temp), minor1);
+				minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, temp));
+				temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(1,0,3,2));
+				minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, temp));
+				minor3 = _mm_add_ps(_mm_mul_ps(row1, temp), minor3);
+
+				/* Exact division, results do not depend on instruction set */
+				det = sum_elements(_mm_mul_ps(row0, minor0));
+				temp = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+				r0 = _mm_mul_ps(minor0, temp);
+				r1 = _mm_mul_ps(minor1, temp);
+				r2 = _mm_mul_ps(minor2, temp);
+				r3 = _mm_mul_ps(minor3, temp);
+
+				return det;
+			}
+
+			/* Columns of inverse of rotation part are cross products of rows divided by determinant */
+			static inline __m128 affine_inverse_rows(__m128 & r0, __m128 & r1, __m128 & r2)
+			{
+				__m128 c0 = cross_rows(r1, r2);
+				__m128 c1 = cross_rows(r2, r0);
+				__m128 c2 = cross_rows(r0, r1);
+				__m128 translation;
+
+				const __m128 det = sum_elements(_mm_mul_ps(r0, c0));
+				const __m128 inverse = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+				c0 = _mm_mul_ps(c0, inverse);
+				c1 = _mm_mul_ps(c1, inverse);
+				c2 = _mm_mul_ps(c2, inverse);
+
+				/* -inverse * translation */
+				translation = _mm_add_ps(_mm_mul_ps(c0, _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3,3,3,3))), _mm_mul_ps(c1, _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3,3,3,3))));
+				translation = _mm_add_ps(translation, _mm_mul_ps(c2, _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3,3,3,3))));
+				translation = _mm_sub_ps(_mm_setzero_ps(), translation);
+
+				transpose_rows(c0, c1, c2, translation);
+
+				r0 = c0;
+				r1 = c1;
+				r2 = c2;
+
+				return det;
+			}
+
+			/* Rotation part is transposed */
+			static inline void rigid_inverse_rows(__m128 & r0, __m128 & r1, __m128 & r2)
+			{
+				__m128 translation;
+
+				/* -transposed * translation */
+				translation = _mm_add_ps(_mm_mul_ps(r0, _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3,3,3,3))), _mm_mul_ps(r1, _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3,3,3,3))));
+				translation = _mm_add_ps(translation, _mm_mul_ps(r2, _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3,3,3,3))));
+				translation = _mm_sub_ps(_mm_setzero_ps(), translation);
+
+				transpose_rows(r0, r1, r2, translation);
+			}
+
+			static inline __m128 determinant_rows(__m128 r0, __m128 r1, __m128 r2)
+			{
+				return sum_elements(_mm_mul_ps(r0, cross_rows(r1, r2)));
+			}
+
+			void Inverse(const float16 * a, float16 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					__m128 r0 = a[i].x.m128;
+					__m128 r1 = a[i].y.m128;
+					__m128 r2 = a[i].z.m128;
+					__m128 r3 = a[i].w.m128;
+
+					inverse_rows(r0, r1, r2, r3);
+
+					res[i].x.m128 = r0;
+					res[i].y.m128 = r1;
+					res[i].z.m128 = r2;
+					res[i].w.m128 = r3;
+				}
+			}
+
+			void Inverse(const float12 * a, float12 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					__m128 r0 = a[i].x.m128;
+					__m128 r1 = a[i].y.m128;
+					__m128 r2 = a[i].z.m128;
+
+					affine_inverse_rows(r0, r1, r2);
+
+					res[i].x.m128 = r0;
+					res[i].y.m128 = r1;
+					res[i].z.m128 = r2;
+				}
+			}
+
+			void Inverse_rigid(const float12 * a, float12 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					__m128 r0 = a[i].x.m128;
+					__m128 r1 = a[i].y.m128;
+					__m128 r2 = a[i].z.m128;
+
+					rigid_inverse_rows(r0, r1, r2);
+
+					res[i].x.m128 = r0;
+					res[i].y.m128 = r1;
+					res[i].z.m128 = r2;
+				}
+			}
+
+			void Determinant(const float16 * a, float * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					__m128 r0 = a[i].x.m128;
+					__m128 r1 = a[i].y.m128;
+					__m128 r2 = a[i].z.m128;
+					__m128 r3 = a[i].w.m128;
+
+					res[i] = _mm_cvtss_f32(inverse_rows(r0, r1, r2, r3));
+				}
+			}
+
+			void Determinant(const float12 * a, float * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					res[i] = _mm_cvtss_f32(determinant_rows(a[i].x.m128, a[i].y.m128, a[i].z.m128));
+				}
+			}
+
+			/* Polynomials of Quaternion::FastAcos and Quaternion::FastSin */
+			static inline __m128 fast_acos(__m128 x)
+			{
+				__m128 res = _mm_set1_ps(-0.0012624911f);
+
+				res = _mm_add_ps(_mm_mul_ps(res, x), _mm_set1_ps(0.0066700901f));
+				res = _mm_add_ps(_mm_mul_ps(res, x), _mm_set1_ps(-0.0170881256f));
+				res = _mm_add_ps(_mm_mul_ps(res, x), _mm_set1_ps(0.0308918810f));
+				res = _mm_add_ps(_mm_mul_ps(res, x), _mm_set1_ps(-0.0501743046f));
+				res = _mm_add_ps(_mm_mul_ps(res, x), _mm_set1_ps(0.0889789874f));
+				res = _mm_add_ps(_mm_mul_ps(res, x), _mm_set1_ps(-0.2145988016f));
+				res = _mm_add_ps(_mm_mul_ps(res, x), _mm_set1_ps(1.5707963050f));
+
+				return _mm_mul_ps(_mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), x)), res);
+			}
+
+			static inline __m128 fast_sin(__m128 x)
+			{
+				const __m128 x2 = _mm_mul_ps(x, x);
+				__m128 res = _mm_set1_ps(-2.5052108e-8f);
+
+				res = _mm_add_ps(_mm_mul_ps(res, x2), _mm_set1_ps(2.7557319e-6f));
+				res = _mm_add_ps(_mm_mul_ps(res, x2), _mm_set1_ps(-1.9841270e-4f));
+				res = _mm_add_ps(_mm_mul_ps(res, x2), _mm_set1_ps(8.3333333e-3f));
+				res = _mm_add_ps(_mm_mul_ps(res, x2), _mm_set1_ps(-1.6666667e-1f));
+				res = _mm_add_ps(_mm_mul_ps(res, x2), _mm_set1_ps(1.0f));
+
+				return _mm_mul_ps(res, x);
+			}
+
+			/* Quaternion::Slerp on streams, first quaternion is replaced with result */
+			static inline void slerp_lanes(__m128 & x, __m128 & y, __m128 & z, __m128 & w, __m128 b_x, __m128 b_y, __m128 b_z, __m128 b_w, __m128 percent)
+			{
+				const __m128 one = _mm_set1_ps(1.0f);
+				const __m128 rest = _mm_sub_ps(one, percent);
+				__m128 cosine, sign, angle, sine, weight_a, weight_b, length;
+
+				cosine = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, b_x), _mm_mul_ps(y, b_y)), _mm_mul_ps(z, b_z)), _mm_mul_ps(w, b_w));
+
+				/* Shortest path */
+				sign = _mm_or_ps(_mm_and_ps(_mm_cmplt_ps(cosine, _mm_setzero_ps()), _mm_set1_ps(-1.0f)), _mm_andnot_ps(_mm_cmplt_ps(cosine, _mm_setzero_ps()), one));
+				b_x = _mm_mul_ps(b_x, sign);
+				b_y = _mm_mul_ps(b_y, sign);
+				b_z = _mm_mul_ps(b_z, sign);
+				b_w = _mm_mul_ps(b_w, sign);
+				cosine = _mm_mul_ps(cosine, sign);
+
+				angle = fast_acos(cosine);
+				sine = _mm_sqrt_ps(_mm_sub_ps(one, _mm_mul_ps(cosine, cosine)));
+				weight_a = _mm_div_ps(fast_sin(_mm_mul_ps(rest, angle)), sine);
+				weight_b = _mm_div_ps(fast_sin(_mm_mul_ps(percent, angle)), sine);
+
+				/* Linear interpolation when quaternions are almost the same */
+				const __m128 is_near = _mm_cmplt_ps(_mm_set1_ps(0.9995f), cosine);
+				weight_a = _mm_or_ps(_mm_and_ps(is_near, rest), _mm_andnot_ps(is_near, weight_a));
+				weight_b = _mm_or_ps(_mm_and_ps(is_near, percent), _mm_andnot_ps(is_near, weight_b));
+
+				x = _mm_add_ps(_mm_mul_ps(x, weight_a), _mm_mul_ps(b_x, weight_b));
+				y = _mm_add_ps(_mm_mul_ps(y, weight_a), _mm_mul_ps(b_y, weight_b));
+				z = _mm_add_ps(_mm_mul_ps(z, weight_a), _mm_mul_ps(b_z, weight_b));
+				w = _mm_add_ps(_mm_mul_ps(w, weight_a), _mm_mul_ps(b_w, weight_b));
+
+				length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)), _mm_mul_ps(w, w)));
+				x = _mm_div_ps(x, length);
+				y = _mm_div_ps(y, length);
+				z = _mm_div_ps(z, length);
+				w = _mm_div_ps(w, length);
+			}
+
+			/* Matrix::RotationFromQuaternion on streams, rows are transposed back, in every 128 bit lane n-th register holds rows of n-th quaternion */
+			static inline void rotation_rows(__m128 x, __m128 y, __m128 z, __m128 w, __m128 * r_x, __m128 * r_y, __m128 * r_z)
+			{
+				const __m128 two = _mm_set1_ps(2.0f);
+				const __m128 ww = _mm_mul_ps(w, w);
+				const __m128 xx = _mm_mul_ps(x, x);
+				const __m128 yy = _mm_mul_ps(y, y);
+				const __m128 zz = _mm_mul_ps(z, z);
+
+				const __m128 xy2 = _mm_mul_ps(_mm_mul_ps(x, y), two);
+				const __m128 xz2 = _mm_mul_ps(_mm_mul_ps(x, z), two);
+				const __m128 xw2 = _mm_mul_ps(_mm_mul_ps(x, w), two);
+				const __m128 yz2 = _mm_mul_ps(_mm_mul_ps(y, z), two);
+				const __m128 yw2 = _mm_mul_ps(_mm_mul_ps(y, w), two);
+				const __m128 zw2 = _mm_mul_ps(_mm_mul_ps(z, w), two);
+
+				r_x[0] = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(ww, xx), yy), zz);
+				r_x[1] = _mm_add_ps(xy2, zw2);
+				r_x[2] = _mm_sub_ps(xz2, yw2);
+				r_x[3] = _mm_setzero_ps();
+
+				r_y[0] = _mm_sub_ps(xy2, zw2);
+				r_y[1] = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(ww, xx), yy), zz);
+				r_y[2] = _mm_add_ps(yz2, xw2);
+				r_y[3] = _mm_setzero_ps();
+
+				r_z[0] = _mm_add_ps(xz2, yw2);
+				r_z[1] = _mm_sub_ps(yz2, xw2);
+				r_z[2] = _mm_add_ps(_mm_sub_ps(_mm_sub_ps(ww, xx), yy), zz);
+				r_z[3] = _mm_setzero_ps();
+
+				transpose_rows(r_x[0], r_x[1], r_x[2], r_x[3]);
+				transpose_rows(r_y[0], r_y[1], r_y[2], r_y[3]);
+				transpose_rows(r_z[0], r_z[1], r_z[2], r_z[3]);
+			}
+
+			/* Up to four quaternions, missing ones are identity */
+			static inline void load_quaternions(const float4 * data, Platform::uint32 count, __m128 & x, __m128 & y, __m128 & z, __m128 & w)
+			{
+				const __m128 identity = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+
+				x = data[0].m128;
+				y = (1 < count) ? data[1].m128 : identity;
+				z = (2 < count) ? data[2].m128 : identity;
+				w = (3 < count) ? data[3].m128 : identity;
+
+				transpose_rows(x, y, z, w);
+			}
+
+			static inline void store_quaternions(float4 * data, Platform::uint32 count, __m128 x, __m128 y, __m128 z, __m128 w)
+			{
+				transpose_rows(x, y, z, w);
+
+				data[0].m128 = x;
+
+				if (1 < count)
+				{
+					data[1].m128 = y;
+				}
+
+				if (2 < count)
+				{
+					data[2].m128 = z;
+				}
+
+				if (3 < count)
+				{
+					data[3].m128 = w;
+				}
+			}
+
+			static inline Platform::uint32 left_quaternions(Platform::uint32 i, Platform::uint32 count)
+			{
+				return (i + 4 <= count) ? 4 : (count - i);
+			}
+
+			void Slerp(const float4 * a, const float4 * b, const float * percent, float4 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 4)
+				{
+					const Platform::uint32 left = left_quaternions(i, count);
+					__m128 x, y, z, w;
+					__m128 b_x, b_y, b_z, b_w;
+
+					load_quaternions(&a[i], left, x, y, z, w);
+					load_quaternions(&b[i], left, b_x, b_y, b_z, b_w);
+					slerp_lanes(x, y, z, w, b_x, b_y, b_z, b_w, load_stream(percent + i, left));
+					store_quaternions(&res[i], left, x, y, z, w);
+				}
+			}
+
+			void Rotation_from_quaternion(const float4 * quaternions, float12 * res, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 4)
+				{
+					const Platform::uint32 left = left_quaternions(i, count);
+					__m128 x, y, z, w;
+					__m128 r_x[4], r_y[4], r_z[4];
+
+					load_quaternions(&quaternions[i], left, x, y, z, w);
+					rotation_rows(x, y, z, w, r_x, r_y, r_z);
+
+					for (Platform::uint32 n = 0; n < left; ++n)
+					{
+						res[i + n].x.m128 = r_x[n];
+						res[i + n].y.m128 = r_y[n];
+						res[i + n].z.m128 = r_z[n];
+					}
+				}
+			}
+
+			/* Linear blend skinning, one vertex at once. W is 1 for points and 0 for vectors */
+			static inline void skin(
+				const float12 * bones,
+				const Platform::uint16 * indices,
+				const float * weights,
+				const float4_soa & source,
+				const float4_soa & res,
+				Platform::uint32 count,
+				float w)
+			{
+				for (Platform::uint32 i = 0; i < count; ++i)
+				{
+					const Platform::uint16 * index = indices + 4 * i;
+					const float * weight = weights + 4 * i;
+					const __m128 point = _mm_setr_ps(source.x[i], source.y[i], source.z[i], w);
+					__m128 scale, r_x, r_y, r_z;
+
+					scale = _mm_set1_ps(weight[0]);
+					r_x = _mm_mul_ps(bones[index[0]].x.m128, scale);
+					r_y = _mm_mul_ps(bones[index[0]].y.m128, scale);
+					r_z = _mm_mul_ps(bones[index[0]].z.m128, scale);
+
+					for (Platform::uint32 n = 1; n < 4; ++n)
+					{
+						const float12 & bone = bones[index[n]];
+
+						scale = _mm_set1_ps(weight[n]);
+						r_x = _mm_add_ps(r_x, _mm_mul_ps(bone.x.m128, scale));
+						r_y = _mm_add_ps(r_y, _mm_mul_ps(bone.y.m128, scale));
+						r_z = _mm_add_ps(r_z, _mm_mul_ps(bone.z.m128, scale));
+					}
+
+					res.x[i] = _mm_cvtss_f32(sum_elements(_mm_mul_ps(r_x, point)));
+					res.y[i] = _mm_cvtss_f32(sum_elements(_mm_mul_ps(r_y, point)));
+					res.z[i] = _mm_cvtss_f32(sum_elements(_mm_mul_ps(r_z, point)));
+				}
+			}
+
+			void Skin_points(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4_soa & points, const float4_soa & res, Platform::uint32 count)
+			{
+				skin(bones, indices, weights, points, res, count, 1.0f);
+			}
+
+			void Skin_vectors(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4_soa & vectors, const float4_soa & res, Platform::uint32 count)
+			{
+				skin(bones, indices, weights, vectors, res, count, 0.0f);
+			}
+
+			/* Indices of lanes set in mask are appended to visible, entry past the last one may be overwritten */
+			static inline Platform::uint32 append_visible(Platform::uint32 * visible, Platform::uint32 n_visible, Platform::uint32 i, Platform::uint32 mask, Platform::uint32 lanes)
+			{
+				for (Platform::uint32 lane = 0; lane < lanes; ++lane)
+				{
+					visible[n_visible] = i + lane;
+					n_visible += (mask >> lane) & 1u;
+				}
+
+				return n_visible;
+			}
+
+			static inline Platform::uint32 valid_lanes(Platform::uint32 count)
+			{
+				return (4 <= count) ? 0xfu : ((1u << count) - 1u);
+			}
+
+			Platform::uint32 Cull_boxes(const frustum & planes, const aabb_soa & boxes, Platform::uint32 * visible, Platform::uint32 count)
+			{
+				Platform::uint32 n_visible = 0;
+
+				for (Platform::uint32 i = 0; i < count; i += 4)
+				{
+					const Platform::uint32 left = count - i;
+					const __m128 min_x = load_stream(boxes.min_x + i, left);
+					const __m128 min_y = load_stream(boxes.min_y + i, left);
+					const __m128 min_z = load_stream(boxes.min_z + i, left);
+					const __m128 max_x = load_stream(boxes.max_x + i, left);
+					const __m128 max_y = load_stream(boxes.max_y + i, left);
+					const __m128 max_z = load_stream(boxes.max_z + i, left);
+					Platform::uint32 mask = valid_lanes(left);
+
+					for (Platform::uint32 p = 0; (p < planes.count) && (0 != mask); ++p)
+					{
+						const __m128 p_x = _mm_set1_ps(planes.x[p]);
+						const __m128 p_y = _mm_set1_ps(planes.y[p]);
+						const __m128 p_z = _mm_set1_ps(planes.z[p]);
+						__m128 distance;
+
+						distance = _mm_add_ps(
+							_mm_max_ps(_mm_mul_ps(p_x, min_x), _mm_mul_ps(p_x, max_x)),
+							_mm_max_ps(_mm_mul_ps(p_y, min_y), _mm_mul_ps(p_y, max_y)));
+						distance = _mm_add_ps(distance, _mm_max_ps(_mm_mul_ps(p_z, min_z), _mm_mul_ps(p_z, max_z)));
+						distance = _mm_add_ps(distance, _mm_set1_ps(planes.w[p]));
+
+						mask &= Platform::uint32(_mm_movemask_ps(_mm_cmpge_ps(distance, _mm_setzero_ps())));
+					}
+
+					n_visible = append_visible(visible, n_visible, i, mask, (4 <= left) ? 4 : left);
+				}
+
+				return n_visible;
+			}
+
+			Platform::uint32 Cull_spheres(const frustum & planes, const float4_soa & spheres, Platform::uint32 * visible, Platform::uint32 count)
+			{
+				Platform::uint32 n_visible = 0;
+
+				for (Platform::uint32 i = 0; i < count; i += 4)
+				{
+					const Platform::uint32 left = count - i;
+					const __m128 c_x = load_stream(spheres.x + i, left);
+					const __m128 c_y = load_stream(spheres.y + i, left);
+					const __m128 c_z = load_stream(spheres.z + i, left);
+					const __m128 radius = _mm_sub_ps(_mm_setzero_ps(), load_stream(spheres.w + i, left));
+					Platform::uint32 mask = valid_lanes(left);
+
+					for (Platform::uint32 p = 0; (p < planes.count) && (0 != mask); ++p)
+					{
+						__m128 distance;
+
+						distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.x[p]), c_x), _mm_mul_ps(_mm_set1_ps(planes.y[p]), c_y));
+						distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes.z[p]), c_z));
+						distance = _mm_add_ps(distance, _mm_set1_ps(planes.w[p]));
+
+						mask &= Platform::uint32(_mm_movemask_ps(_mm_cmpge_ps(distance, radius)));
+					}
+
+					n_visible = append_visible(visible, n_visible, i, mask, (4 <= left) ? 4 : left);
+				}
+
+				return n_visible;
+			}
+
+			/* Half precision, see HalfKernels.hpp. Four values in 32 bit lanes */
+			static inline __m128i float_to_half(__m128 value)
+			{
+				const __m128i sign_mask = _mm_set1_epi32(0x80000000);
+				const __m128i one = _mm_set1_epi32(1);
+				const __m128i infinity = _mm_set1_epi32(255 << 23);
+				const __m128i overflow = _mm_set1_epi32(((127 + 16) << 23) - 1);
+				const __m128i small = _mm_set1_epi32(113 << 23);
+				const __m128i magic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+				const __m128i rebias = _mm_set1_epi32(0xfff - ((127 - 15) << 23));
+				const __m128i half_infinity = _mm_set1_epi32(0x7c00);
+				const __m128i half_quiet = _mm_set1_epi32(0x0200);
+				const __m128i half_mask = _mm_set1_epi32(0x7fff);
+
+				const __m128i bits = _mm_castps_si128(value);
+				const __m128i sign = _mm_and_si128(bits, sign_mask);
+				const __m128i abs = _mm_xor_si128(bits, sign);
+
+				/* Normal, round to nearest even by adding 0xfff and odd bit */
+				__m128i normal = _mm_and_si128(_mm_srli_epi32(abs, 13), one);
+				normal = _mm_add_epi32(normal, _mm_add_epi32(abs, rebias));
+				normal = _mm_srli_epi32(normal, 13);
+
+				/* Subnormal, float addition does the rounding */
+				__m128i subnormal = _mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(abs), _mm_castsi128_ps(magic)));
+				subnormal = _mm_sub_epi32(subnormal, magic);
+
+				/* Infinity or quiet NaN with upper bits of payload */
+				const __m128i is_nan = _mm_cmpgt_epi32(abs, infinity);
+				__m128i special = _mm_or_si128(_mm_srli_epi32(abs, 13), half_quiet);
+				special = _mm_or_si128(half_infinity, _mm_and_si128(is_nan, special));
+				special = _mm_and_si128(special, half_mask);
+
+				const __m128i is_big = _mm_cmpgt_epi32(abs, overflow);
+				const __m128i is_small = _mm_cmplt_epi32(abs, small);
+				__m128i res;
+
+				res = _mm_or_si128(_mm_and_si128(is_small, subnormal), _mm_andnot_si128(is_small, normal));
+				res = _mm_or_si128(_mm_and_si128(is_big, special), _mm_andnot_si128(is_big, res));
+				res = _mm_or_si128(res, _mm_srli_epi32(sign, 16));
+
+				/* Sign extend, so pack does not saturate */
+				return _mm_srai_epi32(_mm_slli_epi32(res, 16), 16);
+			}
+
+			static inline __m128 half_to_float(__m128i value)
+			{
+				const __m128i exponent_mask = _mm_set1_epi32(0x7c00 << 13);
+				const __m128i half_mask = _mm_set1_epi32(0x7fff);
+				const __m128i half_infinity = _mm_set1_epi32(0x7c00);
+				const __m128i sign_mask = _mm_set1_epi32(0x8000);
+				const __m128i rebias = _mm_set1_epi32((127 - 15) << 23);
+				const __m128i special_rebias = _mm_set1_epi32((128 - 16) << 23);
+				const __m128i quiet = _mm_set1_epi32(0x400000);
+				const __m128i one = _mm_set1_epi32(1 << 23);
+				const __m128i magic = _mm_set1_epi32(113 << 23);
+				const __m128i zero = _mm_setzero_si128();
+
+				const __m128i abs = _mm_and_si128(value, half_mask);
+				const __m128i shifted = _mm_slli_epi32(abs, 13);
+				const __m128i exponent = _mm_and_si128(shifted, exponent_mask);
+				__m128i res = _mm_add_epi32(shifted, rebias);
+
+				/* Infinity and NaN, NaN becomes quiet */
+				const __m128i is_special = _mm_cmpeq_epi32(exponent, exponent_mask);
+				const __m128i is_nan = _mm_cmpgt_epi32(abs, half_infinity);
+				res = _mm_add_epi32(res, _mm_and_si128(is_special, special_rebias));
+				res = _mm_or_si128(res, _mm_and_si128(is_nan, quiet));
+
+				/* Subnormal, exact by float subtraction */
+				const __m128i is_subnormal = _mm_cmpeq_epi32(exponent, zero);
+				__m128 subnormal = _mm_castsi128_ps(_mm_add_epi32(res, one));
+				subnormal = _mm_sub_ps(subnormal, _mm_castsi128_ps(magic));
+				res = _mm_or_si128(_mm_and_si128(is_subnormal, _mm_castps_si128(subnormal)), _mm_andnot_si128(is_subnormal, res));
+
+				res = _mm_or_si128(res, _mm_slli_epi32(_mm_and_si128(value, sign_mask), 16));
+
+				return _mm_castsi128_ps(res);
+			}
+
+			void Float_to_half(const float * source, Platform::uint16 * destination, Platform::uint32 count)
+			{
+				for (Platform::uint32 i = 0; i < count; i += 8)
+				{
+					const Platform::uint32 left = count - i;
+					const __m128i low = float_to_half(load_stream(source + i, left));
+					const __m128i high = float_to_half(load_stream(source + i + 4, (4 < left) ? (left - 4) : 0));
+					const __m128i halves = _mm_packs_epi32(low, high);
+
+					if (8 <= left)
+					{
+						_mm_storeu_si128((__m128i *) (destination + i), halves);
+					}
+					else
+					{
+						Platform::uint16 temp[8];
+
+						_mm_storeu_si128((__m128i *) temp, halves);
+
+						for (Platform::uint32 j = 0; j < left; ++j)
+						{
+							destination[i + j] = temp[j];
+						}
+					}
+				}
+			}
+
+			void Half_to_float(const Platform::uint16 * source, float * destination, Platform::uint32 count)
+			{
+				const __m128i zero = _mm_setzero_si128();
+
+				for (Platform::uint32 i = 0; i < count; i += 8)
+				{
+					const Platform::uint32 left = count - i;
+					__m128i halves;
+
+					if (8 <= left)
+					{
+						halves = _mm_loadu_si128((const __m128i *) (source + i));
+					}
+					else
+					{
+						Platform::uint16 temp[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+						for (Platform::uint32 j = 0; j < left; ++j)
+						{
+							temp[j] = source[i + j];
+						}
+
+						halves = _mm_loadu_si128((const __m128i *) temp);
+					}
+
+					store_stream(destination + i, half_to_float(_mm_unpacklo_epi16(halves, zero)), left);
+					store_stream(destination + i + 4, half_to_float(_mm_unpackhi_epi16(halves, zero)), (4 < left) ? (left - 4) : 0);
+				}
+			}
+		}
+	}
+}
@@ -42,7 +42,54 @@ namespace Math
 	{
 		inline float16 Multiply(const float16 & a, const float16 & b)
 		{
-			float16 res, temp;
+			float16 res;
+
+#if (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX512)
+			const __m512 rows = _mm512_loadu_ps(a.f);
+			__m512 x, y, z, w;
+
+			/* All rows at once, n-th element of each row times n-th row of b */
+			x = _mm512_permute_ps(rows, _MM_SHUFFLE(0,0,0,0));
+			y = _mm512_permute_ps(rows, _MM_SHUFFLE(1,1,1,1));
+			z = _mm512_permute_ps(rows, _MM_SHUFFLE(2,2,2,2));
+			w = _mm512_permute_ps(rows, _MM_SHUFFLE(3,3,3,3));
+
+			x = _mm512_mul_ps(x, _mm512_broadcast_f32x4(b.x.m128));
+			y = _mm512_mul_ps(y, _mm512_broadcast_f32x4(b.y.m128));
+			z = _mm512_mul_ps(z, _mm512_broadcast_f32x4(b.z.m128));
+			w = _mm512_mul_ps(w, _mm512_broadcast_f32x4(b.w.m128));
+
+			x = _mm512_add_ps(x, y);
+			z = _mm512_add_ps(z, w);
+			_mm512_storeu_ps(res.f, _mm512_add_ps(x, z));
+#elif (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX)
+			const __m256 b_x = _mm256_broadcast_ps(&b.x.m128);
+			const __m256 b_y = _mm256_broadcast_ps(&b.y.m128);
+			const __m256 b_z = _mm256_broadcast_ps(&b.z.m128);
+			const __m256 b_w = _mm256_broadcast_ps(&b.w.m128);
+
+			/* Two rows at once */
+			for (Platform::uint32 i = 0; i < 16; i += 8)
+			{
+				const __m256 rows = _mm256_loadu_ps(&a.f[i]);
+				__m256 x, y, z, w;
+
+				x = _mm256_permute_ps(rows, _MM_SHUFFLE(0,0,0,0));
+				y = _mm256_permute_ps(rows, _MM_SHUFFLE(1,1,1,1));
+				z = _mm256_permute_ps(rows, _MM_SHUFFLE(2,2,2,2));
+				w = _mm256_permute_ps(rows, _MM_SHUFFLE(3,3,3,3));
+
+				x = _mm256_mul_ps(x, b_x);
+				y = _mm256_mul_ps(y, b_y);
+				z = _mm256_mul_ps(z, b_z);
+				w = _mm256_mul_ps(w, b_w);
+
+				x = _mm256_add_ps(x, y);
+				z = _mm256_add_ps(z, w);
+				_mm256_storeu_ps(&res.f[i], _mm256_add_ps(x, z));
+			}
+#else
+			float16 temp;
 
 			temp.x.m128 = _mm_shuffle_ps(a.x.m128, a.x.m128, _MM_SHUFFLE(0,0,0,0));
 			temp.y.m128 = _mm_shuffle_ps(a.x.m128, a.x.m128, _MM_SHUFFLE(1,1,1,1));
@@ -102,16 +149,57 @@ namespace Math
 			temp.x.m128 = _mm_add_ps(temp.x.m128, temp.y.m128);
 			temp.z.m128 = _mm_add_ps(temp.z.m128, temp.w.m128);
 			res.w.m128 = _mm_add_ps(temp.x.m128, temp.z.m128);
+#endif
 
 			return res;
 		}
 
 		inline float12 Multiply (const float12 & a, const float12 & b)
 		{
-			float16 temp;
 			float12 res;
 			float4 last = Float4::Set(0.0f, 0.0f, 0.0f, 1.0f);
 
+#if (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX512)
+			const __mmask16 mask = UTILITIES_MATH_SIMD_FLOAT12_MASK;
+			const __m512 rows = _mm512_maskz_loadu_ps(mask, a.f);
+			__m512 x, y, z, w;
+
+			/* All three rows at once, fourth row of b is implicit */
+			x = _mm512_permute_ps(rows, _MM_SHUFFLE(0,0,0,0));
+			y = _mm512_permute_ps(rows, _MM_SHUFFLE(1,1,1,1));
+			z = _mm512_permute_ps(rows, _MM_SHUFFLE(2,2,2,2));
+			w = _mm512_permute_ps(rows, _MM_SHUFFLE(3,3,3,3));
+
+			x = _mm512_maskz_mul_ps(mask, x, _mm512_broadcast_f32x4(b.x.m128));
+			y = _mm512_maskz_mul_ps(mask, y, _mm512_broadcast_f32x4(b.y.m128));
+			z = _mm512_maskz_mul_ps(mask, z, _mm512_broadcast_f32x4(b.z.m128));
+			w = _mm512_maskz_mul_ps(mask, w, _mm512_broadcast_f32x4(last.m128));
+
+			x = _mm512_maskz_add_ps(mask, x, y);
+			z = _mm512_maskz_add_ps(mask, z, w);
+			_mm512_mask_storeu_ps(res.f, mask, _mm512_maskz_add_ps(mask, x, z));
+#else
+			float16 temp;
+
+#if (UTILITIES_MATH_SIMD_LEVEL >= UTILITIES_MATH_SIMD_AVX)
+			const __m256 rows = _mm256_loadu_ps(&a.f[0]);
+			__m256 x, y, z, w;
+
+			/* First two rows at once, third one as in SSE version */
+			x = _mm256_permute_ps(rows, _MM_SHUFFLE(0,0,0,0));
+			y = _mm256_permute_ps(rows, _MM_SHUFFLE(1,1,1,1));
+			z = _mm256_permute_ps(rows, _MM_SHUFFLE(2,2,2,2));
+			w = _mm256_permute_ps(rows, _MM_SHUFFLE(3,3,3,3));
+
+			x = _mm256_mul_ps(x, _mm256_broadcast_ps(&b.x.m128));
+			y = _mm256_mul_ps(y, _mm256_broadcast_ps(&b.y.m128));
+			z = _mm256_mul_ps(z, _mm256_broadcast_ps(&b.z.m128));
+			w = _mm256_mul_ps(w, _mm256_broadcast_ps(&last.m128));
+
+			x = _mm256_add_ps(x, y);
+			z = _mm256_add_ps(z, w);
+			_mm256_storeu_ps(&res.f[0], _mm256_add_ps(x, z));
+#else
 			temp.x.m128 = _mm_shuffle_ps(a.x.m128, a.x.m128, _MM_SHUFFLE(0,0,0,0));
 			temp.y.m128 = _mm_shuffle_ps(a.x.m128, a.x.m128, _MM_SHUFFLE(1,1,1,1));
 			temp.z.m128 = _mm_shuffle_ps(a.x.m128, a.x.m128, _MM_SHUFFLE(2,2,2,2));
@@ -140,6 +228,7 @@ namespace Math
 			temp.x.m128 = _mm_add_ps(temp.x.m128, temp.y.m128);
 			temp.z.m128 = _mm_add_ps(temp.z.m128, temp.w.m128);
 			res.y.m128 = _mm_add_ps(temp.x.m128, temp.z.m128);
+#endif /* UTILITIES_MATH_SIMD_AVX */
 
 
 			temp.x.m128 = _mm_shuffle_ps(a.z.m128, a.z.m128, _MM_SHUFFLE(0,0,0,0));
@@ -155,6 +244,7 @@ namespace Math
 			temp.x.m128 = _mm_add_ps(temp.x.m128, temp.y.m128);
 			temp.z.m128 = _mm_add_ps(temp.z.m128, temp.w.m128);
 			res.z.m128 = _mm_add_ps(temp.x.m128, temp.z.m128);
+#endif /* UTILITIES_MATH_SIMD_AVX512 */
 
 			return res;
 		}
@@ -229,6 +319,245 @@ namespace Math
 		{
 			return RotationFromQuaternion(quat) + TranslationFromVector(position);
 		}
+
+		inline float Determinant(const float16 & matrix)
+		{
+			const __m128 r0 = matrix.x.m128;
+			const __m128 r1 = matrix.y.m128;
+			const __m128 r2 = matrix.z.m128;
+			const __m128 r3 = matrix.w.m128;
+			__m128 det, temp;
+			__m128 row0, row1, row2, row3;
+			__m128 minor0;
+
+			/* Columns, second and fourth are rotated by two elements */
+			temp = _mm_shuffle_ps(r0, r1, _MM_SHUFFLE(1,0,1,0));
+			row1 = _mm_shuffle_ps(r2, r3, _MM_SHUFFLE(1,0,1,0));
+			row0 = _mm_shuffle_ps(temp, row1, _MM_SHUFFLE(2,0,2,0));
+			row1 = _mm_shuffle_ps(row1, temp, _MM_SHUFFLE(3,1,3,1));
+			temp = _mm_shuffle_ps(r0, r1, _MM_SHUFFLE(3,2,3,2));
+			row3 = _mm_shuffle_ps(r2, r3, _MM_SHUFFLE(3,2,3,2));
+			row2 = _mm_shuffle_ps(temp, row3, _MM_SHUFFLE(2,0,2,0));
+			row3 = _mm_shuffle_ps(row3, temp, _MM_SHUFFLE(3,1,3,1));
+
+			temp = _mm_mul_ps(row2, row3);
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2,3,0,1));
+			minor0 = _mm_mul_ps(row1, temp);
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(1,0,3,2));
+			minor0 = _mm_sub_ps(_mm_mul_ps(row1, temp), minor0);
+
+			temp = _mm_mul_ps(row1, row2);
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2,3,0,1));
+			minor0 = _mm_add_ps(_mm_mul_ps(row3, temp), minor0);
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(1,0,3,2));
+			minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, temp));
+
+			temp = _mm_mul_ps(_mm_shuffle_ps(row1, row1, _MM_SHUFFLE(1,0,3,2)), row3);
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2,3,0,1));
+			row2 = _mm_shuffle_ps(row2, row2, _MM_SHUFFLE(1,0,3,2));
+			minor0 = _mm_add_ps(_mm_mul_ps(row2, temp), minor0);
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(1,0,3,2));
+			minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, temp));
+
+			det = _mm_mul_ps(row0, minor0);
+			det = _mm_add_ps(_mm_shuffle_ps(det, det, _MM_SHUFFLE(1,0,3,2)), det);
+			det = _mm_add_ps(_mm_shuffle_ps(det, det, _MM_SHUFFLE(2,3,0,1)), det);
+
+			return _mm_cvtss_f32(det);
+		}
+
+		/* Cramer's rule, matrix has to be invertible. Results are the same as of Inverse_batch */
+		inline float16 Inverse(const float16 & matrix)
+		{
+			float16 res;
+			const __m128 r0 = matrix.x.m128;
+			const __m128 r1 = matrix.y.m128;
+			const __m128 r2 = matrix.z.m128;
+			const __m128 r3 = matrix.w.m128;
+			__m128 det, temp;
+			__m128 row0, row1, row2, row3;
+			__m128 minor0, minor1, minor2, minor3;
+
+			/* Columns, second and fourth are rotated by two elements */
+			temp = _mm_shuffle_ps(r0, r1, _MM_SHUFFLE(1,0,1,0));
+			row1 = _mm_shuffle_ps(r2, r3, _MM_SHUFFLE(1,0,1,0));
+			row0 = _mm_shuffle_ps(temp, row1, _MM_SHUFFLE(2,0,2,0));
+			row1 = _mm_shuffle_ps(row1, temp, _MM_SHUFFLE(3,1,3,1));
+			temp = _mm_shuffle_ps(r0, r1, _MM_SHUFFLE(3,2,3,2));
+			row3 = _mm_shuffle_ps(r2, r3, _MM_SHUFFLE(3,2,3,2));
+			row2 = _mm_shuffle_ps(temp, row3, _MM_SHUFFLE(2,0,2,0));
+			row3 = _mm_shuffle_ps(row3, temp, _MM_SHUFFLE(3,1,3,1));
+
+			temp = _mm_mul_ps(row2, row3);
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2,3,0,1));
+			minor0 = _mm_mul_ps(row1, temp);
+			minor1 = _mm_mul_ps(row0, temp);
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(1,0,3,2));
+			minor0 = _mm_sub_ps(_mm_mul_ps(row1, temp), minor0);
+			minor1 = _mm_sub_ps(_mm_mul_ps(row0, temp), minor1);
+			minor1 = _mm_shuffle_ps(minor1, minor1, _MM_SHUFFLE(1,0,3,2));
+
+			temp = _mm_mul_ps(row1, row2);
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2,3,0,1));
+			minor0 = _mm_add_ps(_mm_mul_ps(row3, temp), minor0);
+			minor3 = _mm_mul_ps(row0, temp);
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(1,0,3,2));
+			minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, temp));
+			minor3 = _mm_sub_ps(_mm_mul_ps(row0, temp), minor3);
+			minor3 = _mm_shuffle_ps(minor3, minor3, _MM_SHUFFLE(1,0,3,2));
+
+			temp = _mm_mul_ps(_mm_shuffle_ps(row1, row1, _MM_SHUFFLE(1,0,3,2)), row3);
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2,3,0,1));
+			row2 = _mm_shuffle_ps(row2, row2, _MM_SHUFFLE(1,0,3,2));
+			minor0 = _mm_add_ps(_mm_mul_ps(row2, temp), minor0);
+			minor2 = _mm_mul_ps(row0, temp);
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(1,0,3,2));
+			minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, temp));
+			minor2 = _mm_sub_ps(_mm_mul_ps(row0, temp), minor2);
+			minor2 = _mm_shuffle_ps(minor2, minor2, _MM_SHUFFLE(1,0,3,2));
+
+			temp = _mm_mul_ps(row0, row1);
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2,3,0,1));
+			minor2 = _mm_add_ps(_mm_mul_ps(row3, temp), minor2);
+			minor3 = _mm_sub_ps(_mm_mul_ps(row2, temp), minor3);
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(1,0,3,2));
+			minor2 = _mm_sub_ps(_mm_mul_ps(row3, temp), minor2);
+			minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, temp));
+
+			temp = _mm_mul_ps(row0, row3);
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2,3,0,1));
+			minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, temp));
+			minor2 = _mm_add_ps(_mm_mul_ps(row1, temp), minor2);
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(1,0,3,2));
+			minor1 = _mm_add_ps(_mm_mul_ps(row2, temp), minor1);
+			minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, temp));
+
+			temp = _mm_mul_ps(row0, row2);
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2,3,0,1));
+			minor1 = _mm_add_ps(_mm_mul_ps(row3, temp), minor1);
+			minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, temp));
+			temp = _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(1,0,3,2));
+			minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, temp));
+			minor3 = _mm_add_ps(_mm_mul_ps(row1, temp), minor3);
+
+			det = _mm_mul_ps(row0, minor0);
+			det = _mm_add_ps(_mm_shuffle_ps(det, det, _MM_SHUFFLE(1,0,3,2)), det);
+			det = _mm_add_ps(_mm_shuffle_ps(det, det, _MM_SHUFFLE(2,3,0,1)), det);
+			temp = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+			res.x.m128 = _mm_mul_ps(minor0, temp);
+			res.y.m128 = _mm_mul_ps(minor1, temp);
+			res.z.m128 = _mm_mul_ps(minor2, temp);
+			res.w.m128 = _mm_mul_ps(minor3, temp);
+
+			return res;
+		}
+
+		inline float Determinant(const float12 & matrix)
+		{
+			const __m128 r0 = matrix.x.m128;
+			const __m128 r1 = matrix.y.m128;
+			const __m128 r2 = matrix.z.m128;
+			__m128 cross, det;
+
+			/* Triple product */
+			cross = _mm_sub_ps(
+				_mm_mul_ps(_mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3,0,2,1)), _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3,1,0,2))),
+				_mm_mul_ps(_mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3,1,0,2)), _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3,0,2,1))));
+
+			det = _mm_mul_ps(r0, cross);
+			det = _mm_add_ps(_mm_shuffle_ps(det, det, _MM_SHUFFLE(1,0,3,2)), det);
+			det = _mm_add_ps(_mm_shuffle_ps(det, det, _MM_SHUFFLE(2,3,0,1)), det);
+
+			return _mm_cvtss_f32(det);
+		}
+
+		/* Affine transformation, rotation part has to be invertible. Results are the same as of Inverse_batch */
+		inline float12 Inverse(const float12 & matrix)
+		{
+			float12 res;
+			const __m128 r0 = matrix.x.m128;
+			const __m128 r1 = matrix.y.m128;
+			const __m128 r2 = matrix.z.m128;
+			__m128 c0, c1, c2, translation, det;
+
+			/* Columns of inverse of rotation part are cross products of rows */
+			c0 = _mm_sub_ps(
+				_mm_mul_ps(_mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3,0,2,1)), _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3,1,0,2))),
+				_mm_mul_ps(_mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3,1,0,2)), _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3,0,2,1))));
+			c1 = _mm_sub_ps(
+				_mm_mul_ps(_mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3,0,2,1)), _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3,1,0,2))),
+				_mm_mul_ps(_mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3,1,0,2)), _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3,0,2,1))));
+			c2 = _mm_sub_ps(
+				_mm_mul_ps(_mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3,0,2,1)), _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3,1,0,2))),
+				_mm_mul_ps(_mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3,1,0,2)), _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3,0,2,1))));
+
+			det = _mm_mul_ps(r0, c0);
+			det = _mm_add_ps(_mm_shuffle_ps(det, det, _MM_SHUFFLE(1,0,3,2)), det);
+			det = _mm_add_ps(_mm_shuffle_ps(det, det, _MM_SHUFFLE(2,3,0,1)), det);
+			det = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+			c0 = _mm_mul_ps(c0, det);
+			c1 = _mm_mul_ps(c1, det);
+			c2 = _mm_mul_ps(c2, det);
+
+			/* -inverse * translation */
+			translation = _mm_add_ps(
+				_mm_mul_ps(c0, _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3,3,3,3))),
+				_mm_mul_ps(c1, _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3,3,3,3))));
+			translation = _mm_add_ps(translation, _mm_mul_ps(c2, _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3,3,3,3))));
+			translation = _mm_sub_ps(_mm_setzero_ps(), translation);
+
+			_MM_TRANSPOSE4_PS(c0, c1, c2, translation);
+
+			res.x.m128 = c0;
+			res.y.m128 = c1;
+			res.z.m128 = c2;
+
+			return res;
+		}
+
+		/* Rotation part has to be orthonormal, it is transposed. Results are the same as of Inverse_rigid_batch */
+		inline float12 Inverse_rigid(const float12 & matrix)
+		{
+			float12 res;
+			__m128 r0 = matrix.x.m128;
+			__m128 r1 = matrix.y.m128;
+			__m128 r2 = matrix.z.m128;
+			__m128 translation;
+
+			/* -transposed * translation */
+			translation = _mm_add_ps(
+				_mm_mul_ps(r0, _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3,3,3,3))),
+				_mm_mul_ps(r1, _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3,3,3,3))));
+			translation = _mm_add_ps(translation, _mm_mul_ps(r2, _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3,3,3,3))));
+			translation = _mm_sub_ps(_mm_setzero_ps(), translation);
+
+			_MM_TRANSPOSE4_PS(r0, r1, r2, translation);
+
+			res.x.m128 = r0;
+			res.y.m128 = r1;
+			res.z.m128 = r2;
+
+			return res;
+		}
+
+		/* Batch versions of Multiply, see Kernels.hpp */
+		void Multiply_batch(const float16 * a, const float16 * b, float16 * res, Platform::uint32 count);
+		void Multiply_batch(const float12 * a, const float12 * b, float12 * res, Platform::uint32 count);
+
+		/* Batch versions of Inverse, Inverse_rigid and Determinant, see Kernels.hpp */
+		void Inverse_batch(const float16 * a, float16 * res, Platform::uint32 count);
+		void Inverse_batch(const float12 * a, float12 * res, Platform::uint32 count);
+		void Inverse_rigid_batch(const float12 * a, float12 * res, Platform::uint32 count);
+		void Determinant_batch(const float16 * a, float * res, Platform::uint32 count);
+		void Determinant_batch(const float12 * a, float * res, Platform::uint32 count);
+
+		/* Batch version of RotationFromQuaternion, results are the same, see Kernels.hpp */
+		void RotationFromQuaternion_batch(const float4 * quaternions, float12 * res, Platform::uint32 count);
+
+		/* Transforms x, y and z streams of points, see Kernels.hpp */
+		void Transform_points_batch(const float12 & matrix, const float4_soa & points, const float4_soa & res, Platform::uint32 count);
 	}
 }
 
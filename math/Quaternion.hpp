@@ -33,42 +33,32 @@
 #define UTILITIES_MATH_QUATERNION_HPP
 
 #include "Float4.hpp"
+#include "Transcendental.hpp"
 #include <math.h>
 
 namespace Math
 {
 	namespace Quaternion
 	{
-		inline float4 Make(float j, float x, float y, float z)
+		inline float4 Make(float j, const float4 & axis)
 		{
-			float4 res;
+			float4 res, sinVal, cosVal, temp;
 
-			float rad = j / 2.0f;
-			float sinVal = sin(rad);
+			Sincos(Float4::Set(j / 2.0f), sinVal, cosVal);
 
-			res = Float4::Set(x, y, z, 0.0f);
-				
-			res = res * sinVal;
-			res.w = cos(rad);
+			/* x, y and z from axis * sin, w from cos */
+			res = axis * sinVal;
+			temp.m128 = _mm_unpackhi_ps(res.m128, cosVal.m128);
+			res.m128 = _mm_shuffle_ps(res.m128, temp.m128, _MM_SHUFFLE(3, 0, 1, 0));
 
 			res = Normalise(res);
 
 			return res;
 		}
 
-		inline float4 Make(float j, const float4 & axis)
+		inline float4 Make(float j, float x, float y, float z)
 		{
-			float4 res;
-
-			float rad = j / 2.0f;
-			float sinVal = sin(rad);
-				
-			res = axis * sinVal;
-			res.w = cos(rad);
-
-			res = Normalise(res);
-
-			return res;
+			return Make(j, Float4::Set(x, y, z, 0.0f));
 		}
 
 		inline float4 MakeFromPoint(const float4 & point)
@@ -178,6 +168,95 @@ namespace Math
 
 			return res;
 		}
+
+		/*
+		 * Approximations used by Slerp. FastAcos is valid for x in [0, 1],
+		 * absolute error is below 2e-8 (Abramowitz and Stegun 4.4.46).
+		 * FastSin is Taylor series up to x^11, valid for x in [0, pi/2],
+		 * absolute error is below 6e-8. Error of float arithmetic is added
+		 * to both.
+		 */
+		inline float FastAcos(float x)
+		{
+			float res = -0.0012624911f;
+
+			res = res * x + 0.0066700901f;
+			res = res * x + -0.0170881256f;
+			res = res * x + 0.0308918810f;
+			res = res * x + -0.0501743046f;
+			res = res * x + 0.0889789874f;
+			res = res * x + -0.2145988016f;
+			res = res * x + 1.5707963050f;
+
+			return sqrtf(1.0f - x) * res;
+		}
+
+		inline float FastSin(float x)
+		{
+			const float x2 = x * x;
+			float res = -2.5052108e-8f;
+
+			res = res * x2 + 2.7557319e-6f;
+			res = res * x2 + -1.9841270e-4f;
+			res = res * x2 + 8.3333333e-3f;
+			res = res * x2 + -1.6666667e-1f;
+			res = res * x2 + 1.0f;
+
+			return res * x;
+		}
+
+		/* Above this cosine of angle between quaternions Slerp falls back to normalised lerp */
+		static const float slerpThreshold = 0.9995f;
+
+		/*
+		 * Spherical interpolation along shorter arc, quaternions have to be
+		 * normalised. Result is normalised with exact square root.
+		 */
+		inline float4 Slerp(const float4 & a, const float4 & b, float percent)
+		{
+			float4 res, target;
+			float cosine, sign, weightA, weightB, length;
+
+			cosine = ((a.x * b.x + a.y * b.y) + a.z * b.z) + a.w * b.w;
+
+			sign = (0.0f > cosine) ? -1.0f : 1.0f;
+			target = b * sign;
+			cosine = cosine * sign;
+
+			if (slerpThreshold < cosine)
+			{
+				weightA = 1.0f - percent;
+				weightB = percent;
+			}
+			else
+			{
+				const float angle = FastAcos(cosine);
+				const float sine = sqrtf(1.0f - cosine * cosine);
+
+				weightA = FastSin((1.0f - percent) * angle) / sine;
+				weightB = FastSin(percent * angle) / sine;
+			}
+
+			res = a * weightA + target * weightB;
+
+			length = sqrtf(((res.x * res.x + res.y * res.y) + res.z * res.z) + res.w * res.w);
+
+			res.x = res.x / length;
+			res.y = res.y / length;
+			res.z = res.z / length;
+			res.w = res.w / length;
+
+			return res;
+		}
+
+		/* Batch version of Slerp, percent is given for each pair. Results are the same, see Kernels.hpp */
+		void Slerp_batch(const float4 * a, const float4 * b, const float * percent, float4 * res, Platform::uint32 count);
+
+		/* Batch version of Rotate, see Kernels.hpp */
+		void Rotate_batch(const float4 * points, const float4 * quaternions, float4 * res, Platform::uint32 count);
+
+		/* Structure of arrays version, x, y and z streams of points are rotated */
+		void Rotate_batch(const float4_soa & points, const float4_soa & quaternions, const float4_soa & res, Platform::uint32 count);
 	}
 }
 
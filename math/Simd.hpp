@@ -0,0 +1,71 @@
+/** License
+ * 
+ * Copyright (c) 2015 Adam migielski
+ * 
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a 
+ *      copy of this software and associated documentation files (the 
+ *      "Software"), to deal in the Software without restriction, including 
+ *      without limitation the rights to use, copy, modify, merge, publish, 
+ *      distribute, sublicense, and/or sell copies of the Software, and to 
+ *      permit persons to whom the Software is furnished to do so, subject to 
+ *      the following conditions: The above copyright notice and this permission 
+ *      notice shall be included in all copies or substantial portions of the 
+ *      Software. 
+ *
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ *      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ *      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ *      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ *      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ *      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ *      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+ *
+ **/
+ 
+/**
+ * @author Adam migielski
+ * @file Simd.hpp
+ **/
+
+#ifndef UTILITIES_MATH_SIMD_HPP
+#define UTILITIES_MATH_SIMD_HPP
+
+/*
+ * Instruction set used by float4, float12 and float16 operations.
+ *
+ * Level is selected at build time with UTILITIES_MATH_SIMD option, see
+ * CMakeLists.txt. When level is not defined it follows instruction set
+ * enabled for compiler.
+ *
+ * Wider levels process two or four rows with single instruction. Order
+ * of operations is kept and no fused multiply-add is used, results are
+ * bit-identical with SSE level.
+ */
+#define UTILITIES_MATH_SIMD_SSE    1
+#define UTILITIES_MATH_SIMD_AVX    2
+#define UTILITIES_MATH_SIMD_AVX512 3
+
+#ifndef UTILITIES_MATH_SIMD_LEVEL
+
+#if defined(__AVX512F__)
+#define UTILITIES_MATH_SIMD_LEVEL UTILITIES_MATH_SIMD_AVX512
+#elif defined(__AVX__)
+#define UTILITIES_MATH_SIMD_LEVEL UTILITIES_MATH_SIMD_AVX
+#else
+#define UTILITIES_MATH_SIMD_LEVEL UTILITIES_MATH_SIMD_SSE
+#endif
+
+#endif /* UTILITIES_MATH_SIMD_LEVEL */
+
+#if (UTILITIES_MATH_SIMD_LEVEL > UTILITIES_MATH_SIMD_SSE)
+#include <immintrin.h>
+#else
+#include <xmmintrin.h>
+#endif
+
+/* Mask of first 12 floats, used to process float12 as single 512 bit register */
+#define UTILITIES_MATH_SIMD_FLOAT12_MASK 0x0fff
+
+#endif /* UTILITIES_MATH_SIMD_HPP */
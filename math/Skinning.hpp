@@ -0,0 +1,122 @@
+/** License
+ * 
+ * Copyright (c) 2015 Adam migielski
+ * 
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a 
+ *      copy of this software and associated documentation files (the 
+ *      "Software"), to deal in the Software without restriction, including 
+ *      without limitation the rights to use, copy, modify, merge, publish, 
+ *      distribute, sublicense, and/or sell copies of the Software, and to 
+ *      permit persons to whom the Software is furnished to do so, subject to 
+ *      the following conditions: The above copyright notice and this permission 
+ *      notice shall be included in all copies or substantial portions of the 
+ *      Software. 
+ *
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ *      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ *      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ *      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ *      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ *      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ *      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+ *
+ **/
+ 
+/**
+ * @author Adam migielski
+ * @file Skinning.hpp
+ **/
+
+#ifndef UTILITIES_MATH_SKINNING_HPP
+#define UTILITIES_MATH_SKINNING_HPP
+
+#include "Float4.hpp"
+
+/*
+ * Linear blend skinning. Each vertex is influenced by four bones, indices
+ * and weights are stored as four consecutive entries per vertex. Weights
+ * should sum to one, unused influences have weight 0 and any valid index.
+ * Bones are matrices of skinning palette, already multiplied by inverse of
+ * bind pose.
+ */
+namespace Math
+{
+	namespace Skinning
+	{
+		static const Platform::uint32 influences = 4;
+
+		/* Weighted sum of bone matrices */
+		inline float12 Blend(const float12 * bones, const Platform::uint16 * indices, const float * weights)
+		{
+			float12 res;
+
+			res.x = bones[indices[0]].x * weights[0];
+			res.y = bones[indices[0]].y * weights[0];
+			res.z = bones[indices[0]].z * weights[0];
+
+			for (Platform::uint32 i = 1; i < influences; ++i)
+			{
+				const float12 & bone = bones[indices[i]];
+
+				res.x = res.x + bone.x * weights[i];
+				res.y = res.y + bone.y * weights[i];
+				res.z = res.z + bone.z * weights[i];
+			}
+
+			return res;
+		}
+
+		/* Elements are summed in the same order as in batch kernels */
+		inline float Dot(const float4 & row, const float4 & point)
+		{
+			const float4 temp = row * point;
+
+			return (temp.x + temp.z) + (temp.y + temp.w);
+		}
+
+		inline float4 Skin_point(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4 & point)
+		{
+			const float12 matrix = Blend(bones, indices, weights);
+			float4 res, temp;
+
+			temp = point;
+			temp.w = 1.0f;
+
+			res.x = Dot(matrix.x, temp);
+			res.y = Dot(matrix.y, temp);
+			res.z = Dot(matrix.z, temp);
+			res.w = 1.0f;
+
+			return res;
+		}
+
+		/* Translation is ignored, result is not normalised */
+		inline float4 Skin_vector(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4 & vector)
+		{
+			const float12 matrix = Blend(bones, indices, weights);
+			float4 res, temp;
+
+			temp = vector;
+			temp.w = 0.0f;
+
+			res.x = Dot(matrix.x, temp);
+			res.y = Dot(matrix.y, temp);
+			res.z = Dot(matrix.z, temp);
+			res.w = 0.0f;
+
+			return res;
+		}
+
+		/*
+		 * Batch versions, x, y and z streams of points or vectors are
+		 * transformed, n-th vertex uses entries [4 * n, 4 * n + 4) of
+		 * indices and weights. Results are the same, see Kernels.hpp
+		 */
+		void Skin_points_batch(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4_soa & points, const float4_soa & res, Platform::uint32 count);
+		void Skin_vectors_batch(const float12 * bones, const Platform::uint16 * indices, const float * weights, const float4_soa & vectors, const float4_soa & res, Platform::uint32 count);
+	}
+}
+
+#endif /* UTILITIES_MATH_SKINNING_HPP */
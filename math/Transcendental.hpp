@@ -0,0 +1,309 @@
+/** License
+ * 
+ * Copyright (c) 2015 Adam migielski
+ * 
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a 
+ *      copy of this software and associated documentation files (the 
+ *      "Software"), to deal in the Software without restriction, including 
+ *      without limitation the rights to use, copy, modify, merge, publish, 
+ *      distribute, sublicense, and/or sell copies of the Software, and to 
+ *      permit persons to whom the Software is furnished to do so, subject to 
+ *      the following conditions: The above copyright notice and this permission 
+ *      notice shall be included in all copies or substantial portions of the 
+ *      Software. 
+ *
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ *      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ *      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ *      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ *      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ *      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ *      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+ *
+ **/
+ 
+/**
+ * @author Adam migielski
+ * @file Transcendental.hpp
+ **/
+
+#ifndef UTILITIES_MATH_TRANSCENDENTAL_HPP
+#define UTILITIES_MATH_TRANSCENDENTAL_HPP
+
+#include "Float4.hpp"
+
+/*
+ * Polynomial approximations working on four values at once, only SSE2 is
+ * used. Coefficients and range reductions come from Cephes library.
+ *
+ * Errors are measured against double precision functions and given in
+ * units in the last place of float result. Denormal results may be
+ * flushed to zero.
+ */
+namespace Math
+{
+	namespace Transcendental
+	{
+		inline __m128 sign_mask()
+		{
+			return _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+		}
+
+		inline __m128 select(__m128 mask, __m128 a, __m128 b)
+		{
+			return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+		}
+
+		/* Rounding towards minus infinity, |x| has to be below 2^31 */
+		inline __m128 floor(__m128 x)
+		{
+			const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+			const __m128 correction = _mm_and_ps(_mm_cmpgt_ps(truncated, x), _mm_set1_ps(1.0f));
+
+			return _mm_sub_ps(truncated, correction);
+		}
+	}
+
+	/*
+	 * Sine and cosine share range reduction. Angle is reduced to [-pi/4, pi/4]
+	 * with pi/4 split into three parts. For |angle| up to 8192 error is below
+	 * 2 ulp, close to zeros of result only absolute error below 8e-8 holds.
+	 * Precision is lost for larger angles.
+	 */
+	inline void Sincos(const float4 & angle, float4 & sine, float4 & cosine)
+	{
+		const __m128 sign = Transcendental::sign_mask();
+		__m128 x, y, z, sin_sign, cos_sign, is_sin_poly, poly_sin, poly_cos;
+		__m128i octant;
+
+		sin_sign = _mm_and_ps(angle.m128, sign);
+		x = _mm_andnot_ps(sign, angle.m128);
+
+		/* Even octant, x * 4 / pi is rounded up to it */
+		octant = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.27323954473516f)));
+		octant = _mm_add_epi32(octant, _mm_set1_epi32(1));
+		octant = _mm_and_si128(octant, _mm_set1_epi32(~1));
+		y = _mm_cvtepi32_ps(octant);
+
+		/* Octants 4 to 7 negate sine, octants 2, 3, 6 and 7 swap polynomials */
+		sin_sign = _mm_xor_ps(sin_sign, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(octant, _mm_set1_epi32(4)), 29)));
+		cos_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(octant, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+		is_sin_poly = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(octant, _mm_set1_epi32(2)), _mm_setzero_si128()));
+
+		/* x - y * pi / 4 in extended precision */
+		x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(0.78515625f)));
+		x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(2.4187564849853515625e-4f)));
+		x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(3.77489497744594108e-8f)));
+
+		z = _mm_mul_ps(x, x);
+
+		poly_cos = _mm_set1_ps(2.443315711809948e-5f);
+		poly_cos = _mm_add_ps(_mm_mul_ps(poly_cos, z), _mm_set1_ps(-1.388731625493765e-3f));
+		poly_cos = _mm_add_ps(_mm_mul_ps(poly_cos, z), _mm_set1_ps(4.166664568298827e-2f));
+		poly_cos = _mm_mul_ps(_mm_mul_ps(poly_cos, z), z);
+		poly_cos = _mm_sub_ps(poly_cos, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+		poly_cos = _mm_add_ps(poly_cos, _mm_set1_ps(1.0f));
+
+		poly_sin = _mm_set1_ps(-1.9515295891e-4f);
+		poly_sin = _mm_add_ps(_mm_mul_ps(poly_sin, z), _mm_set1_ps(8.3321608736e-3f));
+		poly_sin = _mm_add_ps(_mm_mul_ps(poly_sin, z), _mm_set1_ps(-1.6666654611e-1f));
+		poly_sin = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(poly_sin, z), x), x);
+
+		sine.m128 = _mm_xor_ps(Transcendental::select(is_sin_poly, poly_sin, poly_cos), sin_sign);
+		cosine.m128 = _mm_xor_ps(Transcendental::select(is_sin_poly, poly_cos, poly_sin), cos_sign);
+	}
+
+	inline float4 Sin(const float4 & angle)
+	{
+		float4 sine, cosine;
+
+		Sincos(angle, sine, cosine);
+
+		return sine;
+	}
+
+	inline float4 Cos(const float4 & angle)
+	{
+		float4 sine, cosine;
+
+		Sincos(angle, sine, cosine);
+
+		return cosine;
+	}
+
+	/*
+	 * Error is below 1 ulp. Argument is clamped to [-88.37, 88.37], larger
+	 * values give 2.4e38 and smaller give zero.
+	 */
+	inline float4 Exp(const float4 & a)
+	{
+		float4 res;
+		__m128 x, n, y, z;
+		__m128i exponent;
+
+		x = _mm_min_ps(a.m128, _mm_set1_ps(88.3762626647949f));
+		x = _mm_max_ps(x, _mm_set1_ps(-88.3762626647949f));
+
+		/* exp(x) = 2^n * exp(x - n * ln2), ln2 is split into two parts */
+		n = Transcendental::floor(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)), _mm_set1_ps(0.5f)));
+		x = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(0.693359375f)));
+		x = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(-2.12194440e-4f)));
+
+		z = _mm_mul_ps(x, x);
+
+		y = _mm_set1_ps(1.9875691500e-4f);
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.3981999507e-3f));
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073e-3f));
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894e-2f));
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459e-1f));
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201e-1f));
+		y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), _mm_set1_ps(1.0f));
+
+		/* 2^n built directly in exponent bits */
+		exponent = _mm_add_epi32(_mm_cvttps_epi32(n), _mm_set1_epi32(0x7f));
+		exponent = _mm_slli_epi32(exponent, 23);
+
+		res.m128 = _mm_mul_ps(y, _mm_castsi128_ps(exponent));
+
+		return res;
+	}
+
+	/*
+	 * Natural logarithm, error is below 1 ulp. Zero, negative values and NaN
+	 * give NaN, denormals are treated as the smallest normal value and
+	 * infinity gives infinity.
+	 */
+	inline float4 Log(const float4 & a)
+	{
+		float4 res;
+		const __m128 infinity = _mm_castsi128_ps(_mm_set1_epi32(0x7f800000));
+		__m128 x, e, y, z, is_invalid, is_small;
+		__m128i exponent;
+
+		is_invalid = _mm_cmpngt_ps(a.m128, _mm_setzero_ps());
+
+		x = _mm_max_ps(a.m128, _mm_castsi128_ps(_mm_set1_epi32(0x00800000)));
+
+		/* x = m * 2^e, m is in [0.5, 1) */
+		exponent = _mm_srli_epi32(_mm_castps_si128(x), 23);
+		e = _mm_cvtepi32_ps(_mm_sub_epi32(exponent, _mm_set1_epi32(0x7e)));
+
+		x = _mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(~0x7f800000)));
+		x = _mm_or_ps(x, _mm_set1_ps(0.5f));
+
+		/* m below sqrt(0.5) is doubled, so m - 1 is in [-0.29, 0.41] */
+		is_small = _mm_cmplt_ps(x, _mm_set1_ps(0.707106781186547524f));
+		e = _mm_sub_ps(e, _mm_and_ps(is_small, _mm_set1_ps(1.0f)));
+		x = _mm_add_ps(_mm_sub_ps(x, _mm_set1_ps(1.0f)), _mm_and_ps(is_small, x));
+
+		z = _mm_mul_ps(x, x);
+
+		y = _mm_set1_ps(7.0376836292e-2f);
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.1514610310e-1f));
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.1676998740e-1f));
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.2420140846e-1f));
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.4249322787e-1f));
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.6668057665e-1f));
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(2.0000714765e-1f));
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-2.4999993993e-1f));
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(3.3333331174e-1f));
+		y = _mm_mul_ps(_mm_mul_ps(y, x), z);
+
+		/* log(x) = log(m) + e * ln2, ln2 is split into two parts */
+		y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(-2.12194440e-4f)));
+		y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+		x = _mm_add_ps(x, y);
+		x = _mm_add_ps(x, _mm_mul_ps(e, _mm_set1_ps(0.693359375f)));
+
+		x = _mm_or_ps(x, is_invalid);
+
+		res.m128 = Transcendental::select(_mm_cmpeq_ps(a.m128, infinity), infinity, x);
+
+		return res;
+	}
+
+	/*
+	 * Angle of point (x, y) in [-pi, pi], signs of zeros are handled as by
+	 * atan2 from C library. Error is below 3.5 ulp. Both coordinates infinite
+	 * give NaN.
+	 */
+	inline float4 Atan2(const float4 & y, const float4 & x)
+	{
+		const __m128 sign = Transcendental::sign_mask();
+		float4 res;
+		__m128 abs_x, abs_y, numerator, denominator, a, z, r, is_reduced, is_steep, is_left;
+
+		abs_x = _mm_andnot_ps(sign, x.m128);
+		abs_y = _mm_andnot_ps(sign, y.m128);
+
+		/* Ratio in [0, 1], 0 / 0 gives 0 */
+		numerator = _mm_min_ps(abs_x, abs_y);
+		denominator = _mm_max_ps(abs_x, abs_y);
+		a = _mm_and_ps(_mm_div_ps(numerator, denominator), _mm_cmpneq_ps(denominator, _mm_setzero_ps()));
+
+		/* atan(a) = pi/4 + atan((a - 1) / (a + 1)) for a above tan(pi/8) */
+		is_reduced = _mm_cmpgt_ps(a, _mm_set1_ps(0.4142135623730950f));
+		a = Transcendental::select(
+			is_reduced,
+			_mm_div_ps(_mm_sub_ps(a, _mm_set1_ps(1.0f)), _mm_add_ps(a, _mm_set1_ps(1.0f))),
+			a);
+
+		z = _mm_mul_ps(a, a);
+
+		r = _mm_set1_ps(8.05374449538e-2f);
+		r = _mm_add_ps(_mm_mul_ps(r, z), _mm_set1_ps(-1.38776856032e-1f));
+		r = _mm_add_ps(_mm_mul_ps(r, z), _mm_set1_ps(1.99777106478e-1f));
+		r = _mm_add_ps(_mm_mul_ps(r, z), _mm_set1_ps(-3.33329491539e-1f));
+		r = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(r, z), a), a);
+		r = _mm_add_ps(r, _mm_and_ps(is_reduced, _mm_set1_ps(0.785398163397448309f)));
+
+		/* Octant of (|x|, |y|), then half plane of x */
+		is_steep = _mm_cmpgt_ps(abs_y, abs_x);
+		r = Transcendental::select(is_steep, _mm_sub_ps(_mm_set1_ps(1.57079632679489662f), r), r);
+
+		is_left = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(x.m128), 31));
+		r = Transcendental::select(is_left, _mm_sub_ps(_mm_set1_ps(3.14159265358979324f), r), r);
+
+		res.m128 = _mm_or_ps(r, _mm_and_ps(y.m128, sign));
+
+		return res;
+	}
+
+	/*
+	 * Hardware approximations refined with one Newton-Raphson step. Relative
+	 * error drops from 1.5 * 2^-12 to below 4 ulp for Rsqrt and 3.5 ulp for
+	 * Rcp. Argument has to be positive and finite for Rsqrt, non zero and
+	 * finite for Rcp.
+	 */
+	inline float4 Rsqrt(const float4 & a)
+	{
+		float4 res;
+		__m128 r;
+
+		r = _mm_rsqrt_ps(a.m128);
+
+		/* r * (3 - a * r * r) / 2 */
+		res.m128 = _mm_mul_ps(
+			_mm_mul_ps(_mm_set1_ps(0.5f), r),
+			_mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(_mm_mul_ps(a.m128, r), r)));
+
+		return res;
+	}
+
+	inline float4 Rcp(const float4 & a)
+	{
+		float4 res;
+		__m128 r;
+
+		r = _mm_rcp_ps(a.m128);
+
+		/* r * (2 - a * r) */
+		res.m128 = _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(2.0f), _mm_mul_ps(a.m128, r)));
+
+		return res;
+	}
+}
+
+#endif /* UTILITIES_MATH_TRANSCENDENTAL_HPP */
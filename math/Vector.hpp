@@ -84,6 +84,10 @@ namespace Math
 
 			return res;
 		}
+
+		/* Structure of arrays versions, only x, y and z streams are used, see Kernels.hpp */
+		void Dot_batch(const float4_soa & a, const float4_soa & b, float * res, Platform::uint32 count);
+		void Cross_batch(const float4_soa & a, const float4_soa & b, const float4_soa & res, Platform::uint32 count);
 	}
 }
 
@@ -0,0 +1,603 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file benchmark.cpp
+**/
+
+#include "PCH.hpp"
+
+#include "Bounds.hpp"
+#include "Cpu.hpp"
+#include "Kernels.hpp"
+#include "Matrix.hpp"
+#include "Quaternion.hpp"
+#include "Skinning.hpp"
+#include "Transcendental.hpp"
+#include "Vector.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if (UTILITIES_COMPILER == UTILITIES_COMPIELR_MSVC)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+/** \brief Measures inline functions and batch kernels of math
+ *
+ * Single form calls inline function for each element of arrays, batch
+ * form calls *_batch function once. Each measurement is repeated and the
+ * fastest sample is reported as time stamp counter cycles per element and
+ * elements per second.
+ *
+ * Usage: math_benchmark [--filter text] [--json file] [--baseline file] [--threshold percent]
+ *
+ * --json writes results for comparison between commits, --baseline reads
+ * such file and exit code is 1 when any benchmark got slower by more than
+ * threshold, 10 percent by default.
+ **/
+
+using clock_type = std::chrono::steady_clock;
+
+static const Platform::uint32 n_elements = 1024;
+static const Platform::uint32 n_samples = 25;
+static const Platform::uint32 n_passes = 8;
+
+struct Result
+{
+    std::string m_name;
+    const char * m_form;
+    double m_cycles_per_element;
+    double m_elements_per_second;
+};
+
+struct Data
+{
+    std::vector< Math::float4 > m_a4;
+    std::vector< Math::float4 > m_b4;
+    std::vector< Math::float4 > m_quaternions;
+    std::vector< Math::float4 > m_res4;
+    std::vector< Math::float12 > m_a12;
+    std::vector< Math::float12 > m_b12;
+    std::vector< Math::float12 > m_res12;
+    std::vector< Math::float16 > m_a16;
+    std::vector< Math::float16 > m_b16;
+    std::vector< Math::float16 > m_res16;
+    std::vector< float > m_scalars;
+    std::vector< float > m_percent;
+    std::vector< float > m_streams[8];
+    std::vector< float > m_res_streams[3];
+    std::vector< Platform::uint16 > m_indices;
+    std::vector< float > m_weights;
+    Math::float4_soa m_soa_a;
+    Math::float4_soa m_soa_b;
+    Math::float4_soa m_soa_res;
+};
+
+static std::vector< Result > s_results;
+static const char * s_filter = nullptr;
+static volatile float s_sink = 0.0f;
+
+static float value(Platform::uint32 i, float seed)
+{
+    return seed + float(i % 17) * 0.37f - float(i % 5) * 0.11f;
+}
+
+static void fill_matrix(float * data, Platform::uint32 rows, Platform::uint32 i)
+{
+    for (Platform::uint32 n = 0; n < rows * 4; ++n)
+    {
+        data[n] = value(i + n, -0.5f) * 0.25f;
+    }
+
+    /* Dominant diagonal, matrix is invertible */
+    for (Platform::uint32 n = 0; n < rows; ++n)
+    {
+        data[n * 5] += 4.0f;
+    }
+}
+
+static void prepare(Data & data)
+{
+    data.m_a4.resize(n_elements);
+    data.m_b4.resize(n_elements);
+    data.m_quaternions.resize(n_elements);
+    data.m_res4.resize(n_elements);
+    data.m_a12.resize(n_elements);
+    data.m_b12.resize(n_elements);
+    data.m_res12.resize(n_elements);
+    data.m_a16.resize(n_elements);
+    data.m_b16.resize(n_elements);
+    data.m_res16.resize(n_elements);
+    data.m_scalars.resize(n_elements);
+    data.m_percent.resize(n_elements);
+    data.m_indices.resize(n_elements * Math::Skinning::influences);
+    data.m_weights.resize(n_elements * Math::Skinning::influences);
+
+    for (auto & stream : data.m_streams)
+    {
+        stream.resize(n_elements);
+    }
+
+    for (auto & stream : data.m_res_streams)
+    {
+        stream.resize(n_elements);
+    }
+
+    for (Platform::uint32 i = 0; i < n_elements; ++i)
+    {
+        data.m_a4[i] = Math::Float4::Set(value(i, 1.0f), value(i, 2.0f), value(i, -1.0f), value(i, 0.5f));
+        data.m_b4[i] = Math::Float4::Set(value(i, -2.0f), value(i, 0.25f), value(i, 3.0f), value(i, 1.5f));
+        data.m_quaternions[i] = Math::Quaternion::Make(value(i, 0.1f), data.m_a4[i]);
+        data.m_scalars[i] = value(i, 0.75f);
+        data.m_percent[i] = float(i % 101) / 100.0f;
+
+        fill_matrix(data.m_a12[i].f, 3, i);
+        fill_matrix(data.m_b12[i].f, 3, i + 7);
+        fill_matrix(data.m_a16[i].f, 4, i);
+        fill_matrix(data.m_b16[i].f, 4, i + 7);
+
+        for (Platform::uint32 k = 0; k < 8; ++k)
+        {
+            data.m_streams[k][i] = value(i, float(k));
+        }
+
+        for (Platform::uint32 k = 0; k < Math::Skinning::influences; ++k)
+        {
+            data.m_indices[i * Math::Skinning::influences + k] = Platform::uint16((i + k * 3) % 64);
+            data.m_weights[i * Math::Skinning::influences + k] = 0.25f;
+        }
+    }
+
+    data.m_soa_a = { data.m_streams[0].data(), data.m_streams[1].data(), data.m_streams[2].data(), data.m_streams[3].data() };
+    data.m_soa_b = { data.m_streams[4].data(), data.m_streams[5].data(), data.m_streams[6].data(), data.m_streams[7].data() };
+
+    /* Results have own streams, writing over inputs would drift values between passes */
+    data.m_soa_res = { data.m_res_streams[0].data(), data.m_res_streams[1].data(), data.m_res_streams[2].data(), nullptr };
+}
+
+/* Compiler can not move work across time measurement */
+static void barrier()
+{
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+template <typename F>
+static void measure(const char * name, const char * form, const F & pass)
+{
+    if ((nullptr != s_filter) &&
+        (nullptr == strstr(name, s_filter)))
+    {
+        return;
+    }
+
+    Platform::uint64 best_cycles = ~Platform::uint64(0);
+    double best_seconds = 1.0e30;
+
+    /* Warm up caches and branch predictors */
+    pass();
+
+    for (Platform::uint32 sample = 0; sample < n_samples; ++sample)
+    {
+        barrier();
+        const auto begin = clock_type::now();
+        const Platform::uint64 begin_cycles = __rdtsc();
+        barrier();
+
+        for (Platform::uint32 i = 0; i < n_passes; ++i)
+        {
+            pass();
+            barrier();
+        }
+
+        const Platform::uint64 cycles = __rdtsc() - begin_cycles;
+        const double seconds = std::chrono::duration< double >(clock_type::now() - begin).count();
+        barrier();
+
+        best_cycles = (cycles < best_cycles) ? cycles : best_cycles;
+        best_seconds = (seconds < best_seconds) ? seconds : best_seconds;
+    }
+
+    const double elements = double(n_elements) * double(n_passes);
+    const Result result = { name, form, double(best_cycles) / elements, elements / best_seconds };
+
+    printf("%-48s %-6s %10.2f %14.0f\n", name, form, result.m_cycles_per_element, result.m_elements_per_second);
+
+    s_results.push_back(result);
+}
+
+static void benchmark_float4(Data & data)
+{
+    const Math::float4 * a = data.m_a4.data();
+    const Math::float4 * b = data.m_b4.data();
+    const float * s = data.m_scalars.data();
+    Math::float4 * res = data.m_res4.data();
+
+    measure("Float4::Set", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Float4::Set(s[i], s[i], s[i], 1.0f); });
+    measure("Float4::Set float", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Float4::Set(s[i]); });
+    measure("Float4::Zero", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Float4::Zero(); });
+    measure("Float4::One", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Float4::One(); });
+    measure("Float4 operator +", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = a[i] + b[i]; });
+    measure("Float4 operator -", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = a[i] - b[i]; });
+    measure("Float4 operator *", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = a[i] * b[i]; });
+    measure("Float4 operator * float", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = a[i] * s[i]; });
+    measure("Float4 operator /", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = a[i] / b[i]; });
+    measure("Float4 operator / float", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = a[i] / s[i]; });
+    measure("Float4 Sum", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i].x = Math::Sum(a[i]); });
+    measure("Float4 SquareLength", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i].x = Math::SquareLength(a[i]); });
+    measure("Float4 Normalise", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Normalise(a[i]); });
+    measure("Float4 Lerp", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Lerp(a[i], b[i], b[i]); });
+
+    measure("Float4 Normalise", "batch", [&]() { Math::Normalise_batch(a, res, n_elements); });
+    measure("Float4 Lerp", "batch", [&]() { Math::Lerp_batch(a, b, b, res, n_elements); });
+
+    measure("Float4 Sincos", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; i += 2) Math::Sincos(a[i], res[i], res[i + 1]); });
+    measure("Float4 Exp", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Exp(a[i]); });
+    measure("Float4 Log", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Log(a[i]); });
+    measure("Float4 Atan2", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Atan2(a[i], b[i]); });
+    measure("Float4 Rsqrt", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Rsqrt(b[i]); });
+    measure("Float4 Rcp", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Rcp(b[i]); });
+}
+
+static void benchmark_float12_float16(Data & data)
+{
+    const Math::float12 * a12 = data.m_a12.data();
+    const Math::float12 * b12 = data.m_b12.data();
+    const Math::float16 * a16 = data.m_a16.data();
+    const Math::float16 * b16 = data.m_b16.data();
+    const float * s = data.m_scalars.data();
+    Math::float12 * res12 = data.m_res12.data();
+    Math::float16 * res16 = data.m_res16.data();
+
+    measure("Float12::Set", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res12[i] = Math::Float12::Set(s[i]); });
+    measure("Float12::Set float16", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res12[i] = Math::Float12::Set(a16[i]); });
+    measure("Float12 operator +", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res12[i] = a12[i] + b12[i]; });
+    measure("Float12 operator -", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res12[i] = a12[i] - b12[i]; });
+    measure("Float12 operator *", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res12[i] = a12[i] * b12[i]; });
+    measure("Float12 operator * float", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res12[i] = a12[i] * s[i]; });
+    measure("Float12 operator /", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res12[i] = a12[i] / b12[i]; });
+
+    measure("Float16 operator +", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res16[i] = a16[i] + b16[i]; });
+    measure("Float16 operator -", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res16[i] = a16[i] - b16[i]; });
+    measure("Float16 operator *", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res16[i] = a16[i] * b16[i]; });
+    measure("Float16 operator * float", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res16[i] = a16[i] * s[i]; });
+    measure("Float16 operator /", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res16[i] = a16[i] / b16[i]; });
+    measure("Float16 Transpose", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res16[i] = Math::Float16::Transpose(a16[i]); });
+}
+
+static void benchmark_matrix(Data & data)
+{
+    const Math::float12 * a12 = data.m_a12.data();
+    const Math::float12 * b12 = data.m_b12.data();
+    const Math::float16 * a16 = data.m_a16.data();
+    const Math::float16 * b16 = data.m_b16.data();
+    const Math::float4 * quaternions = data.m_quaternions.data();
+    const Math::float4 * b4 = data.m_b4.data();
+    float * s = data.m_streams[7].data();
+    Math::float12 * res12 = data.m_res12.data();
+    Math::float16 * res16 = data.m_res16.data();
+
+    measure("Matrix::Multiply float16", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res16[i] = Math::Matrix::Multiply(a16[i], b16[i]); });
+    measure("Matrix::Multiply float12", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res12[i] = Math::Matrix::Multiply(a12[i], b12[i]); });
+    measure("Matrix::Multiply float16 float12", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res12[i] = Math::Matrix::Multiply(a16[i], b12[i]); });
+    measure("Matrix::Multiply float12 float16", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res12[i] = Math::Matrix::Multiply(a12[i], b16[i]); });
+    measure("Matrix::RotationFromQuaternion", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res12[i] = Math::Matrix::RotationFromQuaternion(quaternions[i]); });
+    measure("Matrix::TransformationFromQuaternionAndVector", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res12[i] = Math::Matrix::TransformationFromQuaternionAndVector(quaternions[i], b4[i]); });
+    measure("Matrix::Determinant float16", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) s[i] = Math::Matrix::Determinant(a16[i]); });
+    measure("Matrix::Determinant float12", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) s[i] = Math::Matrix::Determinant(a12[i]); });
+    measure("Matrix::Inverse float16", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res16[i] = Math::Matrix::Inverse(a16[i]); });
+    measure("Matrix::Inverse float12", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res12[i] = Math::Matrix::Inverse(a12[i]); });
+    measure("Matrix::Inverse_rigid", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res12[i] = Math::Matrix::Inverse_rigid(a12[i]); });
+
+    measure("Matrix::Multiply float16", "batch", [&]() { Math::Matrix::Multiply_batch(a16, b16, res16, n_elements); });
+    measure("Matrix::Multiply float12", "batch", [&]() { Math::Matrix::Multiply_batch(a12, b12, res12, n_elements); });
+    measure("Matrix::RotationFromQuaternion", "batch", [&]() { Math::Matrix::RotationFromQuaternion_batch(quaternions, res12, n_elements); });
+    measure("Matrix::Determinant float16", "batch", [&]() { Math::Matrix::Determinant_batch(a16, s, n_elements); });
+    measure("Matrix::Determinant float12", "batch", [&]() { Math::Matrix::Determinant_batch(a12, s, n_elements); });
+    measure("Matrix::Inverse float16", "batch", [&]() { Math::Matrix::Inverse_batch(a16, res16, n_elements); });
+    measure("Matrix::Inverse float12", "batch", [&]() { Math::Matrix::Inverse_batch(a12, res12, n_elements); });
+    measure("Matrix::Inverse_rigid", "batch", [&]() { Math::Matrix::Inverse_rigid_batch(a12, res12, n_elements); });
+    measure("Matrix::Transform_points", "batch", [&]() { Math::Matrix::Transform_points_batch(a12[0], data.m_soa_a, data.m_soa_res, n_elements); });
+}
+
+static void benchmark_quaternion(Data & data)
+{
+    const Math::float4 * a = data.m_quaternions.data();
+    const Math::float4 * b = data.m_b4.data();
+    const float * percent = data.m_percent.data();
+    Math::float4 * res = data.m_res4.data();
+
+    /* Quaternions of b are not normalised, Slerp gets normalised ones */
+    std::vector< Math::float4 > targets(n_elements);
+    for (Platform::uint32 i = 0; i < n_elements; ++i)
+    {
+        targets[i] = a[(i * 7) % n_elements];
+    }
+    const Math::float4 * c = targets.data();
+
+    measure("Quaternion::MakeFromPoint", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Quaternion::MakeFromPoint(b[i]); });
+    measure("Quaternion::Make", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Quaternion::Make(percent[i], b[i]); });
+    measure("Quaternion::Multiply", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Quaternion::Multiply(a[i], b[i]); });
+    measure("Quaternion::Inverse", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Quaternion::Inverse(a[i]); });
+    measure("Quaternion::Rotate", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Quaternion::Rotate(b[i], a[i]); });
+    measure("Quaternion::NLerp", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Quaternion::NLerp(a[i], c[i], b[i]); });
+    measure("Quaternion::Slerp", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Quaternion::Slerp(a[i], c[i], percent[i]); });
+
+    measure("Quaternion::Rotate", "batch", [&]() { Math::Quaternion::Rotate_batch(b, a, res, n_elements); });
+    measure("Quaternion::Rotate soa", "batch", [&]() { Math::Quaternion::Rotate_batch(data.m_soa_a, data.m_soa_b, data.m_soa_res, n_elements); });
+    measure("Quaternion::Slerp", "batch", [&]() { Math::Quaternion::Slerp_batch(a, c, percent, res, n_elements); });
+}
+
+static void benchmark_vector(Data & data)
+{
+    const Math::float4 * a = data.m_a4.data();
+    const Math::float4 * b = data.m_b4.data();
+    Math::float4 * res = data.m_res4.data();
+    float * s = data.m_streams[7].data();
+
+    measure("Vector::Dot", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) s[i] = Math::Vector::Dot(a[i], b[i]); });
+    measure("Vector::Cross", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Vector::Cross(a[i], b[i]); });
+
+    measure("Vector::Dot", "batch", [&]() { Math::Vector::Dot_batch(data.m_soa_a, data.m_soa_b, s, n_elements); });
+    measure("Vector::Cross", "batch", [&]() { Math::Vector::Cross_batch(data.m_soa_a, data.m_soa_b, data.m_soa_res, n_elements); });
+}
+
+static void benchmark_skinning(Data & data)
+{
+    const Math::float12 * bones = data.m_a12.data();
+    const Platform::uint16 * indices = data.m_indices.data();
+    const float * weights = data.m_weights.data();
+    const Math::float4 * a = data.m_a4.data();
+    Math::float4 * res = data.m_res4.data();
+
+    measure("Skinning::Skin_point", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Skinning::Skin_point(bones, indices + i * 4, weights + i * 4, a[i]); });
+
+    measure("Skinning::Skin_points", "batch", [&]() { Math::Skinning::Skin_points_batch(bones, indices, weights, data.m_soa_a, data.m_soa_res, n_elements); });
+    measure("Skinning::Skin_vectors", "batch", [&]() { Math::Skinning::Skin_vectors_batch(bones, indices, weights, data.m_soa_a, data.m_soa_res, n_elements); });
+}
+
+static void benchmark_bounds(Data & data)
+{
+    const Math::frustum planes = Math::Bounds::Make_frustum(data.m_a16[0]);
+    const Math::aabb_soa boxes = { data.m_streams[0].data(), data.m_streams[1].data(), data.m_streams[2].data(), data.m_streams[4].data(), data.m_streams[5].data(), data.m_streams[6].data() };
+    const Math::float4_soa spheres = { data.m_streams[0].data(), data.m_streams[1].data(), data.m_streams[2].data(), data.m_streams[3].data() };
+    const Math::float12 * matrices = data.m_a12.data();
+    std::vector< Math::aabb > aabbs(n_elements);
+    std::vector< Math::aabb > results(n_elements);
+    std::vector< Platform::uint32 > visible(n_elements);
+    Platform::uint32 * indices = visible.data();
+
+    for (Platform::uint32 i = 0; i < n_elements; ++i)
+    {
+        aabbs[i] = Math::Bounds::Make_aabb(Math::Float4::Set(boxes.min_x[i], boxes.min_y[i], boxes.min_z[i], 0.0f), Math::Float4::Set(boxes.max_x[i], boxes.max_y[i], boxes.max_z[i], 0.0f));
+    }
+
+    const Math::aabb * a = aabbs.data();
+    Math::aabb * res = results.data();
+
+    measure("Bounds::Transform", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) res[i] = Math::Bounds::Transform(matrices[i], a[i]); });
+    measure("Bounds::Merge", "single", [&]() { for (Platform::uint32 i = 1; i < n_elements; ++i) res[i] = Math::Bounds::Merge(a[i - 1], a[i]); });
+    measure("Bounds::Is_visible aabb", "single", [&]() { for (Platform::uint32 i = 0; i < n_elements; ++i) indices[i] = Math::Bounds::Is_visible(planes, a[i]) ? 1 : 0; });
+
+    measure("Bounds::Cull aabb", "batch", [&]() { indices[0] = Math::Bounds::Cull_batch(planes, boxes, indices, n_elements); });
+    measure("Bounds::Cull sphere", "batch", [&]() { indices[0] = Math::Bounds::Cull_batch(planes, spheres, indices, n_elements); });
+}
+
+static const char * compiler_name()
+{
+#if (UTILITIES_COMPILER == UTILITIES_COMPIELR_MSVC)
+    static char name[32];
+
+    snprintf(name, sizeof(name), "MSVC %d", _MSC_FULL_VER);
+
+    return name;
+#else
+    return "GCC compatible " __VERSION__;
+#endif
+}
+
+static bool write_json(const char * path)
+{
+    FILE * file = fopen(path, "w");
+
+    if (nullptr == file)
+    {
+        return false;
+    }
+
+    /* One result per line, see read_baseline */
+    fprintf(file, "{\n");
+    fprintf(file, "  \"compiler\": \"%s\",\n", compiler_name());
+    fprintf(file, "  \"simd_level\": %d,\n", UTILITIES_MATH_SIMD_LEVEL);
+    fprintf(file, "  \"kernels\": \"%s\",\n", Math::Kernels::Get_name());
+    fprintf(file, "  \"elements\": %u,\n", n_elements);
+    fprintf(file, "  \"results\": [\n");
+
+    for (size_t i = 0; i < s_results.size(); ++i)
+    {
+        const Result & result = s_results[i];
+
+        fprintf(file, "    { \"name\": \"%s\", \"form\": \"%s\", \"cycles_per_element\": %.4f, \"elements_per_second\": %.0f }%s\n",
+            result.m_name.c_str(),
+            result.m_form,
+            result.m_cycles_per_element,
+            result.m_elements_per_second,
+            (i + 1 < s_results.size()) ? "," : "");
+    }
+
+    fprintf(file, "  ]\n");
+    fprintf(file, "}\n");
+    fclose(file);
+
+    return true;
+}
+
+/* Value of "key": "value" or "key": number, empty when key is missing */
+static std::string field(const std::string & line, const char * key)
+{
+    const std::string pattern = std::string("\"") + key + "\": ";
+    size_t begin = line.find(pattern);
+
+    if (std::string::npos == begin)
+    {
+        return std::string();
+    }
+
+    begin += pattern.size();
+
+    if ('"' == line[begin])
+    {
+        begin += 1;
+
+        return line.substr(begin, line.find('"', begin) - begin);
+    }
+
+    return line.substr(begin, line.find_first_of(", }", begin) - begin);
+}
+
+/* Returns number of regressions, files written by other versions are compared by name and form */
+static Platform::uint32 compare_baseline(const char * path, double threshold)
+{
+    FILE * file = fopen(path, "r");
+    Platform::uint32 n_regressions = 0;
+    char buffer[512];
+
+    if (nullptr == file)
+    {
+        printf("Can not open baseline %s\n", path);
+        return 1;
+    }
+
+    printf("\n%-48s %-6s %10s %10s %8s\n", "baseline", "form", "was", "is", "change");
+
+    while (nullptr != fgets(buffer, sizeof(buffer), file))
+    {
+        const std::string line(buffer);
+        const std::string name = field(line, "name");
+        const std::string form = field(line, "form");
+
+        if (true == name.empty())
+        {
+            continue;
+        }
+
+        const double was = atof(field(line, "cycles_per_element").c_str());
+
+        for (const auto & result : s_results)
+        {
+            if ((name != result.m_name) ||
+                (form != result.m_form))
+            {
+                continue;
+            }
+
+            const double change = (result.m_cycles_per_element - was) / was * 100.0;
+            const bool is_regression = (threshold < change);
+
+            printf("%-48s %-6s %10.2f %10.2f %+7.1f%%%s\n",
+                name.c_str(),
+                form.c_str(),
+                was,
+                result.m_cycles_per_element,
+                change,
+                is_regression ? " REGRESSION" : "");
+
+            n_regressions += is_regression ? 1 : 0;
+        }
+    }
+
+    fclose(file);
+
+    return n_regressions;
+}
+
+int main(int argc, char ** argv)
+{
+    const char * json = nullptr;
+    const char * baseline = nullptr;
+    double threshold = 10.0;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (0 == strcmp(argv[i], "--filter"))
+        {
+            s_filter = argv[i + 1];
+        }
+        else if (0 == strcmp(argv[i], "--json"))
+        {
+            json = argv[i + 1];
+        }
+        else if (0 == strcmp(argv[i], "--baseline"))
+        {
+            baseline = argv[i + 1];
+        }
+        else if (0 == strcmp(argv[i], "--threshold"))
+        {
+            threshold = atof(argv[i + 1]);
+        }
+    }
+
+    Data data;
+    prepare(data);
+
+    printf("%s, SIMD level %d, kernels %s, %u elements\n", compiler_name(), UTILITIES_MATH_SIMD_LEVEL, Math::Kernels::Get_name(), n_elements);
+    printf("%-48s %-6s %10s %14s\n", "benchmark", "form", "cycles", "elements/s");
+
+    benchmark_float4(data);
+    benchmark_float12_float16(data);
+    benchmark_matrix(data);
+    benchmark_quaternion(data);
+    benchmark_vector(data);
+    benchmark_skinning(data);
+    benchmark_bounds(data);
+
+    /* Results are used, nothing is optimised away */
+    s_sink = data.m_res4[1].x + data.m_res12[1].xx + data.m_res16[1].xx + data.m_res_streams[0][1];
+
+    if ((nullptr != json) &&
+        (false == write_json(json)))
+    {
+        printf("Can not write %s\n", json);
+        return 1;
+    }
+
+    if ((nullptr != baseline) &&
+        (0 != compare_baseline(baseline, threshold)))
+    {
+        return 1;
+    }
+
+    return 0;
+}
@@ -33,9 +33,12 @@
 
 #include <Unit_Tests\UnitTests.hpp>
 
+#include "Convert.hpp"
+#include "Cpu.hpp"
 #include "Float.hpp"
 
 #include <cstring>
+#include <vector>
 
 UNIT_TEST(Float16_constants)
 {
@@ -241,3 +244,210 @@ UNIT_TEST(Float_usage)
 
     return Passed;
 }
+
+static Platform::uint32 float_bits(float value)
+{
+    Platform::uint32 bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+
+    return bits;
+}
+
+static float bits_float(Platform::uint32 bits)
+{
+    float value;
+
+    memcpy(&value, &bits, sizeof(value));
+
+    return value;
+}
+
+UNIT_TEST(Half_known_values)
+{
+    static const float values[] =
+    {
+        1.0f,
+        -2.0f,
+        65504.0f,
+        65519.0f,
+        65520.0f,
+        bits_float(0x33800000) /* 2^-24 */,
+        bits_float(0x33000000) /* 2^-25 */,
+        bits_float(0x33c00000) /* 3 * 2^-25 */,
+        bits_float(0x38800000) /* 2^-14 */,
+        bits_float(0x7f800000) /* infinity */,
+        bits_float(0x7fa00000) /* signalling NaN */,
+    };
+    static const Platform::uint16 expected[] =
+    {
+        0x3c00,
+        0xc000,
+        0x7bff,
+        0x7bff,
+        0x7c00,
+        0x0001,
+        0x0000,
+        0x0002,
+        0x0400,
+        0x7c00,
+        0x7f00,
+    };
+    static const size_t n_values = sizeof(values) / sizeof(values[0]);
+
+    Math::half halves[n_values];
+
+    Math::Convert(values, halves, n_values);
+
+    for (size_t i = 0; i < n_values; ++i)
+    {
+        TEST_ASSERT(expected[i], halves[i].m_Raw);
+        TEST_ASSERT(expected[i], Math::Narrow<Math::half>(values[i]).m_Raw);
+    }
+
+    /* Double is rounded once, rounding through float would give 0x3c00 */
+    const double above_half = 1.0 + 1.0 / 2048.0 + 1.0 / 1099511627776.0;
+
+    TEST_ASSERT(0x3c01, Math::Narrow<Math::half>(above_half).m_Raw);
+    TEST_ASSERT(0x3c00, Math::Narrow<Math::half>(double(float(above_half))).m_Raw);
+
+    return Passed;
+}
+
+UNIT_TEST(Half_to_float)
+{
+    std::vector< Platform::uint16 > halves(0x10000);
+    std::vector< float > sse(halves.size());
+    std::vector< float > f16c(halves.size());
+    std::vector< float > selected(halves.size());
+
+    for (size_t i = 0; i < halves.size(); ++i)
+    {
+        halves[i] = Platform::uint16(i);
+    }
+
+    /* Odd count checks last elements */
+    const Platform::uint32 count = Platform::uint32(halves.size() - 3);
+
+    Math::Kernels::Sse::Half_to_float(halves.data(), sse.data(), count);
+    Math::Convert((const Math::half *) halves.data(), selected.data(), count);
+
+    const bool has_f16c = Math::Cpu::Has_features(Math::Cpu::F16c);
+
+    if (true == has_f16c)
+    {
+        Math::Kernels::F16c::Half_to_float(halves.data(), f16c.data(), count);
+    }
+
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        const Math::half half(halves[i]);
+        const Platform::uint32 expected = float_bits(Math::Widen<float>(half));
+
+        TEST_ASSERT(expected, float_bits(sse[i]));
+        TEST_ASSERT(expected, float_bits(selected[i]));
+
+        if (true == has_f16c)
+        {
+            TEST_ASSERT(expected, float_bits(f16c[i]));
+        }
+
+        /* Widening is exact */
+        if (0x7c00 > (halves[i] & 0x7fff))
+        {
+            TEST_ASSERT(double(bits_float(expected)), Math::Widen<double>(half));
+        }
+    }
+
+    return Passed;
+}
+
+UNIT_TEST(Float_to_half)
+{
+    std::vector< float > values;
+
+    for (Platform::uint64 bits = 0; bits <= 0xffffffff; bits += 0x1003)
+    {
+        values.push_back(bits_float(Platform::uint32(bits)));
+    }
+
+    /* Halfway points around every half exponent */
+    for (Platform::uint32 exponent = 100; exponent < 145; ++exponent)
+    {
+        const Platform::uint32 bits = exponent << 23;
+
+        values.push_back(bits_float(bits | 0x1000));
+        values.push_back(bits_float(bits | 0x3000));
+        values.push_back(bits_float(bits | 0x3001));
+        values.push_back(bits_float(bits | 0x7fffff));
+        values.push_back(bits_float(0x80000000 | bits | 0x1000));
+    }
+
+    const Platform::uint32 count = Platform::uint32(values.size());
+    std::vector< Platform::uint16 > sse(count);
+    std::vector< Platform::uint16 > f16c(count);
+    std::vector< Math::half > selected(count);
+
+    Math::Kernels::Sse::Float_to_half(values.data(), sse.data(), count);
+    Math::Convert(values.data(), selected.data(), count);
+
+    const bool has_f16c = Math::Cpu::Has_features(Math::Cpu::F16c);
+
+    if (true == has_f16c)
+    {
+        Math::Kernels::F16c::Float_to_half(values.data(), f16c.data(), count);
+    }
+
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        const Platform::uint16 expected = Math::Narrow<Math::half>(values[i]).m_Raw;
+
+        TEST_ASSERT(expected, sse[i]);
+        TEST_ASSERT(expected, selected[i].m_Raw);
+
+        if (true == has_f16c)
+        {
+            TEST_ASSERT(expected, f16c[i]);
+        }
+
+        /* Float and double give the same half */
+        TEST_ASSERT(expected, Math::Narrow<Math::half>(double(values[i])).m_Raw);
+    }
+
+    return Passed;
+}
+
+/* Conversions are evaluated during compilation */
+static_assert(0x3c00 == Math::half(1.0).m_Raw, "Float is not constexpr");
+static_assert(0xc000 == Math::half(-2.0).m_Raw, "Float is not constexpr");
+static_assert(0.5 == Math::half(Platform::uint16(0x3800)).Value(), "Float is not constexpr");
+static_assert(0x3f800000 == Math::float32(1.0).m_Raw, "Float is not constexpr");
+static_assert(0x7bff == Math::Narrow<Math::half>(65504.0f).m_Raw, "Narrow is not constexpr");
+static_assert(0x0001 == Math::Narrow<Math::half>(5.9604644775390625e-8).m_Raw, "Narrow is not constexpr");
+static_assert(5.9604644775390625e-8 == Math::Widen<double>(Math::half(Platform::uint16(0x0001))), "Widen is not constexpr");
+static_assert(0x0400 == Math::float16::Exponent_mask::Set(1, 0), "Mask is not constexpr");
+static_assert(0x8000 == Math::float16::Sign_bit::Set(1, 0), "Bit is not constexpr");
+
+UNIT_TEST(Float_constexpr_table)
+{
+    /* Quantisation table built during compilation */
+    static constexpr Math::half table[] =
+    {
+        Math::Narrow<Math::half>(0.0f),
+        Math::Narrow<Math::half>(0.25f),
+        Math::Narrow<Math::half>(0.5f),
+        Math::Narrow<Math::half>(0.75f),
+        Math::Narrow<Math::half>(1.0f),
+    };
+    static const size_t n_values = sizeof(table) / sizeof(table[0]);
+
+    for (size_t i = 0; i < n_values; ++i)
+    {
+        const float value = float(i) * 0.25f;
+
+        TEST_ASSERT(value, Math::Widen<float>(table[i]));
+        TEST_ASSERT(Math::half(double(value)).m_Raw, table[i].m_Raw);
+    }
+
+    return Passed;
+}
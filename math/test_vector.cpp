@@ -0,0 +1,1300 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file test_vector.cpp
+**/
+
+/*
+ * Tests of vector and matrix operations. These are kept apart from
+ * test.cpp, Math::float16 from Float.hpp can not be used in the same file as
+ * Math::float16 from FloatTypes.hpp.
+ *
+ * Results are compared bit by bit with scalar code that does operations in
+ * the same order, they must not depend on selected instruction set.
+ */
+
+#include "PCH.hpp"
+
+#include <Unit_Tests\UnitTests.hpp>
+
+#include "Bounds.hpp"
+#include "Cpu.hpp"
+#include "Kernels.hpp"
+#include "Matrix.hpp"
+#include "Quaternion.hpp"
+#include "Skinning.hpp"
+#include "Transcendental.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+static void fill(float * data, Platform::uint32 count, float seed)
+{
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        data[i] = seed + float(i) * 0.37f - float(i * i) * 0.011f;
+    }
+}
+
+static float reference_row_column(
+    const float * a_row,
+    const float * b,
+    const float * last,
+    Platform::uint32 column)
+{
+    const float x = a_row[0] * b[0 * 4 + column];
+    const float y = a_row[1] * b[1 * 4 + column];
+    const float z = a_row[2] * b[2 * 4 + column];
+    const float w = a_row[3] * last[column];
+
+    return (x + y) + (z + w);
+}
+
+UNIT_TEST(Float12_operations)
+{
+    Math::float12 a, b, res;
+
+    fill(a.f, 12, 1.5f);
+    fill(b.f, 12, -0.25f);
+
+    res = a + b;
+    for (Platform::uint32 i = 0; i < 12; ++i)
+    {
+        const float expected = a.f[i] + b.f[i];
+
+        TEST_ASSERT(0, memcmp(&expected, &res.f[i], sizeof(float)));
+    }
+
+    res = a - b;
+    for (Platform::uint32 i = 0; i < 12; ++i)
+    {
+        const float expected = a.f[i] - b.f[i];
+
+        TEST_ASSERT(0, memcmp(&expected, &res.f[i], sizeof(float)));
+    }
+
+    res = a * b;
+    for (Platform::uint32 i = 0; i < 12; ++i)
+    {
+        const float expected = a.f[i] * b.f[i];
+
+        TEST_ASSERT(0, memcmp(&expected, &res.f[i], sizeof(float)));
+    }
+
+    res = a * 3.25f;
+    for (Platform::uint32 i = 0; i < 12; ++i)
+    {
+        const float expected = a.f[i] * 3.25f;
+
+        TEST_ASSERT(0, memcmp(&expected, &res.f[i], sizeof(float)));
+    }
+
+    res = a / b;
+    for (Platform::uint32 i = 0; i < 12; ++i)
+    {
+        const float expected = a.f[i] / b.f[i];
+
+        TEST_ASSERT(0, memcmp(&expected, &res.f[i], sizeof(float)));
+    }
+
+    return Passed;
+}
+
+UNIT_TEST(Float16_operations)
+{
+    Math::float16 a, b, res;
+
+    fill(a.f, 16, 2.5f);
+    fill(b.f, 16, -0.75f);
+
+    res = a + b;
+    for (Platform::uint32 i = 0; i < 16; ++i)
+    {
+        const float expected = a.f[i] + b.f[i];
+
+        TEST_ASSERT(0, memcmp(&expected, &res.f[i], sizeof(float)));
+    }
+
+    res = a - b;
+    for (Platform::uint32 i = 0; i < 16; ++i)
+    {
+        const float expected = a.f[i] - b.f[i];
+
+        TEST_ASSERT(0, memcmp(&expected, &res.f[i], sizeof(float)));
+    }
+
+    res = a * b;
+    for (Platform::uint32 i = 0; i < 16; ++i)
+    {
+        const float expected = a.f[i] * b.f[i];
+
+        TEST_ASSERT(0, memcmp(&expected, &res.f[i], sizeof(float)));
+    }
+
+    res = a * 3.25f;
+    for (Platform::uint32 i = 0; i < 16; ++i)
+    {
+        const float expected = a.f[i] * 3.25f;
+
+        TEST_ASSERT(0, memcmp(&expected, &res.f[i], sizeof(float)));
+    }
+
+    res = a / b;
+    for (Platform::uint32 i = 0; i < 16; ++i)
+    {
+        const float expected = a.f[i] / b.f[i];
+
+        TEST_ASSERT(0, memcmp(&expected, &res.f[i], sizeof(float)));
+    }
+
+    return Passed;
+}
+
+UNIT_TEST(Matrix_multiply)
+{
+    Math::float16 a16, b16, res16;
+    Math::float12 a12, b12, res12;
+
+    fill(a16.f, 16, 0.125f);
+    fill(b16.f, 16, -1.375f);
+    fill(a12.f, 12, 0.625f);
+    fill(b12.f, 12, 1.875f);
+
+    res16 = Math::Matrix::Multiply(a16, b16);
+    for (Platform::uint32 row = 0; row < 4; ++row)
+    {
+        for (Platform::uint32 column = 0; column < 4; ++column)
+        {
+            const float expected = reference_row_column(&a16.f[row * 4], b16.f, &b16.f[12], column);
+
+            TEST_ASSERT(0, memcmp(&expected, &res16.f[row * 4 + column], sizeof(float)));
+        }
+    }
+
+    /* float12 has implicit 0, 0, 0, 1 fourth row */
+    const Math::float4 last = Math::Float4::Set(0.0f, 0.0f, 0.0f, 1.0f);
+
+    res12 = Math::Matrix::Multiply(a12, b12);
+    for (Platform::uint32 row = 0; row < 3; ++row)
+    {
+        for (Platform::uint32 column = 0; column < 4; ++column)
+        {
+            const float expected = reference_row_column(&a12.f[row * 4], b12.f, last.f, column);
+
+            TEST_ASSERT(0, memcmp(&expected, &res12.f[row * 4 + column], sizeof(float)));
+        }
+    }
+
+    return Passed;
+}
+
+static bool is_same(const Math::float4 & a, const Math::float4 & b)
+{
+    return (0 == memcmp(a.f, b.f, sizeof(a.f)));
+}
+
+static bool is_close(const Math::float4 & a, const Math::float4 & b, float tolerance)
+{
+    for (Platform::uint32 i = 0; i < 4; ++i)
+    {
+        const float difference = a.f[i] - b.f[i];
+
+        if ((tolerance < difference) || (-tolerance > difference))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static Test_result test_kernels(
+    Math::Kernels::multiply_float16_t multiply_float16,
+    Math::Kernels::multiply_float12_t multiply_float12,
+    Math::Kernels::rotate_t rotate,
+    Math::Kernels::normalise_t normalise,
+    Math::Kernels::lerp_t lerp,
+    float normalise_tolerance)
+{
+    /* Odd count checks handling of last elements */
+    static const Platform::uint32 count = 7;
+
+    Math::float16 a16[count], b16[count], res16[count];
+    Math::float12 a12[count], b12[count], res12[count];
+    Math::float4 a[count], b[count], percent[count], res[count];
+
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        fill(a16[i].f, 16, 0.5f + float(i));
+        fill(b16[i].f, 16, -1.5f + float(i));
+        fill(a12[i].f, 12, 0.25f - float(i));
+        fill(b12[i].f, 12, 1.25f + float(i));
+        fill(a[i].f, 4, 0.75f + float(i));
+        fill(b[i].f, 4, -2.0f + float(i));
+        fill(percent[i].f, 4, 0.125f * float(i));
+        b[i] = Math::Normalise(b[i]);
+    }
+
+    multiply_float16(a16, b16, res16, count);
+    multiply_float12(a12, b12, res12, count);
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        const Math::float16 expected16 = Math::Matrix::Multiply(a16[i], b16[i]);
+        const Math::float12 expected12 = Math::Matrix::Multiply(a12[i], b12[i]);
+
+        TEST_ASSERT(0, memcmp(expected16.f, res16[i].f, sizeof(expected16.f)));
+        TEST_ASSERT(0, memcmp(expected12.f, res12[i].f, sizeof(expected12.f)));
+    }
+
+    rotate(a, b, res, count);
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        TEST_ASSERT(true, is_same(Math::Quaternion::Rotate(a[i], b[i]), res[i]));
+    }
+
+    normalise(a, res, count);
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        TEST_ASSERT(true, is_close(Math::Normalise(a[i]), res[i], normalise_tolerance));
+    }
+
+    lerp(a, b, percent, res, count);
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        TEST_ASSERT(true, is_same(Math::Lerp(a[i], b[i], percent[i]), res[i]));
+    }
+
+    /* In place */
+    multiply_float16(a16, b16, a16, count);
+    TEST_ASSERT(0, memcmp(res16, a16, sizeof(res16)));
+
+    return Passed;
+}
+
+UNIT_TEST(Batch_kernels)
+{
+    Test_result result = test_kernels(
+        &Math::Kernels::Sse::Multiply,
+        &Math::Kernels::Sse::Multiply,
+        &Math::Kernels::Sse::Rotate,
+        &Math::Kernels::Sse::Normalise,
+        &Math::Kernels::Sse::Lerp,
+        0.0f);
+
+    if ((Passed == result) &&
+        (true == Math::Cpu::Has_features(Math::Cpu::Avx2)))
+    {
+        result = test_kernels(
+            &Math::Kernels::Avx2::Multiply,
+            &Math::Kernels::Avx2::Multiply,
+            &Math::Kernels::Avx2::Rotate,
+            &Math::Kernels::Avx2::Normalise,
+            &Math::Kernels::Avx2::Lerp,
+            0.0f);
+    }
+
+    /* rsqrt14 is more precise than rsqrt */
+    if ((Passed == result) &&
+        (true == Math::Cpu::Has_features(Math::Cpu::Avx512f)))
+    {
+        result = test_kernels(
+            &Math::Kernels::Avx512::Multiply,
+            &Math::Kernels::Avx512::Multiply,
+            &Math::Kernels::Avx512::Rotate,
+            &Math::Kernels::Avx512::Normalise,
+            &Math::Kernels::Avx512::Lerp,
+            0.001f);
+    }
+
+    return result;
+}
+
+UNIT_TEST(Batch_dispatch)
+{
+    static const Platform::uint32 count = 5;
+
+    Math::float16 a[count], b[count], res[count];
+
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        fill(a[i].f, 16, 1.0f + float(i));
+        fill(b[i].f, 16, -1.0f - float(i));
+    }
+
+    Math::Matrix::Multiply_batch(a, b, res, count);
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        const Math::float16 expected = Math::Matrix::Multiply(a[i], b[i]);
+
+        TEST_ASSERT(0, memcmp(expected.f, res[i].f, sizeof(expected.f)));
+    }
+
+    TEST_ASSERT_NOT_EQUAL((const char *) 0, Math::Kernels::Get_name());
+
+    return Passed;
+}
+
+static Test_result test_soa_kernels(
+    Math::Kernels::dot_soa_t dot,
+    Math::Kernels::cross_soa_t cross,
+    Math::Kernels::rotate_soa_t rotate,
+    Math::Kernels::transform_points_soa_t transform_points)
+{
+    /* Not multiple of any width, last elements are checked */
+    static const Platform::uint32 count = 37;
+
+    float a_x[count], a_y[count], a_z[count];
+    float b_x[count], b_y[count], b_z[count], b_w[count];
+    float r_x[count], r_y[count], r_z[count];
+    float dots[count];
+
+    Math::float4 quaternions[count];
+
+    fill(a_x, count, 0.5f);
+    fill(a_y, count, -1.25f);
+    fill(a_z, count, 2.0f);
+
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        fill(quaternions[i].f, 4, 0.25f * float(i) - 3.0f);
+        quaternions[i] = Math::Normalise(quaternions[i]);
+
+        b_x[i] = quaternions[i].x;
+        b_y[i] = quaternions[i].y;
+        b_z[i] = quaternions[i].z;
+        b_w[i] = quaternions[i].w;
+    }
+
+    const Math::float4_soa a = { a_x, a_y, a_z, nullptr };
+    const Math::float4_soa b = { b_x, b_y, b_z, b_w };
+    const Math::float4_soa res = { r_x, r_y, r_z, nullptr };
+
+    dot(a, b, dots, count);
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        const float expected = (a_x[i] * b_x[i] + a_y[i] * b_y[i]) + a_z[i] * b_z[i];
+
+        TEST_ASSERT(0, memcmp(&expected, &dots[i], sizeof(float)));
+    }
+
+    cross(a, b, res, count);
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        const float expected[3] =
+        {
+            a_y[i] * b_z[i] - a_z[i] * b_y[i],
+            a_z[i] * b_x[i] - a_x[i] * b_z[i],
+            a_x[i] * b_y[i] - a_y[i] * b_x[i],
+        };
+
+        TEST_ASSERT(0, memcmp(&expected[0], &r_x[i], sizeof(float)));
+        TEST_ASSERT(0, memcmp(&expected[1], &r_y[i], sizeof(float)));
+        TEST_ASSERT(0, memcmp(&expected[2], &r_z[i], sizeof(float)));
+    }
+
+    /* Different order of operations than in Quaternion::Rotate */
+    rotate(a, b, res, count);
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        const Math::float4 point = Math::Float4::Set(a_x[i], a_y[i], a_z[i], 0.0f);
+        const Math::float4 expected = Math::Quaternion::Rotate(point, quaternions[i]);
+        const Math::float4 result = Math::Float4::Set(r_x[i], r_y[i], r_z[i], 0.0f);
+
+        TEST_ASSERT(true, is_close(Math::Float4::Set(expected.x, expected.y, expected.z, 0.0f), result, 0.01f));
+    }
+
+    const Math::float12 matrix = Math::Float12::Set(
+        1.0f, 2.0f, 3.0f, 4.0f,
+        -5.0f, 6.0f, 7.0f, 8.0f,
+        9.0f, 10.0f, -11.0f, 12.0f);
+
+    transform_points(matrix, a, res, count);
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        const float expected[3] =
+        {
+            ((matrix.xx * a_x[i] + matrix.xy * a_y[i]) + matrix.xz * a_z[i]) + matrix.xw,
+            ((matrix.yx * a_x[i] + matrix.yy * a_y[i]) + matrix.yz * a_z[i]) + matrix.yw,
+            ((matrix.zx * a_x[i] + matrix.zy * a_y[i]) + matrix.zz * a_z[i]) + matrix.zw,
+        };
+
+        TEST_ASSERT(0, memcmp(&expected[0], &r_x[i], sizeof(float)));
+        TEST_ASSERT(0, memcmp(&expected[1], &r_y[i], sizeof(float)));
+        TEST_ASSERT(0, memcmp(&expected[2], &r_z[i], sizeof(float)));
+    }
+
+    return Passed;
+}
+
+UNIT_TEST(Batch_soa_kernels)
+{
+    Test_result result = test_soa_kernels(
+        &Math::Kernels::Sse::Dot,
+        &Math::Kernels::Sse::Cross,
+        &Math::Kernels::Sse::Rotate,
+        &Math::Kernels::Sse::Transform_points);
+
+    if ((Passed == result) &&
+        (true == Math::Cpu::Has_features(Math::Cpu::Avx2)))
+    {
+        result = test_soa_kernels(
+            &Math::Kernels::Avx2::Dot,
+            &Math::Kernels::Avx2::Cross,
+            &Math::Kernels::Avx2::Rotate,
+            &Math::Kernels::Avx2::Transform_points);
+    }
+
+    if ((Passed == result) &&
+        (true == Math::Cpu::Has_features(Math::Cpu::Avx512f)))
+    {
+        result = test_soa_kernels(
+            &Math::Kernels::Avx512::Dot,
+            &Math::Kernels::Avx512::Cross,
+            &Math::Kernels::Avx512::Rotate,
+            &Math::Kernels::Avx512::Transform_points);
+    }
+
+    return result;
+}
+
+/* Well conditioned matrices, diagonal dominates */
+static void fill_invertible(float * data, Platform::uint32 rows, float seed)
+{
+    fill(data, rows * 4, seed);
+
+    for (Platform::uint32 i = 0; i < rows; ++i)
+    {
+        data[i * 4 + i] += 8.0f;
+    }
+}
+
+static bool is_identity(const float * data, Platform::uint32 rows, float tolerance)
+{
+    for (Platform::uint32 row = 0; row < rows; ++row)
+    {
+        for (Platform::uint32 column = 0; column < 4; ++column)
+        {
+            const float expected = (row == column) ? 1.0f : 0.0f;
+            const float difference = data[row * 4 + column] - expected;
+
+            if ((tolerance < difference) || (-tolerance > difference))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static double reference_determinant(const float * m, Platform::uint32 size)
+{
+    if (1 == size)
+    {
+        return m[0];
+    }
+
+    double result = 0.0;
+    double sign = 1.0;
+
+    for (Platform::uint32 column = 0; column < size; ++column)
+    {
+        float minor[16];
+        Platform::uint32 n = 0;
+
+        for (Platform::uint32 row = 1; row < size; ++row)
+        {
+            for (Platform::uint32 c = 0; c < size; ++c)
+            {
+                if (c != column)
+                {
+                    minor[n++] = m[row * 4 + c];
+                }
+            }
+        }
+
+        /* Minor is packed, unpack it to rows of 4 */
+        float unpacked[16];
+        for (Platform::uint32 i = 0; i < n; ++i)
+        {
+            unpacked[(i / (size - 1)) * 4 + (i % (size - 1))] = minor[i];
+        }
+
+        result += sign * double(m[column]) * reference_determinant(unpacked, size - 1);
+        sign = -sign;
+    }
+
+    return result;
+}
+
+UNIT_TEST(Matrix_inverse)
+{
+    for (Platform::uint32 i = 0; i < 5; ++i)
+    {
+        Math::float16 a16;
+        Math::float12 a12;
+
+        fill_invertible(a16.f, 4, 0.5f - float(i));
+        fill_invertible(a12.f, 3, 1.5f + float(i));
+
+        const Math::float16 identity16 = Math::Matrix::Multiply(a16, Math::Matrix::Inverse(a16));
+        const Math::float12 identity12 = Math::Matrix::Multiply(a12, Math::Matrix::Inverse(a12));
+
+        TEST_ASSERT(true, is_identity(identity16.f, 4, 0.0001f));
+        TEST_ASSERT(true, is_identity(identity12.f, 3, 0.0001f));
+
+        const double det16 = reference_determinant(a16.f, 4);
+        const double det12 = reference_determinant(a12.f, 3);
+        const double difference16 = double(Math::Matrix::Determinant(a16)) - det16;
+        const double difference12 = double(Math::Matrix::Determinant(a12)) - det12;
+
+        TEST_ASSERT(true, (difference16 * difference16) < (det16 * det16 * 1.0e-10));
+        TEST_ASSERT(true, (difference12 * difference12) < (det12 * det12 * 1.0e-10));
+
+        /* Rigid transformation, quaternion is normalised precisely */
+        Math::float4 quaternion;
+        fill(quaternion.f, 4, 0.25f + float(i));
+
+        const float length = sqrtf(
+            quaternion.x * quaternion.x + quaternion.y * quaternion.y +
+            quaternion.z * quaternion.z + quaternion.w * quaternion.w);
+        quaternion = Math::Float4::Set(quaternion.x / length, quaternion.y / length, quaternion.z / length, quaternion.w / length);
+
+        const Math::float12 rigid = Math::Matrix::TransformationFromQuaternionAndVector(
+            quaternion,
+            Math::Float4::Set(1.0f + float(i), -2.0f, 3.0f, 0.0f));
+        const Math::float12 rigid_identity = Math::Matrix::Multiply(rigid, Math::Matrix::Inverse_rigid(rigid));
+        const Math::float12 inverse = Math::Matrix::Inverse(rigid);
+        const Math::float12 inverse_rigid = Math::Matrix::Inverse_rigid(rigid);
+
+        TEST_ASSERT(true, is_identity(rigid_identity.f, 3, 0.001f));
+        TEST_ASSERT(true, is_close(inverse.x, inverse_rigid.x, 0.001f));
+        TEST_ASSERT(true, is_close(inverse.y, inverse_rigid.y, 0.001f));
+        TEST_ASSERT(true, is_close(inverse.z, inverse_rigid.z, 0.001f));
+    }
+
+    return Passed;
+}
+
+static Test_result test_inverse_kernels(
+    Math::Kernels::inverse_float16_t inverse_float16,
+    Math::Kernels::inverse_float12_t inverse_float12,
+    Math::Kernels::inverse_float12_t inverse_rigid,
+    Math::Kernels::determinant_float16_t determinant_float16,
+    Math::Kernels::determinant_float12_t determinant_float12)
+{
+    /* Not multiple of any width, last matrices are checked */
+    static const Platform::uint32 count = 7;
+
+    Math::float16 a16[count], res16[count];
+    Math::float12 a12[count], res12[count];
+    float det16[count], det12[count];
+
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        fill_invertible(a16[i].f, 4, 0.5f + float(i));
+        fill_invertible(a12[i].f, 3, -0.75f + float(i));
+    }
+
+    inverse_float16(a16, res16, count);
+    inverse_float12(a12, res12, count);
+    determinant_float16(a16, det16, count);
+    determinant_float12(a12, det12, count);
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        const Math::float16 expected16 = Math::Matrix::Inverse(a16[i]);
+        const Math::float12 expected12 = Math::Matrix::Inverse(a12[i]);
+        const float expected_det16 = Math::Matrix::Determinant(a16[i]);
+        const float expected_det12 = Math::Matrix::Determinant(a12[i]);
+
+        TEST_ASSERT(0, memcmp(expected16.f, res16[i].f, sizeof(expected16.f)));
+        TEST_ASSERT(0, memcmp(expected12.f, res12[i].f, sizeof(expected12.f)));
+        TEST_ASSERT(0, memcmp(&expected_det16, &det16[i], sizeof(float)));
+        TEST_ASSERT(0, memcmp(&expected_det12, &det12[i], sizeof(float)));
+    }
+
+    inverse_rigid(a12, res12, count);
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        const Math::float12 expected = Math::Matrix::Inverse_rigid(a12[i]);
+
+        TEST_ASSERT(0, memcmp(expected.f, res12[i].f, sizeof(expected.f)));
+    }
+
+    /* In place */
+    inverse_float16(a16, a16, count);
+    TEST_ASSERT(0, memcmp(res16, a16, sizeof(res16)));
+
+    return Passed;
+}
+
+UNIT_TEST(Batch_inverse_kernels)
+{
+    Test_result result = test_inverse_kernels(
+        &Math::Kernels::Sse::Inverse,
+        &Math::Kernels::Sse::Inverse,
+        &Math::Kernels::Sse::Inverse_rigid,
+        &Math::Kernels::Sse::Determinant,
+        &Math::Kernels::Sse::Determinant);
+
+    if ((Passed == result) &&
+        (true == Math::Cpu::Has_features(Math::Cpu::Avx2)))
+    {
+        result = test_inverse_kernels(
+            &Math::Kernels::Avx2::Inverse,
+            &Math::Kernels::Avx2::Inverse,
+            &Math::Kernels::Avx2::Inverse_rigid,
+            &Math::Kernels::Avx2::Determinant,
+            &Math::Kernels::Avx2::Determinant);
+    }
+
+    if ((Passed == result) &&
+        (true == Math::Cpu::Has_features(Math::Cpu::Avx512f)))
+    {
+        result = test_inverse_kernels(
+            &Math::Kernels::Avx512::Inverse,
+            &Math::Kernels::Avx512::Inverse,
+            &Math::Kernels::Avx512::Inverse_rigid,
+            &Math::Kernels::Avx512::Determinant,
+            &Math::Kernels::Avx512::Determinant);
+    }
+
+    return result;
+}
+
+static Math::float4 unit_quaternion(float seed)
+{
+    Math::float4 quaternion;
+
+    fill(quaternion.f, 4, seed);
+
+    const float length = sqrtf(
+        quaternion.x * quaternion.x + quaternion.y * quaternion.y +
+        quaternion.z * quaternion.z + quaternion.w * quaternion.w);
+
+    return Math::Float4::Set(quaternion.x / length, quaternion.y / length, quaternion.z / length, quaternion.w / length);
+}
+
+static Math::float4 reference_slerp(const Math::float4 & a, const Math::float4 & b, float percent)
+{
+    double cosine = 0.0;
+    double sign = 1.0;
+    double res[4];
+    double length = 0.0;
+
+    for (Platform::uint32 i = 0; i < 4; ++i)
+    {
+        cosine += double(a.f[i]) * double(b.f[i]);
+    }
+
+    if (0.0 > cosine)
+    {
+        sign = -1.0;
+        cosine = -cosine;
+    }
+
+    const double angle = acos((1.0 < cosine) ? 1.0 : cosine);
+    const double weight_a = (1.0e-6 < angle) ? sin((1.0 - percent) * angle) : (1.0 - percent);
+    const double weight_b = (1.0e-6 < angle) ? sin(percent * angle) : percent;
+
+    for (Platform::uint32 i = 0; i < 4; ++i)
+    {
+        res[i] = weight_a * a.f[i] + weight_b * sign * b.f[i];
+        length += res[i] * res[i];
+    }
+
+    length = sqrt(length);
+
+    return Math::Float4::Set(float(res[0] / length), float(res[1] / length), float(res[2] / length), float(res[3] / length));
+}
+
+UNIT_TEST(Quaternion_slerp)
+{
+    for (Platform::uint32 i = 0; i < 10; ++i)
+    {
+        const Math::float4 a = unit_quaternion(0.25f + float(i));
+        const Math::float4 b = unit_quaternion(-1.5f + 0.3f * float(i));
+        const Math::float4 near = unit_quaternion(0.25f + float(i) + 0.001f);
+
+        for (Platform::uint32 step = 0; step <= 8; ++step)
+        {
+            const float percent = float(step) / 8.0f;
+
+            TEST_ASSERT(true, is_close(reference_slerp(a, b, percent), Math::Quaternion::Slerp(a, b, percent), 0.00001f));
+            TEST_ASSERT(true, is_close(reference_slerp(a, near, percent), Math::Quaternion::Slerp(a, near, percent), 0.00001f));
+
+            /* Same rotation, shorter arc is taken */
+            TEST_ASSERT(true, is_same(Math::Quaternion::Slerp(a, b, percent), Math::Quaternion::Slerp(a, b * -1.0f, percent)));
+        }
+
+        /* End is b or -b, whichever is closer to a */
+        const float cosine = ((a.x * b.x + a.y * b.y) + a.z * b.z) + a.w * b.w;
+        const Math::float4 end = (0.0f > cosine) ? b * -1.0f : b;
+
+        TEST_ASSERT(true, is_close(a, Math::Quaternion::Slerp(a, b, 0.0f), 0.000001f));
+        TEST_ASSERT(true, is_close(end, Math::Quaternion::Slerp(a, b, 1.0f), 0.000001f));
+    }
+
+    return Passed;
+}
+
+static Test_result test_animation_kernels(
+    Math::Kernels::slerp_t slerp,
+    Math::Kernels::rotation_from_quaternion_t rotation_from_quaternion,
+    Math::Kernels::skin_soa_t skin_points,
+    Math::Kernels::skin_soa_t skin_vectors)
+{
+    /* More than sixteen and not multiple of any width, last elements are checked */
+    static const Platform::uint32 count = 19;
+    static const Platform::uint32 bones_count = 5;
+
+    Math::float4 a[count], b[count], res[count];
+    Math::float12 matrices[count];
+    Math::float12 bones[bones_count];
+    Platform::uint16 indices[count * Math::Skinning::influences];
+    float weights[count * Math::Skinning::influences];
+    float percent[count];
+    float streams[6][count];
+
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        a[i] = unit_quaternion(0.5f + float(i));
+        b[i] = unit_quaternion(-2.0f + 0.7f * float(i));
+        percent[i] = float(i) / float(count - 1);
+    }
+
+    /* Almost the same quaternions are interpolated linearly */
+    b[3] = a[3];
+
+    slerp(a, b, percent, res, count);
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        TEST_ASSERT(true, is_same(Math::Quaternion::Slerp(a[i], b[i], percent[i]), res[i]));
+    }
+
+    /* In place */
+    slerp(a, b, percent, a, count);
+    TEST_ASSERT(0, memcmp(res, a, sizeof(res)));
+
+    rotation_from_quaternion(b, matrices, count);
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        const Math::float12 expected = Math::Matrix::RotationFromQuaternion(b[i]);
+
+        TEST_ASSERT(0, memcmp(expected.f, matrices[i].f, sizeof(expected.f)));
+    }
+
+    for (Platform::uint32 i = 0; i < bones_count; ++i)
+    {
+        bones[i] = Math::Matrix::TransformationFromQuaternionAndVector(
+            unit_quaternion(1.25f - float(i)),
+            Math::Float4::Set(float(i), -1.0f, 0.5f * float(i), 0.0f));
+    }
+
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        const float sum = 1.0f + float(i % 3) + 0.5f;
+
+        for (Platform::uint32 n = 0; n < Math::Skinning::influences; ++n)
+        {
+            indices[i * Math::Skinning::influences + n] = Platform::uint16((i + n * 2) % bones_count);
+        }
+
+        weights[i * Math::Skinning::influences + 0] = 1.0f / sum;
+        weights[i * Math::Skinning::influences + 1] = float(i % 3) / sum;
+        weights[i * Math::Skinning::influences + 2] = 0.5f / sum;
+        weights[i * Math::Skinning::influences + 3] = 0.0f;
+
+        streams[0][i] = 0.1f * float(i);
+        streams[1][i] = 1.0f - 0.2f * float(i);
+        streams[2][i] = -0.5f + 0.05f * float(i * i);
+    }
+
+    const Math::float4_soa source = { streams[0], streams[1], streams[2], nullptr };
+    const Math::float4_soa destination = { streams[3], streams[4], streams[5], nullptr };
+
+    skin_points(bones, indices, weights, source, destination, count);
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        const Math::float4 point = Math::Float4::Set(streams[0][i], streams[1][i], streams[2][i], 0.0f);
+        const Math::float4 expected = Math::Skinning::Skin_point(bones, &indices[i * Math::Skinning::influences], &weights[i * Math::Skinning::influences], point);
+
+        TEST_ASSERT(0, memcmp(&expected.x, &streams[3][i], sizeof(float)));
+        TEST_ASSERT(0, memcmp(&expected.y, &streams[4][i], sizeof(float)));
+        TEST_ASSERT(0, memcmp(&expected.z, &streams[5][i], sizeof(float)));
+    }
+
+    skin_vectors(bones, indices, weights, source, destination, count);
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        const Math::float4 vector = Math::Float4::Set(streams[0][i], streams[1][i], streams[2][i], 0.0f);
+        const Math::float4 expected = Math::Skinning::Skin_vector(bones, &indices[i * Math::Skinning::influences], &weights[i * Math::Skinning::influences], vector);
+
+        TEST_ASSERT(0, memcmp(&expected.x, &streams[3][i], sizeof(float)));
+        TEST_ASSERT(0, memcmp(&expected.y, &streams[4][i], sizeof(float)));
+        TEST_ASSERT(0, memcmp(&expected.z, &streams[5][i], sizeof(float)));
+    }
+
+    /* Single bone with full weight is the same as transformation */
+    Math::float4 point = Math::Float4::Set(1.0f, 2.0f, 3.0f, 0.0f);
+    const Platform::uint16 single_indices[Math::Skinning::influences] = { 2, 0, 0, 0 };
+    const float single_weights[Math::Skinning::influences] = { 1.0f, 0.0f, 0.0f, 0.0f };
+    const Math::float4 skinned = Math::Skinning::Skin_point(bones, single_indices, single_weights, point);
+    point.w = 1.0f;
+    const Math::float4 transformed = Math::Float4::Set(
+        Math::Skinning::Dot(bones[2].x, point),
+        Math::Skinning::Dot(bones[2].y, point),
+        Math::Skinning::Dot(bones[2].z, point),
+        1.0f);
+
+    TEST_ASSERT(true, is_same(transformed, skinned));
+
+    return Passed;
+}
+
+UNIT_TEST(Batch_animation_kernels)
+{
+    Test_result result = test_animation_kernels(
+        &Math::Kernels::Sse::Slerp,
+        &Math::Kernels::Sse::Rotation_from_quaternion,
+        &Math::Kernels::Sse::Skin_points,
+        &Math::Kernels::Sse::Skin_vectors);
+
+    if ((Passed == result) &&
+        (true == Math::Cpu::Has_features(Math::Cpu::Avx2)))
+    {
+        result = test_animation_kernels(
+            &Math::Kernels::Avx2::Slerp,
+            &Math::Kernels::Avx2::Rotation_from_quaternion,
+            &Math::Kernels::Avx2::Skin_points,
+            &Math::Kernels::Avx2::Skin_vectors);
+    }
+
+    if ((Passed == result) &&
+        (true == Math::Cpu::Has_features(Math::Cpu::Avx512f)))
+    {
+        result = test_animation_kernels(
+            &Math::Kernels::Avx512::Slerp,
+            &Math::Kernels::Avx512::Rotation_from_quaternion,
+            &Math::Kernels::Avx512::Skin_points,
+            &Math::Kernels::Avx512::Skin_vectors);
+    }
+
+    return result;
+}
+
+/* Distance in units in the last place of float closest to reference */
+static double ulp_error(float value, double reference)
+{
+    const float rounded = float(reference);
+    const double magnitude = fabs(double(rounded));
+    const double ulp = double(std::nextafter(float(magnitude), 3.0e38f)) - magnitude;
+
+    return fabs(double(value) - reference) / ulp;
+}
+
+template <typename F, typename R>
+static double max_ulp_error(float begin, float end, const F & function, const R & reference, double minimum)
+{
+    static const Platform::uint32 count = 100000;
+
+    double res = 0.0;
+
+    for (Platform::uint32 i = 0; i < count; i += 4)
+    {
+        Math::float4 x;
+
+        for (Platform::uint32 k = 0; k < 4; ++k)
+        {
+            x.f[k] = begin + (end - begin) * float(double(i + k) / double(count));
+        }
+
+        const Math::float4 y = function(x);
+
+        for (Platform::uint32 k = 0; k < 4; ++k)
+        {
+            const double expected = reference(double(x.f[k]));
+
+            if (minimum <= fabs(expected))
+            {
+                const double error = ulp_error(y.f[k], expected);
+
+                res = (res < error) ? error : res;
+            }
+        }
+    }
+
+    return res;
+}
+
+UNIT_TEST(Transcendental_functions)
+{
+    TEST_ASSERT(true, 2.0 > max_ulp_error(-8192.0f, 8192.0f, [](const Math::float4 & x) { return Math::Sin(x); }, [](double x) { return sin(x); }, 0.001));
+    TEST_ASSERT(true, 2.0 > max_ulp_error(-8192.0f, 8192.0f, [](const Math::float4 & x) { return Math::Cos(x); }, [](double x) { return cos(x); }, 0.001));
+    TEST_ASSERT(true, 1.0 > max_ulp_error(-87.0f, 88.0f, [](const Math::float4 & x) { return Math::Exp(x); }, [](double x) { return exp(x); }, 0.0));
+    TEST_ASSERT(true, 1.0 > max_ulp_error(1.0e-30f, 1.0e30f, [](const Math::float4 & x) { return Math::Log(x); }, [](double x) { return log(x); }, 0.0));
+    TEST_ASSERT(true, 1.0 > max_ulp_error(0.01f, 100.0f, [](const Math::float4 & x) { return Math::Log(x); }, [](double x) { return log(x); }, 0.0));
+    TEST_ASSERT(true, 4.0 > max_ulp_error(0.5f, 8.0f, [](const Math::float4 & x) { return Math::Rsqrt(x); }, [](double x) { return 1.0 / sqrt(x); }, 0.0));
+    TEST_ASSERT(true, 3.5 > max_ulp_error(0.5f, 8.0f, [](const Math::float4 & x) { return Math::Rcp(x); }, [](double x) { return 1.0 / x; }, 0.0));
+
+    /* Absolute error close to zeros of sine */
+    for (Platform::uint32 i = 0; i < 64; ++i)
+    {
+        const Math::float4 angle = Math::Float4::Set(3.14159265f * float(i), -3.14159265f * float(i), 0.001f * float(i), 1.0e-6f * float(i));
+        Math::float4 sine, cosine;
+
+        Math::Sincos(angle, sine, cosine);
+        for (Platform::uint32 k = 0; k < 4; ++k)
+        {
+            TEST_ASSERT(true, 8.0e-8 > fabs(double(sine.f[k]) - sin(double(angle.f[k]))));
+            TEST_ASSERT(true, 8.0e-8 > fabs(double(cosine.f[k]) - cos(double(angle.f[k]))));
+        }
+    }
+
+    /* Every quadrant and both axes */
+    for (Platform::int32 i = -40; i <= 40; ++i)
+    {
+        for (Platform::int32 j = -40; j <= 40; j += 4)
+        {
+            Math::float4 x;
+            const Math::float4 y = Math::Float4::Set(0.173f * float(i));
+
+            for (Platform::uint32 k = 0; k < 4; ++k)
+            {
+                x.f[k] = 0.119f * float(j + Platform::int32(k));
+            }
+
+            const Math::float4 angle = Math::Atan2(y, x);
+            for (Platform::uint32 k = 0; k < 4; ++k)
+            {
+                const double expected = atan2(double(y.f[k]), double(x.f[k]));
+
+                if (0.0 == expected)
+                {
+                    TEST_ASSERT(0, memcmp(&angle.f[k], &y.f[k], sizeof(float)));
+                }
+                else
+                {
+                    TEST_ASSERT(true, 3.5 > ulp_error(angle.f[k], expected));
+                }
+            }
+        }
+    }
+
+    /* Signed zeros are handled as by C library */
+    const Math::float4 zero_y = Math::Float4::Set(0.0f, -0.0f, 0.0f, -0.0f);
+    const Math::float4 zero_x = Math::Float4::Set(0.0f, 0.0f, -0.0f, -0.0f);
+    const Math::float4 zero_angle = Math::Atan2(zero_y, zero_x);
+    for (Platform::uint32 k = 0; k < 4; ++k)
+    {
+        const float expected = atan2f(zero_y.f[k], zero_x.f[k]);
+
+        TEST_ASSERT(0, memcmp(&expected, &zero_angle.f[k], sizeof(float)));
+    }
+
+    /* Special values */
+    const Math::float4 logarithm = Math::Log(Math::Float4::Set(0.0f, -1.0f, std::numeric_limits< float >::infinity(), 1.0f));
+    const Math::float4 exponent = Math::Exp(Math::Float4::Set(-100.0f, 100.0f, 0.0f, 1.0f));
+
+    TEST_ASSERT(true, std::isnan(logarithm.x));
+    TEST_ASSERT(true, std::isnan(logarithm.y));
+    TEST_ASSERT(true, std::isinf(logarithm.z));
+    TEST_ASSERT(0.0f, logarithm.w);
+    TEST_ASSERT(0.0f, exponent.x);
+    TEST_ASSERT(true, std::isfinite(exponent.y));
+    TEST_ASSERT(1.0f, exponent.z);
+
+    return Passed;
+}
+
+UNIT_TEST(Quaternion_make)
+{
+    for (Platform::uint32 i = 0; i < 16; ++i)
+    {
+        const float angle = -6.0f + 0.83f * float(i);
+        const Math::float4 axis = Math::Float4::Set(0.48f, -0.6f, 0.64f, 0.0f);
+        const Math::float4 expected = Math::Float4::Set(
+            float(0.48 * sin(angle / 2.0)),
+            float(-0.6 * sin(angle / 2.0)),
+            float(0.64 * sin(angle / 2.0)),
+            float(cos(angle / 2.0)));
+
+        /* Normalise uses rsqrt approximation */
+        TEST_ASSERT(true, is_close(expected, Math::Quaternion::Make(angle, axis), 0.001f));
+        TEST_ASSERT(true, is_same(Math::Quaternion::Make(angle, axis), Math::Quaternion::Make(angle, 0.48f, -0.6f, 0.64f)));
+    }
+
+    return Passed;
+}
+
+/* Looking along z, clip space depth is in range [0, w] */
+static Math::float16 perspective(float near, float far)
+{
+    Math::float16 res = Math::Float16::Zero();
+
+    res.xx = 1.0f;
+    res.yy = 1.0f;
+    res.zz = far / (far - near);
+    res.zw = -near * far / (far - near);
+    res.wz = 1.0f;
+
+    return res;
+}
+
+/* Box is outside when all corners are behind one of planes, tolerance marks cases too close to tell */
+static int reference_box_visibility(const Math::frustum & planes, const Math::aabb & box, float tolerance)
+{
+    int res = 1;
+
+    for (Platform::uint32 p = 0; p < planes.count; ++p)
+    {
+        float distance = -1.0e30f;
+
+        for (Platform::uint32 corner = 0; corner < 8; ++corner)
+        {
+            const float x = (corner & 1) ? box.max.x : box.min.x;
+            const float y = (corner & 2) ? box.max.y : box.min.y;
+            const float z = (corner & 4) ? box.max.z : box.min.z;
+            const float d = planes.x[p] * x + planes.y[p] * y + planes.z[p] * z + planes.w[p];
+
+            distance = (d > distance) ? d : distance;
+        }
+
+        if (fabsf(distance) < tolerance)
+        {
+            return -1;
+        }
+
+        if (0.0f > distance)
+        {
+            res = 0;
+        }
+    }
+
+    return res;
+}
+
+UNIT_TEST(Bounding_volumes)
+{
+    const Math::aabb a = Math::Bounds::Make_aabb(Math::Float4::Set(-1.0f, 0.0f, 2.0f, 0.0f), Math::Float4::Set(1.0f, 3.0f, 2.5f, 0.0f));
+    const Math::aabb b = Math::Bounds::Make_aabb(Math::Float4::Set(0.5f, -2.0f, 1.0f, 0.0f), Math::Float4::Set(4.0f, 1.0f, 2.25f, 0.0f));
+
+    const Math::aabb merged = Math::Bounds::Merge(a, b);
+    TEST_ASSERT(true, is_same(Math::Float4::Set(-1.0f, -2.0f, 1.0f, 0.0f), merged.min));
+    TEST_ASSERT(true, is_same(Math::Float4::Set(4.0f, 3.0f, 2.5f, 0.0f), merged.max));
+
+    const Math::aabb grown = Math::Bounds::Merge(a, Math::Float4::Set(0.0f, 5.0f, -1.0f, 0.0f));
+    TEST_ASSERT(true, is_same(Math::Float4::Set(-1.0f, 0.0f, -1.0f, 0.0f), grown.min));
+    TEST_ASSERT(true, is_same(Math::Float4::Set(1.0f, 5.0f, 2.5f, 0.0f), grown.max));
+
+    /* Transformed box is bounds of transformed corners */
+    const Math::float12 matrix = Math::Matrix::TransformationFromQuaternionAndVector(
+        unit_quaternion(0.75f),
+        Math::Float4::Set(1.0f, -2.0f, 3.0f, 0.0f));
+    const Math::aabb transformed = Math::Bounds::Transform(matrix, a);
+    Math::float4 corners_min = Math::Float4::Set(1.0e30f);
+    Math::float4 corners_max = Math::Float4::Set(-1.0e30f);
+
+    for (Platform::uint32 corner = 0; corner < 8; ++corner)
+    {
+        const Math::float4 point = Math::Float4::Set(
+            (corner & 1) ? a.max.x : a.min.x,
+            (corner & 2) ? a.max.y : a.min.y,
+            (corner & 4) ? a.max.z : a.min.z,
+            1.0f);
+        const Math::float4 res = Math::Float4::Set(
+            Math::Skinning::Dot(matrix.x, point),
+            Math::Skinning::Dot(matrix.y, point),
+            Math::Skinning::Dot(matrix.z, point),
+            1.0f);
+
+        corners_min.m128 = _mm_min_ps(corners_min.m128, res.m128);
+        corners_max.m128 = _mm_max_ps(corners_max.m128, res.m128);
+    }
+
+    TEST_ASSERT(true, is_close(corners_min, transformed.min, 0.0001f));
+    TEST_ASSERT(true, is_close(corners_max, transformed.max, 0.0001f));
+
+    /* Spheres */
+    const Math::sphere around = Math::Bounds::Make_sphere(a);
+    TEST_ASSERT(true, is_close(Math::Float4::Set(0.0f, 1.5f, 2.25f, sqrtf(4.0f + 9.0f + 0.25f) * 0.5f), Math::Float4::Set(around.x, around.y, around.z, around.radius), 0.00001f));
+
+    const Math::sphere first = Math::Bounds::Make_sphere(Math::Float4::Set(0.0f, 0.0f, 0.0f, 0.0f), 1.0f);
+    const Math::sphere second = Math::Bounds::Make_sphere(Math::Float4::Set(4.0f, 0.0f, 0.0f, 0.0f), 2.0f);
+    const Math::sphere inner = Math::Bounds::Make_sphere(Math::Float4::Set(3.5f, 0.5f, 0.0f, 0.0f), 0.5f);
+
+    const Math::sphere both = Math::Bounds::Merge(first, second);
+    TEST_ASSERT(true, is_close(Math::Float4::Set(2.5f, 0.0f, 0.0f, 3.5f), Math::Float4::Set(both.x, both.y, both.z, both.radius), 0.00001f));
+    const Math::sphere outer = Math::Bounds::Merge(second, inner);
+    TEST_ASSERT(0, memcmp(&second, &outer, sizeof(second)));
+
+    const Math::sphere swapped = Math::Bounds::Merge(inner, second);
+    TEST_ASSERT(0, memcmp(&second, &swapped, sizeof(second)));
+
+    const Math::aabb sphere_box = Math::Bounds::Make_aabb(second);
+    TEST_ASSERT(true, is_same(Math::Float4::Set(2.0f, -2.0f, -2.0f, 0.0f), Math::Float4::Set(sphere_box.min.x, sphere_box.min.y, sphere_box.min.z, 0.0f)));
+    TEST_ASSERT(true, is_same(Math::Float4::Set(6.0f, 2.0f, 2.0f, 0.0f), Math::Float4::Set(sphere_box.max.x, sphere_box.max.y, sphere_box.max.z, 0.0f)));
+
+    /* Frustum of identity: -1 <= x, y <= 1 and 0 <= z <= 1 */
+    const Math::frustum cube = Math::Bounds::Make_frustum(Math::Float16::One());
+    TEST_ASSERT(6, cube.count);
+    TEST_ASSERT(true, Math::Bounds::Is_visible(cube, Math::Bounds::Make_aabb(Math::Float4::Set(-0.5f, -0.5f, 0.25f, 0.0f), Math::Float4::Set(0.5f, 0.5f, 0.75f, 0.0f))));
+    TEST_ASSERT(true, Math::Bounds::Is_visible(cube, Math::Bounds::Make_aabb(Math::Float4::Set(-5.0f, -5.0f, -5.0f, 0.0f), Math::Float4::Set(5.0f, 5.0f, 5.0f, 0.0f))));
+    TEST_ASSERT(true, Math::Bounds::Is_visible(cube, Math::Bounds::Make_aabb(Math::Float4::Set(0.9f, 0.9f, 0.9f, 0.0f), Math::Float4::Set(2.0f, 2.0f, 2.0f, 0.0f))));
+    TEST_ASSERT(false, Math::Bounds::Is_visible(cube, Math::Bounds::Make_aabb(Math::Float4::Set(1.5f, -0.5f, 0.25f, 0.0f), Math::Float4::Set(2.0f, 0.5f, 0.75f, 0.0f))));
+    TEST_ASSERT(false, Math::Bounds::Is_visible(cube, Math::Bounds::Make_aabb(Math::Float4::Set(-0.5f, -0.5f, -2.0f, 0.0f), Math::Float4::Set(0.5f, 0.5f, -0.5f, 0.0f))));
+
+    TEST_ASSERT(true, Math::Bounds::Is_visible(cube, Math::Bounds::Make_sphere(Math::Float4::Set(1.5f, 0.0f, 0.5f, 0.0f), 0.75f)));
+    TEST_ASSERT(false, Math::Bounds::Is_visible(cube, Math::Bounds::Make_sphere(Math::Float4::Set(1.5f, 0.0f, 0.5f, 0.0f), 0.25f)));
+    TEST_ASSERT(false, Math::Bounds::Is_visible(cube, Math::Bounds::Make_sphere(Math::Float4::Set(0.0f, 0.0f, 2.0f, 0.0f), 0.5f)));
+
+    /* Planes are normalised exactly, distances to spheres are not scaled */
+    const Math::frustum far = Math::Bounds::Make_frustum(perspective(0.5f, 1000.0f));
+    for (Platform::uint32 i = 0; i < far.count; ++i)
+    {
+        const float length = sqrtf(far.x[i] * far.x[i] + far.y[i] * far.y[i] + far.z[i] * far.z[i]);
+        TEST_ASSERT(true, fabsf(length - 1.0f) < 0.000001f);
+    }
+
+    /* No planes, everything is visible */
+    const Math::frustum none = Math::Bounds::Make_frustum(nullptr, 0);
+    TEST_ASSERT(true, Math::Bounds::Is_visible(none, b));
+    TEST_ASSERT(true, Math::Bounds::Is_visible(none, second));
+
+    return Passed;
+}
+
+static Test_result test_cull_kernels(
+    Math::Kernels::cull_boxes_soa_t cull_boxes,
+    Math::Kernels::cull_spheres_soa_t cull_spheres)
+{
+    /* More than thirty two and not multiple of any width, last elements are checked */
+    static const Platform::uint32 count = 37;
+
+    const Math::frustum planes = Math::Bounds::Make_frustum(perspective(0.5f, 20.0f));
+    float streams[6][count];
+    Platform::uint32 visible[count];
+    Platform::uint32 expected[count];
+    Platform::uint32 n_expected = 0;
+    Platform::uint32 n_checked = 0;
+
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        const float x = -12.0f + 0.67f * float(i);
+        const float y = 3.0f - 0.29f * float(i);
+        const float z = -2.0f + 0.71f * float(i);
+        const float size = 0.25f + 0.1f * float(i % 7);
+        const Math::aabb box = Math::Bounds::Make_aabb(Math::Float4::Set(x - size, y - size, z - size, 0.0f), Math::Float4::Set(x + size, y + size, z + size, 0.0f));
+
+        streams[0][i] = box.min.x;
+        streams[1][i] = box.min.y;
+        streams[2][i] = box.min.z;
+        streams[3][i] = box.max.x;
+        streams[4][i] = box.max.y;
+        streams[5][i] = box.max.z;
+
+        const bool is_visible = Math::Bounds::Is_visible(planes, box);
+        const int reference = reference_box_visibility(planes, box, 0.001f);
+
+        if (0 <= reference)
+        {
+            TEST_ASSERT(reference, is_visible ? 1 : 0);
+            n_checked += 1;
+        }
+
+        if (true == is_visible)
+        {
+            expected[n_expected] = i;
+            n_expected += 1;
+        }
+    }
+
+    /* Both visible and culled boxes are there */
+    TEST_ASSERT(true, 0 < n_expected);
+    TEST_ASSERT(true, count / 2 < n_checked);
+    TEST_ASSERT(true, count > n_expected);
+
+    const Math::aabb_soa boxes = { streams[0], streams[1], streams[2], streams[3], streams[4], streams[5] };
+
+    TEST_ASSERT(n_expected, cull_boxes(planes, boxes, visible, count));
+    TEST_ASSERT(0, memcmp(expected, visible, n_expected * sizeof(Platform::uint32)));
+
+    /* Tail only */
+    TEST_ASSERT(0, cull_boxes(planes, boxes, visible, 0));
+
+    /* Spheres, radius in w */
+    n_expected = 0;
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        streams[3][i] = 0.2f + 0.13f * float(i % 5);
+
+        const Math::sphere sphere = Math::Bounds::Make_sphere(Math::Float4::Set(streams[0][i], streams[1][i], streams[2][i], 0.0f), streams[3][i]);
+
+        if (true == Math::Bounds::Is_visible(planes, sphere))
+        {
+            expected[n_expected] = i;
+            n_expected += 1;
+        }
+    }
+
+    TEST_ASSERT(true, 0 < n_expected);
+    TEST_ASSERT(true, count > n_expected);
+
+    const Math::float4_soa spheres = { streams[0], streams[1], streams[2], streams[3] };
+
+    TEST_ASSERT(n_expected, cull_spheres(planes, spheres, visible, count));
+    TEST_ASSERT(0, memcmp(expected, visible, n_expected * sizeof(Platform::uint32)));
+
+    return Passed;
+}
+
+UNIT_TEST(Batch_cull_kernels)
+{
+    Test_result result = test_cull_kernels(
+        &Math::Kernels::Sse::Cull_boxes,
+        &Math::Kernels::Sse::Cull_spheres);
+
+    if ((Passed == result) &&
+        (true == Math::Cpu::Has_features(Math::Cpu::Avx2)))
+    {
+        result = test_cull_kernels(
+            &Math::Kernels::Avx2::Cull_boxes,
+            &Math::Kernels::Avx2::Cull_spheres);
+    }
+
+    if ((Passed == result) &&
+        (true == Math::Cpu::Has_features(Math::Cpu::Avx512f)))
+    {
+        result = test_cull_kernels(
+            &Math::Kernels::Avx512::Cull_boxes,
+            &Math::Kernels::Avx512::Cull_spheres);
+    }
+
+    return result;
+}
@@ -43,6 +43,7 @@ namespace Memory
     Binary_data::Binary_data(Platform::uint8 * data, Platform::uint64 size)
         : m_data(data)
         , m_size(size)
+        , m_is_view(false)
     {
         /* Nothing to be done here */
     }
@@ -102,13 +103,13 @@ namespace Memory
 
     void Binary_data::Release()
     {
-        if (nullptr != m_data)
+        if ((nullptr != m_data) &&
+            (false == m_is_view))
         {
             delete (char *) m_data;
-            m_data = nullptr;
         }
 
-        m_size = 0;
+        set(nullptr, 0, false);
     }
 
     Platform::int32 Binary_data::Copy_range(
@@ -130,8 +131,14 @@ namespace Memory
     {
         Release();
 
-        m_data = data;
-        m_size = size;
+        set(data, size, false);
+    }
+
+    void Binary_data::Reset_view(Platform::uint8 * data, size_type size)
+    {
+        Release();
+
+        set(data, size, true);
     }
 
     bool Binary_data::Is_null() const
@@ -139,6 +146,11 @@ namespace Memory
         return (nullptr == m_data);
     }
 
+    bool Binary_data::Is_view() const
+    {
+        return m_is_view;
+    }
+
     Platform::int32 Binary_data::copy(Platform::uint8 * data, size_type size)
     {
         auto ptr = new Platform::uint8[size_t(size)];
@@ -152,21 +164,22 @@ namespace Memory
 
         memcpy(ptr, data, size_t(size));
 
-        set(ptr, size);
+        set(ptr, size, false);
 
         return Utilities::Success;
     }
 
     void Binary_data::move(Binary_data & data)
     {
-        set(data.m_data, data.m_size);
-        data.set(nullptr, 0);
+        set(data.m_data, data.m_size, data.m_is_view);
+        data.set(nullptr, 0, false);
     }
 
-    void Binary_data::set(Platform::uint8 * data, size_type size)
+    void Binary_data::set(Platform::uint8 * data, size_type size, bool is_view)
     {
         m_data = data;
         m_size = size;
+        m_is_view = is_view;
     }
 
 } /* namespace Memory */
@@ -34,6 +34,13 @@
 
 namespace Memory
 {
+    /** \brief Block of memory
+     *
+     * Memory is owned and released with the object, unless it was set with
+     * Reset_view. View refers to memory that is kept alive by someone else,
+     * for example mapped file or bigger Binary_data. Copy of view owns copy
+     * of memory.
+     **/
     class Binary_data
     {
     public:
@@ -58,16 +65,19 @@ namespace Memory
             size_type size);
         void Release();
         void Reset(Platform::uint8 * data, size_type size);
+        void Reset_view(Platform::uint8 * data, size_type size);
 
         bool Is_null() const;
+        bool Is_view() const;
 
     private:
         Platform::int32 copy(Platform::uint8 * data, size_type size);
         void move(Binary_data & data);
-        void set(Platform::uint8 * data, size_type size);
+        void set(Platform::uint8 * data, size_type size, bool is_view);
 
         Platform::uint8 * m_data;
         size_type m_size;
+        bool m_is_view;
     };
 
 } /* namespace Memory */
@@ -0,0 +1,124 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file Pool.cpp
+**/
+
+#include "PCH.hpp"
+
+#include "Pool.hpp"
+
+namespace Task
+{
+	Pool::Pool()
+		: m_is_stopping(false)
+	{
+	}
+
+	Pool::~Pool()
+	{
+		Release();
+	}
+
+	void Pool::Init(size_t threads_count)
+	{
+		Release();
+
+		m_is_stopping = false;
+
+		for (size_t i = 0; i < threads_count; ++i)
+		{
+			m_threads.push_back(std::thread(&Pool::worker, this));
+		}
+	}
+
+	void Pool::Release()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			m_is_stopping = true;
+		}
+
+		m_condition.notify_all();
+
+		for (auto & thread : m_threads)
+		{
+			thread.join();
+		}
+
+		m_threads.clear();
+	}
+
+	size_t Pool::GetThreadsCount() const
+	{
+		return m_threads.size();
+	}
+
+	void Pool::Run(Job job)
+	{
+		if (true == m_threads.empty())
+		{
+			job();
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			m_jobs.push_back(std::move(job));
+		}
+
+		m_condition.notify_one();
+	}
+
+	/* Queue is drained before worker exits */
+	void Pool::worker()
+	{
+		for (;;)
+		{
+			Job job;
+
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+
+				m_condition.wait(lock, [this]() { return (true == m_is_stopping) || (false == m_jobs.empty()); });
+
+				if (true == m_jobs.empty())
+				{
+					return;
+				}
+
+				job = std::move(m_jobs.front());
+				m_jobs.pop_front();
+			}
+
+			job();
+		}
+	}
+}
@@ -0,0 +1,153 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file Pool.hpp
+**/
+
+#ifndef UTILITIES_TASK_POOL_HPP
+#define UTILITIES_TASK_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Task
+{
+	/** \brief Fixed set of worker threads executing jobs from shared queue
+	 *
+	 * Pool without threads executes everything on calling thread.
+	 **/
+	class Pool
+	{
+	public:
+		typedef std::function<void()> Job;
+
+		Pool();
+		~Pool();
+
+		Pool(const Pool &) = delete;
+		Pool & operator=(const Pool &) = delete;
+
+		/* Starts threads_count workers, previous ones are stopped */
+		void Init(size_t threads_count);
+
+		/* Waits for queued jobs and stops workers */
+		void Release();
+
+		size_t GetThreadsCount() const;
+
+		/* Queues job, it is executed immediately when there are no workers */
+		void Run(Job job);
+
+		/* Calls f(i) for each i in [0, count), returns when all calls are
+		 * done. Calling thread takes part and does not wait for queued
+		 * jobs, so it may be used from job and nested. */
+		template<typename F>
+		void ParallelFor(size_t count, const F & f);
+
+	private:
+		void worker();
+
+		std::vector<std::thread> m_threads;
+		std::deque<Job> m_jobs;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		bool m_is_stopping;
+	};
+
+	template<typename F>
+	void Pool::ParallelFor(size_t count, const F & f)
+	{
+		if (0 == count)
+		{
+			return;
+		}
+
+		const size_t helpers_count = std::min(m_threads.size(), count - 1);
+
+		if (0 == helpers_count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				f(i);
+			}
+
+			return;
+		}
+
+		/* Function returns when all indices are done. Helpers may start
+		 * later, they keep state alive and find no work then, so waiting
+		 * thread never depends on queued jobs. */
+		struct State
+		{
+			std::atomic<size_t> m_next;
+			std::atomic<size_t> m_done;
+			std::mutex m_mutex;
+			std::condition_variable m_condition;
+		};
+
+		auto state = std::make_shared<State>();
+		const F * function = &f;
+
+		state->m_next = 0;
+		state->m_done = 0;
+
+		auto process = [state, function, count]()
+		{
+			for (size_t i = state->m_next++; i < count; i = state->m_next++)
+			{
+				(*function)(i);
+
+				if (count == ++state->m_done)
+				{
+					std::lock_guard<std::mutex> lock(state->m_mutex);
+
+					state->m_condition.notify_all();
+				}
+			}
+		};
+
+		for (size_t i = 0; i < helpers_count; ++i)
+		{
+			Run(process);
+		}
+
+		process();
+
+		std::unique_lock<std::mutex> lock(state->m_mutex);
+		state->m_condition.wait(lock, [&state, count]() { return count == state->m_done; });
+	}
+}
+
+#endif /* UTILITIES_TASK_POOL_HPP */
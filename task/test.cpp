@@ -0,0 +1,96 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file test.cpp
+**/
+
+#include "PCH.hpp"
+
+#include <Unit_Tests\UnitTests.hpp>
+
+#include "Pool.hpp"
+
+#include <atomic>
+#include <vector>
+
+UNIT_TEST(Task_pool_parallel_for)
+{
+	Task::Pool pool;
+	pool.Init(3);
+
+	std::vector<int> calls(1000, 0);
+
+	pool.ParallelFor(calls.size(), [&calls](size_t i) { calls[i] += 1; });
+
+	for (auto count : calls)
+	{
+		TEST_ASSERT(1, count);
+	}
+
+	return Passed;
+}
+
+UNIT_TEST(Task_pool_parallel_for_from_job)
+{
+	/* Single worker runs the job, helper of ParallelFor stays queued */
+	Task::Pool pool;
+	pool.Init(1);
+
+	std::atomic<int> calls(0);
+	std::atomic<bool> is_done(false);
+
+	pool.Run([&]()
+	{
+		pool.ParallelFor(2, [&calls](size_t) { calls += 1; });
+		is_done = true;
+	});
+
+	pool.Release();
+
+	TEST_ASSERT(true, is_done.load());
+	TEST_ASSERT(2, calls.load());
+
+	return Passed;
+}
+
+UNIT_TEST(Task_pool_parallel_for_nested)
+{
+	Task::Pool pool;
+	pool.Init(1);
+
+	std::atomic<int> calls(0);
+
+	pool.ParallelFor(2, [&](size_t)
+	{
+		pool.ParallelFor(2, [&calls](size_t) { calls += 1; });
+	});
+
+	TEST_ASSERT(4, calls.load());
+
+	return Passed;
+}
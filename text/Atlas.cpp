@@ -0,0 +1,397 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file Atlas.cpp
+**/
+
+#include "PCH.hpp"
+#include "Atlas.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace Text
+{
+    Atlas::Atlas()
+        : m_id(next_id())
+        , m_page_width(0)
+        , m_page_height(0)
+        , m_padding(0)
+    {
+        /* Nothing to be done */
+    }
+
+    Atlas::~Atlas()
+    {
+        Release();
+    }
+
+    Platform::int32 Atlas::Init(
+        Platform::uint32 page_width,
+        Platform::uint32 page_height,
+        Platform::uint32 padding)
+    {
+        Release();
+
+        if ((0 == page_width) ||
+            (0 == page_height))
+        {
+            ASSERT(0);
+            return Utilities::Invalid_parameter;
+        }
+
+        m_page_width = page_width;
+        m_page_height = page_height;
+        m_padding = padding;
+
+        return Utilities::Success;
+    }
+
+    void Atlas::Release()
+    {
+        m_pages.clear();
+
+        m_id = next_id();
+        m_page_width = 0;
+        m_page_height = 0;
+        m_padding = 0;
+    }
+
+    Platform::int32 Atlas::Insert(Font & font)
+    {
+        const Platform::uint32 count = font.Get_characters(nullptr, 0);
+        std::vector< Font::character_t > characters(count);
+
+        font.Get_characters(characters.data(), count);
+
+        return Insert(font, characters.data(), count);
+    }
+
+    Platform::int32 Atlas::Insert(
+        Font & font,
+        const Font::character_t * characters,
+        Platform::uint32 count)
+    {
+        if (0 == m_page_width)
+        {
+            ASSERT(0);
+            return Utilities::Invalid_object;
+        }
+
+        std::vector< Glyph * > glyphs;
+
+        for (Platform::uint32 i = 0; i < count; ++i)
+        {
+            Glyph * glyph = font.get_glyph(characters[i]);
+
+            if ((nullptr == glyph) ||
+                (true == Contains(*glyph)) ||
+                (0 == glyph->m_descriptor.m_width) ||
+                (0 == glyph->m_descriptor.m_height) ||
+                (true == glyph->m_data.Is_null()))
+            {
+                continue;
+            }
+
+            glyphs.push_back(glyph);
+        }
+
+        return insert(glyphs);
+    }
+
+    bool Atlas::Contains(const Glyph & glyph) const
+    {
+        return (m_id == glyph.m_atlas_entry.m_atlas);
+    }
+
+    Platform::uint32 Atlas::Get_id() const
+    {
+        return m_id;
+    }
+
+    Platform::uint32 Atlas::Get_page_width() const
+    {
+        return m_page_width;
+    }
+
+    Platform::uint32 Atlas::Get_page_height() const
+    {
+        return m_page_height;
+    }
+
+    Platform::uint32 Atlas::Get_pages_count() const
+    {
+        return Platform::uint32(m_pages.size());
+    }
+
+    const Platform::uint8 * Atlas::Get_page(Platform::uint32 index) const
+    {
+        if (m_pages.size() <= index)
+        {
+            return nullptr;
+        }
+
+        return m_pages[index].m_image.data();
+    }
+
+    Platform::uint32 Atlas::Get_page_revision(Platform::uint32 index) const
+    {
+        if (m_pages.size() <= index)
+        {
+            return 0;
+        }
+
+        return m_pages[index].m_revision;
+    }
+
+    /* Tall images go first, skyline stays flat */
+    Platform::int32 Atlas::insert(std::vector< Glyph * > & glyphs)
+    {
+        std::sort(
+            glyphs.begin(),
+            glyphs.end(),
+            [](const Glyph * l, const Glyph * r) -> bool
+            {
+                if (l->m_descriptor.m_height != r->m_descriptor.m_height)
+                {
+                    return l->m_descriptor.m_height > r->m_descriptor.m_height;
+                }
+
+                return l->m_descriptor.m_width > r->m_descriptor.m_width;
+            });
+
+        for (auto glyph : glyphs)
+        {
+            /* Character may be listed many times */
+            if (true == Contains(*glyph))
+            {
+                continue;
+            }
+
+            const Platform::uint32 width = glyph->m_descriptor.m_width;
+            const Platform::uint32 height = glyph->m_descriptor.m_height;
+            const Platform::uint32 padded_width = width + m_padding;
+            const Platform::uint32 padded_height = height + m_padding;
+
+            if ((m_page_width < padded_width) ||
+                (m_page_height < padded_height))
+            {
+                ERRLOG("Glyph does not fit into page");
+                return Utilities::Invalid_parameter;
+            }
+
+            Platform::uint32 page = 0;
+            Platform::uint32 x = 0;
+            Platform::uint32 y = 0;
+
+            while ((m_pages.size() > page) &&
+                   (false == place(m_pages[page], padded_width, padded_height, x, y)))
+            {
+                ++page;
+            }
+
+            if (m_pages.size() == page)
+            {
+                add_page();
+                place(m_pages[page], padded_width, padded_height, x, y);
+            }
+
+            /* Copy image row by row */
+            Page & target = m_pages[page];
+            const Platform::uint8 * source = glyph->m_data.Data();
+
+            for (Platform::uint32 row = 0; row < height; ++row)
+            {
+                memcpy(&target.m_image[(y + row) * m_page_width + x], source + row * width, width);
+            }
+
+            target.m_revision += 1;
+
+            glyph->m_atlas_entry.m_atlas = m_id;
+            glyph->m_atlas_entry.m_page = page;
+            glyph->m_atlas_entry.m_x = x;
+            glyph->m_atlas_entry.m_y = y;
+            glyph->m_atlas_entry.m_u0 = float(x) / float(m_page_width);
+            glyph->m_atlas_entry.m_v0 = float(y) / float(m_page_height);
+            glyph->m_atlas_entry.m_u1 = float(x + width) / float(m_page_width);
+            glyph->m_atlas_entry.m_v1 = float(y + height) / float(m_page_height);
+        }
+
+        return Utilities::Success;
+    }
+
+    /** \brief Finds place with lowest bottom edge and updates skyline
+     *
+     * Ties are resolved with narrower segment, it wastes less space.
+     **/
+    bool Atlas::place(
+        Page & page,
+        Platform::uint32 width,
+        Platform::uint32 height,
+        Platform::uint32 & x,
+        Platform::uint32 & y)
+    {
+        auto & skyline = page.m_skyline;
+        size_t best = skyline.size();
+        Platform::uint32 best_bottom = 0;
+        Platform::uint32 best_width = 0;
+
+        for (size_t i = 0; i < skyline.size(); ++i)
+        {
+            Platform::uint32 top = 0;
+
+            if (false == fits(page, i, width, height, top))
+            {
+                continue;
+            }
+
+            const Platform::uint32 bottom = top + height;
+
+            if ((skyline.size() == best) ||
+                (best_bottom > bottom) ||
+                ((best_bottom == bottom) && (best_width > skyline[i].m_width)))
+            {
+                best = i;
+                best_bottom = bottom;
+                best_width = skyline[i].m_width;
+                y = top;
+            }
+        }
+
+        if (skyline.size() == best)
+        {
+            return false;
+        }
+
+        x = skyline[best].m_x;
+
+        /* New segment covers segments below rectangle */
+        skyline.insert(skyline.begin() + best, Node{ x, best_bottom, width });
+
+        const Platform::uint32 right = x + width;
+
+        for (size_t i = best + 1; i < skyline.size();)
+        {
+            Node & node = skyline[i];
+
+            if (right <= node.m_x)
+            {
+                break;
+            }
+
+            const Platform::uint32 shrink = right - node.m_x;
+
+            if (node.m_width <= shrink)
+            {
+                skyline.erase(skyline.begin() + i);
+                continue;
+            }
+
+            node.m_x += shrink;
+            node.m_width -= shrink;
+            break;
+        }
+
+        /* Merge neighbours of the same height */
+        for (size_t i = 0; i + 1 < skyline.size();)
+        {
+            if (skyline[i].m_y == skyline[i + 1].m_y)
+            {
+                skyline[i].m_width += skyline[i + 1].m_width;
+                skyline.erase(skyline.begin() + i + 1);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        return true;
+    }
+
+    /* Rectangle starts at segment and lies on the highest of segments below it */
+    bool Atlas::fits(
+        const Page & page,
+        size_t index,
+        Platform::uint32 width,
+        Platform::uint32 height,
+        Platform::uint32 & y) const
+    {
+        const auto & skyline = page.m_skyline;
+
+        if (m_page_width - skyline[index].m_x < width)
+        {
+            return false;
+        }
+
+        Platform::uint32 width_left = width;
+
+        y = 0;
+
+        for (size_t i = index; 0 < width_left; ++i)
+        {
+            y = std::max(y, skyline[i].m_y);
+
+            if (m_page_height - y < height)
+            {
+                return false;
+            }
+
+            width_left -= std::min(width_left, skyline[i].m_width);
+        }
+
+        return true;
+    }
+
+    /* Identifiers are unique within process, 0 is skipped */
+    Platform::uint32 Atlas::next_id()
+    {
+        static std::atomic< Platform::uint32 > s_last_id(0);
+
+        Platform::uint32 id = ++s_last_id;
+
+        while (0 == id)
+        {
+            id = ++s_last_id;
+        }
+
+        return id;
+    }
+
+    void Atlas::add_page()
+    {
+        m_pages.emplace_back();
+
+        Page & page = m_pages.back();
+
+        page.m_image.assign(size_t(m_page_width) * m_page_height, 0);
+        page.m_skyline.push_back(Node{ 0, 0, m_page_width });
+        page.m_revision = 0;
+    }
+}
@@ -0,0 +1,122 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file Atlas.hpp
+**/
+
+#ifndef TEXT_ATLAS_HPP
+#define TEXT_ATLAS_HPP
+
+#include "Font.hpp"
+
+#include <vector>
+
+namespace Text
+{
+    /** \brief Packs glyph images into pages
+     *
+     * Page is an image A8 width x height, stored row after row. Images are
+     * placed with skyline bottom-left heuristic and are separated by padding
+     * of empty pixels, so filtering does not mix neighbours. New page is
+     * added when image does not fit into any of existing ones.
+     *
+     * Location of image is stored in glyph, see Glyph::Atlas_entry. Glyph is
+     * in single atlas at a time, inserting it into another atlas overwrites
+     * entry. Init and Release change identifier of atlas, so entries left in
+     * glyphs are not taken as valid. Glyphs with empty image are not placed.
+     **/
+    class Atlas
+    {
+    public:
+        /* Ctr & dtr */
+        Atlas();
+        ~Atlas();
+
+        /* No copying */
+        Atlas(const Atlas & atlas) = delete;
+        Atlas & operator = (const Atlas & atlas) = delete;
+
+        /* Init & release */
+        Platform::int32 Init(
+            Platform::uint32 page_width,
+            Platform::uint32 page_height,
+            Platform::uint32 padding);
+        void Release();
+
+        /* Insertion, glyphs that are already in atlas are skipped. Glyph
+         * that does not fit into empty page fails with Invalid_parameter,
+         * glyphs placed before it stay in atlas */
+        Platform::int32 Insert(Font & font);
+        Platform::int32 Insert(
+            Font & font,
+            const Font::character_t * characters,
+            Platform::uint32 count);
+
+        /* Access */
+        bool Contains(const Glyph & glyph) const;
+        Platform::uint32 Get_id() const;
+        Platform::uint32 Get_page_width() const;
+        Platform::uint32 Get_page_height() const;
+        Platform::uint32 Get_pages_count() const;
+        const Platform::uint8 * Get_page(Platform::uint32 index) const;
+
+        /* Incremented each time page is modified, tells which pages have to be uploaded again */
+        Platform::uint32 Get_page_revision(Platform::uint32 index) const;
+
+    private:
+        /* Segment of skyline, segments cover whole width of page */
+        struct Node
+        {
+            Platform::uint32 m_x;
+            Platform::uint32 m_y;
+            Platform::uint32 m_width;
+        };
+
+        struct Page
+        {
+            std::vector< Platform::uint8 > m_image;
+            std::vector< Node > m_skyline;
+            Platform::uint32 m_revision;
+        };
+
+        Platform::int32 insert(std::vector< Glyph * > & glyphs);
+        bool place(Page & page, Platform::uint32 width, Platform::uint32 height, Platform::uint32 & x, Platform::uint32 & y);
+        bool fits(const Page & page, size_t index, Platform::uint32 width, Platform::uint32 height, Platform::uint32 & y) const;
+        void add_page();
+
+        static Platform::uint32 next_id();
+
+        std::vector< Page > m_pages;
+        Platform::uint32 m_id;
+        Platform::uint32 m_page_width;
+        Platform::uint32 m_page_height;
+        Platform::uint32 m_padding;
+    };
+}
+
+#endif /* TEXT_ATLAS_HPP */
@@ -34,14 +34,56 @@
 
 #include <Utilities\memory\MemoryAccess.hpp>
 
+#include <Utilities\containers\FlatHashMap.hpp>
+
+#include <emmintrin.h>
+
 #include <algorithm>
-#include <map>
+#include <array>
+#include <cstring>
+#include <deque>
+#include <vector>
 
 namespace Text
 {
-    using Map = std::map < Font::character_t, Glyph > ;
+    /* Page table covers Unicode code space, 17 planes of 0x10000 characters */
+    static const Font::character_t s_code_space = 0x110000;
+    static const Platform::uint32 s_block_shift = 8;
+    static const Platform::uint32 s_block_size = 1 << s_block_shift;
+    static const Platform::uint32 s_blocks_count = s_code_space >> s_block_shift;
+
+    using Block = std::array < Glyph *, s_block_size > ;
+
+    /* Pair of characters, left one in high bits */
+    using Kerning_key = Platform::uint64;
+    using Kerning_map = Containers::Flat_hash_map < Kerning_key, Platform::int32 > ;
+
+    /* "KERN" in file, section starts with tag and number of pairs */
+    static const Platform::uint32 s_kerning_tag = 0x4e52454b;
+    static const Platform::uint64 s_kerning_header_size = 2 * sizeof(Platform::uint32);
+
+    static Kerning_key make_kerning_key(
+        Font::character_t left,
+        Font::character_t right)
+    {
+        return (Kerning_key(left) << 32) | Kerning_key(right);
+    }
+
+    /* Distance in characters of block entries prefetched by Get_glyphs */
+    static const Platform::uint32 s_prefetch_distance = 16;
 
 
+    /** \brief Storage of glyphs
+     *
+     * Characters below TEXT_FONT_CHAR_LUT_SIZE are stored in m_ascii.
+     * Remaining characters are found with two level page table: m_block_index
+     * maps character >> 8 to block of 256 pointers. Block 0 is empty and it
+     * is shared by all ranges without glyphs, so lookup has no branches
+     * besides code space check. Sparse planes, like emoji or CJK extensions,
+     * cost only blocks that are used.
+     *
+     * Glyphs are kept in deque, pointers stay valid when glyphs are added.
+     **/
     class Font_pimpl
     {
     public:
@@ -53,9 +95,32 @@ namespace Text
         Font_pimpl(const Font_pimpl&) = delete;
         Font_pimpl & operator = (const Font_pimpl &) = delete;
 
+        /* Page table */
+        Glyph * Find(Font::character_t character) const;
+        Glyph * Insert(Font::character_t character);
+        void Prefetch(Font::character_t character) const;
+
+        /* Same as Font::Get_glyph */
+        const Glyph * Resolve(Font::character_t character) const;
+
+        /* Calls f(character, glyph) in increasing order of characters */
+        template <typename F>
+        void For_each(const F & f) const;
+
         /* Members */
         Glyph m_ascii[TEXT_FONT_CHAR_LUT_SIZE];
-        Map m_map;
+
+        /* Results of Get_glyph for ASCII, missing glyphs point to m_ascii[0] */
+        const Glyph * m_ascii_glyphs[TEXT_FONT_CHAR_LUT_SIZE];
+
+        Platform::uint16 m_block_index[s_blocks_count];
+        std::vector< Block > m_blocks;
+
+        Kerning_map m_kerning;
+        std::deque< Glyph > m_glyphs;
+
+        /* Images of glyphs loaded with Reference_images */
+        Memory::Binary_data m_data;
 
         Glyph::Descriptor m_max;
     };
@@ -63,6 +128,102 @@ namespace Text
     Font_pimpl::Font_pimpl()
     {
         m_max = Glyph::Descriptor{ 0, 0, 0, 0, 0, 0, 0, 0 };
+
+        /* Empty block */
+        m_blocks.emplace_back();
+        m_blocks[0].fill(nullptr);
+
+        std::fill(m_block_index, m_block_index + s_blocks_count, Platform::uint16(0));
+        std::fill(m_ascii_glyphs, m_ascii_glyphs + TEXT_FONT_CHAR_LUT_SIZE, &m_ascii[0]);
+    }
+
+    Glyph * Font_pimpl::Find(Font::character_t character) const
+    {
+        if (s_code_space <= character)
+        {
+            return nullptr;
+        }
+
+        return m_blocks[m_block_index[character >> s_block_shift]][character & (s_block_size - 1)];
+    }
+
+    Glyph * Font_pimpl::Insert(Font::character_t character)
+    {
+        if (s_code_space <= character)
+        {
+            return nullptr;
+        }
+
+        Platform::uint16 & index = m_block_index[character >> s_block_shift];
+
+        if (0 == index)
+        {
+            index = Platform::uint16(m_blocks.size());
+            m_blocks.emplace_back();
+            m_blocks.back().fill(nullptr);
+        }
+
+        Glyph * & glyph = m_blocks[index][character & (s_block_size - 1)];
+
+        if (nullptr == glyph)
+        {
+            m_glyphs.emplace_back();
+            glyph = &m_glyphs.back();
+        }
+
+        return glyph;
+    }
+
+    void Font_pimpl::Prefetch(Font::character_t character) const
+    {
+        if ((TEXT_FONT_CHAR_LUT_SIZE > character) ||
+            (s_code_space <= character))
+        {
+            return;
+        }
+
+        const Block & block = m_blocks[m_block_index[character >> s_block_shift]];
+
+        _mm_prefetch((const char *) &block[character & (s_block_size - 1)], _MM_HINT_T0);
+    }
+
+    const Glyph * Font_pimpl::Resolve(Font::character_t character) const
+    {
+        if (TEXT_FONT_CHAR_LUT_SIZE > character)
+        {
+            return m_ascii_glyphs[character];
+        }
+
+        const Glyph * glyph = Find(character);
+
+        if (nullptr == glyph)
+        {
+            return &m_ascii[0];
+        }
+
+        return glyph;
+    }
+
+    template <typename F>
+    void Font_pimpl::For_each(const F & f) const
+    {
+        for (Platform::uint32 i = 0; i < s_blocks_count; ++i)
+        {
+            if (0 == m_block_index[i])
+            {
+                continue;
+            }
+
+            const Block & block = m_blocks[m_block_index[i]];
+
+            for (Platform::uint32 j = 0; j < s_block_size; ++j)
+            {
+                if (nullptr != block[j])
+                {
+                    f(Font::character_t((i << s_block_shift) | j), *block[j]);
+                }
+            }
+        }
     }
 
     Font::Font()
@@ -106,6 +267,53 @@ namespace Text
         return Utilities::Success;
     }
 
+    template <typename T>
+    static T read_value(
+        const Platform::uint8 * ptr,
+        bool is_endianess_swapped)
+    {
+        T value;
+
+        memcpy(&value, ptr, sizeof(T));
+
+        if (true == is_endianess_swapped)
+        {
+            Memory::Access::Swap_endianess(value);
+        }
+
+        return value;
+    }
+
+    static Glyph::Descriptor read_descriptor(
+        const Platform::uint8 * ptr,
+        bool is_endianess_swapped)
+    {
+        Glyph::Descriptor descriptor;
+
+        memcpy(&descriptor, ptr, sizeof(Glyph::Descriptor));
+
+        if (true == is_endianess_swapped)
+        {
+            Memory::Access::Swap_endianess(descriptor.m_width);
+            Memory::Access::Swap_endianess(descriptor.m_height);
+            Memory::Access::Swap_endianess(descriptor.m_left);
+            Memory::Access::Swap_endianess(descriptor.m_top);
+            Memory::Access::Swap_endianess(descriptor.m_right);
+            Memory::Access::Swap_endianess(descriptor.m_bottom);
+            Memory::Access::Swap_endianess(descriptor.m_horizontal_advance);
+            Memory::Access::Swap_endianess(descriptor.m_vertical_advance);
+        }
+
+        return descriptor;
+    }
+
+    Platform::int32 Font::Init(
+        Memory::Binary_data && data,
+        bool is_endianess_swapped)
+    {
+        return Init(std::move(data), is_endianess_swapped, Copy_images);
+    }
+
     /** \brief Unpacks glyphs from memory
      *
      * The memory layout is as follows:
@@ -114,10 +322,19 @@ namespace Text
      * NOG * sizeof(Glyph::Descriptor) - descriptors
      * NOG * uint64 - image offsets
      * NOG * desc.width * desc.height - image data
+     * Optional, directly after last image:
+     * uint32 - Tag of kerning section, "KERN"
+     * uint32 - Number of kerning pairs - NOK
+     * NOK * (uint32 left, uint32 right, int32 adjustment) - kerning pairs
+     *
+     * Data after last image that does not start with the tag is ignored.
+     * Size of tables is validated once, then tables are read directly.
+     * Data is moved to font only with Reference_images.
      **/
     Platform::int32 Font::Init(
         Memory::Binary_data && data,
-        bool is_endianess_swapped)
+        bool is_endianess_swapped,
+        Load_mode mode)
     {
         /* Clean up */
         Release();
@@ -147,68 +364,71 @@ namespace Text
 
         /* Calculate constants */
         const Platform::uint64 off_chars = sizeof(Platform::uint32);
-        const Platform::uint64 size_chars = nog * sizeof(Font::character_t);
+        const Platform::uint64 size_chars = Platform::uint64(nog) * sizeof(Font::character_t);
         const Platform::uint64 off_descs = off_chars + size_chars;
-        const Platform::uint64 size_descs = nog * sizeof(Glyph::Descriptor);
+        const Platform::uint64 size_descs = Platform::uint64(nog) * sizeof(Glyph::Descriptor);
         const Platform::uint64 off_img_offs = off_descs + size_descs;
-        const Platform::uint64 size_img_offs = nog * sizeof(Platform::uint64);
+        const Platform::uint64 size_img_offs = Platform::uint64(nog) * sizeof(Platform::uint64);
         const Platform::uint64 off_imgs = off_img_offs + size_img_offs;
 
+        /* Validate tables */
+        if (data.Size() < off_imgs)
+        {
+            ERRLOG("Corrupted resource");
+            Release();
+            return Utilities::Failure;
+        }
+
+        /* Keep data, images are referenced in place */
+        if (Reference_images == mode)
+        {
+            m_pimpl->m_data = std::move(data);
+        }
+
+        const Memory::Binary_data & source = (Reference_images == mode) ? m_pimpl->m_data : data;
+        const Platform::uint8 * chars = source.Data() + off_chars;
+        const Platform::uint8 * descs = source.Data() + off_descs;
+        const Platform::uint8 * img_offs = source.Data() + off_img_offs;
+
+        /* Kerning follows last image */
+        Platform::uint64 off_kerning = off_imgs;
+
         /* Read each glyph */
         for (Platform::uint32 i = 0; i < nog; ++i)
         {
-            /* Calculate constants */
-            const Platform::uint64 off_char = off_chars + i * sizeof(Font::character_t);
-            const Platform::uint64 off_desc = off_descs + i * sizeof(Glyph::Descriptor);
-            const Platform::uint64 off_img_off = off_img_offs + i * sizeof(Platform::uint64);
+            const Font::character_t character = read_value<Font::character_t>(chars + i * sizeof(Font::character_t), is_endianess_swapped);
+            const Glyph::Descriptor descriptor = read_descriptor(descs + i * sizeof(Glyph::Descriptor), is_endianess_swapped);
+            const Platform::uint64 off_img = read_value<Platform::uint64>(img_offs + i * sizeof(Platform::uint64), is_endianess_swapped);
 
-            /* Get data */
-            Font::character_t character = 0;
-            Glyph::Descriptor descriptor = { 0 };
-            Platform::uint64 off_img = 0;
+            /* Get image data */
+            const Platform::uint64 size = Platform::uint64(descriptor.m_width) * descriptor.m_height;
 
-            ret = Memory::Access::Read(data, off_char, is_endianess_swapped, character);
-            if (Utilities::Success != ret)
+            if ((source.Size() < off_img) ||
+                (source.Size() - off_img < size))
             {
                 ERRLOG("Corrupted resource");
                 Release();
-                return ret;
+                return Utilities::Failure;
             }
 
-            ret = Memory::Access::Read(data, off_desc, descriptor);
-            if (Utilities::Success != ret)
-            {
-                ERRLOG("Corrupted resource");
-                Release();
-                return ret;
-            }
+            off_kerning = std::max(off_kerning, off_img + size);
 
-            ret = Memory::Access::Read(data, off_img_off, is_endianess_swapped, off_img);
-            if (Utilities::Success != ret)
+            Memory::Binary_data img_data;
+
+            if (Reference_images == mode)
             {
-                ERRLOG("Corrupted resource");
-                Release();
-                return ret;
+                img_data.Reset_view(source.Data() + off_img, size);
             }
-
-            if (true == is_endianess_swapped)
+            else
             {
-                Memory::Access::Swap_endianess(descriptor.m_width);
-                Memory::Access::Swap_endianess(descriptor.m_height);
-                Memory::Access::Swap_endianess(descriptor.m_left);
-                Memory::Access::Swap_endianess(descriptor.m_top);
-                Memory::Access::Swap_endianess(descriptor.m_right);
-                Memory::Access::Swap_endianess(descriptor.m_bottom);
-                Memory::Access::Swap_endianess(descriptor.m_horizontal_advance);
-                Memory::Access::Swap_endianess(descriptor.m_vertical_advance);
+                ret = img_data.Copy_range(source, off_img, size);
+                if (Utilities::Success != ret)
+                {
+                    Release();
+                    return ret;
+                }
             }
 
-            /* Get image data */
-            const auto size = descriptor.m_width * descriptor.m_height;
-
-            Memory::Binary_data img_data;
-            img_data.Copy_range(data, off_img, size);
-
             ret = Add_glyph(character, descriptor, std::move(img_data));
             if (Utilities::Success != ret)
             {
@@ -234,6 +454,40 @@ namespace Text
             }
         }
 
+        /* Read kerning */
+        Platform::uint32 tag = 0;
+
+        if ((source.Size() >= off_kerning + s_kerning_header_size) &&
+            (Utilities::Success == Memory::Access::Read(source, off_kerning, is_endianess_swapped, tag)) &&
+            (s_kerning_tag == tag))
+        {
+            const Platform::uint64 pair_size = 2 * sizeof(Font::character_t) + sizeof(Platform::int32);
+            Platform::uint32 nok = 0;
+
+            ret = Memory::Access::Read(source, off_kerning + sizeof(Platform::uint32), is_endianess_swapped, nok);
+            if ((Utilities::Success != ret) ||
+                ((source.Size() - off_kerning - s_kerning_header_size) / pair_size < nok))
+            {
+                ERRLOG("Corrupted resource");
+                Release();
+                return Utilities::Failure;
+            }
+
+            const Platform::uint8 * pairs = source.Data() + off_kerning + s_kerning_header_size;
+
+            m_pimpl->m_kerning.Reserve(nok);
+
+            for (Platform::uint32 i = 0; i < nok; ++i)
+            {
+                const Platform::uint8 * pair = pairs + i * pair_size;
+                const Font::character_t left = read_value<Font::character_t>(pair, is_endianess_swapped);
+                const Font::character_t right = read_value<Font::character_t>(pair + sizeof(Font::character_t), is_endianess_swapped);
+                const Platform::int32 adjustment = read_value<Platform::int32>(pair + 2 * sizeof(Font::character_t), is_endianess_swapped);
+
+                m_pimpl->m_kerning[make_kerning_key(left, right)] = adjustment;
+            }
+        }
+
         return Utilities::Success;
     }
 
@@ -245,7 +499,7 @@ namespace Text
         }
 
         /* Get NOG & image data size */
-        Platform::uint32 nog = m_pimpl->m_map.size();
+        Platform::uint32 nog = Platform::uint32(m_pimpl->m_glyphs.size());
         Platform::uint64 image_data_size = 0;
 
         for (Platform::uint32 i = 0; i < TEXT_FONT_CHAR_LUT_SIZE; ++i)
@@ -261,11 +515,10 @@ namespace Text
             }
         }
 
-        for (auto it : m_pimpl->m_map)
+        m_pimpl->For_each([&](character_t, const Glyph & glyph)
         {
-            auto size = it.second.Get_data().Size();
-            image_data_size += size;
-        }
+            image_data_size += glyph.Get_data().Size();
+        });
 
 
         /* Calculate constants */
@@ -276,7 +529,10 @@ namespace Text
         const Platform::uint64 off_img_offs = off_descs + size_descs;
         const Platform::uint64 size_img_offs = nog * sizeof(Platform::uint64);
         const Platform::uint64 off_imgs = off_img_offs + size_img_offs;
-        const Platform::uint64 memory_req = off_imgs + image_data_size;
+        const Platform::uint64 off_kerning = off_imgs + image_data_size;
+        const Platform::uint64 nok = m_pimpl->m_kerning.Size();
+        const Platform::uint64 size_kerning = (0 == nok) ? 0 : s_kerning_header_size + nok * (2 * sizeof(Font::character_t) + sizeof(Platform::int32));
+        const Platform::uint64 memory_req = off_kerning + size_kerning;
 
         /* Allocate memory */
         auto ptr = new Platform::uint8[size_t(memory_req)];
@@ -372,18 +628,71 @@ namespace Text
             ++index;
         }
 
-        for (auto it : m_pimpl->m_map)
+        ret = Utilities::Success;
+
+        m_pimpl->For_each([&](character_t character, const Glyph & glyph)
         {
-            const Glyph * glyph = &it.second;
+            if (Utilities::Success != ret)
+            {
+                return;
+            }
+
+            ret = write_glyph(character, &glyph, index, off_img);
+            ++index;
+        });
+
+        if (Utilities::Success != ret)
+        {
+            ASSERT(0);
+            return ret;
+        }
+
+        /* Store kerning, pairs are sorted so output does not depend on hashing */
+        if (0 != nok)
+        {
+            std::vector< std::pair< Kerning_key, Platform::int32 > > pairs;
+
+            pairs.reserve(size_t(nok));
+            m_pimpl->m_kerning.For_each([&](Kerning_key key, Platform::int32 adjustment)
+            {
+                pairs.push_back(std::make_pair(key, adjustment));
+            });
+            std::sort(pairs.begin(), pairs.end());
+
+            ret = Memory::Access::Write(out_result, off_kerning, s_kerning_tag);
+            if (Utilities::Success == ret)
+            {
+                ret = Memory::Access::Write(out_result, off_kerning + sizeof(Platform::uint32), Platform::uint32(nok));
+            }
+
+            Platform::uint64 off_pair = off_kerning + s_kerning_header_size;
+
+            for (auto & pair : pairs)
+            {
+                if (Utilities::Success != ret)
+                {
+                    break;
+                }
+
+                ret = Memory::Access::Write(out_result, off_pair, Font::character_t(pair.first >> 32));
+                if (Utilities::Success == ret)
+                {
+                    ret = Memory::Access::Write(out_result, off_pair + 4, Font::character_t(pair.first));
+                }
+                if (Utilities::Success == ret)
+                {
+                    ret = Memory::Access::Write(out_result, off_pair + 8, pair.second);
+                }
+
+                off_pair += 2 * sizeof(Font::character_t) + sizeof(Platform::int32);
+            }
 
-            auto ret = write_glyph(it.first, glyph, index, off_img);
             if (Utilities::Success != ret)
             {
+                ERRLOG("Corrupted resource");
                 ASSERT(0);
                 return ret;
             }
-
-            ++index;
         }
 
         return Utilities::Success;
@@ -412,11 +721,23 @@ namespace Text
         /* Store glyph */
         if (TEXT_FONT_CHAR_LUT_SIZE > character)
         {
-            m_pimpl->m_ascii[character].Init(std::move(image), descriptor);
+            Glyph & glyph = m_pimpl->m_ascii[character];
+
+            glyph.Init(std::move(image), descriptor);
+
+            m_pimpl->m_ascii_glyphs[character] = (true == glyph.Get_data().Is_null()) ? &m_pimpl->m_ascii[0] : &glyph;
         }
         else
         {
-            m_pimpl->m_map[character].Init(std::move(image), descriptor);
+            Glyph * glyph = m_pimpl->Insert(character);
+
+            if (nullptr == glyph)
+            {
+                ERRLOG("Character is out of Unicode code space");
+                return Utilities::Invalid_parameter;
+            }
+
+            glyph->Init(std::move(image), descriptor);
         }
 
         return Utilities::Success;
@@ -463,15 +784,74 @@ namespace Text
         }
         else
         {
-            auto it = m_pimpl->m_map.find(character);
+            ptr = m_pimpl->Find(character);
+        }
+            
+        return ptr;
+    }
 
-            if (m_pimpl->m_map.end() != it)
+    /** \brief Resolves glyphs of whole string
+     *
+     * Result is the same as Get_glyph called for each character. Characters
+     * are tested four at a time, runs of ASCII are read from table without
+     * touching page table. Block entries of characters ahead are prefetched.
+     **/
+    Platform::int32 Font::Get_glyphs(
+        const character_t * characters,
+        Platform::uint32 count,
+        const Glyph ** out_glyphs) const
+    {
+        if (nullptr == m_pimpl)
+        {
+            ASSERT(0);
+            return Utilities::Invalid_object;
+        }
+
+        if ((0 != count) &&
+            ((nullptr == characters) ||
+             (nullptr == out_glyphs)))
+        {
+            ASSERT(0);
+            return Utilities::Invalid_parameter;
+        }
+
+        const Font_pimpl & pimpl = *m_pimpl;
+        const __m128i zero = _mm_setzero_si128();
+        Platform::uint32 i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            if (count > i + s_prefetch_distance)
+            {
+                pimpl.Prefetch(characters[i + s_prefetch_distance]);
+            }
+
+            /* Character is ASCII when bits above 7th are zero */
+            const __m128i chars = _mm_loadu_si128((const __m128i *) (characters + i));
+            const __m128i high = _mm_srli_epi32(chars, 7);
+
+            if (0xffff == _mm_movemask_epi8(_mm_cmpeq_epi32(high, zero)))
             {
-                ptr = &it->second;
+                out_glyphs[i + 0] = pimpl.m_ascii_glyphs[characters[i + 0]];
+                out_glyphs[i + 1] = pimpl.m_ascii_glyphs[characters[i + 1]];
+                out_glyphs[i + 2] = pimpl.m_ascii_glyphs[characters[i + 2]];
+                out_glyphs[i + 3] = pimpl.m_ascii_glyphs[characters[i + 3]];
+            }
+            else
+            {
+                out_glyphs[i + 0] = pimpl.Resolve(characters[i + 0]);
+                out_glyphs[i + 1] = pimpl.Resolve(characters[i + 1]);
+                out_glyphs[i + 2] = pimpl.Resolve(characters[i + 2]);
+                out_glyphs[i + 3] = pimpl.Resolve(characters[i + 3]);
             }
         }
-            
-        return ptr;
+
+        for (; i < count; ++i)
+        {
+            out_glyphs[i] = pimpl.Resolve(characters[i]);
+        }
+
+        return Utilities::Success;
     }
 
     const Glyph::Descriptor * Font::Get_max() const
@@ -483,4 +863,88 @@ namespace Text
 
         return &m_pimpl->m_max;
     }
+
+    /** \brief Lists characters that have glyph
+     *
+     * Characters are written in increasing order, up to capacity. Returns
+     * number of all characters, out_characters may be null to query it.
+     **/
+    Platform::uint32 Font::Get_characters(
+        character_t * out_characters,
+        Platform::uint32 capacity) const
+    {
+        if (nullptr == m_pimpl)
+        {
+            return 0;
+        }
+
+        Platform::uint32 count = 0;
+
+        auto add = [&](character_t character)
+        {
+            if ((nullptr != out_characters) &&
+                (capacity > count))
+            {
+                out_characters[count] = character;
+            }
+
+            ++count;
+        };
+
+        for (character_t i = 0; i < TEXT_FONT_CHAR_LUT_SIZE; ++i)
+        {
+            if (nullptr != Get_glyph_raw(i))
+            {
+                add(i);
+            }
+        }
+
+        m_pimpl->For_each([&](character_t character, const Glyph &)
+        {
+            add(character);
+        });
+
+        return count;
+    }
+
+    Platform::int32 Font::Add_kerning(
+        character_t left,
+        character_t right,
+        Platform::int32 adjustment)
+    {
+        if (nullptr == m_pimpl)
+        {
+            ASSERT(0);
+            return Utilities::Invalid_object;
+        }
+
+        m_pimpl->m_kerning[make_kerning_key(left, right)] = adjustment;
+
+        return Utilities::Success;
+    }
+
+    Platform::int32 Font::Get_kerning(
+        character_t left,
+        character_t right) const
+    {
+        if ((nullptr == m_pimpl) ||
+            (true == m_pimpl->m_kerning.Is_empty()))
+        {
+            return 0;
+        }
+
+        const Platform::int32 * adjustment = m_pimpl->m_kerning.Find(make_kerning_key(left, right));
+
+        return (nullptr == adjustment) ? 0 : *adjustment;
+    }
+
+    bool Font::Has_kerning() const
+    {
+        return (nullptr != m_pimpl) && (false == m_pimpl->m_kerning.Is_empty());
+    }
+
+    Glyph * Font::get_glyph(character_t character)
+    {
+        return const_cast< Glyph * >(Get_glyph(character));
+    }
 }
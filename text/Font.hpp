@@ -42,6 +42,7 @@
 
 namespace Text
 {
+    class Atlas;
     class Font_pimpl;
     class Glyph;
 
@@ -49,10 +50,21 @@ namespace Text
      **/
     class Font
     {
+        friend class Atlas;
+
     public:
         /* Types */
         using character_t = Platform::uint32;
 
+        /* Copy_images: each glyph owns copy of its image.
+         * Reference_images: glyphs refer to images in data, data is kept by
+         * font. Data may be a view, then memory has to outlive font. */
+        enum Load_mode
+        {
+            Copy_images,
+            Reference_images,
+        };
+
         /* Ctr & dtr */
         Font();
         ~Font();
@@ -70,6 +82,10 @@ namespace Text
         Platform::int32 Init(
             Memory::Binary_data && data,
             bool is_endianess_swapped);
+        Platform::int32 Init(
+            Memory::Binary_data && data,
+            bool is_endianess_swapped,
+            Load_mode mode);
         Platform::int32 Font::Store(Memory::Binary_data & out_result) const;
         void Release();
 
@@ -80,9 +96,29 @@ namespace Text
             Memory::Binary_data && image);
         const Glyph * Get_glyph(character_t character) const;
         const Glyph * Get_glyph_raw(character_t character) const;
+        Platform::int32 Get_glyphs(
+            const character_t * characters,
+            Platform::uint32 count,
+            const Glyph ** out_glyphs) const;
         const Glyph::Descriptor * Get_max() const;
+        Platform::uint32 Get_characters(
+            character_t * out_characters,
+            Platform::uint32 capacity) const;
+
+        /* Kerning, adjustment is added to advance of left character when
+         * right one follows it */
+        Platform::int32 Add_kerning(
+            character_t left,
+            character_t right,
+            Platform::int32 adjustment);
+        Platform::int32 Get_kerning(
+            character_t left,
+            character_t right) const;
+        bool Has_kerning() const;
 
     private:
+        Glyph * get_glyph(character_t character);
+
         Font_pimpl * m_pimpl;
     };
 }
@@ -37,6 +37,7 @@ namespace Text
     Glyph::Glyph()
     {
         m_descriptor = Descriptor{ 0, 0, 0, 0, 0, 0, 0, 0 };
+        m_atlas_entry = Atlas_entry{ 0, 0, 0, 0, 0.0f, 0.0f, 0.0f, 0.0f };
     }
 
     Glyph::~Glyph()
@@ -48,6 +49,7 @@ namespace Text
     {
         m_data = std::move(glyph.m_data);
         m_descriptor = glyph.m_descriptor;
+        m_atlas_entry = glyph.m_atlas_entry;
 
         glyph.Release();
     }
@@ -58,6 +60,7 @@ namespace Text
 
         m_data = std::move(glyph.m_data);
         m_descriptor = glyph.m_descriptor;
+        m_atlas_entry = glyph.m_atlas_entry;
 
         glyph.Release();
 
@@ -88,6 +91,8 @@ namespace Text
         m_descriptor.m_bottom = 0;
         m_descriptor.m_horizontal_advance = 0;
         m_descriptor.m_vertical_advance = 0;
+
+        m_atlas_entry = Atlas_entry{ 0, 0, 0, 0, 0.0f, 0.0f, 0.0f, 0.0f };
     }
 
     const Memory::Binary_data & Glyph::Get_data() const
@@ -99,4 +104,9 @@ namespace Text
     {
         return m_descriptor;
     }
+
+    auto Glyph::Get_atlas_entry() const -> const Atlas_entry &
+    {
+        return m_atlas_entry;
+    }
 }
@@ -36,14 +36,18 @@
 
 namespace Text
 {
+    class Atlas;
     class Font;
 
     /** \brief Information and image of single character
      *
-     * Data is an image A8 width x height. Data is owned by Glyph instance.
+     * Data is an image A8 width x height. Data is owned by Glyph instance,
+     * unless it is a view of font data. Location of image in Atlas is
+     * stored with glyph.
      **/
     class Glyph
     {
+        friend class Atlas;
         friend class Font;
 
     public:
@@ -60,6 +64,21 @@ namespace Text
             Platform::int32  m_vertical_advance;
         };
 
+        /* Pixel rectangle and matching texture coordinates in page of Atlas,
+         * identifier of atlas is 0 when glyph was not placed. Entry may be
+         * left by released atlas, Atlas::Contains tells if it is valid */
+        struct Atlas_entry
+        {
+            Platform::uint32 m_atlas;
+            Platform::uint32 m_page;
+            Platform::uint32 m_x;
+            Platform::uint32 m_y;
+            float m_u0;
+            float m_v0;
+            float m_u1;
+            float m_v1;
+        };
+
         /* Ctr & dtr */
         Glyph();
         ~Glyph();
@@ -81,11 +100,13 @@ namespace Text
         /* Access */
         const Memory::Binary_data & Get_data() const;
         const Descriptor & Get_descriptor() const;
+        const Atlas_entry & Get_atlas_entry() const;
 
     private:
         Memory::Binary_data m_data;
 
         Descriptor m_descriptor;
+        Atlas_entry m_atlas_entry;
     };
 }
 
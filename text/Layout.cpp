@@ -32,10 +32,18 @@
 #include "PCH.hpp"
 #include "Layout.hpp"
 #include "Glyph.hpp"
+#include "LineBreak.hpp"
+#include "RunCache.hpp"
 
 #include <Utilities\containers\PointerContainer.hpp>
+#include <Utilities\task\Pool.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
 #include <list>
+#include <vector>
 
 namespace Text
 {
@@ -133,14 +141,156 @@ namespace Text
         Containers::PointerContainer::Remove_all(positions);
     }
 
-    Platform::int32 Init_layout(
+    /* Grows owned array of layout, previous positions are discarded */
+    static Platform::int32 reserve_positions(
+        const Platform::uint32 count,
+        Layout_buffer & layout)
+    {
+        if ((true == layout.m_Is_external) ||
+            (count <= layout.m_Capacity))
+        {
+            return Utilities::Success;
+        }
+
+        auto ptr = new Glyph_position[count];
+        if (nullptr == ptr)
+        {
+            ASSERT(0);
+            return Utilities::Failed_to_allocate_memory;
+        }
+
+        delete[] layout.m_Positions;
+
+        layout.m_Positions = ptr;
+        layout.m_Capacity = count;
+
+        return Utilities::Success;
+    }
+
+    /* Number of glyphs resolved at once, lookup is batched without allocation */
+    static const Platform::uint32 s_glyphs_chunk = 64;
+
+    /* Returned by output to end layout, remaining positions are known */
+    static const Platform::int32 s_converged = 1;
+
+    /* State of layout before placing character */
+    struct Cursor
+    {
+        Platform::uint32 m_char_index;
+        Platform::uint32 m_box_index;
+        Platform::int32 m_x;
+        Platform::int32 m_y;
+        bool m_is_box_started;
+    };
+
+    static const Cursor s_layout_start = { 0, 0, 0, 0, false };
+
+    /* Output of place_glyphs, positions are allocated one by one */
+    class List_output
+    {
+    public:
+        List_output(position_list & positions)
+            : m_positions(positions)
+        {
+            /* Nothing to be done */
+        }
+
+        Platform::int32 Add(
+            const Box * box,
+            const Platform::int32 x,
+            const Platform::int32 y,
+            const Glyph * glyph)
+        {
+            if (nullptr == add_glyph_position(box, x, y, glyph, m_positions))
+            {
+                ASSERT(0);
+                return Utilities::Failed_to_allocate_memory;
+            }
+
+            return Utilities::Success;
+        }
+
+    private:
+        position_list & m_positions;
+    };
+
+    /** \brief Output of place_glyphs, positions are written into array
+     *
+     * Array may hold positions of previous layout in range [tail_begin,
+     * tail_end). Layout converges when new position is the same as stored
+     * one, the rest of stored positions is valid then.
+     **/
+    class Buffer_output
+    {
+    public:
+        Buffer_output(
+            Layout_buffer & layout,
+            Platform::uint32 tail_begin = 0,
+            Platform::uint32 tail_end = 0)
+            : m_layout(layout)
+            , m_tail_begin(tail_begin)
+            , m_tail_end(tail_end)
+        {
+            /* Nothing to be done */
+        }
+
+        Platform::int32 Add(
+            const Box * box,
+            const Platform::int32 x,
+            const Platform::int32 y,
+            const Glyph * glyph)
+        {
+            if (m_layout.m_Capacity == m_layout.m_Count)
+            {
+                return Not_enough_space;
+            }
+
+            Glyph_position & position = m_layout.m_Positions[m_layout.m_Count];
+
+            if ((m_tail_begin <= m_layout.m_Count) &&
+                (m_tail_end > m_layout.m_Count) &&
+                (box == position.m_Box) &&
+                (x == position.m_X) &&
+                (y == position.m_Y))
+            {
+                return s_converged;
+            }
+
+            position.m_Glyph = glyph;
+            position.m_Box = box;
+            position.m_X = x;
+            position.m_Y = y;
+
+            m_layout.m_Count += 1;
+
+            return Utilities::Success;
+        }
+
+    private:
+        Layout_buffer & m_layout;
+        const Platform::uint32 m_tail_begin;
+        const Platform::uint32 m_tail_end;
+    };
+
+    /** \brief Places glyphs in boxes
+     *
+     * Layout starts from given cursor. Positions are passed to output in
+     * order of characters. Error returned by output stops layout. Number of
+     * placed characters is stored in out_count, also when layout fails.
+     **/
+    template <typename Output>
+    static Platform::int32 place_glyphs(
         const Font & font,
         const Box * boxes,
         const Platform::uint32 boxes_count,
         const Font::character_t * text,
         const Platform::uint32 characters_count,
-        Layout & layout)
+        const Cursor & start,
+        Output & output,
+        Platform::uint32 & out_count)
     {
+        out_count = start.m_char_index;
+
         if ((nullptr == boxes) ||
             (nullptr == text)  ||
             (0 == boxes_count) ||
@@ -155,46 +305,70 @@ namespace Text
             return Utilities::Invalid_object;
         }
 
-        position_list positions;
+        const Glyph * glyphs[s_glyphs_chunk];
+        Platform::uint32 chunk_begin = start.m_char_index;
+        Platform::uint32 chunk_end = start.m_char_index;
 
-        Platform::uint32 current_box_index = 0;
-        Platform::uint32 current_char_index = 0;
+        Platform::uint32 current_box_index = start.m_box_index;
+        Platform::uint32 current_char_index = start.m_char_index;
+        bool is_box_started = start.m_is_box_started;
 
         do
         {
             auto current_box = boxes + current_box_index;
 
-            Platform::int32 cursor_x = 0;
-            Platform::int32 cursor_y = 0;
+            Platform::int32 cursor_x = start.m_x;
+            Platform::int32 cursor_y = start.m_y;
+
+            if (false == is_box_started)
+            {
+                start_new_box(*current_box, *max, cursor_x, cursor_y);
+            }
 
-            start_new_box(*current_box, *max, cursor_x, cursor_y);
+            is_box_started = false;
 
             /* For each line */
             while (true == does_glyph_fit_vertically(*current_box, *max, cursor_y))
             {
-                do {
-                    const auto character = text[current_char_index];
+                while (characters_count > current_char_index)
+                {
+                    /* Resolve next chunk of glyphs */
+                    if (chunk_end == current_char_index)
+                    {
+                        const Platform::uint32 count = std::min(s_glyphs_chunk, characters_count - current_char_index);
+
+                        auto ret = font.Get_glyphs(text + current_char_index, count, glyphs);
+                        if (Utilities::Success != ret)
+                        {
+                            out_count = current_char_index;
+                            return ret;
+                        }
 
-                    const Glyph * glyph = font.Get_glyph(character);
+                        chunk_begin = current_char_index;
+                        chunk_end = current_char_index + count;
+                    }
+
+                    const Glyph * glyph = glyphs[current_char_index - chunk_begin];
                     const auto& descriptor = glyph->Get_descriptor();
+                    const bool is_line_feed = (Line_feed == text[current_char_index]);
 
-                    if (false == does_glyph_fit_horizontally(*current_box, descriptor, cursor_x))
+                    /* Line feed is placed where line ends */
+                    if ((false == is_line_feed) &&
+                        (false == does_glyph_fit_horizontally(*current_box, descriptor, cursor_x)))
                     {
                         break; /* Start new line and try with the same character */
                     }
 
                     /* Save glyph_usage and position */
-                    auto ret = add_glyph_position(
+                    auto ret = output.Add(
                         current_box,
                         cursor_x,
                         cursor_y,
-                        glyph,
-                        positions);
-                    if (nullptr == ret)
+                        glyph);
+                    if (Utilities::Success != ret)
                     {
-                        ASSERT(0);
-                        release_resources(positions);
-                        return Utilities::Failed_to_allocate_memory;
+                        out_count = current_char_index;
+                        return ret;
                     }
 
                     /* Advance cursor in line */
@@ -202,7 +376,12 @@ namespace Text
 
                     /* Increment index */
                     ++current_char_index;
-                } while (1);
+
+                    if (true == is_line_feed)
+                    {
+                        break;
+                    }
+                }
 
 
                 /* All characters done */
@@ -230,9 +409,39 @@ namespace Text
             }
         } while (current_box_index < boxes_count);
 
+        out_count = current_char_index;
+
+        if (current_char_index != characters_count)
+        {
+            return Not_enough_space;
+        }
+
+        return Utilities::Success;
+    }
+
+    Platform::int32 Init_layout(
+        const Font & font,
+        const Box * boxes,
+        const Platform::uint32 boxes_count,
+        const Font::character_t * text,
+        const Platform::uint32 characters_count,
+        Layout & layout)
+    {
+        position_list positions;
+        List_output output(positions);
+        Platform::uint32 count = 0;
+
+        auto ret = place_glyphs(font, boxes, boxes_count, text, characters_count, s_layout_start, output, count);
+        if ((Utilities::Success != ret) &&
+            (Not_enough_space != ret))
+        {
+            release_resources(positions);
+            return ret;
+        }
+
         /* Store results */
         {
-            auto ptr = new Glyph_position *[current_char_index];
+            auto ptr = new Glyph_position *[count];
             if (nullptr == ptr)
             {
                 ASSERT(0);
@@ -243,7 +452,7 @@ namespace Text
             Release_layout(layout);
 
             layout.m_Positions = ptr;
-            layout.m_Count = current_char_index;
+            layout.m_Count = count;
             Platform::uint32 index = 0;
 
             for (auto it : positions)
@@ -252,24 +461,928 @@ namespace Text
             }
         }
 
-        if (current_char_index != characters_count)
+        return ret;
+    }
+
+    /** \brief Places glyphs into array of layout
+     *
+     * Owned array grows to characters_count when it is too small and it is
+     * kept for next layouts. Storage set with Set_layout_storage is never
+     * reallocated, layout ends with Not_enough_space when it is full.
+     **/
+    Platform::int32 Init_layout(
+        const Font & font,
+        const Box * boxes,
+        const Platform::uint32 boxes_count,
+        const Font::character_t * text,
+        const Platform::uint32 characters_count,
+        Layout_buffer & layout)
+    {
+        layout.m_Count = 0;
+
+        auto ret = reserve_positions(characters_count, layout);
+        if (Utilities::Success != ret)
         {
-            return Not_enough_space;
+            return ret;
+        }
+
+        Buffer_output output(layout);
+        Platform::uint32 count = 0;
+
+        return place_glyphs(font, boxes, boxes_count, text, characters_count, s_layout_start, output, count);
+    }
+
+    /** \brief Updates layout after edit of text
+     *
+     * Positions before edit are kept. Layout is resumed after last of them
+     * and ends as soon as character after edit lands where it was before,
+     * positions of remaining characters are moved to new indices then.
+     * Font and boxes have to be the same as used for previous layout.
+     **/
+    Platform::int32 Update_layout(
+        const Font & font,
+        const Box * boxes,
+        const Platform::uint32 boxes_count,
+        const Font::character_t * text,
+        const Platform::uint32 characters_count,
+        const Text_edit & edit,
+        Layout_buffer & layout)
+    {
+        if ((edit.m_Begin > edit.m_Old_end) ||
+            (edit.m_Begin > edit.m_New_end) ||
+            (characters_count < edit.m_New_end))
+        {
+            ASSERT(0);
+            return Utilities::Invalid_parameter;
+        }
+
+        const Platform::uint32 old_count = layout.m_Count;
+        const Platform::uint32 resume = std::min(edit.m_Begin, old_count);
+        Platform::uint32 tail_count = (old_count > edit.m_Old_end) ? (old_count - edit.m_Old_end) : 0;
+
+        /* Grow owned array, positions are preserved */
+        if ((false == layout.m_Is_external) &&
+            (characters_count > layout.m_Capacity))
+        {
+            auto ptr = new Glyph_position[characters_count];
+            if (nullptr == ptr)
+            {
+                ASSERT(0);
+                return Utilities::Failed_to_allocate_memory;
+            }
+
+            if (0 != old_count)
+            {
+                memcpy(ptr, layout.m_Positions, old_count * sizeof(Glyph_position));
+            }
+
+            delete[] layout.m_Positions;
+
+            layout.m_Positions = ptr;
+            layout.m_Capacity = characters_count;
+        }
+
+        if (layout.m_Capacity < edit.m_New_end + tail_count)
+        {
+            tail_count = (layout.m_Capacity > edit.m_New_end) ? (layout.m_Capacity - edit.m_New_end) : 0;
+        }
+
+        /* Move positions of characters after edit */
+        if ((0 != tail_count) &&
+            (edit.m_Old_end != edit.m_New_end))
+        {
+            memmove(
+                layout.m_Positions + edit.m_New_end,
+                layout.m_Positions + edit.m_Old_end,
+                tail_count * sizeof(Glyph_position));
+        }
+
+        auto max = font.Get_max();
+        if (nullptr == max)
+        {
+            layout.m_Count = 0;
+            return Utilities::Invalid_object;
+        }
+
+        /* Cursor after last kept position */
+        Cursor start = s_layout_start;
+
+        if (0 != resume)
+        {
+            const Glyph_position & last = layout.m_Positions[resume - 1];
+
+            if ((boxes > last.m_Box) ||
+                (boxes + boxes_count <= last.m_Box))
+            {
+                ASSERT(0);
+                layout.m_Count = 0;
+                return Utilities::Invalid_parameter;
+            }
+
+            start.m_char_index = resume;
+            start.m_box_index = Platform::uint32(last.m_Box - boxes);
+            start.m_x = last.m_X + last.m_Glyph->Get_descriptor().m_horizontal_advance;
+            start.m_y = last.m_Y;
+            start.m_is_box_started = true;
+
+            /* Line feed ends line, characters before edit are not changed */
+            if (Line_feed == text[resume - 1])
+            {
+                return_cursor_in_line(*last.m_Box, start.m_x);
+                advance_cursor_in_row(*max, start.m_y);
+            }
+        }
+
+        layout.m_Count = resume;
+
+        Buffer_output output(layout, edit.m_New_end, edit.m_New_end + tail_count);
+        Platform::uint32 count = 0;
+
+        auto ret = place_glyphs(font, boxes, boxes_count, text, characters_count, start, output, count);
+        if (s_converged == ret)
+        {
+            layout.m_Count = edit.m_New_end + tail_count;
+
+            if (characters_count != layout.m_Count)
+            {
+                return Not_enough_space;
+            }
+
+            return Utilities::Success;
+        }
+
+        return ret;
+    }
+
+    /* Minimal number of characters processed by single job of parallel layout */
+    static const Platform::uint32 s_parallel_chunk = 4096;
+
+    /** \brief Paragraph broken into lines
+     *
+     * Positions hold x relative to left side of box and index of line in
+     * paragraph as y, until lines are assigned to boxes.
+     **/
+    struct Paragraph
+    {
+        Platform::uint32 m_begin;
+        Platform::uint32 m_end;
+        Platform::uint32 m_lines_count;
+
+        /* Character that does not fit into empty line or m_end */
+        Platform::uint32 m_blocked;
+    };
+
+    struct Line_slot
+    {
+        Platform::uint32 m_box_index;
+        Platform::int32 m_y;
+    };
+
+    static Platform::int32 break_paragraph(
+        const Font & font,
+        const Platform::int32 width,
+        const Font::character_t * text,
+        Glyph_position * positions,
+        Paragraph & paragraph)
+    {
+        const Glyph * glyphs[s_glyphs_chunk];
+        Platform::int32 x = 0;
+        Platform::uint32 line = 0;
+        bool is_line_empty = true;
+
+        paragraph.m_blocked = paragraph.m_end;
+
+        for (Platform::uint32 chunk = paragraph.m_begin; chunk < paragraph.m_end; chunk += s_glyphs_chunk)
+        {
+            const Platform::uint32 count = std::min(s_glyphs_chunk, paragraph.m_end - chunk);
+
+            auto ret = font.Get_glyphs(text + chunk, count, glyphs);
+            if (Utilities::Success != ret)
+            {
+                return ret;
+            }
+
+            for (Platform::uint32 i = 0; i < count; ++i)
+            {
+                const auto & descriptor = glyphs[i]->Get_descriptor();
+                const bool is_line_feed = (Line_feed == text[chunk + i]);
+
+                /* Same conditions as in place_glyphs */
+                if ((false == is_line_feed) &&
+                    (width - x < descriptor.m_right))
+                {
+                    if (width < descriptor.m_right)
+                    {
+                        paragraph.m_blocked = chunk + i;
+                        paragraph.m_lines_count = (true == is_line_empty) ? line : line + 1;
+                        return Utilities::Success;
+                    }
+
+                    x = 0;
+                    line += 1;
+                }
+
+                Glyph_position & position = positions[chunk + i];
+
+                position.m_Glyph = glyphs[i];
+                position.m_Box = nullptr;
+                position.m_X = x;
+                position.m_Y = Platform::int32(line);
+
+                x += descriptor.m_horizontal_advance;
+                is_line_empty = false;
+            }
         }
 
+        paragraph.m_lines_count = line + 1;
+
         return Utilities::Success;
     }
 
-    void Release_layout(Layout & layout)
+    /** \brief Lays out paragraphs concurrently
+     *
+     * Paragraph ends with line feed, so its lines depend only on width of
+     * boxes. Paragraphs are broken into lines in parallel, then lines are
+     * assigned to boxes in order and positions are moved to boxes in
+     * parallel. Result is the same as of Init_layout. Boxes of different
+     * widths and storage smaller than text are laid out serially.
+     **/
+    Platform::int32 Init_layout(
+        const Font & font,
+        const Box * boxes,
+        const Platform::uint32 boxes_count,
+        const Font::character_t * text,
+        const Platform::uint32 characters_count,
+        Task::Pool & pool,
+        Layout_buffer & layout)
     {
-        for (size_t i = 0; i < layout.m_Count; ++i)
+        if ((nullptr == boxes) ||
+            (nullptr == text)  ||
+            (0 == boxes_count) ||
+            (0 == characters_count))
         {
-            delete layout.m_Positions[i];
-            layout.m_Positions[i] = nullptr;
+            return Utilities::Invalid_parameter;
+        }
+
+        auto max = font.Get_max();
+        if (nullptr == max)
+        {
+            return Utilities::Invalid_object;
+        }
+
+        const Platform::int32 width = boxes[0].m_Right - boxes[0].m_Left;
+        bool is_width_uniform = true;
+
+        for (Platform::uint32 i = 1; i < boxes_count; ++i)
+        {
+            is_width_uniform = is_width_uniform && (width == boxes[i].m_Right - boxes[i].m_Left);
+        }
+
+        if ((false == is_width_uniform) ||
+            ((true == layout.m_Is_external) && (characters_count > layout.m_Capacity)))
+        {
+            return Init_layout(font, boxes, boxes_count, text, characters_count, layout);
+        }
+
+        layout.m_Count = 0;
+
+        auto ret = reserve_positions(characters_count, layout);
+        if (Utilities::Success != ret)
+        {
+            return ret;
+        }
+
+        /* Split text into paragraphs and paragraphs into jobs */
+        std::vector< Paragraph > paragraphs;
+        std::vector< Platform::uint32 > jobs;
+
+        {
+            Platform::uint32 begin = 0;
+            Platform::uint32 job_begin = 0;
+
+            jobs.push_back(0);
+
+            for (Platform::uint32 i = 0; i < characters_count; ++i)
+            {
+                if ((Line_feed != text[i]) &&
+                    (characters_count != i + 1))
+                {
+                    continue;
+                }
+
+                paragraphs.push_back(Paragraph{ begin, i + 1, 0, i + 1 });
+                begin = i + 1;
+
+                if (begin - job_begin >= s_parallel_chunk)
+                {
+                    jobs.push_back(Platform::uint32(paragraphs.size()));
+                    job_begin = begin;
+                }
+            }
+
+            if (jobs.back() != paragraphs.size())
+            {
+                jobs.push_back(Platform::uint32(paragraphs.size()));
+            }
+        }
+
+        const size_t jobs_count = jobs.size() - 1;
+        std::atomic< Platform::int32 > result(Utilities::Success);
+
+        pool.ParallelFor(jobs_count, [&](size_t job)
+        {
+            for (Platform::uint32 i = jobs[job]; i < jobs[job + 1]; ++i)
+            {
+                auto ret = break_paragraph(font, width, text, layout.m_Positions, paragraphs[i]);
+                if (Utilities::Success != ret)
+                {
+                    result = ret;
+                    return;
+                }
+            }
+        });
+
+        if (Utilities::Success != result)
+        {
+            return result;
+        }
+
+        /* Assign lines to boxes, the same way as place_glyphs */
+        std::vector< Line_slot > slots;
+        std::vector< Platform::uint32 > first_slots(paragraphs.size());
+        Platform::uint32 count = characters_count;
+
+        {
+            Platform::uint32 box_index = 0;
+            Platform::int32 x = 0;
+            Platform::int32 y = 0;
+            bool is_box_full = false;
+
+            start_new_box(boxes[0], *max, x, y);
+
+            for (size_t i = 0; i < paragraphs.size(); ++i)
+            {
+                const Paragraph & paragraph = paragraphs[i];
+
+                first_slots[i] = Platform::uint32(slots.size());
+
+                for (Platform::uint32 line = 0; line < paragraph.m_lines_count; ++line)
+                {
+                    if (0 != slots.size())
+                    {
+                        advance_cursor_in_row(*max, y);
+                    }
+
+                    while (false == does_glyph_fit_vertically(boxes[box_index], *max, y))
+                    {
+                        box_index += 1;
+
+                        if (boxes_count == box_index)
+                        {
+                            is_box_full = true;
+                            break;
+                        }
+
+                        start_new_box(boxes[box_index], *max, x, y);
+                    }
+
+                    if (true == is_box_full)
+                    {
+                        /* First character of line without place */
+                        count = paragraph.m_begin;
+
+                        while ((paragraph.m_blocked > count) &&
+                               (Platform::int32(line) > layout.m_Positions[count].m_Y))
+                        {
+                            ++count;
+                        }
+
+                        break;
+                    }
+
+                    slots.push_back(Line_slot{ box_index, y });
+                }
+
+                if ((true == is_box_full) ||
+                    (paragraph.m_end != paragraph.m_blocked))
+                {
+                    count = std::min(count, paragraph.m_blocked);
+                    break;
+                }
+            }
+        }
+
+        /* Move positions to boxes */
+        pool.ParallelFor(jobs_count, [&](size_t job)
+        {
+            for (Platform::uint32 i = jobs[job]; i < jobs[job + 1]; ++i)
+            {
+                const Paragraph & paragraph = paragraphs[i];
+
+                if (count <= paragraph.m_begin)
+                {
+                    return;
+                }
+
+                const Platform::uint32 end = std::min(count, paragraph.m_end);
+
+                for (Platform::uint32 n = paragraph.m_begin; n < end; ++n)
+                {
+                    Glyph_position & position = layout.m_Positions[n];
+                    const Line_slot & slot = slots[first_slots[i] + position.m_Y];
+
+                    position.m_Box = boxes + slot.m_box_index;
+                    position.m_X += boxes[slot.m_box_index].m_Left;
+                    position.m_Y = slot.m_y;
+                }
+            }
+        });
+
+        layout.m_Count = count;
+
+        if (characters_count != count)
+        {
+            return Not_enough_space;
+        }
+
+        return Utilities::Success;
+    }
+
+    /* Text and settings shared by line breaking functions */
+    struct Line_context
+    {
+        const Font & m_font;
+        const Font::character_t * m_text;
+        const Glyph_position * m_positions;
+        Platform::uint32 m_count;
+        bool m_use_kerning;
+        bool m_wrap_words;
+    };
+
+    static Platform::int32 get_kerning(
+        const Line_context & context,
+        Platform::uint32 index)
+    {
+        if (false == context.m_use_kerning)
+        {
+            return 0;
+        }
+
+        return context.m_font.Get_kerning(context.m_text[index - 1], context.m_text[index]);
+    }
+
+    static bool can_break_before(
+        const Line_context & context,
+        Platform::uint32 index)
+    {
+        return Is_break_allowed(
+            Get_break_class(context.m_text[index - 1]),
+            Get_break_class(context.m_text[index]));
+    }
+
+    /* Spaces may hang over end of line when words are wrapped */
+    static bool is_hanging(
+        const Line_context & context,
+        Platform::uint32 index)
+    {
+        return (true == context.m_wrap_words) && (Break_SP == Get_break_class(context.m_text[index]));
+    }
+
+    /** \brief Finds end of line that starts at begin
+     *
+     * Line ends after line feed, before character that does not fit or at
+     * last break opportunity before it. Word longer than line is broken at
+     * any character. Returns begin when first character does not fit.
+     **/
+    static Platform::uint32 find_line_end(
+        const Line_context & context,
+        const Platform::uint32 begin,
+        const Platform::int32 width)
+    {
+        Platform::int32 x = 0;
+        Platform::uint32 last_break = begin;
+
+        for (Platform::uint32 i = begin; i < context.m_count; ++i)
+        {
+            if (Line_feed == context.m_text[i])
+            {
+                return i + 1;
+            }
+
+            if (begin != i)
+            {
+                x += get_kerning(context, i);
+
+                if ((true == context.m_wrap_words) &&
+                    (true == can_break_before(context, i)))
+                {
+                    last_break = i;
+                }
+            }
+
+            const auto & descriptor = context.m_positions[i].m_Glyph->Get_descriptor();
+
+            if ((false == is_hanging(context, i)) &&
+                (width - x < descriptor.m_right))
+            {
+                return (begin != last_break) ? last_break : i;
+            }
+
+            x += descriptor.m_horizontal_advance;
+        }
+
+        return context.m_count;
+    }
+
+    /** \brief Knuth-Plass breaking of paragraph
+     *
+     * Lines end at break opportunities. Chosen breaks minimise sum of squares
+     * of space left in lines, except last one. Trailing spaces are not
+     * counted. Ends of lines are stored in out_line_ends in reversed order.
+     * Returns false when some word does not fit into width.
+     **/
+    static bool break_optimal(
+        const Line_context & context,
+        const Platform::uint32 begin,
+        const Platform::int32 width,
+        std::vector< Platform::uint32 > & out_line_ends)
+    {
+        struct Candidate
+        {
+            Platform::uint32 m_index;
+            Platform::uint32 m_previous;
+            Platform::int64 m_cost;
+        };
+
+        static const Platform::int64 s_infinity = INT64_MAX;
+
+        /* Offsets of characters when whole paragraph is single line */
+        std::vector< Platform::int32 > offsets;
+        std::vector< Candidate > candidates;
+
+        Platform::uint32 end = begin;
+        Platform::int32 x = 0;
+
+        candidates.push_back(Candidate{ begin, 0, 0 });
+
+        for (; end < context.m_count; ++end)
+        {
+            if (begin != end)
+            {
+                x += get_kerning(context, end);
+
+                if (true == can_break_before(context, end))
+                {
+                    candidates.push_back(Candidate{ end, 0, s_infinity });
+                }
+            }
+
+            offsets.push_back(x);
+            x += context.m_positions[end].m_Glyph->Get_descriptor().m_horizontal_advance;
+
+            if (Line_feed == context.m_text[end])
+            {
+                ++end;
+                break;
+            }
+        }
+
+        if (candidates.back().m_index != end)
+        {
+            candidates.push_back(Candidate{ end, 0, s_infinity });
+        }
+
+        for (size_t b = 1; b < candidates.size(); ++b)
+        {
+            const Platform::uint32 line_end = candidates[b].m_index;
+            Platform::uint32 content_end = line_end;
+
+            while ((begin < content_end) &&
+                   ((Line_feed == context.m_text[content_end - 1]) ||
+                    (true == is_hanging(context, content_end - 1))))
+            {
+                --content_end;
+            }
+
+            /* Extent of line grows as its start moves back */
+            Platform::int32 extent = INT32_MIN;
+            Platform::uint32 scanned = content_end;
+
+            for (size_t a = b; 0 < a--;)
+            {
+                const Platform::uint32 line_begin = candidates[a].m_index;
+
+                for (; line_begin < scanned; --scanned)
+                {
+                    const Platform::uint32 j = scanned - 1;
+
+                    extent = std::max(extent, offsets[j - begin] + context.m_positions[j].m_Glyph->Get_descriptor().m_right);
+                }
+
+                const Platform::int32 used = (line_begin < content_end) ? extent - offsets[line_begin - begin] : 0;
+
+                if (width < used)
+                {
+                    break;
+                }
+
+                if (s_infinity == candidates[a].m_cost)
+                {
+                    continue;
+                }
+
+                const Platform::int64 left = width - used;
+                const Platform::int64 cost = candidates[a].m_cost + ((end == line_end) ? 0 : left * left);
+
+                if (candidates[b].m_cost > cost)
+                {
+                    candidates[b].m_cost = cost;
+                    candidates[b].m_previous = Platform::uint32(a);
+                }
+            }
+        }
+
+        if (s_infinity == candidates.back().m_cost)
+        {
+            return false;
+        }
+
+        for (size_t b = candidates.size() - 1; 0 != b; b = candidates[b].m_previous)
+        {
+            out_line_ends.push_back(candidates[b].m_index);
+        }
+
+        return true;
+    }
+
+    /** \brief Places glyphs line by line with given options
+     *
+     * Lines flow through boxes the same way as in Init_layout. Optimal
+     * breaks are chosen for width of box where paragraph starts, line that
+     * does not fit into later box is broken greedily with rest of paragraph.
+     * Layout without kerning that wraps characters gives the same result as
+     * Init_layout.
+     **/
+    Platform::int32 Init_layout(
+        const Font & font,
+        const Box * boxes,
+        const Platform::uint32 boxes_count,
+        const Font::character_t * text,
+        const Platform::uint32 characters_count,
+        const Layout_options & options,
+        Layout_buffer & layout)
+    {
+        if ((nullptr == boxes) ||
+            (nullptr == text)  ||
+            (0 == boxes_count) ||
+            (0 == characters_count))
+        {
+            return Utilities::Invalid_parameter;
+        }
+
+        auto max = font.Get_max();
+        if (nullptr == max)
+        {
+            return Utilities::Invalid_object;
+        }
+
+        layout.m_Count = 0;
+
+        auto ret = reserve_positions(characters_count, layout);
+        if (Utilities::Success != ret)
+        {
+            return ret;
+        }
+
+        /* Glyphs are kept in positions until they are placed */
+        const Platform::uint32 count = std::min(characters_count, layout.m_Capacity);
+        Glyph_position * positions = layout.m_Positions;
+
+        for (Platform::uint32 chunk = 0; chunk < count; chunk += s_glyphs_chunk)
+        {
+            const Glyph * glyphs[s_glyphs_chunk];
+            const Platform::uint32 chunk_size = std::min(s_glyphs_chunk, count - chunk);
+
+            ret = font.Get_glyphs(text + chunk, chunk_size, glyphs);
+            if (Utilities::Success != ret)
+            {
+                return ret;
+            }
+
+            for (Platform::uint32 i = 0; i < chunk_size; ++i)
+            {
+                positions[chunk + i].m_Glyph = glyphs[i];
+            }
+        }
+
+        const Line_context context = {
+            font,
+            text,
+            positions,
+            count,
+            (true == options.m_Use_kerning) && (true == font.Has_kerning()),
+            (Wrap_character != options.m_Wrap_mode),
+        };
+
+        std::vector< Platform::uint32 > line_ends;
+
+        Platform::uint32 box_index = 0;
+        Platform::int32 cursor_x = 0;
+        Platform::int32 cursor_y = 0;
+        Platform::uint32 index = 0;
+
+        bool is_first_line = true;
+
+        start_new_box(boxes[0], *max, cursor_x, cursor_y);
+
+        while (count > index)
+        {
+            /* Line that does not fit any character is left empty */
+            if (false == is_first_line)
+            {
+                advance_cursor_in_row(*max, cursor_y);
+            }
+
+            is_first_line = false;
+
+            while (false == does_glyph_fit_vertically(boxes[box_index], *max, cursor_y))
+            {
+                ++box_index;
+
+                if (boxes_count == box_index)
+                {
+                    layout.m_Count = index;
+                    return Not_enough_space;
+                }
+
+                start_new_box(boxes[box_index], *max, cursor_x, cursor_y);
+            }
+
+            const Box & box = boxes[box_index];
+            const Platform::int32 width = box.m_Right - box.m_Left;
+
+            /* Plan lines of paragraph */
+            if ((Wrap_optimal == options.m_Wrap_mode) &&
+                ((0 == index) || (Line_feed == text[index - 1])))
+            {
+                line_ends.clear();
+                break_optimal(context, index, width, line_ends);
+            }
+
+            Platform::uint32 end = find_line_end(context, index, width);
+
+            if (false == line_ends.empty())
+            {
+                /* Planned end fits when greedy one is not before it */
+                if (end >= line_ends.back())
+                {
+                    end = line_ends.back();
+                    line_ends.pop_back();
+                }
+                else
+                {
+                    line_ends.clear();
+                }
+            }
+
+            /* Place glyphs of line */
+            return_cursor_in_line(box, cursor_x);
+
+            for (Platform::uint32 i = index; i < end; ++i)
+            {
+                if (index != i)
+                {
+                    cursor_x += get_kerning(context, i);
+                }
+
+                Glyph_position & position = positions[i];
+
+                position.m_Box = &box;
+                position.m_X = cursor_x;
+                position.m_Y = cursor_y;
+
+                advance_cursor_in_line(position.m_Glyph->Get_descriptor(), cursor_x);
+            }
+
+            index = end;
+        }
+
+        layout.m_Count = index;
+
+        if (characters_count != index)
+        {
+            return Not_enough_space;
+        }
+
+        return Utilities::Success;
+    }
+
+    /** \brief Places glyphs, reusing runs stored in cache
+     *
+     * Text that fits into first box is stored in cache. Next layout of the
+     * same text with the same font and width of first box copies stored
+     * positions, when box is high enough for all lines.
+     **/
+    Platform::int32 Init_layout(
+        const Font & font,
+        const Box * boxes,
+        const Platform::uint32 boxes_count,
+        const Font::character_t * text,
+        const Platform::uint32 characters_count,
+        Run_cache & cache,
+        Layout_buffer & layout)
+    {
+        auto max = font.Get_max();
+
+        if ((nullptr == boxes) ||
+            (nullptr == text) ||
+            (nullptr == max) ||
+            (0 == boxes_count) ||
+            (0 == characters_count))
+        {
+            return Init_layout(font, boxes, boxes_count, text, characters_count, layout);
+        }
+
+        const Box & box = boxes[0];
+        Run_cache::Run_view run;
+
+        if ((true == cache.Find(font, box.m_Right - box.m_Left, text, characters_count, run)) &&
+            ((false == layout.m_Is_external) || (characters_count <= layout.m_Capacity)))
+        {
+            Platform::int32 lowest_y = box.m_Top + run.m_Lowest_y;
+
+            if (true == does_glyph_fit_vertically(box, *max, lowest_y))
+            {
+                layout.m_Count = 0;
+
+                auto ret = reserve_positions(characters_count, layout);
+                if (Utilities::Success != ret)
+                {
+                    return ret;
+                }
+
+                for (Platform::uint32 i = 0; i < characters_count; ++i)
+                {
+                    Glyph_position & position = layout.m_Positions[i];
+
+                    position.m_Glyph = run.m_Positions[i].m_Glyph;
+                    position.m_Box = &box;
+                    position.m_X = box.m_Left + run.m_Positions[i].m_X;
+                    position.m_Y = box.m_Top + run.m_Positions[i].m_Y;
+                }
+
+                layout.m_Count = characters_count;
+
+                return Utilities::Success;
+            }
+        }
+
+        auto ret = Init_layout(font, boxes, boxes_count, text, characters_count, layout);
+
+        if ((Utilities::Success == ret) &&
+            (&box == layout.m_Positions[characters_count - 1].m_Box))
+        {
+            cache.Insert(font, box, text, characters_count, layout.m_Positions);
+        }
+
+        return ret;
+    }
+
+    void Set_layout_storage(
+        Layout_buffer & layout,
+        Glyph_position * positions,
+        const Platform::uint32 capacity)
+    {
+        Release_layout(layout);
+
+        layout.m_Positions = positions;
+        layout.m_Capacity = capacity;
+        layout.m_Is_external = true;
+    }
+
+    void Release_layout(Layout & layout)
+    {
+        for (size_t i = 0; i < layout.m_Count; ++i)
+        {
+            delete layout.m_Positions[i];
+            layout.m_Positions[i] = nullptr;
+        }
+
+        delete[] layout.m_Positions;
+        layout.m_Positions = nullptr;
+        layout.m_Count = 0;
+    }
+
+    void Release_layout(Layout_buffer & layout)
+    {
+        if (false == layout.m_Is_external)
+        {
+            delete[] layout.m_Positions;
         }
 
-        delete[] layout.m_Positions;
         layout.m_Positions = nullptr;
         layout.m_Count = 0;
+        layout.m_Capacity = 0;
+        layout.m_Is_external = false;
     }
 }
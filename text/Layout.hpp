@@ -34,8 +34,15 @@
 
 #include "Font.hpp"
 
+namespace Task
+{
+    class Pool;
+}
+
 namespace Text
 {
+    class Run_cache;
+
     class Box
     {
     public:
@@ -68,11 +75,53 @@ namespace Text
         Platform::uint32 m_Count;
     };
 
+    /** \brief Layout stored in single array of positions
+     *
+     * Array is owned by layout, unless it was provided with
+     * Set_layout_storage. Memory is kept between layouts, so text can be
+     * laid out every frame without allocations. Zero initialised instance
+     * is empty.
+     **/
+    struct Layout_buffer
+    {
+        Glyph_position * m_Positions;
+        Platform::uint32 m_Count;
+        Platform::uint32 m_Capacity;
+        bool m_Is_external;
+    };
+
+    /* Characters [m_Begin, m_Old_end) of previous text were replaced with
+     * characters [m_Begin, m_New_end) of new text */
+    struct Text_edit
+    {
+        Platform::uint32 m_Begin;
+        Platform::uint32 m_Old_end;
+        Platform::uint32 m_New_end;
+    };
+
     enum Layout_errors
     {
         Not_enough_space = -1024,
     };
 
+    enum Wrap_mode
+    {
+        Wrap_character, /* Line ends before first character that does not fit */
+        Wrap_word,      /* Line ends at last break opportunity that fits */
+        Wrap_optimal,   /* Breaks of paragraph minimise sum of squares of space left in lines */
+    };
+
+    struct Layout_options
+    {
+        Wrap_mode m_Wrap_mode;
+        bool m_Use_kerning;
+    };
+
+    enum Layout_characters
+    {
+        Line_feed = 0x0A,
+    };
+
 
     Platform::int32 Init_layout(
         const Font & font,
@@ -82,6 +131,51 @@ namespace Text
         const Platform::uint32 characters_count,
         Layout & layout);
     void Release_layout(Layout & layout);
+
+    Platform::int32 Init_layout(
+        const Font & font,
+        const Box * boxes,
+        const Platform::uint32 boxes_count,
+        const Font::character_t * text,
+        const Platform::uint32 characters_count,
+        Layout_buffer & layout);
+    Platform::int32 Init_layout(
+        const Font & font,
+        const Box * boxes,
+        const Platform::uint32 boxes_count,
+        const Font::character_t * text,
+        const Platform::uint32 characters_count,
+        Task::Pool & pool,
+        Layout_buffer & layout);
+    Platform::int32 Init_layout(
+        const Font & font,
+        const Box * boxes,
+        const Platform::uint32 boxes_count,
+        const Font::character_t * text,
+        const Platform::uint32 characters_count,
+        const Layout_options & options,
+        Layout_buffer & layout);
+    Platform::int32 Init_layout(
+        const Font & font,
+        const Box * boxes,
+        const Platform::uint32 boxes_count,
+        const Font::character_t * text,
+        const Platform::uint32 characters_count,
+        Run_cache & cache,
+        Layout_buffer & layout);
+    Platform::int32 Update_layout(
+        const Font & font,
+        const Box * boxes,
+        const Platform::uint32 boxes_count,
+        const Font::character_t * text,
+        const Platform::uint32 characters_count,
+        const Text_edit & edit,
+        Layout_buffer & layout);
+    void Set_layout_storage(
+        Layout_buffer & layout,
+        Glyph_position * positions,
+        const Platform::uint32 capacity);
+    void Release_layout(Layout_buffer & layout);
 }
 
 #endif /* TEXT_LAYOUT_HPP */
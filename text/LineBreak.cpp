@@ -0,0 +1,172 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file LineBreak.cpp
+**/
+
+#include "PCH.hpp"
+#include "LineBreak.hpp"
+
+#include <algorithm>
+
+namespace Text
+{
+    using Class = Platform::uint8;
+
+    /* Classes of ASCII characters */
+    static const Class s_ascii_classes[128] = {
+        /* 0x00 */ Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL,
+        /* 0x08 */ Break_AL, Break_BA, Break_BK, Break_BK, Break_BK, Break_BK, Break_AL, Break_AL,
+        /* 0x10 */ Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL,
+        /* 0x18 */ Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL,
+        /* ' '  */ Break_SP, Break_EX, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL,
+        /* '('  */ Break_OP, Break_CL, Break_AL, Break_AL, Break_IS, Break_BA, Break_IS, Break_IS,
+        /* '0'  */ Break_NU, Break_NU, Break_NU, Break_NU, Break_NU, Break_NU, Break_NU, Break_NU,
+        /* '8'  */ Break_NU, Break_NU, Break_IS, Break_IS, Break_AL, Break_AL, Break_AL, Break_EX,
+        /* '@'  */ Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL,
+        /* 'H'  */ Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL,
+        /* 'P'  */ Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL,
+        /* 'X'  */ Break_AL, Break_AL, Break_AL, Break_OP, Break_AL, Break_CL, Break_AL, Break_AL,
+        /* '`'  */ Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL,
+        /* 'h'  */ Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL,
+        /* 'p'  */ Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL, Break_AL,
+        /* 'x'  */ Break_AL, Break_AL, Break_AL, Break_OP, Break_BA, Break_CL, Break_AL, Break_AL,
+    };
+
+    struct Class_range
+    {
+        Font::character_t m_first;
+        Font::character_t m_last;
+        Class m_class;
+    };
+
+    /* Classes of remaining characters, sorted, characters out of ranges are AL */
+    static const Class_range s_ranges[] = {
+        { 0x00A0, 0x00A0, Break_GL },
+        { 0x00AD, 0x00AD, Break_BA },
+        { 0x1100, 0x115F, Break_ID },
+        { 0x2000, 0x2006, Break_BA },
+        { 0x2007, 0x2007, Break_GL },
+        { 0x2008, 0x200A, Break_BA },
+        { 0x2010, 0x2010, Break_BA },
+        { 0x2011, 0x2011, Break_GL },
+        { 0x2012, 0x2013, Break_BA },
+        { 0x2014, 0x2014, Break_BA },
+        { 0x2024, 0x2024, Break_IS },
+        { 0x202F, 0x202F, Break_GL },
+        { 0x203C, 0x203D, Break_EX },
+        { 0x2060, 0x2060, Break_GL },
+        { 0x2E80, 0x2FFF, Break_ID },
+        { 0x3000, 0x3000, Break_BA },
+        { 0x3001, 0x3002, Break_CL },
+        { 0x3003, 0x3007, Break_ID },
+        { 0x3008, 0x3008, Break_OP },
+        { 0x3009, 0x3009, Break_CL },
+        { 0x300A, 0x300A, Break_OP },
+        { 0x300B, 0x300B, Break_CL },
+        { 0x300C, 0x300C, Break_OP },
+        { 0x300D, 0x300D, Break_CL },
+        { 0x300E, 0x300E, Break_OP },
+        { 0x300F, 0x300F, Break_CL },
+        { 0x3010, 0x3010, Break_OP },
+        { 0x3011, 0x3011, Break_CL },
+        { 0x3012, 0x303F, Break_ID },
+        { 0x3040, 0x30FF, Break_ID },
+        { 0x3100, 0x33FF, Break_ID },
+        { 0x3400, 0x4DBF, Break_ID },
+        { 0x4E00, 0x9FFF, Break_ID },
+        { 0xA000, 0xA4CF, Break_ID },
+        { 0xAC00, 0xD7A3, Break_ID },
+        { 0xF900, 0xFAFF, Break_ID },
+        { 0xFE30, 0xFE4F, Break_ID },
+        { 0xFF01, 0xFF01, Break_EX },
+        { 0xFF08, 0xFF08, Break_OP },
+        { 0xFF09, 0xFF09, Break_CL },
+        { 0xFF0C, 0xFF0C, Break_CL },
+        { 0xFF0E, 0xFF0E, Break_CL },
+        { 0xFF1A, 0xFF1B, Break_IS },
+        { 0xFF1F, 0xFF1F, Break_EX },
+        { 0x1F000, 0x1FAFF, Break_ID },
+        { 0x20000, 0x2FFFD, Break_ID },
+        { 0x30000, 0x3FFFD, Break_ID },
+    };
+
+    /* Break is allowed between before (row) and after (column)
+     *
+     * Derived from pair rules of UAX #14: no break before SP, BK, CL, EX,
+     * IS and BA, no break after OP and GL, SP and BA allow break after, ID
+     * allows break on both sides. Alphanumerics are not broken. */
+    static const bool s_pairs[Break_classes_count][Break_classes_count] = {
+        /*          AL     NU     SP     BK     GL     BA     OP     CL     EX     IS     ID    */
+        /* AL */ { false, false, false, false, false, false, false, false, false, false, true  },
+        /* NU */ { false, false, false, false, false, false, false, false, false, false, true  },
+        /* SP */ { true,  true,  false, false, true,  true,  true,  false, false, false, true  },
+        /* BK */ { true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true  },
+        /* GL */ { false, false, false, false, false, false, false, false, false, false, false },
+        /* BA */ { true,  true,  false, false, true,  false, true,  false, false, false, true  },
+        /* OP */ { false, false, false, false, false, false, false, false, false, false, false },
+        /* CL */ { true,  true,  false, false, false, false, true,  false, false, false, true  },
+        /* EX */ { true,  true,  false, false, false, false, true,  false, false, false, true  },
+        /* IS */ { false, false, false, false, false, false, true,  false, false, false, true  },
+        /* ID */ { true,  true,  false, false, false, false, true,  false, false, false, true  },
+    };
+
+    Break_class Get_break_class(Font::character_t character)
+    {
+        if (128 > character)
+        {
+            return Break_class(s_ascii_classes[character]);
+        }
+
+        const Class_range * end = s_ranges + sizeof(s_ranges) / sizeof(s_ranges[0]);
+        const Class_range * it = std::upper_bound(
+            s_ranges,
+            end,
+            character,
+            [](Font::character_t c, const Class_range & range) -> bool
+            {
+                return c < range.m_first;
+            });
+
+        /* it points after range that may contain character */
+        if ((s_ranges != it) &&
+            ((it - 1)->m_last >= character))
+        {
+            return Break_class((it - 1)->m_class);
+        }
+
+        return Break_AL;
+    }
+
+    bool Is_break_allowed(
+        Break_class before,
+        Break_class after)
+    {
+        return s_pairs[before][after];
+    }
+}
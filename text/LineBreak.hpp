@@ -0,0 +1,65 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file LineBreak.hpp
+**/
+
+#ifndef TEXT_LINE_BREAK_HPP
+#define TEXT_LINE_BREAK_HPP
+
+#include "Font.hpp"
+
+namespace Text
+{
+    /* Subset of line breaking classes of UAX #14 */
+    enum Break_class
+    {
+        Break_AL, /* Alphabetic, default class */
+        Break_NU, /* Numeric */
+        Break_SP, /* Space */
+        Break_BK, /* Mandatory break, line feed */
+        Break_GL, /* Non-breaking glue */
+        Break_BA, /* Break after, hyphens and tab */
+        Break_OP, /* Open punctuation */
+        Break_CL, /* Close punctuation */
+        Break_EX, /* Exclamation and question mark */
+        Break_IS, /* Infix separator, comma and full stop */
+        Break_ID, /* Ideographic, CJK and emoji */
+
+        Break_classes_count,
+    };
+
+    Break_class Get_break_class(Font::character_t character);
+
+    /* Tells if line may be broken between characters of given classes */
+    bool Is_break_allowed(
+        Break_class before,
+        Break_class after);
+}
+
+#endif /* TEXT_LINE_BREAK_HPP */
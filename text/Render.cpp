@@ -0,0 +1,304 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file Render.cpp
+**/
+
+#include "PCH.hpp"
+#include "Render.hpp"
+#include "Glyph.hpp"
+#include "RenderKernels.hpp"
+
+#include <Utilities\math\Cpu.hpp>
+#include <Utilities\task\Pool.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace Text
+{
+    namespace Render_kernels
+    {
+        /* SSE2 is available on every x86-64 processor, it is used until selection is done */
+        static Table s_table =
+        {
+            "SSE2",
+            &Sse2::Blend_a8,
+            &Sse2::Blend_rgba8,
+        };
+
+        static bool select()
+        {
+            if (true == Math::Cpu::Has_features(Math::Cpu::Avx2))
+            {
+                s_table.m_name = "AVX2";
+                s_table.m_blend_a8 = &Avx2::Blend_a8;
+                s_table.m_blend_rgba8 = &Avx2::Blend_rgba8;
+            }
+
+            return true;
+        }
+
+        static const bool s_is_selected = select();
+
+        const char * Get_name()
+        {
+            return s_table.m_name;
+        }
+    }
+
+    /* Rows of surface drawn by single job of parallel render */
+    static const Platform::uint32 s_tile_rows = 32;
+
+    /* Rectangle of surface, [m_left, m_right) x [m_top, m_bottom) */
+    struct Rectangle
+    {
+        Platform::int32 m_left;
+        Platform::int32 m_top;
+        Platform::int32 m_right;
+        Platform::int32 m_bottom;
+    };
+
+    static bool is_surface_valid(const Surface & surface)
+    {
+        const Platform::uint32 pixel_size = (Surface_RGBA8 == surface.m_Format) ? 4 : 1;
+
+        return (nullptr != surface.m_Data) &&
+               ((Surface_A8 == surface.m_Format) || (Surface_RGBA8 == surface.m_Format)) &&
+               (surface.m_Width * pixel_size <= surface.m_Pitch) &&
+               (0x7fffffff >= surface.m_Width) &&
+               (0x7fffffff >= surface.m_Height);
+    }
+
+    /* Part of glyph image that is inside of clip and box, false when it is empty */
+    static bool clip_glyph(
+        const Glyph_position & position,
+        const Rectangle & clip,
+        Rectangle & out_rectangle)
+    {
+        if ((nullptr == position.m_Glyph) ||
+            (nullptr == position.m_Box))
+        {
+            return false;
+        }
+
+        const auto & descriptor = position.m_Glyph->Get_descriptor();
+        const auto & data = position.m_Glyph->Get_data();
+        const Box & box = *position.m_Box;
+
+        if ((true == data.Is_null()) ||
+            (size_t(descriptor.m_width) * descriptor.m_height > data.Size()))
+        {
+            return false;
+        }
+
+        /* Image of glyph in surface */
+        const Platform::int32 image_left = position.m_X + descriptor.m_left;
+        const Platform::int32 image_top = -(position.m_Y + descriptor.m_top);
+
+        out_rectangle.m_left = std::max({ clip.m_left, image_left, box.m_Left });
+        out_rectangle.m_top = std::max({ clip.m_top, image_top, -box.m_Top });
+        out_rectangle.m_right = std::min({ clip.m_right, image_left + Platform::int32(descriptor.m_width), box.m_Right });
+        out_rectangle.m_bottom = std::min({ clip.m_bottom, image_top + Platform::int32(descriptor.m_height), -box.m_Bottom });
+
+        return (out_rectangle.m_left < out_rectangle.m_right) &&
+               (out_rectangle.m_top < out_rectangle.m_bottom);
+    }
+
+    /* Blends glyph over part of surface that is inside of clip */
+    static void render_glyph(
+        const Glyph_position & position,
+        const Surface & surface,
+        const Rectangle & clip)
+    {
+        Rectangle rectangle;
+
+        if (false == clip_glyph(position, clip, rectangle))
+        {
+            return;
+        }
+
+        const auto & descriptor = position.m_Glyph->Get_descriptor();
+        const Platform::int32 image_left = position.m_X + descriptor.m_left;
+        const Platform::int32 image_top = -(position.m_Y + descriptor.m_top);
+
+        const Platform::int32 left = rectangle.m_left;
+        const Platform::int32 top = rectangle.m_top;
+        const Platform::int32 bottom = rectangle.m_bottom;
+
+        const Platform::uint32 count = Platform::uint32(rectangle.m_right - left);
+        const Platform::uint8 * coverage = position.m_Glyph->Get_data().Data() + size_t(top - image_top) * descriptor.m_width + (left - image_left);
+        Platform::uint8 * row = surface.m_Data + size_t(top) * surface.m_Pitch;
+
+        for (Platform::int32 y = top; y < bottom; ++y)
+        {
+            if (Surface_RGBA8 == surface.m_Format)
+            {
+                Render_kernels::s_table.m_blend_rgba8(coverage, row + 4 * left, count, surface.m_Color);
+            }
+            else
+            {
+                Render_kernels::s_table.m_blend_a8(coverage, row + left, count);
+            }
+
+            coverage += descriptor.m_width;
+            row += surface.m_Pitch;
+        }
+    }
+
+    static Rectangle get_tile(
+        const Surface & surface,
+        const Platform::uint32 index)
+    {
+        const Platform::uint32 top = index * s_tile_rows;
+
+        return Rectangle{
+            0,
+            Platform::int32(top),
+            Platform::int32(surface.m_Width),
+            Platform::int32(std::min(top + s_tile_rows, surface.m_Height)),
+        };
+    }
+
+    Platform::int32 Render(
+        const Layout & layout,
+        const Surface & surface)
+    {
+        if (false == is_surface_valid(surface))
+        {
+            ASSERT(0);
+            return Utilities::Invalid_parameter;
+        }
+
+        const Rectangle clip = { 0, 0, Platform::int32(surface.m_Width), Platform::int32(surface.m_Height) };
+
+        for (Platform::uint32 i = 0; i < layout.m_Count; ++i)
+        {
+            render_glyph(*layout.m_Positions[i], surface, clip);
+        }
+
+        return Utilities::Success;
+    }
+
+    Platform::int32 Render(
+        const Layout_buffer & layout,
+        const Surface & surface)
+    {
+        if (false == is_surface_valid(surface))
+        {
+            ASSERT(0);
+            return Utilities::Invalid_parameter;
+        }
+
+        const Rectangle clip = { 0, 0, Platform::int32(surface.m_Width), Platform::int32(surface.m_Height) };
+
+        for (Platform::uint32 i = 0; i < layout.m_Count; ++i)
+        {
+            render_glyph(layout.m_Positions[i], surface, clip);
+        }
+
+        return Utilities::Success;
+    }
+
+    /** \brief Renders tiles of surface concurrently
+     *
+     * Surface is split into tiles of s_tile_rows rows. Glyphs are sorted
+     * into buckets of tiles that their clipped images overlap, keeping order
+     * of layout. Each job draws its bucket, so overlapping glyphs are blended
+     * the same way as by serial render and tiles never write the same pixels.
+     **/
+    Platform::int32 Render(
+        const Layout_buffer & layout,
+        const Surface & surface,
+        Task::Pool & pool)
+    {
+        if (false == is_surface_valid(surface))
+        {
+            ASSERT(0);
+            return Utilities::Invalid_parameter;
+        }
+
+        const Platform::uint32 tiles_count = (surface.m_Height + s_tile_rows - 1) / s_tile_rows;
+        const Rectangle clip = { 0, 0, Platform::int32(surface.m_Width), Platform::int32(surface.m_Height) };
+
+        /* Rows of tiles overlapped by each glyph, empty range for hidden glyph */
+        std::vector< Platform::uint32 > first_tiles(layout.m_Count);
+        std::vector< Platform::uint32 > end_tiles(layout.m_Count);
+
+        /* Buckets of tile i are [bucket_offsets[i], bucket_offsets[i + 1]) of bucket_glyphs */
+        std::vector< Platform::uint32 > bucket_offsets(tiles_count + 1, 0);
+
+        for (Platform::uint32 i = 0; i < layout.m_Count; ++i)
+        {
+            Rectangle rectangle;
+
+            if (false == clip_glyph(layout.m_Positions[i], clip, rectangle))
+            {
+                first_tiles[i] = 0;
+                end_tiles[i] = 0;
+                continue;
+            }
+
+            first_tiles[i] = Platform::uint32(rectangle.m_top) / s_tile_rows;
+            end_tiles[i] = (Platform::uint32(rectangle.m_bottom) - 1) / s_tile_rows + 1;
+
+            for (Platform::uint32 tile = first_tiles[i]; tile < end_tiles[i]; ++tile)
+            {
+                bucket_offsets[tile + 1] += 1;
+            }
+        }
+
+        for (Platform::uint32 tile = 0; tile < tiles_count; ++tile)
+        {
+            bucket_offsets[tile + 1] += bucket_offsets[tile];
+        }
+
+        std::vector< Platform::uint32 > bucket_glyphs(bucket_offsets[tiles_count]);
+        std::vector< Platform::uint32 > bucket_ends(bucket_offsets.begin(), bucket_offsets.end() - 1);
+
+        for (Platform::uint32 i = 0; i < layout.m_Count; ++i)
+        {
+            for (Platform::uint32 tile = first_tiles[i]; tile < end_tiles[i]; ++tile)
+            {
+                bucket_glyphs[bucket_ends[tile]++] = i;
+            }
+        }
+
+        pool.ParallelFor(tiles_count, [&](size_t index)
+        {
+            const Rectangle tile = get_tile(surface, Platform::uint32(index));
+
+            for (Platform::uint32 n = bucket_offsets[index]; n < bucket_offsets[index + 1]; ++n)
+            {
+                render_glyph(layout.m_Positions[bucket_glyphs[n]], surface, tile);
+            }
+        });
+
+        return Utilities::Success;
+    }
+}
@@ -0,0 +1,78 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file Render.hpp
+**/
+
+#ifndef TEXT_RENDER_HPP
+#define TEXT_RENDER_HPP
+
+#include "Layout.hpp"
+
+namespace Text
+{
+    enum Surface_format
+    {
+        Surface_A8,
+        Surface_RGBA8,
+    };
+
+    /** \brief Image that glyphs are drawn into
+     *
+     * Rows are stored from top to bottom, pitch is distance between rows in
+     * bytes. Pixel (x, y) of surface covers point (x, -y) of layout, so box
+     * with top at 0 starts in first row. Colour is used by RGBA8 surfaces,
+     * it is packed as R | G << 8 | B << 16 | A << 24. Glyphs are drawn to A8
+     * surface as coverage.
+     **/
+    struct Surface
+    {
+        Platform::uint8 * m_Data;
+        Platform::uint32 m_Width;
+        Platform::uint32 m_Height;
+        Platform::uint32 m_Pitch;
+        Surface_format m_Format;
+        Platform::uint32 m_Color;
+    };
+
+    /* Images of glyphs are blended over surface, clipped to box of each
+     * glyph. Tiles of surface are drawn concurrently, result is the same as
+     * without pool. */
+    Platform::int32 Render(
+        const Layout & layout,
+        const Surface & surface);
+    Platform::int32 Render(
+        const Layout_buffer & layout,
+        const Surface & surface);
+    Platform::int32 Render(
+        const Layout_buffer & layout,
+        const Surface & surface,
+        Task::Pool & pool);
+}
+
+#endif /* TEXT_RENDER_HPP */
@@ -0,0 +1,126 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file RenderKernels.hpp
+**/
+
+#ifndef TEXT_RENDER_KERNELS_HPP
+#define TEXT_RENDER_KERNELS_HPP
+
+/*
+ * Blending of glyph coverage into row of surface. Each instruction set
+ * lives in its own source file compiled with matching flags, set is
+ * selected once during static initialisation, see Render.cpp.
+ *
+ * Colour is packed as R | G << 8 | B << 16 | A << 24, the same as RGBA8
+ * pixel in memory of little endian processor. Coverage scales alpha of colour, result
+ * is source over destination for all four channels:
+ *     a = cov * color_a / 255
+ *     dst = (src * a + dst * (255 - a)) / 255
+ * with alpha channel of source equal to 255. A8 surface is blended as
+ * alpha channel only. Division is rounded to nearest, all sets give the
+ * same results.
+ */
+namespace Text
+{
+    namespace Render_kernels
+    {
+        typedef void (* blend_a8_t)(const Platform::uint8 * coverage, Platform::uint8 * destination, Platform::uint32 count);
+        typedef void (* blend_rgba8_t)(const Platform::uint8 * coverage, Platform::uint8 * destination, Platform::uint32 count, Platform::uint32 color);
+
+        struct Table
+        {
+            const char * m_name;
+            blend_a8_t m_blend_a8;
+            blend_rgba8_t m_blend_rgba8;
+        };
+
+        /* Name of selected set: "SSE2" or "AVX2" */
+        const char * Get_name();
+
+        namespace Sse2
+        {
+            void Blend_a8(const Platform::uint8 * coverage, Platform::uint8 * destination, Platform::uint32 count);
+            void Blend_rgba8(const Platform::uint8 * coverage, Platform::uint8 * destination, Platform::uint32 count, Platform::uint32 color);
+        }
+
+        namespace Avx2
+        {
+            void Blend_a8(const Platform::uint8 * coverage, Platform::uint8 * destination, Platform::uint32 count);
+            void Blend_rgba8(const Platform::uint8 * coverage, Platform::uint8 * destination, Platform::uint32 count, Platform::uint32 color);
+        }
+
+        /* Rounded x / 255, exact for x <= 255 * 255 */
+        static inline Platform::uint32 divide_255(Platform::uint32 x)
+        {
+            x += 128;
+
+            return (x + (x >> 8)) >> 8;
+        }
+
+        /* Reference versions, used for ends of rows */
+        static inline void blend_a8(
+            const Platform::uint8 * coverage,
+            Platform::uint8 * destination,
+            Platform::uint32 count)
+        {
+            for (Platform::uint32 i = 0; i < count; ++i)
+            {
+                const Platform::uint32 a = coverage[i];
+
+                destination[i] = Platform::uint8(divide_255(255 * a + destination[i] * (255 - a)));
+            }
+        }
+
+        static inline void blend_rgba8(
+            const Platform::uint8 * coverage,
+            Platform::uint8 * destination,
+            Platform::uint32 count,
+            Platform::uint32 color)
+        {
+            const Platform::uint32 source_alpha = color >> 24;
+
+            for (Platform::uint32 i = 0; i < count; ++i)
+            {
+                const Platform::uint32 a = divide_255(coverage[i] * source_alpha);
+                Platform::uint8 * pixel = destination + 4 * i;
+
+                for (Platform::uint32 c = 0; c < 3; ++c)
+                {
+                    const Platform::uint32 source = (color >> (8 * c)) & 0xff;
+
+                    pixel[c] = Platform::uint8(divide_255(source * a + pixel[c] * (255 - a)));
+                }
+
+                pixel[3] = Platform::uint8(divide_255(255 * a + pixel[3] * (255 - a)));
+            }
+        }
+    }
+}
+
+#endif /* TEXT_RENDER_KERNELS_HPP */
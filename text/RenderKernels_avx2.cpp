@@ -0,0 +1,132 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file RenderKernels_avx2.cpp
+**/
+
+#include "PCH.hpp"
+
+#include "RenderKernels.hpp"
+
+#include <immintrin.h>
+
+/*
+ * Thirty two A8 pixels or eight RGBA8 pixels per iteration. Unpacking works
+ * within 128 bit lanes, packing restores order of bytes. Operations are the
+ * same as in RenderKernels_sse.cpp, results are the same.
+ */
+
+namespace Text
+{
+    namespace Render_kernels
+    {
+        namespace Avx2
+        {
+            static inline __m256i divide_255(__m256i x)
+            {
+                x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+
+                return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+            }
+
+            /* (src * a + dst * (255 - a)) / 255 */
+            static inline __m256i blend(
+                __m256i source,
+                __m256i destination,
+                __m256i alpha)
+            {
+                const __m256i inverse = _mm256_sub_epi16(_mm256_set1_epi16(255), alpha);
+
+                return divide_255(_mm256_add_epi16(
+                    _mm256_mullo_epi16(source, alpha),
+                    _mm256_mullo_epi16(destination, inverse)));
+            }
+
+            void Blend_a8(
+                const Platform::uint8 * coverage,
+                Platform::uint8 * destination,
+                Platform::uint32 count)
+            {
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i source = _mm256_set1_epi16(255);
+                Platform::uint32 i = 0;
+
+                for (; i + 32 <= count; i += 32)
+                {
+                    const __m256i cov = _mm256_loadu_si256(reinterpret_cast< const __m256i * >(coverage + i));
+                    const __m256i dst = _mm256_loadu_si256(reinterpret_cast< const __m256i * >(destination + i));
+
+                    const __m256i lo = blend(source, _mm256_unpacklo_epi8(dst, zero), _mm256_unpacklo_epi8(cov, zero));
+                    const __m256i hi = blend(source, _mm256_unpackhi_epi8(dst, zero), _mm256_unpackhi_epi8(cov, zero));
+
+                    _mm256_storeu_si256(reinterpret_cast< __m256i * >(destination + i), _mm256_packus_epi16(lo, hi));
+                }
+
+                blend_a8(coverage + i, destination + i, count - i);
+            }
+
+            void Blend_rgba8(
+                const Platform::uint8 * coverage,
+                Platform::uint8 * destination,
+                Platform::uint32 count,
+                Platform::uint32 color)
+            {
+                const __m256i zero = _mm256_setzero_si256();
+
+                /* Colour of two pixels with alpha 255 in each lane */
+                const __m256i source = _mm256_unpacklo_epi8(_mm256_set1_epi32(int(color | 0xff000000u)), zero);
+                const __m128i source_alpha = _mm_set1_epi16(short(color >> 24));
+                Platform::uint32 i = 0;
+
+                for (; i + 8 <= count; i += 8)
+                {
+                    /* a0..a7, then a0..a3 in first lane and a4..a7 in second, each repeated for four channels */
+                    const __m128i cov = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast< const __m128i * >(coverage + i)));
+                    __m128i alpha = _mm_add_epi16(_mm_mullo_epi16(cov, source_alpha), _mm_set1_epi16(128));
+                    alpha = _mm_srli_epi16(_mm_add_epi16(alpha, _mm_srli_epi16(alpha, 8)), 8);
+
+                    __m256i alpha_pairs = _mm256_cvtepu16_epi32(alpha);
+                    alpha_pairs = _mm256_or_si256(alpha_pairs, _mm256_slli_epi32(alpha_pairs, 16));
+
+                    const __m256i alpha_lo = _mm256_unpacklo_epi32(alpha_pairs, alpha_pairs);
+                    const __m256i alpha_hi = _mm256_unpackhi_epi32(alpha_pairs, alpha_pairs);
+
+                    Platform::uint8 * pixels = destination + 4 * i;
+                    const __m256i dst = _mm256_loadu_si256(reinterpret_cast< const __m256i * >(pixels));
+
+                    const __m256i lo = blend(source, _mm256_unpacklo_epi8(dst, zero), alpha_lo);
+                    const __m256i hi = blend(source, _mm256_unpackhi_epi8(dst, zero), alpha_hi);
+
+                    _mm256_storeu_si256(reinterpret_cast< __m256i * >(pixels), _mm256_packus_epi16(lo, hi));
+                }
+
+                blend_rgba8(coverage + i, destination + 4 * i, count - i, color);
+            }
+        }
+    }
+}
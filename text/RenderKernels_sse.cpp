@@ -0,0 +1,130 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file RenderKernels_sse.cpp
+**/
+
+#include "PCH.hpp"
+
+#include "RenderKernels.hpp"
+
+#include <emmintrin.h>
+
+#include <cstring>
+
+/* Sixteen A8 pixels or four RGBA8 pixels per iteration, arithmetic is done on 16 bit lanes */
+
+namespace Text
+{
+    namespace Render_kernels
+    {
+        namespace Sse2
+        {
+            static inline __m128i divide_255(__m128i x)
+            {
+                x = _mm_add_epi16(x, _mm_set1_epi16(128));
+
+                return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+            }
+
+            /* (src * a + dst * (255 - a)) / 255 */
+            static inline __m128i blend(
+                __m128i source,
+                __m128i destination,
+                __m128i alpha)
+            {
+                const __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+
+                return divide_255(_mm_add_epi16(
+                    _mm_mullo_epi16(source, alpha),
+                    _mm_mullo_epi16(destination, inverse)));
+            }
+
+            void Blend_a8(
+                const Platform::uint8 * coverage,
+                Platform::uint8 * destination,
+                Platform::uint32 count)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i source = _mm_set1_epi16(255);
+                Platform::uint32 i = 0;
+
+                for (; i + 16 <= count; i += 16)
+                {
+                    const __m128i cov = _mm_loadu_si128(reinterpret_cast< const __m128i * >(coverage + i));
+                    const __m128i dst = _mm_loadu_si128(reinterpret_cast< const __m128i * >(destination + i));
+
+                    const __m128i lo = blend(source, _mm_unpacklo_epi8(dst, zero), _mm_unpacklo_epi8(cov, zero));
+                    const __m128i hi = blend(source, _mm_unpackhi_epi8(dst, zero), _mm_unpackhi_epi8(cov, zero));
+
+                    _mm_storeu_si128(reinterpret_cast< __m128i * >(destination + i), _mm_packus_epi16(lo, hi));
+                }
+
+                blend_a8(coverage + i, destination + i, count - i);
+            }
+
+            void Blend_rgba8(
+                const Platform::uint8 * coverage,
+                Platform::uint8 * destination,
+                Platform::uint32 count,
+                Platform::uint32 color)
+            {
+                const __m128i zero = _mm_setzero_si128();
+
+                /* Colour of two pixels with alpha 255 */
+                const __m128i source = _mm_unpacklo_epi8(_mm_set1_epi32(int(color | 0xff000000u)), zero);
+                const __m128i source_alpha = _mm_set1_epi16(short(color >> 24));
+                Platform::uint32 i = 0;
+
+                for (; i + 4 <= count; i += 4)
+                {
+                    Platform::int32 cov_bits;
+                    memcpy(&cov_bits, coverage + i, 4);
+
+                    /* a0 a1 a2 a3, then each of them repeated for four channels */
+                    const __m128i cov = _mm_unpacklo_epi8(_mm_cvtsi32_si128(cov_bits), zero);
+                    const __m128i alpha = divide_255(_mm_mullo_epi16(cov, source_alpha));
+                    const __m128i alpha_pairs = _mm_unpacklo_epi16(alpha, alpha);
+
+                    const __m128i alpha_lo = _mm_unpacklo_epi32(alpha_pairs, alpha_pairs);
+                    const __m128i alpha_hi = _mm_unpackhi_epi32(alpha_pairs, alpha_pairs);
+
+                    Platform::uint8 * pixels = destination + 4 * i;
+                    const __m128i dst = _mm_loadu_si128(reinterpret_cast< const __m128i * >(pixels));
+
+                    const __m128i lo = blend(source, _mm_unpacklo_epi8(dst, zero), alpha_lo);
+                    const __m128i hi = blend(source, _mm_unpackhi_epi8(dst, zero), alpha_hi);
+
+                    _mm_storeu_si128(reinterpret_cast< __m128i * >(pixels), _mm_packus_epi16(lo, hi));
+                }
+
+                blend_rgba8(coverage + i, destination + 4 * i, count - i, color);
+            }
+        }
+    }
+}
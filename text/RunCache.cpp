@@ -0,0 +1,232 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file RunCache.cpp
+**/
+
+#include "PCH.hpp"
+#include "RunCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace Text
+{
+    /* FNV-1a, applied to whole characters instead of bytes */
+    static const Platform::uint64 s_fnv_offset = 0xcbf29ce484222325ULL;
+    static const Platform::uint64 s_fnv_prime = 0x100000001b3ULL;
+
+    Run_cache::Run_cache()
+        : m_budget(0)
+        , m_size(0)
+    {
+        /* Nothing to be done */
+    }
+
+    Run_cache::~Run_cache()
+    {
+        Release();
+    }
+
+    Platform::int32 Run_cache::Init(size_t budget)
+    {
+        Release();
+
+        if (0 == budget)
+        {
+            ASSERT(0);
+            return Utilities::Invalid_parameter;
+        }
+
+        m_budget = budget;
+
+        return Utilities::Success;
+    }
+
+    void Run_cache::Release()
+    {
+        Clear();
+
+        m_budget = 0;
+    }
+
+    void Run_cache::Clear()
+    {
+        m_runs.clear();
+        m_map.Clear();
+
+        m_size = 0;
+    }
+
+    bool Run_cache::Find(
+        const Font & font,
+        Platform::int32 width,
+        const Font::character_t * text,
+        Platform::uint32 count,
+        Run_view & out_run)
+    {
+        auto found = m_map.Find(make_key(font, width, text, count));
+        if (nullptr == found)
+        {
+            return false;
+        }
+
+        auto it = *found;
+
+        /* Different run with the same key */
+        if ((&font != it->m_font) ||
+            (width != it->m_width) ||
+            (count != it->m_text.size()) ||
+            (0 != memcmp(text, it->m_text.data(), count * sizeof(Font::character_t))))
+        {
+            return false;
+        }
+
+        m_runs.splice(m_runs.begin(), m_runs, it);
+
+        out_run.m_Positions = it->m_positions.data();
+        out_run.m_Count = count;
+        out_run.m_Lowest_y = it->m_lowest_y;
+
+        return true;
+    }
+
+    Platform::int32 Run_cache::Insert(
+        const Font & font,
+        const Box & box,
+        const Font::character_t * text,
+        Platform::uint32 count,
+        const Glyph_position * positions)
+    {
+        if (0 == m_budget)
+        {
+            ASSERT(0);
+            return Utilities::Invalid_object;
+        }
+
+        if ((nullptr == text) ||
+            (nullptr == positions) ||
+            (0 == count))
+        {
+            return Utilities::Invalid_parameter;
+        }
+
+        const size_t size = sizeof(Run) + count * (sizeof(Font::character_t) + sizeof(Glyph_position));
+        if (m_budget < size)
+        {
+            return Utilities::Success;
+        }
+
+        const Platform::int32 width = box.m_Right - box.m_Left;
+        const Platform::uint64 key = make_key(font, width, text, count);
+
+        /* Replace run with the same key */
+        auto found = m_map.Find(key);
+        if (nullptr != found)
+        {
+            erase(*found);
+        }
+
+        while (m_budget - m_size < size)
+        {
+            erase(std::prev(m_runs.end()));
+        }
+
+        m_runs.emplace_front();
+
+        Run & run = m_runs.front();
+
+        run.m_font = &font;
+        run.m_width = width;
+        run.m_key = key;
+        run.m_text.assign(text, text + count);
+        run.m_positions.resize(count);
+        run.m_lowest_y = positions[0].m_Y - box.m_Top;
+        run.m_size = size;
+
+        for (Platform::uint32 i = 0; i < count; ++i)
+        {
+            Glyph_position & position = run.m_positions[i];
+
+            position.m_Glyph = positions[i].m_Glyph;
+            position.m_Box = nullptr;
+            position.m_X = positions[i].m_X - box.m_Left;
+            position.m_Y = positions[i].m_Y - box.m_Top;
+
+            run.m_lowest_y = std::min(run.m_lowest_y, position.m_Y);
+        }
+
+        m_map.Insert(key, m_runs.begin());
+        m_size += size;
+
+        return Utilities::Success;
+    }
+
+    size_t Run_cache::Get_budget() const
+    {
+        return m_budget;
+    }
+
+    size_t Run_cache::Get_size() const
+    {
+        return m_size;
+    }
+
+    Platform::uint32 Run_cache::Get_runs_count() const
+    {
+        return Platform::uint32(m_runs.size());
+    }
+
+    Platform::uint64 Run_cache::make_key(
+        const Font & font,
+        Platform::int32 width,
+        const Font::character_t * text,
+        Platform::uint32 count)
+    {
+        Platform::uint64 hash = s_fnv_offset;
+
+        for (Platform::uint32 i = 0; i < count; ++i)
+        {
+            hash = (hash ^ text[i]) * s_fnv_prime;
+        }
+
+        hash = (hash ^ Platform::uint32(width)) * s_fnv_prime;
+        hash = (hash ^ Platform::uint64(reinterpret_cast< uintptr_t >(&font))) * s_fnv_prime;
+
+        return hash;
+    }
+
+    void Run_cache::erase(run_list::iterator it)
+    {
+        m_size -= it->m_size;
+
+        m_map.Erase(it->m_key);
+        m_runs.erase(it);
+    }
+}
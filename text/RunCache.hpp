@@ -0,0 +1,131 @@
+/** License
+*
+* Copyright (c) 2015 Adam migielski
+*
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a
+*      copy of this software and associated documentation files (the
+*      "Software"), to deal in the Software without restriction, including
+*      without limitation the rights to use, copy, modify, merge, publish,
+*      distribute, sublicense, and/or sell copies of the Software, and to
+*      permit persons to whom the Software is furnished to do so, subject to
+*      the following conditions: The above copyright notice and this permission
+*      notice shall be included in all copies or substantial portions of the
+*      Software.
+*
+*
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+*      OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+*      MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+*      IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+*      CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+*      TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+*      SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+**/
+
+/**
+* @author Adam migielski
+* @file RunCache.hpp
+**/
+
+#ifndef TEXT_RUN_CACHE_HPP
+#define TEXT_RUN_CACHE_HPP
+
+#include "Layout.hpp"
+
+#include <Utilities\containers\FlatHashMap.hpp>
+
+#include <list>
+#include <vector>
+
+namespace Text
+{
+    /** \brief Keeps laid out runs of repeated strings
+     *
+     * Run is identified by font, text and width of box. It stores positions
+     * relative to top left corner of box, so it is reused for any box of the
+     * same width that is high enough. Least recently used runs are evicted
+     * when size of cache exceeds budget.
+     *
+     * Positions point to glyphs of font, cache has to be cleared when font
+     * is modified or released.
+     **/
+    class Run_cache
+    {
+    public:
+        /* Positions of run, relative to top left corner of box */
+        struct Run_view
+        {
+            const Glyph_position * m_Positions;
+            Platform::uint32 m_Count;
+            Platform::int32 m_Lowest_y;
+        };
+
+        /* Ctr & dtr */
+        Run_cache();
+        ~Run_cache();
+
+        /* No copying */
+        Run_cache(const Run_cache & cache) = delete;
+        Run_cache & operator = (const Run_cache & cache) = delete;
+
+        /* Init & release */
+        Platform::int32 Init(size_t budget);
+        void Release();
+        void Clear();
+
+        /* Finds run and marks it as most recently used */
+        bool Find(
+            const Font & font,
+            Platform::int32 width,
+            const Font::character_t * text,
+            Platform::uint32 count,
+            Run_view & out_run);
+
+        /* Stores positions of text laid out in box, run that is larger than
+         * budget is not stored */
+        Platform::int32 Insert(
+            const Font & font,
+            const Box & box,
+            const Font::character_t * text,
+            Platform::uint32 count,
+            const Glyph_position * positions);
+
+        /* Access */
+        size_t Get_budget() const;
+        size_t Get_size() const;
+        Platform::uint32 Get_runs_count() const;
+
+    private:
+        struct Run
+        {
+            const Font * m_font;
+            Platform::int32 m_width;
+            Platform::uint64 m_key;
+            std::vector< Font::character_t > m_text;
+            std::vector< Glyph_position > m_positions;
+            Platform::int32 m_lowest_y;
+            size_t m_size;
+        };
+
+        using run_list = std::list< Run >;
+        using run_map = Containers::Flat_hash_map< Platform::uint64, run_list::iterator >;
+
+        static Platform::uint64 make_key(
+            const Font & font,
+            Platform::int32 width,
+            const Font::character_t * text,
+            Platform::uint32 count);
+
+        void erase(run_list::iterator it);
+
+        /* Most recently used run is first */
+        run_list m_runs;
+        run_map m_map;
+        size_t m_budget;
+        size_t m_size;
+    };
+}
+
+#endif /* TEXT_RUN_CACHE_HPP */
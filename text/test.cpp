@@ -33,11 +33,20 @@
 
 #include <Unit_Tests\UnitTests.hpp>
 #include <Utilities\memory\Binary_data.hpp>
+#include <Utilities\math\Cpu.hpp>
 #include <Utilities\memory\MemoryAccess.hpp>
+#include <Utilities\task\Pool.hpp>
 
 #include "Glyph.hpp"
+#include "Atlas.hpp"
 #include "Font.hpp"
 #include "Layout.hpp"
+#include "Render.hpp"
+#include "RenderKernels.hpp"
+#include "RunCache.hpp"
+
+#include <algorithm>
+#include <vector>
 
 UNIT_TEST(Text_glyph_initial_state)
 {
@@ -420,3 +429,1117 @@ UNIT_TEST(Text_font_init)
 
     return Passed;
 }
+
+/* Font with glyphs 'a' and CJK 0x4e2d, images are filled with index of glyph plus one */
+static Memory::Binary_data create_font_data(bool is_endianess_swapped)
+{
+    const Text::Font::character_t characters[] = { 'a', 0x4e2d };
+    const Text::Glyph::Descriptor descriptors[] = {
+        { 3, 5, 0, 5, 3, 0, 4, -6 },
+        { 8, 7, 1, 6, 9, -1, 10, -8 },
+    };
+    const Platform::uint32 nog = 2;
+
+    const size_t off_chars = sizeof(Platform::uint32);
+    const size_t off_descs = off_chars + nog * sizeof(Text::Font::character_t);
+    const size_t off_img_offs = off_descs + nog * sizeof(Text::Glyph::Descriptor);
+    const size_t off_imgs = off_img_offs + nog * sizeof(Platform::uint64);
+    const size_t total_size = off_imgs + 3 * 5 + 8 * 7;
+
+    auto ptr = new Platform::uint8[total_size];
+    size_t off_img = off_imgs;
+
+    auto write = [&](size_t offset, auto value)
+    {
+        if (true == is_endianess_swapped)
+        {
+            Memory::Access::Swap_endianess(value);
+        }
+
+        memcpy(ptr + offset, &value, sizeof(value));
+    };
+
+    write(0, nog);
+
+    for (Platform::uint32 i = 0; i < nog; ++i)
+    {
+        const auto & desc = descriptors[i];
+        const size_t off_desc = off_descs + i * sizeof(Text::Glyph::Descriptor);
+
+        write(off_chars + i * sizeof(Text::Font::character_t), characters[i]);
+        write(off_desc + 0, desc.m_width);
+        write(off_desc + 4, desc.m_height);
+        write(off_desc + 8, desc.m_left);
+        write(off_desc + 12, desc.m_top);
+        write(off_desc + 16, desc.m_right);
+        write(off_desc + 20, desc.m_bottom);
+        write(off_desc + 24, desc.m_horizontal_advance);
+        write(off_desc + 28, desc.m_vertical_advance);
+        write(off_img_offs + i * sizeof(Platform::uint64), Platform::uint64(off_img));
+
+        memset(ptr + off_img, int(i + 1), desc.m_width * desc.m_height);
+        off_img += desc.m_width * desc.m_height;
+    }
+
+    return Memory::Binary_data(ptr, total_size);
+}
+
+static Test_result test_font_glyphs(const Text::Font & font)
+{
+    const Text::Font::character_t characters[] = { 'a', 0x4e2d };
+
+    for (Platform::uint32 i = 0; i < 2; ++i)
+    {
+        auto glyph = font.Get_glyph_raw(characters[i]);
+        TEST_ASSERT_NOT_EQUAL((Text::Glyph *) 0, glyph);
+
+        auto& desc = glyph->Get_descriptor();
+        auto& data = glyph->Get_data();
+        TEST_ASSERT(Platform::uint64(desc.m_width * desc.m_height), data.Size());
+
+        for (Platform::uint64 n = 0; n < data.Size(); ++n)
+        {
+            TEST_ASSERT(Platform::uint8(i + 1), data.Data()[n]);
+        }
+    }
+
+    TEST_ASSERT(10, font.Get_glyph_raw(0x4e2d)->Get_descriptor().m_horizontal_advance);
+    TEST_ASSERT(-8, font.Get_glyph_raw(0x4e2d)->Get_descriptor().m_vertical_advance);
+    TEST_ASSERT(8, font.Get_max()->m_width);
+    TEST_ASSERT(-8, font.Get_max()->m_vertical_advance);
+
+    return Passed;
+}
+
+UNIT_TEST(Text_font_init_modes)
+{
+    for (Platform::uint32 i = 0; i < 2; ++i)
+    {
+        const bool is_endianess_swapped = (1 == i);
+
+        /* Copy, data stays with caller */
+        {
+            Text::Font font;
+            Memory::Binary_data data = create_font_data(is_endianess_swapped);
+
+            TEST_ASSERT(Utilities::Success, font.Init(std::move(data), is_endianess_swapped, Text::Font::Copy_images));
+            TEST_ASSERT(false, data.Is_null());
+            TEST_ASSERT(false, font.Get_glyph_raw('a')->Get_data().Is_view());
+            TEST_ASSERT(Passed, test_font_glyphs(font));
+        }
+
+        /* Reference, images point into data kept by font */
+        {
+            Text::Font font;
+            Memory::Binary_data data = create_font_data(is_endianess_swapped);
+            const Platform::uint8 * begin = data.Data();
+            const Platform::uint8 * end = begin + data.Size();
+
+            TEST_ASSERT(Utilities::Success, font.Init(std::move(data), is_endianess_swapped, Text::Font::Reference_images));
+            TEST_ASSERT(true, data.Is_null());
+            TEST_ASSERT(Passed, test_font_glyphs(font));
+
+            auto& image = font.Get_glyph_raw(0x4e2d)->Get_data();
+            TEST_ASSERT(true, image.Is_view());
+            TEST_ASSERT(true, (begin <= image.Data()) && (end >= image.Data() + image.Size()));
+
+            /* Moved font keeps images */
+            Text::Font font_b;
+            font_b = std::move(font);
+            TEST_ASSERT(Passed, test_font_glyphs(font_b));
+
+            /* Copy of glyph owns its image */
+            Text::Glyph copy(*font_b.Get_glyph_raw('a'));
+            TEST_ASSERT(false, copy.Get_data().Is_view());
+            TEST_ASSERT(Platform::uint8(1), copy.Get_data()[0]);
+        }
+    }
+
+    /* Memory owned by caller, for example mapped file */
+    {
+        Memory::Binary_data owner = create_font_data(false);
+        Memory::Binary_data view;
+        Text::Font font;
+
+        view.Reset_view(owner.Data(), owner.Size());
+        TEST_ASSERT(Utilities::Success, font.Init(std::move(view), false, Text::Font::Reference_images));
+        TEST_ASSERT(Passed, test_font_glyphs(font));
+
+        font.Release();
+        TEST_ASSERT(Platform::uint8(2), owner[owner.Size() - 1]);
+    }
+
+    /* Truncated tables and images */
+    {
+        Memory::Binary_data data = create_font_data(false);
+        Memory::Binary_data truncated;
+        Text::Font font;
+
+        truncated.Copy_range(data, 0, 20);
+        TEST_ASSERT(true, Utilities::Success != font.Init(std::move(truncated), false, Text::Font::Reference_images));
+
+        truncated.Copy_range(data, 0, data.Size() - 1);
+        TEST_ASSERT(true, Utilities::Success != font.Init(std::move(truncated), false, Text::Font::Copy_images));
+        TEST_ASSERT(true, Utilities::Success != font.Init(std::move(truncated), false, Text::Font::Reference_images));
+    }
+
+    return Passed;
+}
+
+static Test_result test_atlas_glyph(
+    const Text::Atlas & atlas,
+    const Text::Glyph & glyph,
+    Platform::uint8 value)
+{
+    TEST_ASSERT(true, atlas.Contains(glyph));
+    TEST_ASSERT(atlas.Get_id(), glyph.Get_atlas_entry().m_atlas);
+
+    auto& entry = glyph.Get_atlas_entry();
+    auto& desc = glyph.Get_descriptor();
+    const Platform::uint32 width = atlas.Get_page_width();
+    const Platform::uint32 height = atlas.Get_page_height();
+    const Platform::uint8 * page = atlas.Get_page(entry.m_page);
+
+    TEST_ASSERT_NOT_EQUAL((const Platform::uint8 *) 0, page);
+    TEST_ASSERT(float(entry.m_x) / float(width), entry.m_u0);
+    TEST_ASSERT(float(entry.m_y) / float(height), entry.m_v0);
+    TEST_ASSERT(float(entry.m_x + desc.m_width) / float(width), entry.m_u1);
+    TEST_ASSERT(float(entry.m_y + desc.m_height) / float(height), entry.m_v1);
+
+    for (Platform::uint32 y = 0; y < desc.m_height; ++y)
+    {
+        for (Platform::uint32 x = 0; x < desc.m_width; ++x)
+        {
+            TEST_ASSERT(value, page[(entry.m_y + y) * width + entry.m_x + x]);
+        }
+    }
+
+    return Passed;
+}
+
+UNIT_TEST(Text_atlas)
+{
+    Text::Font font;
+    TEST_ASSERT(Utilities::Success, font.Init(create_font_data(false), false));
+
+    auto& a = *font.Get_glyph_raw('a');
+    auto& b = *font.Get_glyph_raw(0x4e2d);
+
+    /* Both glyphs on single page, taller first */
+    {
+        Text::Atlas atlas;
+        TEST_ASSERT(Utilities::Success, atlas.Init(16, 16, 1));
+        TEST_ASSERT(Utilities::Success, atlas.Insert(font));
+        TEST_ASSERT(1, atlas.Get_pages_count());
+
+        TEST_ASSERT(Passed, test_atlas_glyph(atlas, a, 1));
+        TEST_ASSERT(Passed, test_atlas_glyph(atlas, b, 2));
+        TEST_ASSERT(0, b.Get_atlas_entry().m_x);
+        TEST_ASSERT(0, b.Get_atlas_entry().m_y);
+        TEST_ASSERT(9, a.Get_atlas_entry().m_x);
+        TEST_ASSERT(0, a.Get_atlas_entry().m_y);
+
+        /* Padding is left empty */
+        const Platform::uint8 * page = atlas.Get_page(0);
+        for (Platform::uint32 y = 0; y < 16; ++y)
+        {
+            TEST_ASSERT(0, page[y * 16 + 8]);
+        }
+    }
+
+    /* Incremental insertion, placed glyphs do not move */
+    {
+        Text::Atlas atlas;
+        const Text::Font::character_t characters[] = { 'a', 'a' };
+
+        TEST_ASSERT(Utilities::Success, atlas.Init(16, 16, 1));
+        TEST_ASSERT(false, atlas.Contains(a));
+        TEST_ASSERT(Utilities::Success, atlas.Insert(font, characters, 2));
+        TEST_ASSERT(true, atlas.Contains(a));
+        TEST_ASSERT(false, atlas.Contains(b));
+        TEST_ASSERT(0, a.Get_atlas_entry().m_x);
+        TEST_ASSERT(1, atlas.Get_page_revision(0));
+
+        TEST_ASSERT(Utilities::Success, atlas.Insert(font));
+        TEST_ASSERT(2, atlas.Get_page_revision(0));
+        TEST_ASSERT(0, a.Get_atlas_entry().m_x);
+        TEST_ASSERT(4, b.Get_atlas_entry().m_x);
+        TEST_ASSERT(Passed, test_atlas_glyph(atlas, a, 1));
+        TEST_ASSERT(Passed, test_atlas_glyph(atlas, b, 2));
+
+        /* Nothing new */
+        TEST_ASSERT(Utilities::Success, atlas.Insert(font));
+        TEST_ASSERT(2, atlas.Get_page_revision(0));
+
+        /* Entries of released atlas are not valid */
+        atlas.Release();
+        TEST_ASSERT(false, atlas.Contains(a));
+    }
+
+    /* Second page when first is full */
+    {
+        Text::Atlas atlas;
+
+        TEST_ASSERT(Utilities::Success, atlas.Init(8, 8, 0));
+        TEST_ASSERT(Utilities::Success, atlas.Insert(font));
+        TEST_ASSERT(2, atlas.Get_pages_count());
+        TEST_ASSERT(0, b.Get_atlas_entry().m_page);
+        TEST_ASSERT(1, a.Get_atlas_entry().m_page);
+        TEST_ASSERT(Passed, test_atlas_glyph(atlas, a, 1));
+        TEST_ASSERT(Passed, test_atlas_glyph(atlas, b, 2));
+    }
+
+    /* Glyph larger than page */
+    {
+        Text::Atlas atlas;
+
+        TEST_ASSERT(Utilities::Success, atlas.Init(4, 8, 1));
+        TEST_ASSERT(Utilities::Invalid_parameter, atlas.Insert(font));
+        TEST_ASSERT(false, atlas.Contains(b));
+    }
+
+    return Passed;
+}
+
+UNIT_TEST(Text_font_code_space)
+{
+    /* Characters at borders of blocks and planes */
+    const Text::Font::character_t characters[] = { 0x80, 0xff, 0x100, 0x4e2d, 0xffff, 0x1f600, 0x10ffff };
+    const Text::Font::character_t missing[] = { 0x81, 0x1ff, 0x4e2e, 0x10000, 0x1f601, 0x10fffe };
+    const Platform::uint32 count = 7;
+    const Text::Glyph::Descriptor desc = { 2, 2, 0, 2, 2, 0, 3, -3 };
+
+    Text::Font font;
+    TEST_ASSERT(Utilities::Success, font.Init());
+
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        auto ptr = new Platform::uint8[4];
+        memset(ptr, int(i + 1), 4);
+
+        TEST_ASSERT(Utilities::Success, font.Add_glyph(characters[i], desc, Memory::Binary_data(ptr, 4)));
+    }
+
+    /* Outside of Unicode */
+    TEST_ASSERT(Utilities::Invalid_parameter, font.Add_glyph(0x110000, desc, Memory::Binary_data()));
+    TEST_ASSERT((const Text::Glyph *) 0, font.Get_glyph_raw(0x110000));
+    TEST_ASSERT((const Text::Glyph *) 0, font.Get_glyph_raw(0xffffffff));
+
+    /* Replacing glyph keeps its address */
+    const Text::Glyph * glyph_4e2d = font.Get_glyph_raw(0x4e2d);
+    {
+        auto ptr = new Platform::uint8[4];
+        memset(ptr, 4, 4);
+
+        TEST_ASSERT(Utilities::Success, font.Add_glyph(0x4e2d, desc, Memory::Binary_data(ptr, 4)));
+        TEST_ASSERT(glyph_4e2d, font.Get_glyph_raw(0x4e2d));
+    }
+
+    for (Platform::uint32 i = 0; i < 6; ++i)
+    {
+        TEST_ASSERT((const Text::Glyph *) 0, font.Get_glyph_raw(missing[i]));
+    }
+
+    /* Order of characters is kept by Store */
+    Memory::Binary_data data;
+    TEST_ASSERT(Utilities::Success, font.Store(data));
+
+    Text::Font font_b;
+    TEST_ASSERT(Utilities::Success, font_b.Init(std::move(data), false));
+
+    Text::Font::character_t listed[count];
+    TEST_ASSERT(count, font_b.Get_characters(listed, count));
+
+    for (Platform::uint32 i = 0; i < count; ++i)
+    {
+        TEST_ASSERT(characters[i], listed[i]);
+
+        auto glyph = font_b.Get_glyph_raw(characters[i]);
+        TEST_ASSERT_NOT_EQUAL((const Text::Glyph *) 0, glyph);
+        TEST_ASSERT(Platform::uint8(i + 1), glyph->Get_data()[3]);
+    }
+
+    return Passed;
+}
+
+UNIT_TEST(Text_font_get_glyphs)
+{
+    Text::Font font;
+    TEST_ASSERT(Utilities::Success, font.Init(create_font_data(false), false));
+
+    /* ASCII runs, missing characters and characters outside Unicode */
+    const Text::Font::character_t text[] = {
+        'a', 'b', 'a', 'a',
+        'a', 0x4e2d, 'a', 0,
+        0x4e2e, 0x110000, 0x7f, 0x80,
+        'a', 'a', 'a', 'a',
+        'a', 'a', 'a', 'a',
+        0x4e2d, 0x4e2d, 'a',
+    };
+    const Platform::uint32 count = sizeof(text) / sizeof(text[0]);
+
+    for (Platform::uint32 length = 0; length <= count; ++length)
+    {
+        const Text::Glyph * glyphs[count] = { 0 };
+
+        TEST_ASSERT(Utilities::Success, font.Get_glyphs(text, length, glyphs));
+
+        for (Platform::uint32 i = 0; i < count; ++i)
+        {
+            const Text::Glyph * expected = (i < length) ? font.Get_glyph(text[i]) : nullptr;
+
+            TEST_ASSERT(expected, glyphs[i]);
+        }
+    }
+
+    TEST_ASSERT(font.Get_glyph_raw('a'), font.Get_glyph('a'));
+    TEST_ASSERT(font.Get_glyph(0), font.Get_glyph('b'));
+    TEST_ASSERT(font.Get_glyph(0), font.Get_glyph(0x110000));
+
+    return Passed;
+}
+
+UNIT_TEST(Text_layout_buffer)
+{
+    Text::Font font;
+    TEST_ASSERT(Utilities::Success, font.Init(create_font_data(false), false));
+
+    static const Text::Box boxes[] = {
+        { 0, 0, 20, -16 },
+        { 0, 0, 40, -16 },
+    };
+    const Text::Font::character_t text[] = { 'a', 0x4e2d, 'a', 'a', 0x4e2d, 'a', 0x4e2d, 0x4e2d, 'a', 'a' };
+    const Platform::uint32 count = sizeof(text) / sizeof(text[0]);
+
+    Text::Layout layout = { 0 };
+    TEST_ASSERT(Utilities::Success, Text::Init_layout(font, boxes, 2, text, count, layout));
+    TEST_ASSERT(count, layout.m_Count);
+
+    /* Same positions as list based layout, array is reused */
+    Text::Layout_buffer buffer = { 0 };
+    const Text::Glyph_position * storage = nullptr;
+
+    for (Platform::uint32 frame = 0; frame < 3; ++frame)
+    {
+        const Platform::uint32 length = count - frame;
+
+        TEST_ASSERT(Utilities::Success, Text::Init_layout(font, boxes, 2, text, length, buffer));
+        TEST_ASSERT(length, buffer.m_Count);
+        TEST_ASSERT(count, buffer.m_Capacity);
+
+        if (0 == frame)
+        {
+            storage = buffer.m_Positions;
+        }
+        TEST_ASSERT(storage, buffer.m_Positions);
+
+        for (Platform::uint32 i = 0; i < length; ++i)
+        {
+            TEST_ASSERT(layout.m_Positions[i]->m_Glyph, buffer.m_Positions[i].m_Glyph);
+            TEST_ASSERT(layout.m_Positions[i]->m_Box, buffer.m_Positions[i].m_Box);
+            TEST_ASSERT(layout.m_Positions[i]->m_X, buffer.m_Positions[i].m_X);
+            TEST_ASSERT(layout.m_Positions[i]->m_Y, buffer.m_Positions[i].m_Y);
+        }
+    }
+
+    /* Storage of caller is not reallocated */
+    Text::Glyph_position positions[4];
+
+    Text::Set_layout_storage(buffer, positions, 4);
+    TEST_ASSERT(Text::Not_enough_space, Text::Init_layout(font, boxes, 2, text, count, buffer));
+    TEST_ASSERT(4, buffer.m_Count);
+    TEST_ASSERT(positions, buffer.m_Positions);
+    TEST_ASSERT(layout.m_Positions[3]->m_X, positions[3].m_X);
+
+    Text::Release_layout(buffer);
+    TEST_ASSERT((Text::Glyph_position *) 0, buffer.m_Positions);
+    TEST_ASSERT(false, buffer.m_Is_external);
+
+    Text::Release_layout(layout);
+
+    return Passed;
+}
+
+UNIT_TEST(Text_layout_update)
+{
+    Text::Font font;
+    TEST_ASSERT(Utilities::Success, font.Init(create_font_data(false), false));
+
+    static const Text::Box boxes[] = {
+        { 0, 0, 30, -24 },
+        { 40, 0, 100, -40 },
+        { 0, -50, 60, -70 },
+    };
+    const Text::Font::character_t alphabet[] = { 'a', 0x4e2d, 'b' };
+
+    std::vector< Text::Font::character_t > text(60);
+    Platform::uint32 seed = 7;
+    auto random = [&](Platform::uint32 range) -> Platform::uint32
+    {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 8) % range;
+    };
+
+    for (auto & character : text)
+    {
+        character = alphabet[random(3)];
+    }
+
+    Text::Layout_buffer layout = { 0 };
+    Text::Init_layout(font, boxes, 3, text.data(), Platform::uint32(text.size()), layout);
+
+    for (Platform::uint32 i = 0; i < 200; ++i)
+    {
+        /* Replace random range with random characters */
+        Text::Text_edit edit;
+        edit.m_Begin = random(Platform::uint32(text.size()) + 1);
+        edit.m_Old_end = edit.m_Begin + random(std::min(4u, Platform::uint32(text.size()) - edit.m_Begin + 1));
+
+        const Platform::uint32 inserted = random(4);
+        std::vector< Text::Font::character_t > characters(inserted);
+        for (auto & character : characters)
+        {
+            character = alphabet[random(3)];
+        }
+
+        text.erase(text.begin() + edit.m_Begin, text.begin() + edit.m_Old_end);
+        text.insert(text.begin() + edit.m_Begin, characters.begin(), characters.end());
+        edit.m_New_end = edit.m_Begin + inserted;
+
+        if (true == text.empty())
+        {
+            text.push_back('a');
+            Text::Init_layout(font, boxes, 3, text.data(), 1, layout);
+            continue;
+        }
+
+        const Platform::uint32 count = Platform::uint32(text.size());
+        Text::Layout_buffer expected = { 0 };
+        const auto expected_ret = Text::Init_layout(font, boxes, 3, text.data(), count, expected);
+
+        TEST_ASSERT(expected_ret, Text::Update_layout(font, boxes, 3, text.data(), count, edit, layout));
+        TEST_ASSERT(expected.m_Count, layout.m_Count);
+
+        for (Platform::uint32 n = 0; n < expected.m_Count; ++n)
+        {
+            TEST_ASSERT(expected.m_Positions[n].m_Glyph, layout.m_Positions[n].m_Glyph);
+            TEST_ASSERT(expected.m_Positions[n].m_Box, layout.m_Positions[n].m_Box);
+            TEST_ASSERT(expected.m_Positions[n].m_X, layout.m_Positions[n].m_X);
+            TEST_ASSERT(expected.m_Positions[n].m_Y, layout.m_Positions[n].m_Y);
+        }
+
+        Text::Release_layout(expected);
+    }
+
+    Text::Release_layout(layout);
+
+    return Passed;
+}
+
+static Test_result test_layout_parallel(
+    const Text::Font & font,
+    Task::Pool & pool,
+    const std::vector< Text::Box > & boxes,
+    const std::vector< Text::Font::character_t > & text)
+{
+    const Platform::uint32 boxes_count = Platform::uint32(boxes.size());
+    const Platform::uint32 count = Platform::uint32(text.size());
+
+    Text::Layout_buffer expected = { 0 };
+    Text::Layout_buffer layout = { 0 };
+
+    const auto expected_ret = Text::Init_layout(font, boxes.data(), boxes_count, text.data(), count, expected);
+
+    TEST_ASSERT(expected_ret, Text::Init_layout(font, boxes.data(), boxes_count, text.data(), count, pool, layout));
+    TEST_ASSERT(expected.m_Count, layout.m_Count);
+
+    for (Platform::uint32 i = 0; i < expected.m_Count; ++i)
+    {
+        TEST_ASSERT(expected.m_Positions[i].m_Glyph, layout.m_Positions[i].m_Glyph);
+        TEST_ASSERT(expected.m_Positions[i].m_Box, layout.m_Positions[i].m_Box);
+        TEST_ASSERT(expected.m_Positions[i].m_X, layout.m_Positions[i].m_X);
+        TEST_ASSERT(expected.m_Positions[i].m_Y, layout.m_Positions[i].m_Y);
+    }
+
+    Text::Release_layout(expected);
+    Text::Release_layout(layout);
+
+    return Passed;
+}
+
+UNIT_TEST(Text_layout_parallel)
+{
+    Text::Font font;
+    TEST_ASSERT(Utilities::Success, font.Init(create_font_data(false), false));
+
+    Task::Pool pool;
+    pool.Init(3);
+
+    /* Paragraphs of random length, some of them empty */
+    const Text::Font::character_t alphabet[] = { 'a', 'a', 'a', 0x4e2d, 'b', Text::Line_feed };
+    std::vector< Text::Font::character_t > text(20000);
+    Platform::uint32 seed = 11;
+
+    for (auto & character : text)
+    {
+        seed = seed * 1103515245 + 12345;
+        character = alphabet[(seed >> 8) % 6];
+    }
+
+    std::vector< Text::Box > boxes;
+
+    /* All text fits */
+    for (Platform::int32 i = 0; i < 2000; ++i)
+    {
+        boxes.push_back(Text::Box{ 100 * (i % 3), -50 * i, 100 * (i % 3) + 60, -50 * i - 20 - (i % 4) * 10 });
+    }
+    TEST_ASSERT(Passed, test_layout_parallel(font, pool, boxes, text));
+
+    /* Out of boxes */
+    boxes.resize(300);
+    TEST_ASSERT(Passed, test_layout_parallel(font, pool, boxes, text));
+
+    /* Boxes too narrow for CJK glyph */
+    for (auto & box : boxes)
+    {
+        box.m_Right = box.m_Left + 8;
+    }
+    TEST_ASSERT(Passed, test_layout_parallel(font, pool, boxes, text));
+
+    /* Different widths, serial path */
+    boxes[1].m_Right += 20;
+    TEST_ASSERT(Passed, test_layout_parallel(font, pool, boxes, text));
+
+    /* Without workers */
+    pool.Release();
+    boxes[1].m_Right -= 20;
+    TEST_ASSERT(Passed, test_layout_parallel(font, pool, boxes, text));
+
+    return Passed;
+}
+
+UNIT_TEST(Text_layout_options)
+{
+    Text::Font font;
+    TEST_ASSERT(Utilities::Success, font.Init(create_font_data(false), false));
+
+    const Text::Font::character_t alphabet[] = { 'a', 'a', 0x4e2d, 'b', Text::Line_feed };
+    std::vector< Text::Font::character_t > text(500);
+    Platform::uint32 seed = 7;
+
+    for (auto & character : text)
+    {
+        seed = seed * 1103515245 + 12345;
+        character = alphabet[(seed >> 8) % 5];
+    }
+
+    std::vector< Text::Box > boxes;
+    for (Platform::int32 i = 0; i < 40; ++i)
+    {
+        boxes.push_back(Text::Box{ 0, -50 * i, 20 + (i % 3) * 20, -50 * i - 20 - (i % 4) * 10 });
+    }
+
+    /* Wrapping characters without kerning matches Init_layout */
+    const Text::Layout_options options = { Text::Wrap_character, false };
+    const Platform::uint32 count = Platform::uint32(text.size());
+
+    /* All text fits, then out of boxes */
+    for (Platform::uint32 boxes_count = 40; boxes_count > 1; boxes_count /= 3)
+    {
+        Text::Layout_buffer expected = { 0 };
+        Text::Layout_buffer layout = { 0 };
+
+        const auto expected_ret = Text::Init_layout(font, boxes.data(), boxes_count, text.data(), count, expected);
+
+        TEST_ASSERT(expected_ret, Text::Init_layout(font, boxes.data(), boxes_count, text.data(), count, options, layout));
+        TEST_ASSERT(expected.m_Count, layout.m_Count);
+
+        for (Platform::uint32 i = 0; i < expected.m_Count; ++i)
+        {
+            TEST_ASSERT(expected.m_Positions[i].m_Glyph, layout.m_Positions[i].m_Glyph);
+            TEST_ASSERT(expected.m_Positions[i].m_Box, layout.m_Positions[i].m_Box);
+            TEST_ASSERT(expected.m_Positions[i].m_X, layout.m_Positions[i].m_X);
+            TEST_ASSERT(expected.m_Positions[i].m_Y, layout.m_Positions[i].m_Y);
+        }
+
+        Text::Release_layout(expected);
+        Text::Release_layout(layout);
+    }
+
+    /* Boxes too narrow for CJK glyph, in every wrap mode */
+    for (auto & box : boxes)
+    {
+        box.m_Right = box.m_Left + 8;
+    }
+
+    const Text::Wrap_mode modes[] = { Text::Wrap_character, Text::Wrap_word, Text::Wrap_optimal };
+
+    for (auto mode : modes)
+    {
+        const Text::Layout_options narrow_options = { mode, false };
+
+        Text::Layout_buffer expected = { 0 };
+        Text::Layout_buffer layout = { 0 };
+
+        const auto expected_ret = Text::Init_layout(font, boxes.data(), 40, text.data(), count, expected);
+
+        TEST_ASSERT(expected_ret, Text::Init_layout(font, boxes.data(), 40, text.data(), count, narrow_options, layout));
+        TEST_ASSERT(expected.m_Count, layout.m_Count);
+
+        if (Text::Wrap_character == mode)
+        {
+            for (Platform::uint32 i = 0; i < expected.m_Count; ++i)
+            {
+                TEST_ASSERT(expected.m_Positions[i].m_Box, layout.m_Positions[i].m_Box);
+                TEST_ASSERT(expected.m_Positions[i].m_X, layout.m_Positions[i].m_X);
+                TEST_ASSERT(expected.m_Positions[i].m_Y, layout.m_Positions[i].m_Y);
+            }
+        }
+
+        /* First character does not fit */
+        const Text::Font::character_t wide[] = { 0x4e2d, 'a' };
+        TEST_ASSERT(Text::Not_enough_space, Text::Init_layout(font, boxes.data(), 1, wide, 2, narrow_options, layout));
+        TEST_ASSERT(0, layout.m_Count);
+
+        Text::Release_layout(expected);
+        Text::Release_layout(layout);
+    }
+
+    return Passed;
+}
+
+static Memory::Binary_data create_wrap_font_data()
+{
+    const Text::Glyph::Descriptor desc_a = { 3, 5, 0, 5, 3, 0, 4, -6 };
+    const Text::Glyph::Descriptor desc_space = { 1, 1, 0, 1, 1, 0, 4, -6 };
+
+    Text::Font font;
+    font.Init();
+
+    auto ptr = new Platform::uint8[15];
+    memset(ptr, 0xff, 15);
+    font.Add_glyph('a', desc_a, Memory::Binary_data(ptr, 15));
+
+    ptr = new Platform::uint8[1];
+    ptr[0] = 0;
+    font.Add_glyph(' ', desc_space, Memory::Binary_data(ptr, 1));
+
+    font.Add_kerning('a', 'a', -1);
+
+    Memory::Binary_data data;
+    font.Store(data);
+
+    return data;
+}
+
+/* Returns indices of characters that start lines */
+static std::vector< Platform::uint32 > get_line_starts(
+    const Text::Layout_buffer & layout)
+{
+    std::vector< Platform::uint32 > result;
+
+    for (Platform::uint32 i = 0; i < layout.m_Count; ++i)
+    {
+        if ((0 == i) || (layout.m_Positions[i - 1].m_Y != layout.m_Positions[i].m_Y))
+        {
+            result.push_back(i);
+        }
+    }
+
+    return result;
+}
+
+UNIT_TEST(Text_layout_wrap)
+{
+    Text::Font font;
+    TEST_ASSERT(Utilities::Success, font.Init(create_wrap_font_data(), false));
+    TEST_ASSERT(true, font.Has_kerning());
+    TEST_ASSERT(-1, font.Get_kerning('a', 'a'));
+    TEST_ASSERT(0, font.Get_kerning('a', ' '));
+
+    static const Text::Box boxes[] = {
+        { 0, 0, 27, -100 },
+    };
+
+    /* "a a a aa aaaaa" */
+    const Text::Font::character_t text[] = { 'a', ' ', 'a', ' ', 'a', ' ', 'a', 'a', ' ', 'a', 'a', 'a', 'a', 'a' };
+    const Platform::uint32 count = sizeof(text) / sizeof(text[0]);
+
+    Text::Layout_buffer layout = { 0 };
+    Text::Layout_options options = { Text::Wrap_character, false };
+
+    /* Words are broken */
+    TEST_ASSERT(Utilities::Success, Text::Init_layout(font, boxes, 1, text, count, options, layout));
+    TEST_ASSERT((std::vector< Platform::uint32 >{ 0, 7 }), get_line_starts(layout));
+
+    /* Greedy */
+    options.m_Wrap_mode = Text::Wrap_word;
+    TEST_ASSERT(Utilities::Success, Text::Init_layout(font, boxes, 1, text, count, options, layout));
+    TEST_ASSERT((std::vector< Platform::uint32 >{ 0, 6, 9 }), get_line_starts(layout));
+    TEST_ASSERT(0, layout.m_Positions[6].m_X);
+
+    /* Lines are balanced */
+    options.m_Wrap_mode = Text::Wrap_optimal;
+    TEST_ASSERT(Utilities::Success, Text::Init_layout(font, boxes, 1, text, count, options, layout));
+    TEST_ASSERT((std::vector< Platform::uint32 >{ 0, 4, 9 }), get_line_starts(layout));
+
+    /* Kerning moves glyphs closer, the last word fits into line with previous one */
+    options.m_Use_kerning = true;
+    options.m_Wrap_mode = Text::Wrap_word;
+    TEST_ASSERT(Utilities::Success, Text::Init_layout(font, boxes, 1, text, count, options, layout));
+    TEST_ASSERT((std::vector< Platform::uint32 >{ 0, 6 }), get_line_starts(layout));
+    TEST_ASSERT(3, layout.m_Positions[7].m_X);
+    TEST_ASSERT(11, layout.m_Positions[9].m_X);
+    TEST_ASSERT(23, layout.m_Positions[13].m_X);
+
+    /* Word longer than line is broken */
+    const Text::Font::character_t word[] = { 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', ' ', 'a', Text::Line_feed, 'a' };
+    const Platform::uint32 word_count = sizeof(word) / sizeof(word[0]);
+
+    options.m_Use_kerning = false;
+    TEST_ASSERT(Utilities::Success, Text::Init_layout(font, boxes, 1, word, word_count, options, layout));
+    TEST_ASSERT((std::vector< Platform::uint32 >{ 0, 7, 11 }), get_line_starts(layout));
+
+    options.m_Wrap_mode = Text::Wrap_optimal;
+    TEST_ASSERT(Utilities::Success, Text::Init_layout(font, boxes, 1, word, word_count, options, layout));
+    TEST_ASSERT((std::vector< Platform::uint32 >{ 0, 7, 11 }), get_line_starts(layout));
+
+    Text::Release_layout(layout);
+
+    return Passed;
+}
+
+static Test_result test_cached_layout(
+    const Text::Font & font,
+    Text::Run_cache & cache,
+    const Text::Box * boxes,
+    const Platform::uint32 boxes_count,
+    const std::vector< Text::Font::character_t > & text)
+{
+    const Platform::uint32 count = Platform::uint32(text.size());
+
+    Text::Layout_buffer expected = { 0 };
+    Text::Layout_buffer layout = { 0 };
+
+    const auto expected_ret = Text::Init_layout(font, boxes, boxes_count, text.data(), count, expected);
+
+    TEST_ASSERT(expected_ret, Text::Init_layout(font, boxes, boxes_count, text.data(), count, cache, layout));
+    TEST_ASSERT(expected.m_Count, layout.m_Count);
+
+    for (Platform::uint32 i = 0; i < expected.m_Count; ++i)
+    {
+        TEST_ASSERT(expected.m_Positions[i].m_Glyph, layout.m_Positions[i].m_Glyph);
+        TEST_ASSERT(expected.m_Positions[i].m_Box, layout.m_Positions[i].m_Box);
+        TEST_ASSERT(expected.m_Positions[i].m_X, layout.m_Positions[i].m_X);
+        TEST_ASSERT(expected.m_Positions[i].m_Y, layout.m_Positions[i].m_Y);
+    }
+
+    Text::Release_layout(expected);
+    Text::Release_layout(layout);
+
+    return Passed;
+}
+
+UNIT_TEST(Text_run_cache)
+{
+    Text::Font font;
+    TEST_ASSERT(Utilities::Success, font.Init(create_font_data(false), false));
+
+    const std::vector< Text::Font::character_t > label = { 'a', 0x4e2d, 'a', 'a', Text::Line_feed, 'b', 'a' };
+    const std::vector< Text::Font::character_t > number = { 'b', 'b', 'a', 'a', 0x4e2d, 'a', 'b' };
+    const std::vector< Text::Font::character_t > menu = { 0x4e2d, 0x4e2d, 'a', 'b', 'a', 'b', 'a' };
+
+    Text::Box boxes[] = {
+        { 0, 0, 20, -60 },
+        { 0, -100, 40, -160 },
+    };
+
+    Text::Run_cache cache;
+    TEST_ASSERT(Utilities::Invalid_parameter, cache.Init(0));
+    TEST_ASSERT(Utilities::Success, cache.Init(1024 * 1024));
+
+    /* Stored, then copied */
+    TEST_ASSERT(Passed, test_cached_layout(font, cache, boxes, 2, label));
+    TEST_ASSERT(1, cache.Get_runs_count());
+    TEST_ASSERT(Passed, test_cached_layout(font, cache, boxes, 2, label));
+    TEST_ASSERT(1, cache.Get_runs_count());
+
+    /* Run is moved with box */
+    boxes[0].m_Left += 7;
+    boxes[0].m_Right += 7;
+    boxes[0].m_Top -= 3;
+    TEST_ASSERT(Passed, test_cached_layout(font, cache, boxes, 2, label));
+    TEST_ASSERT(1, cache.Get_runs_count());
+
+    /* Box is too low for run, text flows into next box and is not stored */
+    boxes[0].m_Bottom = -20;
+    TEST_ASSERT(Passed, test_cached_layout(font, cache, boxes, 2, label));
+    TEST_ASSERT(Passed, test_cached_layout(font, cache, boxes, 1, label));
+    TEST_ASSERT(1, cache.Get_runs_count());
+    boxes[0].m_Bottom = -60;
+
+    /* Width is part of key */
+    boxes[0].m_Right += 10;
+    TEST_ASSERT(Passed, test_cached_layout(font, cache, boxes, 2, label));
+    TEST_ASSERT(2, cache.Get_runs_count());
+
+    /* Budget for two runs of the same length, least recently used is evicted */
+    const size_t run_size = cache.Get_size() / 2;
+    TEST_ASSERT(Utilities::Success, cache.Init(run_size * 2 + run_size / 2));
+
+    TEST_ASSERT(Passed, test_cached_layout(font, cache, boxes, 2, label));
+    TEST_ASSERT(Passed, test_cached_layout(font, cache, boxes, 2, number));
+    TEST_ASSERT(Passed, test_cached_layout(font, cache, boxes, 2, label));
+    TEST_ASSERT(Passed, test_cached_layout(font, cache, boxes, 2, menu));
+    TEST_ASSERT(2, cache.Get_runs_count());
+    TEST_ASSERT(true, cache.Get_size() <= cache.Get_budget());
+
+    Text::Run_cache::Run_view run;
+    const Platform::int32 width = boxes[0].m_Right - boxes[0].m_Left;
+    TEST_ASSERT(true, cache.Find(font, width, label.data(), 7, run));
+    TEST_ASSERT(true, cache.Find(font, width, menu.data(), 7, run));
+    TEST_ASSERT(false, cache.Find(font, width, number.data(), 7, run));
+    TEST_ASSERT(false, cache.Find(font, width + 1, menu.data(), 7, run));
+    TEST_ASSERT(false, cache.Find(font, width, menu.data(), 6, run));
+
+    cache.Clear();
+    TEST_ASSERT(0, cache.Get_runs_count());
+    TEST_ASSERT(0, cache.Get_size());
+
+    return Passed;
+}
+
+UNIT_TEST(Text_render_kernels)
+{
+    std::vector< Platform::uint8 > coverage(70);
+    std::vector< Platform::uint8 > initial(4 * 70);
+    Platform::uint32 seed = 5;
+
+    for (auto & value : coverage)
+    {
+        seed = seed * 1103515245 + 12345;
+        value = Platform::uint8(seed >> 16);
+    }
+    for (auto & value : initial)
+    {
+        seed = seed * 1103515245 + 12345;
+        value = Platform::uint8(seed >> 16);
+    }
+    coverage[0] = 0;
+    coverage[1] = 255;
+
+    const Platform::uint32 colors[] = { 0xffffffff, 0x80204060, 0x00ff00ff };
+    const bool has_avx2 = Math::Cpu::Has_features(Math::Cpu::Avx2);
+
+    for (Platform::uint32 count = 0; count <= 70; ++count)
+    {
+        /* A8 */
+        std::vector< Platform::uint8 > expected(initial.begin(), initial.begin() + count);
+        std::vector< Platform::uint8 > result(expected);
+
+        Text::Render_kernels::blend_a8(coverage.data(), expected.data(), count);
+
+        Text::Render_kernels::Sse2::Blend_a8(coverage.data(), result.data(), count);
+        TEST_ASSERT(true, expected == result);
+
+        if (true == has_avx2)
+        {
+            result.assign(initial.begin(), initial.begin() + count);
+            Text::Render_kernels::Avx2::Blend_a8(coverage.data(), result.data(), count);
+            TEST_ASSERT(true, expected == result);
+        }
+
+        /* RGBA8 */
+        for (auto color : colors)
+        {
+            expected.assign(initial.begin(), initial.begin() + 4 * count);
+            result = expected;
+
+            Text::Render_kernels::blend_rgba8(coverage.data(), expected.data(), count, color);
+
+            Text::Render_kernels::Sse2::Blend_rgba8(coverage.data(), result.data(), count, color);
+            TEST_ASSERT(true, expected == result);
+
+            if (true == has_avx2)
+            {
+                result.assign(initial.begin(), initial.begin() + 4 * count);
+                Text::Render_kernels::Avx2::Blend_rgba8(coverage.data(), result.data(), count, color);
+                TEST_ASSERT(true, expected == result);
+            }
+        }
+    }
+
+    /* Full coverage replaces pixel, no coverage keeps it */
+    Platform::uint8 pixels[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    const Platform::uint8 ends[] = { 255, 0 };
+
+    Text::Render_kernels::blend_rgba8(ends, pixels, 2, 0xff302010);
+    TEST_ASSERT(0x10, pixels[0]);
+    TEST_ASSERT(0x20, pixels[1]);
+    TEST_ASSERT(0x30, pixels[2]);
+    TEST_ASSERT(0xff, pixels[3]);
+    TEST_ASSERT(5, pixels[4]);
+    TEST_ASSERT(8, pixels[7]);
+
+    return Passed;
+}
+
+/* Blends glyphs pixel by pixel */
+static void render_reference(
+    const Text::Layout_buffer & layout,
+    const Text::Surface & surface)
+{
+    for (Platform::uint32 i = 0; i < layout.m_Count; ++i)
+    {
+        const auto & position = layout.m_Positions[i];
+        const auto & descriptor = position.m_Glyph->Get_descriptor();
+        const Platform::uint8 * image = position.m_Glyph->Get_data().Data();
+
+        for (Platform::int32 row = 0; row < Platform::int32(descriptor.m_height); ++row)
+        {
+            for (Platform::int32 column = 0; column < Platform::int32(descriptor.m_width); ++column)
+            {
+                const Platform::int32 x = position.m_X + descriptor.m_left + column;
+                const Platform::int32 y = position.m_Y + descriptor.m_top - row;
+
+                if ((x < position.m_Box->m_Left) || (x >= position.m_Box->m_Right) ||
+                    (y > position.m_Box->m_Top) || (y <= position.m_Box->m_Bottom) ||
+                    (x < 0) || (x >= Platform::int32(surface.m_Width)) ||
+                    (-y < 0) || (-y >= Platform::int32(surface.m_Height)))
+                {
+                    continue;
+                }
+
+                const Platform::uint8 * coverage = image + row * descriptor.m_width + column;
+                Platform::uint8 * pixel = surface.m_Data + (-y) * surface.m_Pitch;
+
+                if (Text::Surface_RGBA8 == surface.m_Format)
+                {
+                    Text::Render_kernels::blend_rgba8(coverage, pixel + 4 * x, 1, surface.m_Color);
+                }
+                else
+                {
+                    Text::Render_kernels::blend_a8(coverage, pixel + x, 1);
+                }
+            }
+        }
+    }
+}
+
+static Test_result test_render(
+    const Text::Layout_buffer & layout,
+    Task::Pool & pool,
+    Text::Surface_format format,
+    Platform::uint32 width,
+    Platform::uint32 height)
+{
+    const Platform::uint32 pixel_size = (Text::Surface_RGBA8 == format) ? 4 : 1;
+    const Platform::uint32 pitch = width * pixel_size + 3;
+
+    std::vector< Platform::uint8 > expected(pitch * height, 0x40);
+    std::vector< Platform::uint8 > result(expected);
+    std::vector< Platform::uint8 > parallel(expected);
+
+    Text::Surface surface = { expected.data(), width, height, pitch, format, 0xc0ff8020 };
+    render_reference(layout, surface);
+    TEST_ASSERT(false, expected == result);
+
+    surface.m_Data = result.data();
+    TEST_ASSERT(Utilities::Success, Text::Render(layout, surface));
+    TEST_ASSERT(true, expected == result);
+
+    surface.m_Data = parallel.data();
+    TEST_ASSERT(Utilities::Success, Text::Render(layout, surface, pool));
+    TEST_ASSERT(true, expected == parallel);
+
+    return Passed;
+}
+
+UNIT_TEST(Text_render)
+{
+    Text::Font font;
+    TEST_ASSERT(Utilities::Success, font.Init(create_font_data(false), false));
+
+    Task::Pool pool;
+    pool.Init(3);
+
+    /* Glyphs overlap each other when they are put closer than their width */
+    std::vector< Text::Box > boxes;
+    for (Platform::int32 i = 0; i < 30; ++i)
+    {
+        boxes.push_back(Text::Box{ 7 * (i % 2), -20 * i, 7 * (i % 2) + 60, -20 * i - 20 });
+    }
+
+    const Text::Font::character_t alphabet[] = { 'a', 0x4e2d, 'b', 'a' };
+    std::vector< Text::Font::character_t > text(300);
+    Platform::uint32 seed = 3;
+
+    for (auto & character : text)
+    {
+        seed = seed * 1103515245 + 12345;
+        character = alphabet[(seed >> 8) % 4];
+    }
+
+    Text::Layout_buffer layout = { 0 };
+    Text::Init_layout(font, boxes.data(), Platform::uint32(boxes.size()), text.data(), Platform::uint32(text.size()), layout);
+    TEST_ASSERT(true, 0 != layout.m_Count);
+
+    TEST_ASSERT(Passed, test_render(layout, pool, Text::Surface_A8, 80, 620));
+    TEST_ASSERT(Passed, test_render(layout, pool, Text::Surface_RGBA8, 80, 620));
+
+    /* Clipped to surface */
+    TEST_ASSERT(Passed, test_render(layout, pool, Text::Surface_A8, 33, 101));
+    TEST_ASSERT(Passed, test_render(layout, pool, Text::Surface_RGBA8, 33, 101));
+
+    /* Clipped to boxes */
+    for (auto & box : boxes)
+    {
+        box.m_Left += 3;
+        box.m_Right -= 25;
+        box.m_Top -= 2;
+        box.m_Bottom += 3;
+    }
+    TEST_ASSERT(Passed, test_render(layout, pool, Text::Surface_RGBA8, 80, 620));
+
+    /* Invalid surface */
+    Platform::uint8 pixel = 0;
+    const Text::Surface surface = { &pixel, 2, 1, 1, Text::Surface_A8, 0 };
+    TEST_ASSERT(Utilities::Invalid_parameter, Text::Render(layout, surface));
+
+    Text::Release_layout(layout);
+
+    return Passed;
+}
+
+static Memory::Binary_data append_data(
+    const Memory::Binary_data & data,
+    const std::vector< Platform::uint8 > & trailing)
+{
+    auto ptr = new Platform::uint8[data.Size() + trailing.size()];
+
+    memcpy(ptr, data.Data(), data.Size());
+    memcpy(ptr + data.Size(), trailing.data(), trailing.size());
+
+    return Memory::Binary_data(ptr, data.Size() + trailing.size());
+}
+
+UNIT_TEST(Text_font_trailing_data)
+{
+    const Memory::Binary_data data = create_font_data(false);
+
+    /* Padding after images of font without kerning */
+    const std::vector< Platform::uint8 > padding(7, 0xff);
+
+    Text::Font font;
+    TEST_ASSERT(Utilities::Success, font.Init(append_data(data, padding), false));
+    TEST_ASSERT(Passed, test_font_glyphs(font));
+    TEST_ASSERT(false, font.Has_kerning());
+
+    /* Tagged section that claims more pairs than there are */
+    const std::vector< Platform::uint8 > kerning = { 'K', 'E', 'R', 'N', 2, 0, 0, 0, 'a', 0, 0, 0 };
+
+    Text::Font font_b;
+    TEST_ASSERT(Utilities::Failure, font_b.Init(append_data(data, kerning), false));
+
+    return Passed;
+}